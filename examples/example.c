@@ -51,6 +51,7 @@ int main(int argc, char* argv[])
     struct qrvmc_host_context* ctx = example_host_create_context(tx_context);
     struct qrvmc_message msg = {
         .kind = QRVMC_CALL,
+        .flags = QRVMC_HOST_TX_CONTEXT_PTR | QRVMC_HOST_EMIT_LOGS,
         .sender = addr,
         .recipient = addr,
         .value = value,
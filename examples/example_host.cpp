@@ -4,44 +4,80 @@
 
 /// @file
 /// Example implementation of a QRVMC Host.
+///
+/// The host callbacks are on the hot path of the VM, so the state is kept in the hash maps
+/// and the derived values like the code hash are computed once when the state is modified.
 
 #include "example_host.h"
 
 #include <qrvmc/qrvmc.hpp>
 
 #include <algorithm>
-#include <map>
+#include <unordered_map>
 #include <vector>
 
 using namespace qrvmc::literals;
 
 namespace qrvmc
 {
-struct account
+class account
 {
-    virtual ~account() = default;
+    std::vector<uint8_t> m_code;
+    qrvmc::bytes32 m_code_hash{};
 
+public:
     qrvmc::uint256be balance = {};
-    std::vector<uint8_t> code;
-    std::map<qrvmc::bytes32, qrvmc::bytes32> storage;
 
-    virtual qrvmc::bytes32 code_hash() const
+    const std::vector<uint8_t>& code() const noexcept { return m_code; }
+
+    /// Returns the code hash computed when the code was set.
+    const qrvmc::bytes32& code_hash() const noexcept { return m_code_hash; }
+
+    /// Sets the code and computes its hash.
+    void set_code(std::vector<uint8_t> code)
     {
+        m_code = std::move(code);
+
         // Extremely dumb "hash" function.
-        qrvmc::bytes32 ret{};
-        for (const auto v : code)
-            ret.bytes[v % sizeof(ret.bytes)] ^= v;
-        return ret;
+        m_code_hash = {};
+        for (const auto v : m_code)
+            m_code_hash.bytes[v % sizeof(m_code_hash.bytes)] ^= v;
+    }
+};
+
+using accounts = std::unordered_map<qrvmc::address, account>;
+
+/// The key of the storage of all the accounts: the account address and the storage key.
+struct storage_key
+{
+    qrvmc::address addr;
+    qrvmc::bytes32 key;
+
+    friend bool operator==(const storage_key& a, const storage_key& b) noexcept
+    {
+        return a.key == b.key && a.addr == b.addr;
+    }
+};
+
+struct storage_key_hash
+{
+    size_t operator()(const storage_key& k) const noexcept
+    {
+        const auto key_hash = std::hash<qrvmc::bytes32>{}(k.key);
+        const auto addr_hash = std::hash<qrvmc::address>{}(k.addr);
+        return static_cast<size_t>(fnv::fnv1a_by64(key_hash, addr_hash));
     }
 };
 
-using accounts = std::map<qrvmc::address, account>;
+/// The storage of all the accounts in the single hash map, so the access is one lookup.
+using storage = std::unordered_map<storage_key, qrvmc::bytes32, storage_key_hash>;
 
 }  // namespace qrvmc
 
 class ExampleHost : public qrvmc::Host
 {
     qrvmc::accounts accounts;
+    qrvmc::storage storage;
     qrvmc_tx_context tx_context{};
 
 public:
@@ -51,6 +87,19 @@ public:
       : accounts{_accounts}, tx_context{_tx_context}
     {}
 
+    /// Reserves the space for the accounts and the storage slots to avoid the rehashing.
+    void reserve(size_t num_accounts, size_t num_storage_slots)
+    {
+        accounts.reserve(num_accounts);
+        storage.reserve(num_storage_slots);
+    }
+
+    /// Sets the code of the account, creating the account if needed.
+    void set_code(const qrvmc::address& addr, std::vector<uint8_t> code)
+    {
+        accounts[addr].set_code(std::move(code));
+    }
+
     bool account_exists(const qrvmc::address& addr) const noexcept final
     {
         return accounts.find(addr) != accounts.end();
@@ -59,13 +108,9 @@ public:
     qrvmc::bytes32 get_storage(const qrvmc::address& addr,
                                const qrvmc::bytes32& key) const noexcept final
     {
-        const auto account_iter = accounts.find(addr);
-        if (account_iter == accounts.end())
-            return {};
-
-        const auto storage_iter = account_iter->second.storage.find(key);
-        if (storage_iter != account_iter->second.storage.end())
-            return storage_iter->second;
+        const auto it = storage.find({addr, key});
+        if (it != storage.end())
+            return it->second;
         return {};
     }
 
@@ -73,9 +118,10 @@ public:
                                      const qrvmc::bytes32& key,
                                      const qrvmc::bytes32& value) noexcept final
     {
-        auto& account = accounts[addr];
-        auto prev_value = account.storage[key];
-        account.storage[key] = value;
+        accounts.try_emplace(addr);
+        auto& slot = storage[{addr, key}];
+        const auto prev_value = slot;
+        slot = value;
 
         return (prev_value == value) ? QRVMC_STORAGE_ASSIGNED : QRVMC_STORAGE_MODIFIED;
     }
@@ -92,7 +138,7 @@ public:
     {
         auto it = accounts.find(addr);
         if (it != accounts.end())
-            return it->second.code.size();
+            return it->second.code().size();
         return 0;
     }
 
@@ -113,7 +159,7 @@ public:
         if (it == accounts.end())
             return 0;
 
-        const auto& code = it->second.code;
+        const auto& code = it->second.code();
 
         if (code_offset >= code.size())
             return 0;
@@ -132,6 +178,8 @@ public:
 
     qrvmc_tx_context get_tx_context() const noexcept final { return tx_context; }
 
+    const qrvmc_tx_context* get_tx_context_ptr() const noexcept final { return &tx_context; }
+
     // NOLINTNEXTLINE(bugprone-exception-escape)
     qrvmc::bytes32 get_block_hash(int64_t number) const noexcept final
     {
@@ -188,4 +236,20 @@ void example_host_destroy_context(qrvmc_host_context* context)
 {
     delete qrvmc::Host::from_context<ExampleHost>(context);
 }
+
+void example_host_reserve(qrvmc_host_context* context,
+                          size_t num_accounts,
+                          size_t num_storage_slots)
+{
+    qrvmc::Host::from_context<ExampleHost>(context)->reserve(num_accounts, num_storage_slots);
+}
+
+void example_host_set_code(qrvmc_host_context* context,
+                           const qrvmc_address* address,
+                           const uint8_t* code,
+                           size_t code_size)
+{
+    qrvmc::Host::from_context<ExampleHost>(context)->set_code(*address,
+                                                              {code, code + code_size});
+}
 }
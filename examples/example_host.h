@@ -14,6 +14,19 @@ struct qrvmc_host_context* example_host_create_context(struct qrvmc_tx_context t
 
 void example_host_destroy_context(struct qrvmc_host_context* context);
 
+/// Reserves the space for the given numbers of the accounts and the storage slots in total.
+/// The host state grows without the rehashing up to these sizes.
+void example_host_reserve(struct qrvmc_host_context* context,
+                          size_t num_accounts,
+                          size_t num_storage_slots);
+
+/// Sets the code of the account, creating the account if needed. The code hash is computed
+/// once here, not by every get_code_hash().
+void example_host_set_code(struct qrvmc_host_context* context,
+                           const qrvmc_address* address,
+                           const uint8_t* code,
+                           size_t code_size);
+
 #if __cplusplus
 }
 #endif
@@ -0,0 +1,1298 @@
+// EVMC: Ethereum Client-VM Connector API.
+// Copyright 2026 The EVMC Authors.
+// Licensed under the Apache License, Version 2.0.
+
+/// @file
+/// Example template JIT implementation of the QRVMC VM interface for x86-64.
+///
+/// This VM implements the same subset of QRVM instructions as the Example VM with the same
+/// simplifications, and the same results as its "block" charging mode: the gas and the stack
+/// requirements of a basic block are checked once at the block entry. The logs are passed
+/// to the host as by the Example VM: buffered if the host accepts the batches of logs
+/// (::QRVMC_HOST_EMIT_LOGS), otherwise one by one right away.
+///
+/// The code is translated to the x86-64 machine code by stitching together the prebuilt
+/// machine code templates of the instructions, with only the immediate values patched in.
+/// The simple instructions are executed inline, the others call the helper functions.
+/// The helpers access the Host through the qrvmc_host_interface function pointers.
+/// The compiled code is placed in the mmap'd executable memory and cached by the VM instance.
+///
+/// The register assignment in the compiled code:
+/// - rbx: the stack pointer (the first empty stack slot, the top item is at [rbx-32]),
+/// - r12: the gas left,
+/// - r13: the pointer to the execution State.
+/// The stack items are 4 little-endian 64-bit words, the least significant first.
+
+#include "example_jit_vm.h"
+#include <qrvmc/helpers.h>
+#include <qrvmc/instructions.h>
+#include <qrvmc/qrvmc.h>
+#include <qrvmc/qrvmc.hpp>
+#include <sys/mman.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#if !defined(__x86_64__)
+#error "The Example JIT VM supports only x86-64"
+#endif
+
+/// The Example JIT VM methods, helper and types are contained in the anonymous namespace.
+namespace
+{
+/// The maximum supported code size. Keeps the jump destinations and the displacements
+/// of the jumps in the compiled code in the 32-bit immediates.
+constexpr size_t max_code_size = size_t{1} << 24;
+
+/// The maximum number of the compiled codes in the VM cache.
+constexpr size_t max_cached_codes = 1024;
+
+/// The stack size limit.
+constexpr size_t stack_limit = 1024;
+
+/// The helper result telling the compiled code to continue the execution.
+/// Other results are the status codes ending the execution.
+constexpr int continue_execution = -1;
+
+static_assert(sizeof(qrvmc::uint256) == 32, "the compiled code assumes 32-byte stack items");
+
+/// The Example JIT VM memory: the buffer growing with the QRVM memory.
+class Memory
+{
+public:
+    /// The maximum memory size. The expansion to this size costs more than 2^31 gas.
+    static constexpr size_t max_size = size_t{32} * 1024 * 1024;
+
+    /// The current size of the memory, the multiple of 32.
+    size_t size() const noexcept { return m_data.size(); }
+
+    /// The beginning of the memory. It may move when the memory is expanded.
+    uint8_t* data() noexcept { return m_data.data(); }
+
+    /// Expands the memory by the region defined by @p offset and @p region_size,
+    /// charging the QRVM memory expansion cost from @p gas_left.
+    /// Returns false if the memory cannot be expanded to the required size
+    /// or the gas is insufficient.
+    bool expand(uint64_t offset, uint64_t region_size, int64_t& gas_left) noexcept
+    {
+        if (region_size == 0)
+            return true;  // The empty region does not expand the memory.
+
+        if (offset > max_size || region_size > max_size - offset)
+            return false;  // Cannot expand more than the max memory size.
+
+        const auto new_size = (offset + region_size + 31) / 32 * 32;
+        if (new_size > m_data.size())
+        {
+            gas_left -= cost(new_size) - cost(m_data.size());
+            if (gas_left < 0)
+                return false;
+            try
+            {
+                m_data.resize(static_cast<size_t>(new_size));
+            }
+            catch (const std::bad_alloc&)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// Clears the memory for reuse by following execution. The allocation is kept.
+    void clear() noexcept { m_data.clear(); }
+
+private:
+    std::vector<uint8_t> m_data;
+
+    /// Returns the QRVM cost of the memory of the given size (the multiple of 32).
+    static int64_t cost(uint64_t size) noexcept
+    {
+        const auto num_words = static_cast<int64_t>(size / 32);
+        return 3 * num_words + num_words * num_words / 512;
+    }
+};
+
+/// The execution state accessed by the compiled code and the helpers.
+struct State
+{
+    int64_t gas_left = 0;                        ///< The gas left, synced around helper calls.
+    const qrvmc::uint256* stack_begin = nullptr;  ///< The bottom of the stack.
+    const qrvmc::uint256* stack_end = nullptr;    ///< The end of the stack space.
+    Memory* memory = nullptr;                     ///< The memory.
+    const qrvmc_host_interface* host = nullptr;   ///< The Host interface.
+    qrvmc_host_context* context = nullptr;        ///< The Host context.
+    const qrvmc_message* msg = nullptr;           ///< The message being executed.
+    qrvmc::LogBuffer* logs = nullptr;             ///< The logs not yet passed to the host.
+    const uint8_t* output_data = nullptr;         ///< The output of RETURN or REVERT.
+    size_t output_size = 0;                       ///< The output size.
+};
+
+static_assert(std::is_standard_layout<State>::value, "the State fields are accessed by offset");
+
+/// Returns the 8-bit displacement of the State field in the compiled code.
+constexpr uint8_t disp(size_t offset)
+{
+    return static_cast<uint8_t>(offset);
+}
+
+/// @cond internal
+constexpr auto gas_left_disp = disp(offsetof(State, gas_left));
+constexpr auto stack_begin_disp = disp(offsetof(State, stack_begin));
+constexpr auto stack_end_disp = disp(offsetof(State, stack_end));
+/// @endcond
+
+/// Creates 256-bit value out of an 160-bit address.
+inline qrvmc::uint256 to_uint256(const qrvmc_address& address)
+{
+    qrvmc::uint256be value;
+    size_t offset = sizeof(value) - sizeof(address);
+    std::memcpy(&value.bytes[offset], address.bytes, sizeof(address.bytes));
+    return qrvmc::to_uint256(value);
+}
+
+/// Truncates 256-bit value to 32-bit value.
+inline uint32_t to_uint32(const qrvmc::uint256& value)
+{
+    return static_cast<uint32_t>(value[0]);
+}
+
+/// Converts 256-bit value to the memory offset or size. The values not fitting 64 bits
+/// are saturated, so the memory expansion fails.
+inline uint64_t to_memory_size(const qrvmc::uint256& value)
+{
+    return (value[1] | value[2] | value[3]) != 0 ? ~uint64_t{0} : value[0];
+}
+
+/// Truncates 256-bit value to 160-bit address.
+inline qrvmc_address to_address(const qrvmc::uint256& value)
+{
+    const auto bytes = qrvmc::to_uint256be(value);
+    qrvmc_address address = {};
+    size_t offset = sizeof(bytes) - sizeof(address);
+    std::memcpy(address.bytes, &bytes.bytes[offset], sizeof(address.bytes));
+    return address;
+}
+
+/// Returns the @p value shifted by @p n bits with the shift @p op.
+/// Shifts by 256 bits or more result in zero.
+template <typename Op>
+inline qrvmc::uint256 shift(const qrvmc::uint256& n, const qrvmc::uint256& value, Op op)
+{
+    if ((n[1] | n[2] | n[3]) != 0)
+        return {};
+    return op(value, n[0]);
+}
+
+/// @name The helpers of the instructions not worth inlining.
+/// The helpers get the stack pointer @p sp (the first empty slot) and put the results
+/// in place of the arguments. The compiled code adjusts the stack pointer afterwards.
+/// @{
+
+/// The helper of the pure instruction.
+using PureHelper = void (*)(qrvmc::uint256* sp) noexcept;
+
+void op_mul(qrvmc::uint256* sp) noexcept
+{
+    sp[-2] = sp[-1] * sp[-2];
+}
+
+void op_div(qrvmc::uint256* sp) noexcept
+{
+    sp[-2] = sp[-1] / sp[-2];
+}
+
+void op_mod(qrvmc::uint256* sp) noexcept
+{
+    sp[-2] = sp[-1] % sp[-2];
+}
+
+void op_lt(qrvmc::uint256* sp) noexcept
+{
+    sp[-2] = sp[-1] < sp[-2] ? 1 : 0;
+}
+
+void op_gt(qrvmc::uint256* sp) noexcept
+{
+    sp[-2] = sp[-1] > sp[-2] ? 1 : 0;
+}
+
+void op_eq(qrvmc::uint256* sp) noexcept
+{
+    sp[-2] = sp[-1] == sp[-2] ? 1 : 0;
+}
+
+void op_iszero(qrvmc::uint256* sp) noexcept
+{
+    sp[-1] = !sp[-1] ? 1 : 0;
+}
+
+void op_shl(qrvmc::uint256* sp) noexcept
+{
+    sp[-2] = shift(sp[-1], sp[-2], [](const qrvmc::uint256& v, uint64_t n) { return v << n; });
+}
+
+void op_shr(qrvmc::uint256* sp) noexcept
+{
+    sp[-2] = shift(sp[-1], sp[-2], [](const qrvmc::uint256& v, uint64_t n) { return v >> n; });
+}
+
+/// The helper of the instruction accessing the execution state.
+/// Returns continue_execution or the status code ending the execution.
+using StateHelper = int (*)(State& state, qrvmc::uint256* sp) noexcept;
+
+int op_address(State& state, qrvmc::uint256* sp) noexcept
+{
+    sp[0] = to_uint256(state.msg->recipient);
+    return continue_execution;
+}
+
+int op_calldataload(State& state, qrvmc::uint256* sp) noexcept
+{
+    const auto offset = to_memory_size(sp[-1]);
+    qrvmc::uint256be value;
+
+    if (offset < state.msg->input_size)
+    {
+        const auto available = state.msg->input_size - static_cast<size_t>(offset);
+        const auto copy_size = std::min(available, sizeof(value));
+        std::memcpy(value.bytes, &state.msg->input_data[offset], copy_size);
+    }
+
+    sp[-1] = qrvmc::to_uint256(value);
+    return continue_execution;
+}
+
+int op_calldatacopy(State& state, qrvmc::uint256* sp) noexcept
+{
+    const auto mem_offset = to_memory_size(sp[-1]);
+    const auto input_offset = to_memory_size(sp[-2]);
+    const auto size = to_memory_size(sp[-3]);
+    if (!state.memory->expand(mem_offset, size, state.gas_left))
+        return QRVMC_OUT_OF_GAS;
+
+    state.gas_left -= 3 * static_cast<int64_t>((size + 31) / 32);  // The copy cost.
+    if (state.gas_left < 0)
+        return QRVMC_OUT_OF_GAS;
+
+    if (size == 0)
+        return continue_execution;
+
+    const auto& msg = *state.msg;
+    uint8_t* p = state.memory->data() + mem_offset;
+    size_t copy_size = 0;
+    if (input_offset < msg.input_size)
+    {
+        const auto available = msg.input_size - static_cast<size_t>(input_offset);
+        copy_size = std::min(available, static_cast<size_t>(size));
+    }
+    if (copy_size != 0)
+        std::memcpy(p, &msg.input_data[input_offset], copy_size);
+    std::memset(p + copy_size, 0, static_cast<size_t>(size) - copy_size);
+    return continue_execution;
+}
+
+int op_blockhash(State& state, qrvmc::uint256* sp) noexcept
+{
+    const auto number = static_cast<int64_t>(to_uint32(sp[-1]));
+    sp[-1] = qrvmc::to_uint256(state.host->get_block_hash(state.context, number));
+    return continue_execution;
+}
+
+int op_number(State& state, qrvmc::uint256* sp) noexcept
+{
+    const auto number = state.host->get_tx_context(state.context).block_number;
+    sp[0] = static_cast<uint32_t>(number);
+    return continue_execution;
+}
+
+int op_mload(State& state, qrvmc::uint256* sp) noexcept
+{
+    const auto offset = to_memory_size(sp[-1]);
+    if (!state.memory->expand(offset, 32, state.gas_left))
+        return QRVMC_OUT_OF_GAS;
+    qrvmc::uint256be value;
+    std::memcpy(value.bytes, state.memory->data() + offset, sizeof(value));
+    sp[-1] = qrvmc::to_uint256(value);
+    return continue_execution;
+}
+
+int op_mstore(State& state, qrvmc::uint256* sp) noexcept
+{
+    const auto offset = to_memory_size(sp[-1]);
+    const auto value = qrvmc::to_uint256be(sp[-2]);
+    if (!state.memory->expand(offset, sizeof(value), state.gas_left))
+        return QRVMC_OUT_OF_GAS;
+    std::memcpy(state.memory->data() + offset, value.bytes, sizeof(value));
+    return continue_execution;
+}
+
+int op_sload(State& state, qrvmc::uint256* sp) noexcept
+{
+    const qrvmc_bytes32 index = qrvmc::to_uint256be(sp[-1]);
+    const auto value = state.host->get_storage(state.context, &state.msg->recipient, &index);
+    sp[-1] = qrvmc::to_uint256(value);
+    return continue_execution;
+}
+
+int op_sstore(State& state, qrvmc::uint256* sp) noexcept
+{
+    const qrvmc_bytes32 index = qrvmc::to_uint256be(sp[-1]);
+    const qrvmc_bytes32 value = qrvmc::to_uint256be(sp[-2]);
+    state.host->set_storage(state.context, &state.msg->recipient, &index, &value);
+    return continue_execution;
+}
+
+int op_msize(State& state, qrvmc::uint256* sp) noexcept
+{
+    sp[0] = state.memory->size();
+    return continue_execution;
+}
+
+int op_call(State& state, qrvmc::uint256* sp) noexcept
+{
+    qrvmc_message call_msg = {};
+    // The host capabilities.
+    call_msg.flags = state.msg->flags & (QRVMC_HOST_TX_CONTEXT_PTR | QRVMC_HOST_EMIT_LOGS);
+    call_msg.depth = state.msg->depth + 1;
+    call_msg.gas = to_uint32(sp[-1]);
+    call_msg.recipient = to_address(sp[-2]);
+    call_msg.sender = state.msg->recipient;
+    call_msg.code_address = call_msg.recipient;
+    call_msg.value = qrvmc::to_uint256be(sp[-3]);
+
+    const auto input_offset = to_memory_size(sp[-4]);
+    const auto input_size = to_memory_size(sp[-5]);
+    const auto output_offset = to_memory_size(sp[-6]);
+    auto output_size = to_memory_size(sp[-7]);
+
+    auto& memory = *state.memory;
+    if (!memory.expand(input_offset, input_size, state.gas_left) ||
+        !memory.expand(output_offset, output_size, state.gas_left))
+        return QRVMC_OUT_OF_GAS;
+
+    // The pointers are taken after both expansions, as these may move the memory.
+    call_msg.input_data = input_size != 0 ? memory.data() + input_offset : nullptr;
+    call_msg.input_size = static_cast<size_t>(input_size);
+
+    // The call may be executed by another VM, emitting its logs to the host directly,
+    // so the logs so far are passed to the host first to keep the order.
+    auto& logs = *state.logs;
+    try
+    {
+        logs.flush(state.host, state.context, *state.msg);
+    }
+    catch (const std::bad_alloc&)
+    {
+        return QRVMC_OUT_OF_GAS;
+    }
+    const auto logs_checkpoint = logs.size();
+    qrvmc_result call_result = state.host->call(state.context, &call_msg);
+    if (call_result.status_code != QRVMC_SUCCESS)
+        logs.truncate(logs_checkpoint);  // Drop the logs of the failed call.
+
+    sp[-7] = call_result.status_code == QRVMC_SUCCESS ? 1 : 0;
+
+    if (output_size > call_result.output_size)
+        output_size = call_result.output_size;
+    if (output_size != 0)
+        std::memcpy(memory.data() + output_offset, call_result.output_data, output_size);
+
+    if (call_result.release != nullptr)
+        call_result.release(&call_result);
+    return continue_execution;
+}
+
+/// The helper of LOG0-LOG4 with the @p NumTopics.
+template <size_t NumTopics>
+int op_log(State& state, qrvmc::uint256* sp) noexcept
+{
+    const auto offset = to_memory_size(sp[-1]);
+    const auto size = to_memory_size(sp[-2]);
+    if (!state.memory->expand(offset, size, state.gas_left))
+        return QRVMC_OUT_OF_GAS;
+
+    const uint8_t* data = size != 0 ? state.memory->data() + offset : nullptr;
+    qrvmc::bytes32 topics[NumTopics + 1];  // Not empty for LOG0.
+    for (size_t i = 0; i < NumTopics; ++i)
+        topics[i] = qrvmc::to_uint256be(sp[-3 - static_cast<std::ptrdiff_t>(i)]);
+
+    const auto& msg = *state.msg;
+    if ((msg.flags & QRVMC_HOST_EMIT_LOGS) == 0)
+    {
+        state.host->emit_log(state.context, &msg.recipient, data, static_cast<size_t>(size),
+                             topics, NumTopics);
+        return continue_execution;
+    }
+    try
+    {
+        state.logs->append(msg.recipient, data, static_cast<size_t>(size), topics, NumTopics);
+    }
+    catch (const std::bad_alloc&)
+    {
+        return QRVMC_OUT_OF_GAS;
+    }
+    return continue_execution;
+}
+
+/// The helper of RETURN and REVERT ending the execution with the @p StatusCode.
+template <qrvmc_status_code StatusCode>
+int op_return(State& state, qrvmc::uint256* sp) noexcept
+{
+    const auto offset = to_memory_size(sp[-1]);
+    const auto size = to_memory_size(sp[-2]);
+    if (!state.memory->expand(offset, size, state.gas_left))
+        return QRVMC_OUT_OF_GAS;
+
+    state.output_data = size != 0 ? state.memory->data() + offset : nullptr;
+    state.output_size = static_cast<size_t>(size);
+    return StatusCode;
+}
+/// @}
+
+/// @name The machine code templates.
+/// @{
+
+/// Saves the callee-saved registers and loads the registers of the compiled code.
+/// The 3 pushes keep the stack 16-byte aligned for the helper calls.
+constexpr uint8_t prologue[] = {
+    0x53,                               // push rbx
+    0x41, 0x54,                         // push r12
+    0x41, 0x55,                         // push r13
+    0x49, 0x89, 0xfd,                   // mov r13, rdi
+    0x48, 0x89, 0xf3,                   // mov rbx, rsi
+    0x4d, 0x8b, 0x65, gas_left_disp,    // mov r12, [r13+gas_left]
+};
+
+/// Stores the gas left and returns the status code in eax.
+constexpr uint8_t epilogue[] = {
+    0x4d, 0x89, 0x65, gas_left_disp,  // mov [r13+gas_left], r12
+    0x41, 0x5d,                       // pop r13
+    0x41, 0x5c,                       // pop r12
+    0x5b,                             // pop rbx
+    0xc3,                             // ret
+};
+
+constexpr uint8_t add[] = {
+    0x48, 0x8b, 0x43, 0xe0,  // mov rax, [rbx-32]
+    0x48, 0x01, 0x43, 0xc0,  // add [rbx-64], rax
+    0x48, 0x8b, 0x43, 0xe8,  // mov rax, [rbx-24]
+    0x48, 0x11, 0x43, 0xc8,  // adc [rbx-56], rax
+    0x48, 0x8b, 0x43, 0xf0,  // mov rax, [rbx-16]
+    0x48, 0x11, 0x43, 0xd0,  // adc [rbx-48], rax
+    0x48, 0x8b, 0x43, 0xf8,  // mov rax, [rbx-8]
+    0x48, 0x11, 0x43, 0xd8,  // adc [rbx-40], rax
+    0x48, 0x83, 0xeb, 0x20,  // sub rbx, 32
+};
+
+constexpr uint8_t sub[] = {
+    0x48, 0x8b, 0x43, 0xe0,  // mov rax, [rbx-32]
+    0x48, 0x2b, 0x43, 0xc0,  // sub rax, [rbx-64]
+    0x48, 0x89, 0x43, 0xc0,  // mov [rbx-64], rax
+    0x48, 0x8b, 0x43, 0xe8,  // mov rax, [rbx-24]
+    0x48, 0x1b, 0x43, 0xc8,  // sbb rax, [rbx-56]
+    0x48, 0x89, 0x43, 0xc8,  // mov [rbx-56], rax
+    0x48, 0x8b, 0x43, 0xf0,  // mov rax, [rbx-16]
+    0x48, 0x1b, 0x43, 0xd0,  // sbb rax, [rbx-48]
+    0x48, 0x89, 0x43, 0xd0,  // mov [rbx-48], rax
+    0x48, 0x8b, 0x43, 0xf8,  // mov rax, [rbx-8]
+    0x48, 0x1b, 0x43, 0xd8,  // sbb rax, [rbx-40]
+    0x48, 0x89, 0x43, 0xd8,  // mov [rbx-40], rax
+    0x48, 0x83, 0xeb, 0x20,  // sub rbx, 32
+};
+
+/// The template of the bitwise instruction with the given x86 opcode (op r/m64, r64).
+struct Bitwise
+{
+    uint8_t code[36] = {};
+
+    constexpr explicit Bitwise(uint8_t opcode) noexcept
+    {
+        for (int i = 0; i < 4; ++i)
+        {
+            const auto word = static_cast<uint8_t>(8 * i);
+            const uint8_t instructions[8] = {
+                0x48, 0x8b, 0x43, static_cast<uint8_t>(0xe0 + word),  // mov rax, [rbx-32+word]
+                0x48, opcode, 0x43, static_cast<uint8_t>(0xc0 + word),  // op [rbx-64+word], rax
+            };
+            for (int j = 0; j < 8; ++j)
+                code[8 * i + j] = instructions[j];
+        }
+        const uint8_t pop[] = {0x48, 0x83, 0xeb, 0x20};  // sub rbx, 32
+        for (int j = 0; j < 4; ++j)
+            code[32 + j] = pop[j];
+    }
+};
+
+constexpr Bitwise and_{0x21};
+constexpr Bitwise or_{0x09};
+constexpr Bitwise xor_{0x31};
+
+constexpr uint8_t not_[] = {
+    0x48, 0xf7, 0x53, 0xe0,  // not qword [rbx-32]
+    0x48, 0xf7, 0x53, 0xe8,  // not qword [rbx-24]
+    0x48, 0xf7, 0x53, 0xf0,  // not qword [rbx-16]
+    0x48, 0xf7, 0x53, 0xf8,  // not qword [rbx-8]
+};
+
+constexpr uint8_t pop[] = {
+    0x48, 0x83, 0xeb, 0x20,  // sub rbx, 32
+};
+
+constexpr uint8_t dup1[] = {
+    0xf3, 0x0f, 0x6f, 0x43, 0xe0,  // movdqu xmm0, [rbx-32]
+    0xf3, 0x0f, 0x6f, 0x4b, 0xf0,  // movdqu xmm1, [rbx-16]
+    0xf3, 0x0f, 0x7f, 0x03,        // movdqu [rbx], xmm0
+    0xf3, 0x0f, 0x7f, 0x4b, 0x10,  // movdqu [rbx+16], xmm1
+    0x48, 0x83, 0xc3, 0x20,        // add rbx, 32
+};
+
+constexpr uint8_t swap1[] = {
+    0xf3, 0x0f, 0x6f, 0x43, 0xe0,  // movdqu xmm0, [rbx-32]
+    0xf3, 0x0f, 0x6f, 0x4b, 0xf0,  // movdqu xmm1, [rbx-16]
+    0xf3, 0x0f, 0x6f, 0x53, 0xc0,  // movdqu xmm2, [rbx-64]
+    0xf3, 0x0f, 0x6f, 0x5b, 0xd0,  // movdqu xmm3, [rbx-48]
+    0xf3, 0x0f, 0x7f, 0x43, 0xc0,  // movdqu [rbx-64], xmm0
+    0xf3, 0x0f, 0x7f, 0x4b, 0xd0,  // movdqu [rbx-48], xmm1
+    0xf3, 0x0f, 0x7f, 0x53, 0xe0,  // movdqu [rbx-32], xmm2
+    0xf3, 0x0f, 0x7f, 0x5b, 0xf0,  // movdqu [rbx-16], xmm3
+};
+
+/// Loads the jump destination (truncated to 32 bits) of JUMP to eax and pops it.
+constexpr uint8_t jump_head[] = {
+    0x8b, 0x43, 0xe0,        // mov eax, [rbx-32]
+    0x48, 0x83, 0xeb, 0x20,  // sub rbx, 32
+};
+
+/// Loads the jump destination of JUMPI to eax, ORs the condition words to rcx, pops both
+/// and skips the jump if the condition is zero (the rel8 displacement is patched).
+constexpr uint8_t jumpi_head[] = {
+    0x48, 0x8b, 0x4b, 0xc0,  // mov rcx, [rbx-64]
+    0x48, 0x0b, 0x4b, 0xc8,  // or rcx, [rbx-56]
+    0x48, 0x0b, 0x4b, 0xd0,  // or rcx, [rbx-48]
+    0x48, 0x0b, 0x4b, 0xd8,  // or rcx, [rbx-40]
+    0x8b, 0x43, 0xe0,        // mov eax, [rbx-32]
+    0x48, 0x83, 0xeb, 0x40,  // sub rbx, 64
+    0x48, 0x85, 0xc9,        // test rcx, rcx
+    0x74, 0x00,              // jz <after the jump>
+};
+/// @}
+
+/// The shared exits of the compiled code.
+enum class Exit
+{
+    end,  ///< The epilogue returning to the caller.
+    out_of_gas,
+    stack_underflow,
+    stack_overflow,
+    bad_jump_destination,
+    undefined_instruction,
+};
+
+/// The buffer of the machine code being generated.
+class CodeBuffer
+{
+public:
+    /// The offset of the next emitted byte.
+    size_t size() const noexcept { return m_code.size(); }
+
+    const std::vector<uint8_t>& code() const noexcept { return m_code; }
+
+    template <size_t N>
+    void emit(const uint8_t (&bytes)[N])
+    {
+        m_code.insert(m_code.end(), bytes, bytes + N);
+    }
+
+    void emit(std::initializer_list<uint8_t> bytes)
+    {
+        m_code.insert(m_code.end(), bytes.begin(), bytes.end());
+    }
+
+    void emit32(uint32_t value)
+    {
+        for (int i = 0; i < 4; ++i)
+            m_code.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+
+    void emit64(uint64_t value)
+    {
+        emit32(static_cast<uint32_t>(value));
+        emit32(static_cast<uint32_t>(value >> 32));
+    }
+
+    void patch8(size_t offset, uint8_t value) noexcept { m_code[offset] = value; }
+
+    void patch32(size_t offset, uint32_t value) noexcept
+    {
+        for (int i = 0; i < 4; ++i)
+            m_code[offset + static_cast<size_t>(i)] = static_cast<uint8_t>(value >> (8 * i));
+    }
+
+    /// Emits the rel32 displacement of the jump to the exit, resolved by bind().
+    void emit_jump(Exit exit)
+    {
+        m_fixups.push_back({size(), exit});
+        emit32(0);
+    }
+
+    /// Binds the exit to the current offset and resolves the jumps emitted so far.
+    void bind(Exit exit) noexcept
+    {
+        for (const auto& fixup : m_fixups)
+        {
+            if (fixup.exit == exit)
+                patch32(fixup.offset, static_cast<uint32_t>(size() - (fixup.offset + 4)));
+        }
+    }
+
+private:
+    struct Fixup
+    {
+        size_t offset;
+        Exit exit;
+    };
+
+    std::vector<uint8_t> m_code;
+    std::vector<Fixup> m_fixups;
+};
+
+/// The basic block requirements being collected while its instructions are emitted.
+struct Block
+{
+    size_t header = 0;             ///< The offset of the block header in the machine code.
+    int32_t gas = 0;               ///< The gas cost of the block's instructions.
+    int32_t stack_required = 0;    ///< The minimum stack height required by the block.
+    int32_t stack_change = 0;      ///< The stack height change from the block entry.
+    int32_t stack_max_growth = 0;  ///< The maximum stack height growth in the block.
+};
+
+/// @name The emitters of the machine code templates with the immediate values.
+/// @{
+
+/// The offsets of the immediate values in the block header.
+constexpr size_t header_gas_imm = 3;
+constexpr size_t header_required_imm = 16;
+constexpr size_t header_growth_imm = 33;
+
+/// Emits the block header checking the gas and the stack requirements of the block.
+/// The immediate values are patched by patch_block_header() when the block is complete.
+void emit_block_header(CodeBuffer& buf)
+{
+    buf.emit({0x49, 0x81, 0xec});  // sub r12, <gas>
+    buf.emit32(0);
+    buf.emit({0x0f, 0x8c});  // jl out_of_gas
+    buf.emit_jump(Exit::out_of_gas);
+    buf.emit({0x48, 0x8d, 0x83});  // lea rax, [rbx - <required> * 32]
+    buf.emit32(0);
+    buf.emit({0x49, 0x3b, 0x45, stack_begin_disp});  // cmp rax, [r13+stack_begin]
+    buf.emit({0x0f, 0x82});                          // jb stack_underflow
+    buf.emit_jump(Exit::stack_underflow);
+    buf.emit({0x48, 0x8d, 0x83});  // lea rax, [rbx + <max_growth> * 32]
+    buf.emit32(0);
+    buf.emit({0x49, 0x3b, 0x45, stack_end_disp});  // cmp rax, [r13+stack_end]
+    buf.emit({0x0f, 0x87});                        // ja stack_overflow
+    buf.emit_jump(Exit::stack_overflow);
+}
+
+void patch_block_header(CodeBuffer& buf, const Block& block) noexcept
+{
+    buf.patch32(block.header + header_gas_imm, static_cast<uint32_t>(block.gas));
+    buf.patch32(block.header + header_required_imm,
+                static_cast<uint32_t>(-block.stack_required * 32));
+    buf.patch32(block.header + header_growth_imm,
+                static_cast<uint32_t>(block.stack_max_growth * 32));
+}
+
+/// Emits PUSH of the value from the push data. The data missing at the code end are zeros.
+void emit_push(CodeBuffer& buf, const uint8_t* data, size_t num_bytes, size_t available)
+{
+    qrvmc::uint256be bytes;
+    std::memcpy(&bytes.bytes[sizeof(bytes) - num_bytes], data, std::min(num_bytes, available));
+    const auto value = qrvmc::to_uint256(bytes);
+
+    for (size_t i = 0; i < 4; ++i)
+    {
+        const auto word_disp = static_cast<uint8_t>(8 * i);
+        if (value[i] <= 0x7fffffff)
+        {
+            buf.emit({0x48, 0xc7, 0x43, word_disp});  // mov qword [rbx+word], <imm32>
+            buf.emit32(static_cast<uint32_t>(value[i]));
+        }
+        else
+        {
+            buf.emit({0x48, 0xb8});  // mov rax, <imm64>
+            buf.emit64(value[i]);
+            buf.emit({0x48, 0x89, 0x43, word_disp});  // mov [rbx+word], rax
+        }
+    }
+    buf.emit({0x48, 0x83, 0xc3, 0x20});  // add rbx, 32
+}
+
+/// Emits the stack pointer adjustment by @p stack_change items.
+void emit_stack_change(CodeBuffer& buf, int stack_change)
+{
+    if (stack_change == 0)
+        return;
+    buf.emit({0x48, 0x81, 0xc3});  // add rbx, <imm32>
+    buf.emit32(static_cast<uint32_t>(stack_change * 32));
+}
+
+void emit_call(CodeBuffer& buf, PureHelper helper, int stack_change)
+{
+    buf.emit({0x48, 0x89, 0xdf});  // mov rdi, rbx
+    buf.emit({0x48, 0xb8});        // mov rax, <helper>
+    buf.emit64(reinterpret_cast<uintptr_t>(helper));
+    buf.emit({0xff, 0xd0});  // call rax
+    emit_stack_change(buf, stack_change);
+}
+
+/// Emits the call of the helper accessing the State. The gas left is synced around the call
+/// and the execution ends if the helper returns the status code.
+void emit_call(CodeBuffer& buf, StateHelper helper, int stack_change)
+{
+    buf.emit({0x4d, 0x89, 0x65, gas_left_disp});  // mov [r13+gas_left], r12
+    buf.emit({0x4c, 0x89, 0xef});                 // mov rdi, r13
+    buf.emit({0x48, 0x89, 0xde});                 // mov rsi, rbx
+    buf.emit({0x48, 0xb8});                       // mov rax, <helper>
+    buf.emit64(reinterpret_cast<uintptr_t>(helper));
+    buf.emit({0xff, 0xd0});                       // call rax
+    buf.emit({0x4d, 0x8b, 0x65, gas_left_disp});  // mov r12, [r13+gas_left]
+    buf.emit({0x83, 0xf8, 0xff});                 // cmp eax, continue_execution
+    buf.emit({0x0f, 0x85});                       // jne epilogue
+    buf.emit_jump(Exit::end);
+    emit_stack_change(buf, stack_change);
+}
+
+/// Emits the jump to the destination in eax through the @p jump_table
+/// of the native addresses of the JUMPDESTs.
+void emit_jump(CodeBuffer& buf, size_t code_size, const uint8_t* const* jump_table)
+{
+    buf.emit({0x3d});  // cmp eax, <code_size>
+    buf.emit32(static_cast<uint32_t>(code_size));
+    buf.emit({0x0f, 0x83});  // jae bad_jump_destination
+    buf.emit_jump(Exit::bad_jump_destination);
+    buf.emit({0x48, 0xb9});  // mov rcx, <jump_table>
+    buf.emit64(reinterpret_cast<uintptr_t>(jump_table));
+    buf.emit({0x48, 0x8b, 0x04, 0xc1});  // mov rax, [rcx+rax*8]
+    buf.emit({0x48, 0x85, 0xc0});        // test rax, rax
+    buf.emit({0x0f, 0x84});              // jz bad_jump_destination
+    buf.emit_jump(Exit::bad_jump_destination);
+    buf.emit({0xff, 0xe0});  // jmp rax
+}
+
+/// Emits the end of the execution with the status code.
+void emit_exit(CodeBuffer& buf, qrvmc_status_code status_code)
+{
+    buf.emit({0xb8});  // mov eax, <status_code>
+    buf.emit32(static_cast<uint32_t>(status_code));
+    buf.emit({0xe9});  // jmp epilogue
+    buf.emit_jump(Exit::end);
+}
+/// @}
+
+/// The compiled code: the machine code in the executable memory and the jump table.
+class CompiledCode
+{
+public:
+    /// The bytecode, the key of the VM cache.
+    const std::vector<uint8_t> bytecode;
+
+    /// The native addresses of the JUMPDESTs, null for the other code positions.
+    std::vector<const uint8_t*> jump_table;
+
+    CompiledCode(const uint8_t* code, size_t code_size)
+      : bytecode(code, code + code_size), jump_table(code_size, nullptr)
+    {}
+
+    ~CompiledCode()
+    {
+        if (m_exec != nullptr)
+            munmap(m_exec, m_exec_size);
+    }
+
+    CompiledCode(const CompiledCode&) = delete;
+    CompiledCode& operator=(const CompiledCode&) = delete;
+
+    /// Copies the machine code to the newly mapped memory and makes it executable
+    /// (but no longer writable). Returns false in case of failure.
+    bool load(const std::vector<uint8_t>& machine_code) noexcept
+    {
+        const auto size = machine_code.size();
+        void* p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED)
+            return false;
+        std::memcpy(p, machine_code.data(), size);
+        if (mprotect(p, size, PROT_READ | PROT_EXEC) != 0)
+        {
+            munmap(p, size);
+            return false;
+        }
+        m_exec = static_cast<uint8_t*>(p);
+        m_exec_size = size;
+        return true;
+    }
+
+    /// Returns the native address of the machine code offset.
+    const uint8_t* address(size_t offset) const noexcept { return m_exec + offset; }
+
+    /// Executes the compiled code with the given stack. Returns the status code.
+    int run(State& state, qrvmc::uint256* stack) const noexcept
+    {
+        using Entry = int (*)(State*, qrvmc::uint256*);
+        return reinterpret_cast<Entry>(m_exec)(&state, stack);
+    }
+
+private:
+    uint8_t* m_exec = nullptr;  ///< The executable memory.
+    size_t m_exec_size = 0;     ///< The size of the executable memory.
+};
+
+/// Compiles the code. Returns null in case the executable memory cannot be allocated.
+///
+/// The basic blocks are split as in the Example VM: the block starts at the beginning
+/// of the code, at each JUMPDEST and after each instruction ending the block (or jumping).
+/// The gas cost of each instruction is 1, the stack requirements come from the QRVM
+/// instruction metrics.
+std::unique_ptr<CompiledCode> compile(const uint8_t* code, size_t code_size)
+{
+    static const auto metrics = qrvmc_get_instruction_metrics_table(QRVMC_LATEST_STABLE_REVISION);
+
+    auto compiled = std::make_unique<CompiledCode>(code, code_size);
+    std::vector<size_t> jumpdests;  // The machine code offsets of the JUMPDESTs.
+    jumpdests.resize(code_size, 0);
+
+    CodeBuffer buf;
+    buf.emit(prologue);
+
+    Block block;
+    bool in_block = false;
+    for (size_t pc = 0; pc < code_size; ++pc)
+    {
+        const auto op = code[pc];
+        if (!in_block || op == OP_JUMPDEST)
+        {
+            if (in_block)
+                patch_block_header(buf, block);
+            if (op == OP_JUMPDEST)
+                jumpdests[pc] = buf.size();
+            block = {};
+            block.header = buf.size();
+            emit_block_header(buf);
+            in_block = true;
+        }
+
+        const auto& m = metrics[op];
+        block.gas += 1;
+        block.stack_required =
+            std::max(block.stack_required, m.stack_height_required - block.stack_change);
+        block.stack_change += m.stack_height_change;
+        block.stack_max_growth = std::max(block.stack_max_growth, block.stack_change);
+
+        bool ends_block = false;
+        switch (op)
+        {
+        case OP_STOP:
+            emit_exit(buf, QRVMC_SUCCESS);
+            ends_block = true;
+            break;
+        case OP_ADD:
+            buf.emit(add);
+            break;
+        case OP_MUL:
+            emit_call(buf, op_mul, -1);
+            break;
+        case OP_SUB:
+            buf.emit(sub);
+            break;
+        case OP_DIV:
+            emit_call(buf, op_div, -1);
+            break;
+        case OP_MOD:
+            emit_call(buf, op_mod, -1);
+            break;
+        case OP_LT:
+            emit_call(buf, op_lt, -1);
+            break;
+        case OP_GT:
+            emit_call(buf, op_gt, -1);
+            break;
+        case OP_EQ:
+            emit_call(buf, op_eq, -1);
+            break;
+        case OP_ISZERO:
+            emit_call(buf, op_iszero, 0);
+            break;
+        case OP_AND:
+            buf.emit(and_.code);
+            break;
+        case OP_OR:
+            buf.emit(or_.code);
+            break;
+        case OP_XOR:
+            buf.emit(xor_.code);
+            break;
+        case OP_NOT:
+            buf.emit(not_);
+            break;
+        case OP_SHL:
+            emit_call(buf, op_shl, -1);
+            break;
+        case OP_SHR:
+            emit_call(buf, op_shr, -1);
+            break;
+        case OP_ADDRESS:
+            emit_call(buf, op_address, 1);
+            break;
+        case OP_CALLDATALOAD:
+            emit_call(buf, op_calldataload, 0);
+            break;
+        case OP_CALLDATACOPY:
+            emit_call(buf, op_calldatacopy, -3);
+            break;
+        case OP_BLOCKHASH:
+            emit_call(buf, op_blockhash, 0);
+            break;
+        case OP_NUMBER:
+            emit_call(buf, op_number, 1);
+            break;
+        case OP_POP:
+            buf.emit(pop);
+            break;
+        case OP_MLOAD:
+            emit_call(buf, op_mload, 0);
+            break;
+        case OP_MSTORE:
+            emit_call(buf, op_mstore, -2);
+            break;
+        case OP_SLOAD:
+            emit_call(buf, op_sload, 0);
+            break;
+        case OP_SSTORE:
+            emit_call(buf, op_sstore, -2);
+            break;
+        case OP_JUMP:
+            buf.emit(jump_head);
+            emit_jump(buf, code_size, compiled->jump_table.data());
+            ends_block = true;
+            break;
+        case OP_JUMPI:
+        {
+            buf.emit(jumpi_head);
+            const auto jump_begin = buf.size();
+            emit_jump(buf, code_size, compiled->jump_table.data());
+            buf.patch8(jump_begin - 1, static_cast<uint8_t>(buf.size() - jump_begin));
+            ends_block = true;
+            break;
+        }
+        case OP_MSIZE:
+            emit_call(buf, op_msize, 1);
+            break;
+        case OP_JUMPDEST:
+            break;
+        case OP_DUP1:
+            buf.emit(dup1);
+            break;
+        case OP_SWAP1:
+            buf.emit(swap1);
+            break;
+        case OP_LOG0:
+            emit_call(buf, op_log<0>, -2);
+            break;
+        case OP_LOG1:
+            emit_call(buf, op_log<1>, -3);
+            break;
+        case OP_LOG2:
+            emit_call(buf, op_log<2>, -4);
+            break;
+        case OP_LOG3:
+            emit_call(buf, op_log<3>, -5);
+            break;
+        case OP_LOG4:
+            emit_call(buf, op_log<4>, -6);
+            break;
+        case OP_CALL:
+            emit_call(buf, op_call, -6);
+            break;
+        case OP_RETURN:
+            emit_call(buf, op_return<QRVMC_SUCCESS>, 0);
+            ends_block = true;
+            break;
+        case OP_REVERT:
+            emit_call(buf, op_return<QRVMC_REVERT>, 0);
+            ends_block = true;
+            break;
+        default:
+            if (op >= OP_PUSH1 && op <= OP_PUSH32)
+            {
+                const auto num_push_bytes = size_t{op} - OP_PUSH1 + 1;
+                emit_push(buf, &code[pc + 1], num_push_bytes, code_size - pc - 1);
+                pc += num_push_bytes;
+                break;
+            }
+            buf.emit({0xe9});  // jmp undefined_instruction
+            buf.emit_jump(Exit::undefined_instruction);
+            ends_block = true;
+            break;
+        }
+
+        if (ends_block)
+        {
+            patch_block_header(buf, block);
+            in_block = false;
+        }
+    }
+    if (in_block)
+        patch_block_header(buf, block);
+    emit_exit(buf, QRVMC_SUCCESS);  // The implicit STOP at the code end.
+
+    const std::pair<Exit, qrvmc_status_code> errors[] = {
+        {Exit::out_of_gas, QRVMC_OUT_OF_GAS},
+        {Exit::stack_underflow, QRVMC_STACK_UNDERFLOW},
+        {Exit::stack_overflow, QRVMC_STACK_OVERFLOW},
+        {Exit::bad_jump_destination, QRVMC_BAD_JUMP_DESTINATION},
+        {Exit::undefined_instruction, QRVMC_UNDEFINED_INSTRUCTION},
+    };
+    for (const auto& [exit, status_code] : errors)
+    {
+        buf.bind(exit);
+        emit_exit(buf, status_code);
+    }
+    buf.bind(Exit::end);
+    buf.emit(epilogue);
+
+    if (!compiled->load(buf.code()))
+        return nullptr;
+    for (size_t pc = 0; pc < code_size; ++pc)
+    {
+        if (jumpdests[pc] != 0)
+            compiled->jump_table[pc] = compiled->address(jumpdests[pc]);
+    }
+    return compiled;
+}
+
+/// The example JIT VM instance struct extending the qrvmc_vm.
+struct ExampleJitVM : qrvmc_vm
+{
+    int verbose = 0;  ///< The verbosity level.
+
+    /// The cache of the compiled codes, by the bytecode owned by the compiled code.
+    std::unordered_map<std::string_view, std::shared_ptr<const CompiledCode>> cache;
+    std::mutex cache_mutex;  ///< The mutex guarding the cache.
+
+    ExampleJitVM();  ///< Constructor to initialize the qrvmc_vm struct.
+
+    /// Returns the compiled code from the cache or compiles it.
+    /// Returns null if the code cannot be compiled.
+    std::shared_ptr<const CompiledCode> get_compiled(const uint8_t* code, size_t code_size)
+    {
+        const auto key = std::string_view{reinterpret_cast<const char*>(code), code_size};
+        {
+            const std::lock_guard lock{cache_mutex};
+            if (const auto it = cache.find(key); it != cache.end())
+                return it->second;
+        }
+
+        // Compile without holding the lock. Concurrent compilations of the same code are fine.
+        std::shared_ptr<const CompiledCode> compiled = compile(code, code_size);
+        if (compiled == nullptr)
+            return nullptr;
+
+        const std::lock_guard lock{cache_mutex};
+        if (cache.size() >= max_cached_codes)
+            cache.clear();  // The compiled codes being executed are kept alive by the callers.
+        const auto& bytecode = compiled->bytecode;
+        const auto compiled_key =
+            std::string_view{reinterpret_cast<const char*>(bytecode.data()), bytecode.size()};
+        return cache.emplace(compiled_key, std::move(compiled)).first->second;
+    }
+};
+
+/// The implementation of the qrvmc_vm::destroy() method.
+void destroy(qrvmc_vm* instance)
+{
+    delete static_cast<ExampleJitVM*>(instance);
+}
+
+/// The example implementation of the qrvmc_vm::get_capabilities() method.
+qrvmc_capabilities_flagset get_capabilities(qrvmc_vm* /*instance*/)
+{
+    return QRVMC_CAPABILITY_QRVM1;
+}
+
+/// Example JIT VM options:
+/// - verbose: the verbosity level (-1 - 9).
+///
+/// The implementation of the qrvmc_vm::set_option() method.
+enum qrvmc_set_option_result set_option(qrvmc_vm* instance, const char* name, const char* value)
+{
+    auto* vm = static_cast<ExampleJitVM*>(instance);
+    if (std::strcmp(name, "verbose") == 0)
+    {
+        if (value == nullptr)
+            return QRVMC_SET_OPTION_INVALID_VALUE;
+
+        char* end = nullptr;
+        auto v = std::strtol(value, &end, 0);
+        if (end == value)  // Parsing the value failed.
+            return QRVMC_SET_OPTION_INVALID_VALUE;
+        if (v > 9 || v < -1)  // Not in the valid range.
+            return QRVMC_SET_OPTION_INVALID_VALUE;
+        vm->verbose = static_cast<int>(v);
+        return QRVMC_SET_OPTION_SUCCESS;
+    }
+
+    return QRVMC_SET_OPTION_INVALID_NAME;
+}
+
+/// The Example JIT VM execution frame: the stack and the memory of a single execution.
+struct Frame
+{
+    qrvmc::uint256 stack[stack_limit];  ///< The stack space.
+    Memory memory;                      ///< The memory.
+    int32_t msg_depth = 0;              ///< The depth of the message of the execution.
+};
+
+/// The pool of execution frames reused by the executions in a thread,
+/// the frame index is the current depth of execute() calls.
+/// The frames in use share the log buffer as in the Example VM.
+struct FramePool
+{
+    std::vector<std::unique_ptr<Frame>> frames;  ///< The allocated frames.
+    size_t depth = 0;                            ///< The number of frames in use.
+    qrvmc::LogBuffer logs;                       ///< The logs not yet passed to the host.
+};
+
+/// The frame of the execution acquired from the per-thread pool for the execution lifetime.
+/// When released, the logs of the frame are dropped, unless committed.
+class ScopedFrame
+{
+    FramePool& pool;
+    size_t logs_checkpoint;  ///< The size of the log buffer at the frame start.
+
+    static Frame& acquire(FramePool& pool)
+    {
+        if (pool.depth == pool.frames.size())
+            pool.frames.emplace_back(new Frame);
+        return *pool.frames[pool.depth++];
+    }
+
+public:
+    Frame& frame;  ///< The acquired frame.
+
+    ScopedFrame(FramePool& p, int32_t msg_depth)
+      : pool{p}, logs_checkpoint{p.logs.size()}, frame{acquire(p)}
+    {
+        frame.msg_depth = msg_depth;
+    }
+
+    ~ScopedFrame()
+    {
+        frame.memory.clear();
+        pool.logs.truncate(logs_checkpoint);
+        --pool.depth;
+    }
+
+    ScopedFrame(const ScopedFrame&) = delete;
+    ScopedFrame& operator=(const ScopedFrame&) = delete;
+
+    qrvmc::LogBuffer& logs() noexcept { return pool.logs; }  ///< The shared log buffer.
+
+    /// Commits the logs of the successful execution: leaves them to the direct caller
+    /// in the frame below or passes them to the host now, as the Example VM does.
+    void commit_logs(const qrvmc_host_interface* host,
+                     qrvmc_host_context* context,
+                     const qrvmc_message& msg)
+    {
+        if (pool.depth > 1 && pool.frames[pool.depth - 2]->msg_depth == msg.depth - 1)
+            logs_checkpoint = pool.logs.size();
+        else
+            pool.logs.flush(host, context, msg);
+    }
+};
+
+/// The example implementation of the qrvmc_vm::execute() method.
+qrvmc_result execute(qrvmc_vm* instance,
+                     const qrvmc_host_interface* host,
+                     qrvmc_host_context* context,
+                     enum qrvmc_revision /*rev*/,
+                     const qrvmc_message* msg,
+                     const uint8_t* code,
+                     size_t code_size)
+{
+    auto* vm = static_cast<ExampleJitVM*>(instance);
+
+    if (code_size > max_code_size)
+        return qrvmc_make_result(QRVMC_INTERNAL_ERROR, 0, 0, nullptr, 0);
+
+    std::shared_ptr<const CompiledCode> compiled;
+    try
+    {
+        compiled = vm->get_compiled(code, code_size);
+    }
+    catch (const std::bad_alloc&)
+    {
+    }
+    if (compiled == nullptr)
+        return qrvmc_make_result(QRVMC_OUT_OF_MEMORY, 0, 0, nullptr, 0);
+
+    static thread_local FramePool frame_pool;
+    ScopedFrame scoped_frame{frame_pool, msg->depth};
+    auto& frame = scoped_frame.frame;
+
+    State state;
+    state.gas_left = msg->gas;
+    state.stack_begin = frame.stack;
+    state.stack_end = frame.stack + stack_limit;
+    state.memory = &frame.memory;
+    state.host = host;
+    state.context = context;
+    state.msg = msg;
+    state.logs = &scoped_frame.logs();
+
+    auto status_code = static_cast<qrvmc_status_code>(compiled->run(state, frame.stack));
+    if (status_code == QRVMC_SUCCESS)
+    {
+        // The execution ended with STOP or RETURN.
+        try
+        {
+            scoped_frame.commit_logs(host, context, *msg);
+        }
+        catch (const std::bad_alloc&)
+        {
+            status_code = QRVMC_OUT_OF_GAS;
+        }
+    }
+    if (status_code != QRVMC_SUCCESS && status_code != QRVMC_REVERT)
+        return qrvmc_make_result(status_code, 0, 0, nullptr, 0);
+    return qrvmc_make_result(status_code, state.gas_left, 0, state.output_data,
+                             state.output_size);
+}
+
+
+/// @cond internal
+#if !defined(PROJECT_VERSION)
+/// The dummy project version if not provided by the build system.
+#define PROJECT_VERSION "0.0.0"
+#endif
+/// @endcond
+
+ExampleJitVM::ExampleJitVM()
+  : qrvmc_vm{QRVMC_ABI_VERSION, "example_jit_vm", PROJECT_VERSION, ::destroy,
+             ::execute,         ::get_capabilities, ::set_option}
+{}
+}  // namespace
+
+extern "C" qrvmc_vm* qrvmc_create_example_jit_vm()
+{
+    return new ExampleJitVM;
+}
@@ -0,0 +1,23 @@
+// EVMC: Ethereum Client-VM Connector API.
+// Copyright 2026 The EVMC Authors.
+// Licensed under the Apache License, Version 2.0.
+
+#pragma once
+
+#include <qrvmc/qrvmc.h>
+#include <qrvmc/utils.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Creates QRVMC Example JIT VM.
+ *
+ * Available only on x86-64 POSIX systems.
+ */
+QRVMC_EXPORT struct qrvmc_vm* qrvmc_create_example_jit_vm(void);
+
+#ifdef __cplusplus
+}
+#endif
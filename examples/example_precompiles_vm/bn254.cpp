@@ -0,0 +1,1024 @@
+// EVMC: Ethereum Client-VM Connector API.
+// Copyright 2026 The EVMC Authors.
+// Licensed under the Apache License, Version 2.0.
+
+/// @file
+/// The BN254 (alt_bn128) curve operations (EIP-196, EIP-197).
+///
+/// - Fp: the 4-word Montgomery arithmetic. The top word of p is less than 2^62,
+///   so the multiplication needs no extra carry words.
+/// - The tower: Fp2 = Fp[i]/(i^2 + 1), Fp6 = Fp2[v]/(v^3 - xi), Fp12 = Fp6[w]/(w^2 - v)
+///   with xi = 9 + i.
+/// - G1: the Jacobian coordinates, the scalar multiplication splits the scalar with the GLV
+///   endomorphism (x, y) -> (beta x, y) into two 128-bit halves processed together in the wNAF.
+/// - G2: the points on the D-type twist y^2 = x^3 + 3/xi over Fp2. The subgroup membership is
+///   checked with the endomorphism psi (untwist-Frobenius-twist) and the 63-bit [u] Q.
+/// - Pairing: the optimal ate pairing. The Miller loop iterates over the NAF of 6u + 2 with
+///   the G2 point in the homogeneous projective coordinates (Costello, Lange, Naehrig,
+///   https://eprint.iacr.org/2009/615) and the sparse line multiplication. The Miller loops of
+///   all the pairs share the squarings of f and a single final exponentiation is done.
+///   The hard part of the final exponentiation follows Devegili, Scott and Dahab
+///   (https://eprint.iacr.org/2007/390) with the cyclotomic squarings (Granger, Scott,
+///   https://eprint.iacr.org/2009/565).
+
+#include "bn254.hpp"
+#include <qrvmc/qrvmc.hpp>
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+namespace precompiles
+{
+namespace
+{
+using qrvmc::uint256;
+using qrvmc::internal::umul;
+
+/// The prime p of the base field.
+constexpr uint256 P{0x3c208c16d87cfd47, 0x97816a916871ca8d, 0xb85045b68181585d,
+                    0x30644e72e131a029};
+
+/// The -p^-1 mod 2^64.
+constexpr uint64_t P_INV = 0x87d20782e4866389;
+
+/// The R^2 mod p for R = 2^256, converts to the Montgomery form.
+constexpr uint256 R2{0xf32cfc5b538afa89, 0xb5e71911d44501fb, 0x47ab1eff0a417ff6,
+                     0x06d89f71cab8351f};
+
+/// The order r of G1 and G2.
+constexpr uint256 ORDER{0x43e1f593f0000001, 0x2833e84879b97091, 0xb85045b68181585d,
+                        0x30644e72e131a029};
+
+/// Computes acc + a * b + carry, stores the low word in @p r and returns the high word.
+constexpr uint64_t mac(uint64_t& r, uint64_t acc, uint64_t a, uint64_t b, uint64_t carry) noexcept
+{
+#ifdef __SIZEOF_INT128__
+    // Cannot overflow: (2^64 - 1)^2 + 2 * (2^64 - 1) = 2^128 - 1.
+    const auto s = static_cast<qrvmc::internal::uint128>(a) * b + acc + carry;
+    r = static_cast<uint64_t>(s);
+    return static_cast<uint64_t>(s >> 64);
+#else
+    const auto p = umul(a, b);
+    const auto s1 = p.lo + acc;
+    const auto s2 = s1 + carry;
+    r = s2;
+    return p.hi + (s1 < acc) + (s2 < carry);
+#endif
+}
+
+/// Computes r = x + y and returns the carry (0 or 1).
+constexpr uint64_t add_with_carry(uint256& r, const uint256& x, const uint256& y) noexcept
+{
+    uint64_t carry = 0;
+    for (size_t i = 0; i < 4; ++i)
+    {
+        const auto s = x[i] + y[i];
+        const auto c1 = s < x[i];
+        r[i] = s + carry;
+        carry = uint64_t{c1} | uint64_t{r[i] < s};
+    }
+    return carry;
+}
+
+/// Computes r = x - y and returns the borrow (0 or 1).
+constexpr uint64_t sub_with_borrow(uint256& r, const uint256& x, const uint256& y) noexcept
+{
+    uint64_t borrow = 0;
+    for (size_t i = 0; i < 4; ++i)
+    {
+        const auto d = x[i] - y[i];
+        const auto b1 = x[i] < y[i];
+        r[i] = d - borrow;
+        borrow = uint64_t{b1} | uint64_t{d < borrow};
+    }
+    return borrow;
+}
+
+/// Reduces x < 2p to x mod p. Branch-free: the comparison result is not predictable.
+constexpr uint256 reduce_once(const uint256& x) noexcept
+{
+    uint256 d;
+    const auto mask = 0 - sub_with_borrow(d, x, P);
+    for (size_t i = 0; i < 4; ++i)
+        d[i] = (x[i] & mask) | (d[i] & ~mask);
+    return d;
+}
+
+/// The element of Fp in the Montgomery form.
+struct Fp
+{
+    uint256 v;  ///< The value times 2^256 mod p.
+};
+
+constexpr bool operator==(const Fp& a, const Fp& b) noexcept
+{
+    return a.v == b.v;
+}
+
+constexpr bool operator!=(const Fp& a, const Fp& b) noexcept
+{
+    return !(a == b);
+}
+
+constexpr Fp operator+(const Fp& a, const Fp& b) noexcept
+{
+    uint256 s;
+    add_with_carry(s, a.v, b.v);  // No carry: a + b < 2p < 2^255.
+    return {reduce_once(s)};
+}
+
+constexpr Fp operator-(const Fp& a, const Fp& b) noexcept
+{
+    uint256 d;
+    const auto mask = 0 - sub_with_borrow(d, a.v, b.v);
+    add_with_carry(d, d, {P[0] & mask, P[1] & mask, P[2] & mask, P[3] & mask});
+    return {d};
+}
+
+constexpr Fp operator-(const Fp& a) noexcept
+{
+    return Fp{} - a;
+}
+
+/// The Montgomery multiplication (CIOS). The top word of p is less than (2^64 - 1) / 2 - 1,
+/// so the final carries of the two accumulation chains fit the top word of the result.
+constexpr Fp operator*(const Fp& a, const Fp& b) noexcept
+{
+    uint64_t t[4]{};
+    for (size_t i = 0; i < 4; ++i)
+    {
+        auto c = mac(t[0], t[0], a.v[0], b.v[i], 0);
+        const auto q = t[0] * P_INV;
+        uint64_t zero = 0;
+        auto c2 = mac(zero, t[0], q, P[0], 0);
+        for (size_t j = 1; j < 4; ++j)
+        {
+            c = mac(t[j], t[j], a.v[j], b.v[i], c);
+            c2 = mac(t[j - 1], t[j], q, P[j], c2);
+        }
+        t[3] = c + c2;
+    }
+    return {reduce_once({t[0], t[1], t[2], t[3]})};
+}
+
+/// Converts the value < p to the Montgomery form.
+constexpr Fp to_fp(const uint256& x) noexcept
+{
+    return Fp{x} * Fp{R2};
+}
+
+/// Converts out of the Montgomery form.
+constexpr uint256 from_fp(const Fp& a) noexcept
+{
+    return (a * Fp{1}).v;
+}
+
+constexpr bool is_zero(const Fp& a) noexcept
+{
+    return !a.v;
+}
+
+Fp sqr(const Fp& a) noexcept
+{
+    return a * a;
+}
+
+/// Computes a^-1 = a^(p-2) (Fermat's little theorem). The inverse of zero is zero.
+Fp inv(const Fp& a) noexcept
+{
+    constexpr auto e = P - 2;
+    auto r = to_fp(1);
+    for (size_t i = 254; i-- > 0;)
+    {
+        r = sqr(r);
+        if (((e[i / 64] >> (i % 64)) & 1) != 0)
+            r = r * a;
+    }
+    return r;
+}
+
+/// The element of Fp2 = Fp[i]/(i^2 + 1): c0 + c1 i.
+struct Fp2
+{
+    Fp c0;
+    Fp c1;
+};
+
+constexpr bool operator==(const Fp2& a, const Fp2& b) noexcept
+{
+    return a.c0 == b.c0 && a.c1 == b.c1;
+}
+
+constexpr bool operator!=(const Fp2& a, const Fp2& b) noexcept
+{
+    return !(a == b);
+}
+
+constexpr Fp2 operator+(const Fp2& a, const Fp2& b) noexcept
+{
+    return {a.c0 + b.c0, a.c1 + b.c1};
+}
+
+constexpr Fp2 operator-(const Fp2& a, const Fp2& b) noexcept
+{
+    return {a.c0 - b.c0, a.c1 - b.c1};
+}
+
+constexpr Fp2 operator-(const Fp2& a) noexcept
+{
+    return {-a.c0, -a.c1};
+}
+
+/// The Karatsuba multiplication: 3 Fp multiplications.
+constexpr Fp2 operator*(const Fp2& a, const Fp2& b) noexcept
+{
+    const auto aa = a.c0 * b.c0;
+    const auto bb = a.c1 * b.c1;
+    return {aa - bb, (a.c0 + a.c1) * (b.c0 + b.c1) - aa - bb};
+}
+
+constexpr Fp2 operator*(const Fp2& a, const Fp& b) noexcept
+{
+    return {a.c0 * b, a.c1 * b};
+}
+
+constexpr bool is_zero(const Fp2& a) noexcept
+{
+    return is_zero(a.c0) && is_zero(a.c1);
+}
+
+/// The complex squaring: 2 Fp multiplications.
+Fp2 sqr(const Fp2& a) noexcept
+{
+    const auto ab = a.c0 * a.c1;
+    return {(a.c0 + a.c1) * (a.c0 - a.c1), ab + ab};
+}
+
+/// The conjugate, also the Frobenius map a^p.
+Fp2 conj(const Fp2& a) noexcept
+{
+    return {a.c0, -a.c1};
+}
+
+/// Multiplies by the non-residue xi = 9 + i.
+Fp2 mul_by_xi(const Fp2& a) noexcept
+{
+    const auto a2 = a + a;
+    const auto a8 = (a2 + a2) + (a2 + a2);
+    const auto a9 = a8 + a;
+    return {a9.c0 - a.c1, a9.c1 + a.c0};
+}
+
+Fp2 inv(const Fp2& a) noexcept
+{
+    const auto t = inv(sqr(a.c0) + sqr(a.c1));
+    return {a.c0 * t, -(a.c1 * t)};
+}
+
+/// The element of Fp6 = Fp2[v]/(v^3 - xi): c0 + c1 v + c2 v^2.
+struct Fp6
+{
+    Fp2 c0;
+    Fp2 c1;
+    Fp2 c2;
+};
+
+Fp6 operator+(const Fp6& a, const Fp6& b) noexcept
+{
+    return {a.c0 + b.c0, a.c1 + b.c1, a.c2 + b.c2};
+}
+
+Fp6 operator-(const Fp6& a, const Fp6& b) noexcept
+{
+    return {a.c0 - b.c0, a.c1 - b.c1, a.c2 - b.c2};
+}
+
+Fp6 operator-(const Fp6& a) noexcept
+{
+    return {-a.c0, -a.c1, -a.c2};
+}
+
+/// The Karatsuba multiplication: 6 Fp2 multiplications.
+Fp6 operator*(const Fp6& a, const Fp6& b) noexcept
+{
+    const auto v0 = a.c0 * b.c0;
+    const auto v1 = a.c1 * b.c1;
+    const auto v2 = a.c2 * b.c2;
+    return {
+        v0 + mul_by_xi((a.c1 + a.c2) * (b.c1 + b.c2) - v1 - v2),
+        (a.c0 + a.c1) * (b.c0 + b.c1) - v0 - v1 + mul_by_xi(v2),
+        (a.c0 + a.c2) * (b.c0 + b.c2) - v0 - v2 + v1,
+    };
+}
+
+Fp6 operator*(const Fp6& a, const Fp2& b) noexcept
+{
+    return {a.c0 * b, a.c1 * b, a.c2 * b};
+}
+
+/// Multiplies by the sparse b0 + b1 v: 5 Fp2 multiplications.
+Fp6 mul_by_01(const Fp6& a, const Fp2& b0, const Fp2& b1) noexcept
+{
+    const auto v0 = a.c0 * b0;
+    const auto v1 = a.c1 * b1;
+    return {
+        v0 + mul_by_xi((a.c1 + a.c2) * b1 - v1),
+        (a.c0 + a.c1) * (b0 + b1) - v0 - v1,
+        (a.c0 + a.c2) * b0 - v0 + v1,
+    };
+}
+
+/// Multiplies by v: (c0, c1, c2) -> (xi c2, c0, c1).
+Fp6 mul_by_v(const Fp6& a) noexcept
+{
+    return {mul_by_xi(a.c2), a.c0, a.c1};
+}
+
+/// The Chung-Hasan squaring (CH-SQR2).
+Fp6 sqr(const Fp6& a) noexcept
+{
+    const auto s0 = sqr(a.c0);
+    const auto ab = a.c0 * a.c1;
+    const auto s1 = ab + ab;
+    const auto s2 = sqr(a.c0 - a.c1 + a.c2);
+    const auto bc = a.c1 * a.c2;
+    const auto s3 = bc + bc;
+    const auto s4 = sqr(a.c2);
+    return {s0 + mul_by_xi(s3), s1 + mul_by_xi(s4), s1 + s2 + s3 - s0 - s4};
+}
+
+Fp6 inv(const Fp6& a) noexcept
+{
+    const auto t0 = sqr(a.c0) - mul_by_xi(a.c1 * a.c2);
+    const auto t1 = mul_by_xi(sqr(a.c2)) - a.c0 * a.c1;
+    const auto t2 = sqr(a.c1) - a.c0 * a.c2;
+    const auto t = inv(a.c0 * t0 + mul_by_xi(a.c2 * t1 + a.c1 * t2));
+    return {t0 * t, t1 * t, t2 * t};
+}
+
+/// The element of Fp12 = Fp6[w]/(w^2 - v): c0 + c1 w.
+///
+/// In the powers of w the coefficients are: c0.c0 w^0, c1.c0 w^1, c0.c1 w^2, c1.c1 w^3,
+/// c0.c2 w^4, c1.c2 w^5.
+struct Fp12
+{
+    Fp6 c0;
+    Fp6 c1;
+};
+
+bool operator==(const Fp12& a, const Fp12& b) noexcept
+{
+    return a.c0.c0 == b.c0.c0 && a.c0.c1 == b.c0.c1 && a.c0.c2 == b.c0.c2 &&
+           a.c1.c0 == b.c1.c0 && a.c1.c1 == b.c1.c1 && a.c1.c2 == b.c1.c2;
+}
+
+/// The Karatsuba multiplication: 3 Fp6 multiplications.
+Fp12 operator*(const Fp12& a, const Fp12& b) noexcept
+{
+    const auto aa = a.c0 * b.c0;
+    const auto bb = a.c1 * b.c1;
+    return {aa + mul_by_v(bb), (a.c0 + a.c1) * (b.c0 + b.c1) - aa - bb};
+}
+
+/// The complex squaring: 2 Fp6 multiplications.
+Fp12 sqr(const Fp12& a) noexcept
+{
+    const auto ab = a.c0 * a.c1;
+    return {(a.c0 + a.c1) * (a.c0 + mul_by_v(a.c1)) - ab - mul_by_v(ab), ab + ab};
+}
+
+/// The conjugate, also the map a^(p^6). This is the inverse in the cyclotomic subgroup.
+Fp12 conj(const Fp12& a) noexcept
+{
+    return {a.c0, -a.c1};
+}
+
+Fp12 inv(const Fp12& a) noexcept
+{
+    const auto t = inv(sqr(a.c0) - mul_by_v(sqr(a.c1)));
+    return {a.c0 * t, -(a.c1 * t)};
+}
+
+/// Multiplies by the sparse line l0 + l1 w + l3 w^3 = (l0, 0, 0) + (l1, l3, 0) w:
+/// 13 Fp2 multiplications instead of 18.
+Fp12 mul_by_line(const Fp12& a, const Fp2& l0, const Fp2& l1, const Fp2& l3) noexcept
+{
+    const auto aa = a.c0 * l0;
+    const auto bb = mul_by_01(a.c1, l1, l3);
+    const auto e = mul_by_01(a.c0 + a.c1, l0 + l1, l3);
+    return {aa + mul_by_v(bb), e - aa - bb};
+}
+
+/// The Frobenius map constants: xi^(k (p - 1) / 6) for k = 1..5.
+constexpr Fp2 FROBENIUS1[] = {
+    {to_fp({0xd60b35dadcc9e470, 0x5c521e08292f2176, 0xe8b99fdd76e68b60, 0x1284b71c2865a7df}),
+     to_fp({0xca5cf05f80f362ac, 0x747992778eeec7e5, 0xa6327cfe12150b8e, 0x246996f3b4fae7e6})},
+    {to_fp({0x99e39557176f553d, 0xb78cc310c2c3330c, 0x4c0bec3cf559b143, 0x2fb347984f7911f7}),
+     to_fp({0x1665d51c640fcba2, 0x32ae2a1d0b7c9dce, 0x4ba4cc8bd75a0794, 0x16c9e55061ebae20})},
+    {to_fp({0xdc54014671a0135a, 0xdbaae0eda9c95998, 0xdc5ec698b6e2f9b9, 0x063cf305489af5dc}),
+     to_fp({0x82d37f632623b0e3, 0x21807dc98fa25bd2, 0x0704b5a7ec796f2b, 0x07c03cbcac41049a})},
+    {to_fp({0x848a1f55921ea762, 0xd33365f7be94ec72, 0x80f3c0b75a181e84, 0x05b54f5e64eea801}),
+     to_fp({0xc13b4711cd2b8126, 0x3685d2ea1bdec763, 0x9f3a80b03b0b1c92, 0x2c145edbe7fd8aee})},
+    {to_fp({0x2ea2c810eab7692f, 0x425c459b55aa1bd3, 0xe93a3661a4353ff4, 0x0183c1e74f798649}),
+     to_fp({0x24c6b8ee6e0c2c4b, 0xb080cb99678e2ac0, 0xa27fb246c7729f7d, 0x12acf2ca76fd0675})},
+};
+
+/// The Frobenius map squared constants: xi^(k (p^2 - 1) / 6) for k = 1..5, all in Fp.
+constexpr Fp FROBENIUS2[] = {
+    to_fp({0xe4bd44e5607cfd49, 0xc28f069fbb966e3d, 0x5e6dd9e7e0acccb0, 0x30644e72e131a029}),
+    to_fp({0xe4bd44e5607cfd48, 0xc28f069fbb966e3d, 0x5e6dd9e7e0acccb0, 0x30644e72e131a029}),
+    to_fp({0x3c208c16d87cfd46, 0x97816a916871ca8d, 0xb85045b68181585d, 0x30644e72e131a029}),
+    to_fp({0x5763473177fffffe, 0xd4f263f1acdb5c4f, 0x59e26bcea0d48bac, 0x0000000000000000}),
+    to_fp({0x5763473177ffffff, 0xd4f263f1acdb5c4f, 0x59e26bcea0d48bac, 0x0000000000000000}),
+};
+
+/// The Frobenius map a^p: conjugates the coefficients and multiplies the coefficient
+/// of w^k by xi^(k (p - 1) / 6).
+Fp12 frobenius(const Fp12& a) noexcept
+{
+    return {
+        {conj(a.c0.c0), conj(a.c0.c1) * FROBENIUS1[1], conj(a.c0.c2) * FROBENIUS1[3]},
+        {conj(a.c1.c0) * FROBENIUS1[0], conj(a.c1.c1) * FROBENIUS1[2],
+         conj(a.c1.c2) * FROBENIUS1[4]},
+    };
+}
+
+/// The Frobenius map squared a^(p^2).
+Fp12 frobenius2(const Fp12& a) noexcept
+{
+    return {
+        {a.c0.c0, a.c0.c1 * FROBENIUS2[1], a.c0.c2 * FROBENIUS2[3]},
+        {a.c1.c0 * FROBENIUS2[0], a.c1.c1 * FROBENIUS2[2], a.c1.c2 * FROBENIUS2[4]},
+    };
+}
+
+/// The Granger-Scott squaring in the cyclotomic subgroup: 6 Fp2 multiplications
+/// in the Fp4 = Fp2[w^3] representation of the pairs (w^0, w^3), (w^1, w^4) and (w^2, w^5).
+Fp12 cyclotomic_sqr(const Fp12& a) noexcept
+{
+    const auto& z0 = a.c0.c0;
+    const auto& z4 = a.c0.c1;
+    const auto& z3 = a.c0.c2;
+    const auto& z2 = a.c1.c0;
+    const auto& z1 = a.c1.c1;
+    const auto& z5 = a.c1.c2;
+
+    // The squarings in Fp4: (x + y s)^2 = (x^2 + xi y^2) + 2xy s.
+    const auto fp4_sqr = [](const Fp2& x, const Fp2& y, Fp2& r0, Fp2& r1) noexcept {
+        const auto x2 = sqr(x);
+        const auto y2 = sqr(y);
+        r0 = x2 + mul_by_xi(y2);
+        r1 = sqr(x + y) - x2 - y2;
+    };
+    Fp2 t0, t1, t2, t3, t4, t5;
+    fp4_sqr(z0, z1, t0, t1);
+    fp4_sqr(z2, z3, t2, t3);
+    fp4_sqr(z4, z5, t4, t5);
+
+    // 3t - 2z and 3t + 2z.
+    const auto minus = [](const Fp2& t, const Fp2& z) noexcept {
+        const auto d = t - z;
+        return d + d + t;
+    };
+    const auto plus = [](const Fp2& t, const Fp2& z) noexcept {
+        const auto s = t + z;
+        return s + s + t;
+    };
+    Fp12 r;
+    r.c0.c0 = minus(t0, z0);
+    r.c1.c1 = plus(t1, z1);
+    r.c1.c0 = plus(mul_by_xi(t5), z2);
+    r.c0.c2 = minus(t4, z3);
+    r.c0.c1 = minus(t2, z4);
+    r.c1.c2 = plus(t3, z5);
+    return r;
+}
+
+/// The NAF of the curve parameter u = 4965661367192848881, the most significant digit first.
+/// The p = 36u^4 + 36u^3 + 24u^2 + 6u + 1.
+constexpr int8_t U_NAF[] = {
+    1, 0, 0, 0, 1, 0, 1, 0,  0,  -1, 0, 1, 0, 1, 0, -1, 0, 0, 1, 0, 1, 0,
+    -1, 0, -1, 0, -1, 0, 1, 0, 0, 0, 1, 0, 0, 1, 0, 1, 0, 1, 0, -1, 0, 1,
+    0, 0, 1, 0, 0, 0, 0,  1, 0, 1, 0, 0, 0, 0, -1, 0, 0, 0, 1,
+};
+
+/// Computes a^u of the element of the cyclotomic subgroup. The inverse there is
+/// the conjugate, so the NAF of u with 24 instead of 28 non-zero digits is used.
+Fp12 cyclotomic_exp_by_u(const Fp12& a) noexcept
+{
+    const auto a_inv = conj(a);
+    auto r = a;
+    for (size_t i = 1; i < std::size(U_NAF); ++i)
+    {
+        r = cyclotomic_sqr(r);
+        if (U_NAF[i] == 1)
+            r = r * a;
+        else if (U_NAF[i] == -1)
+            r = r * a_inv;
+    }
+    return r;
+}
+
+/// The final exponentiation f^((p^12 - 1) / r).
+Fp12 final_exponentiation(const Fp12& f) noexcept
+{
+    // The easy part: f^((p^6 - 1)(p^2 + 1)). The result is in the cyclotomic subgroup.
+    auto t1 = conj(f) * inv(f);
+    t1 = frobenius2(t1) * t1;
+
+    // The hard part: f^((p^4 - p^2 + 1) / r) (Devegili, Scott, Dahab).
+    const auto fp = frobenius(t1);
+    const auto fp2 = frobenius2(t1);
+    const auto fp3 = frobenius(fp2);
+    const auto fu = cyclotomic_exp_by_u(t1);
+    const auto fu2 = cyclotomic_exp_by_u(fu);
+    const auto fu3 = cyclotomic_exp_by_u(fu2);
+    const auto fu2p = frobenius(fu2);
+    const auto fu3p = frobenius(fu3);
+
+    const auto y0 = fp * fp2 * fp3;
+    const auto y1 = conj(t1);
+    const auto y2 = frobenius2(fu2);
+    const auto y3 = conj(frobenius(fu));
+    const auto y4 = conj(fu * fu2p);
+    const auto y5 = conj(fu2);
+    const auto y6 = conj(fu3 * fu3p);
+
+    auto t0 = cyclotomic_sqr(y6) * y4 * y5;
+    auto t = y3 * y5 * t0;
+    t0 = t0 * y2;
+    t = cyclotomic_sqr(t) * t0;
+    t = cyclotomic_sqr(t);
+    t0 = t * y1;
+    t = t * y0;
+    t0 = cyclotomic_sqr(t0);
+    return t0 * t;
+}
+
+/// The point in the Jacobian coordinates: (x / z^2, y / z^3). The z = 0 is the infinity.
+template <typename F>
+struct Jacobian
+{
+    F x;
+    F y;
+    F z;
+};
+
+/// The point in the affine coordinates.
+template <typename F>
+struct Affine
+{
+    F x;
+    F y;
+};
+
+template <typename F>
+Jacobian<F> operator-(const Jacobian<F>& p) noexcept
+{
+    return {p.x, -p.y, p.z};
+}
+
+/// The point doubling of the a = 0 curve (dbl-2009-l).
+template <typename F>
+Jacobian<F> dbl(const Jacobian<F>& p) noexcept
+{
+    const auto a = sqr(p.x);
+    const auto b = sqr(p.y);
+    const auto c = sqr(b);
+    auto d = sqr(p.x + b) - a - c;
+    d = d + d;
+    const auto e = a + a + a;
+    const auto f = sqr(e);
+    const auto x3 = f - (d + d);
+    auto c8 = c + c;
+    c8 = c8 + c8;
+    c8 = c8 + c8;
+    const auto yz = p.y * p.z;
+    return {x3, e * (d - x3) - c8, yz + yz};
+}
+
+/// The point addition (add-2007-bl) including the cases of the infinity and the equal points.
+template <typename F>
+Jacobian<F> add(const Jacobian<F>& p, const Jacobian<F>& q) noexcept
+{
+    if (is_zero(p.z))
+        return q;
+    if (is_zero(q.z))
+        return p;
+
+    const auto z1z1 = sqr(p.z);
+    const auto z2z2 = sqr(q.z);
+    const auto u1 = p.x * z2z2;
+    const auto u2 = q.x * z1z1;
+    const auto s1 = p.y * q.z * z2z2;
+    const auto s2 = q.y * p.z * z1z1;
+    const auto h = u2 - u1;
+    auto r = s2 - s1;
+    if (is_zero(h))
+        return is_zero(r) ? dbl(p) : Jacobian<F>{};
+
+    const auto h2 = h + h;
+    const auto i = sqr(h2);
+    const auto j = h * i;
+    r = r + r;
+    const auto v = u1 * i;
+    const auto x3 = sqr(r) - j - (v + v);
+    const auto s1j = s1 * j;
+    return {x3, r * (v - x3) - (s1j + s1j), (sqr(p.z + q.z) - z1z1 - z2z2) * h};
+}
+
+/// Converts to the affine coordinates. The point must not be the infinity.
+template <typename F>
+Affine<F> to_affine(const Jacobian<F>& p) noexcept
+{
+    const auto z_inv = inv(p.z);
+    const auto z_inv2 = sqr(z_inv);
+    return {p.x * z_inv2, p.y * z_inv2 * z_inv};
+}
+
+/// Compares the points in the Jacobian coordinates.
+template <typename F>
+bool operator==(const Jacobian<F>& p, const Jacobian<F>& q) noexcept
+{
+    if (is_zero(p.z) || is_zero(q.z))
+        return is_zero(p.z) && is_zero(q.z);
+    const auto z1z1 = sqr(p.z);
+    const auto z2z2 = sqr(q.z);
+    return p.x * z2z2 == q.x * z1z1 && p.y * z2z2 * q.z == q.y * z1z1 * p.z;
+}
+
+/// Loads the 32-byte big-endian number.
+uint256 load_uint256(const uint8_t* data) noexcept
+{
+    return {qrvmc::load64be(&data[24]), qrvmc::load64be(&data[16]), qrvmc::load64be(&data[8]),
+            qrvmc::load64be(&data[0])};
+}
+
+/// Stores the 32-byte big-endian number.
+void store_uint256(uint8_t* output, const uint256& x) noexcept
+{
+    for (size_t i = 0; i < 32; ++i)
+        output[31 - i] = static_cast<uint8_t>(x[i / 8] >> (8 * (i % 8)));
+}
+
+/// Loads the Fp element. Returns false if the value is not less than p.
+bool load_fp(Fp& a, const uint8_t* data) noexcept
+{
+    const auto x = load_uint256(data);
+    if (!(x < P))
+        return false;
+    a = to_fp(x);
+    return true;
+}
+
+/// The coefficient b = 3 of the curve y^2 = x^3 + b.
+constexpr auto B = to_fp(3);
+
+/// Decodes the G1 point of 64 bytes. Returns false if the point is not on the curve.
+/// All the points of the curve are in G1 (the cofactor is 1).
+bool decode_g1(Jacobian<Fp>& p, const uint8_t* data) noexcept
+{
+    if (!load_fp(p.x, &data[0]) || !load_fp(p.y, &data[32]))
+        return false;
+    if (is_zero(p.x) && is_zero(p.y))
+    {
+        p = {};  // The infinity.
+        return true;
+    }
+    p.z = to_fp(1);
+    return sqr(p.y) == sqr(p.x) * p.x + B;
+}
+
+/// Encodes the G1 point of 64 bytes.
+void encode_g1(uint8_t* output, const Jacobian<Fp>& p) noexcept
+{
+    if (is_zero(p.z))
+    {
+        std::fill_n(output, 64, uint8_t{0});
+        return;
+    }
+    const auto a = to_affine(p);
+    store_uint256(&output[0], from_fp(a.x));
+    store_uint256(&output[32], from_fp(a.y));
+}
+
+/// The cube root of unity beta in Fp: (x, y) -> (beta x, y) is [lambda] on G1.
+constexpr auto BETA = to_fp({0x5763473177fffffe, 0xd4f263f1acdb5c4f, 0x59e26bcea0d48bac, 0});
+
+/// The short basis of the lattice {(a, b): a + b lambda = 0 mod r}: (A1, -B1), (A2, B2).
+constexpr uint256 A1{0x89d3256894d213e3};
+constexpr uint256 B1{0x8211bbeb7d4f1128, 0x6f4d8248eeb859fc};
+constexpr uint256 A2{0x0be4e1541221250b, 0x6f4d8248eeb859fd};
+constexpr uint256 B2{0x89d3256894d213e3};
+
+/// The round(2^256 B2 / r) and round(2^256 B1 / r) computing the decomposition coefficients.
+constexpr uint64_t G1_COEFF[] = {0xd91d232ec7e0b3d7, 0x2};
+constexpr uint64_t G2_COEFF[] = {0x7a7bd9d4391eb18d, 0x4ccef014a773d2cf, 0x2};
+
+/// Computes (k g) >> 256.
+template <size_t N>
+uint256 mul_shift_256(const uint256& k, const uint64_t (&g)[N]) noexcept
+{
+    uint64_t p[4 + N]{};
+    for (size_t j = 0; j < N; ++j)
+    {
+        uint64_t carry = 0;
+        for (size_t i = 0; i < 4; ++i)
+            carry = mac(p[i + j], p[i + j], k[i], g[j], carry);
+        p[j + 4] = carry;
+    }
+    uint256 r;
+    for (size_t i = 0; i < N; ++i)
+        r[i] = p[4 + i];
+    return r;
+}
+
+/// The window width of the wNAF.
+constexpr int WNAF_WIDTH = 5;
+
+/// Computes the width-w NAF digits of @p k, the lowest first. Returns the number of digits.
+/// The non-zero digits are odd, in (-2^(w-1), 2^(w-1)), and are followed by at least
+/// w - 1 zero digits.
+size_t wnaf(int8_t* digits, uint256 k) noexcept
+{
+    size_t n = 0;
+    while (k)
+    {
+        int d = 0;
+        if ((k[0] & 1) != 0)
+        {
+            d = static_cast<int>(k[0] & ((1 << WNAF_WIDTH) - 1));
+            if (d >= 1 << (WNAF_WIDTH - 1))
+                d -= 1 << WNAF_WIDTH;
+            k = d > 0 ? k - static_cast<uint64_t>(d) : k + static_cast<uint64_t>(-d);
+        }
+        digits[n++] = static_cast<int8_t>(d);
+        k = k >> 1;
+    }
+    return n;
+}
+
+/// Computes [k] p of the G1 point with the GLV method:
+/// k = k1 + k2 lambda mod r with |k1|, |k2| < 2^128, [k] p = [k1] p + [k2] (beta x, y).
+Jacobian<Fp> mul_glv(const Jacobian<Fp>& p, const uint256& scalar) noexcept
+{
+    const auto k = scalar % ORDER;
+    const auto c1 = mul_shift_256(k, G1_COEFF);
+    const auto c2 = mul_shift_256(k, G2_COEFF);
+
+    // The k1 and k2 are small and computed modulo 2^256: the negative ones in the two's complement.
+    auto k1 = k - c1 * A1 - c2 * A2;
+    auto k2 = c1 * B1 - c2 * B2;
+    const auto neg1 = (k1[3] >> 63) != 0;
+    const auto neg2 = (k2[3] >> 63) != 0;
+    if (neg1)
+        k1 = -k1;
+    if (neg2)
+        k2 = -k2;
+
+    // The odd multiples p, 3p, ..., (2^(w-1) - 1)p and their endomorphism images.
+    constexpr size_t table_size = 1 << (WNAF_WIDTH - 2);
+    Jacobian<Fp> table1[table_size];
+    Jacobian<Fp> table2[table_size];
+    table1[0] = neg1 ? -p : p;
+    const auto p2 = dbl(table1[0]);
+    for (size_t i = 1; i < table_size; ++i)
+        table1[i] = add(table1[i - 1], p2);
+    for (size_t i = 0; i < table_size; ++i)
+    {
+        const auto& t = table1[i];
+        table2[i] = {t.x * BETA, neg1 != neg2 ? -t.y : t.y, t.z};
+    }
+
+    int8_t digits1[130];
+    int8_t digits2[130];
+    const auto n1 = wnaf(digits1, k1);
+    const auto n2 = wnaf(digits2, k2);
+
+    Jacobian<Fp> r{};
+    for (auto i = std::max(n1, n2); i-- > 0;)
+    {
+        r = dbl(r);
+        const auto d1 = i < n1 ? digits1[i] : 0;
+        if (d1 > 0)
+            r = add(r, table1[d1 / 2]);
+        else if (d1 < 0)
+            r = add(r, -table1[-d1 / 2]);
+        const auto d2 = i < n2 ? digits2[i] : 0;
+        if (d2 > 0)
+            r = add(r, table2[d2 / 2]);
+        else if (d2 < 0)
+            r = add(r, -table2[-d2 / 2]);
+    }
+    return r;
+}
+
+/// The coefficient b' = 3 / xi of the twist y^2 = x^3 + b'.
+constexpr Fp2 B_TWIST{
+    to_fp({0x3267e6dc24a138e5, 0xb5b4c5e559dbefa3, 0x81be18991be06ac3, 0x2b149d40ceb8aaae}),
+    to_fp({0xe4a2bd0685c315d2, 0xa74fa084e52d1852, 0xcd2cafadeed8fdf4, 0x009713b03af0fed4}),
+};
+
+/// The endomorphism psi of the twist (untwist-Frobenius-twist).
+Affine<Fp2> psi(const Affine<Fp2>& q) noexcept
+{
+    return {conj(q.x) * FROBENIUS1[1], conj(q.y) * FROBENIUS1[2]};
+}
+
+/// The endomorphism psi in the Jacobian coordinates.
+Jacobian<Fp2> psi(const Jacobian<Fp2>& q) noexcept
+{
+    return {conj(q.x) * FROBENIUS1[1], conj(q.y) * FROBENIUS1[2], conj(q.z)};
+}
+
+/// Computes [u] q with the NAF of u.
+Jacobian<Fp2> mul_by_u(const Jacobian<Fp2>& q) noexcept
+{
+    const auto neg_q = -q;
+    auto r = q;
+    for (size_t i = 1; i < std::size(U_NAF); ++i)
+    {
+        r = dbl(r);
+        if (U_NAF[i] == 1)
+            r = add(r, q);
+        else if (U_NAF[i] == -1)
+            r = add(r, neg_q);
+    }
+    return r;
+}
+
+/// Decodes the G2 point of 128 bytes. Returns false if the point is not on the twist
+/// or not in G2. Sets the @p infinity for the point at infinity.
+bool decode_g2(Affine<Fp2>& q, bool& infinity, const uint8_t* data) noexcept
+{
+    // The imaginary part goes first.
+    if (!load_fp(q.x.c1, &data[0]) || !load_fp(q.x.c0, &data[32]) ||
+        !load_fp(q.y.c1, &data[64]) || !load_fp(q.y.c0, &data[96]))
+        return false;
+    infinity = is_zero(q.x) && is_zero(q.y);
+    if (infinity)
+        return true;
+    if (sqr(q.y) != sqr(q.x) * q.x + B_TWIST)
+        return false;
+
+    // Q is in G2 iff [u + 1] Q + psi([u] Q) + psi^2([u] Q) = psi^3([2u] Q)
+    // (Scott, https://eprint.iacr.org/2021/1130). This needs the 63-bit [u] Q only
+    // instead of the 127-bit [6u^2] Q of psi(Q) = [6u^2] Q.
+    const auto jq = Jacobian<Fp2>{q.x, q.y, {to_fp(1), {}}};
+    const auto uq = mul_by_u(jq);
+    const auto psi_uq = psi(uq);
+    const auto lhs = add(add(add(uq, jq), psi_uq), psi(psi_uq));
+    const auto rhs = psi(psi(psi(dbl(uq))));
+    return lhs == rhs;
+}
+
+/// The NAF of 6u + 2, the most significant digit first.
+constexpr int8_t ATE_LOOP_NAF[] = {
+    1, 0, -1, 0, 1,  0, 0, 0, -1, 0, -1, 0,  0, 0, -1, 0, 1,  0, -1, 0, 0,  -1, 0,
+    0, 0, 0,  0, 1,  0, 0, -1, 0, 1, 0,  0, -1, 0, 0, 0, 0,  -1, 0, 1, 0,  0,  0,
+    -1, 0, -1, 0, 0, 1, 0, 0, 0, -1, 0, 0, -1, 0, 1, 0, 1, 0, 0, 0,
+};
+
+/// The G2 point in the homogeneous projective coordinates: (x / z, y / z).
+struct G2Projective
+{
+    Fp2 x;
+    Fp2 y;
+    Fp2 z;
+};
+
+/// The line coefficients: the line evaluated at the G1 point P is c0 yP + c1 xP w + c3 w^3.
+struct Line
+{
+    Fp2 c0;
+    Fp2 c1;
+    Fp2 c3;
+};
+
+/// The 1/2 in Fp.
+constexpr auto TWO_INV =
+    to_fp({0x9e10460b6c3e7ea4, 0xcbc0b548b438e546, 0xdc2822db40c0ac2e, 0x183227397098d014});
+
+/// Doubles the point T and returns the tangent line at T.
+Line doubling_step(G2Projective& t) noexcept
+{
+    const auto a = t.x * t.y * TWO_INV;
+    const auto b = sqr(t.y);
+    const auto c = sqr(t.z);
+    const auto e = B_TWIST * (c + c + c);
+    const auto f = e + e + e;
+    const auto g = (b + f) * TWO_INV;
+    const auto h = sqr(t.y + t.z) - (b + c);
+    const auto i = e - b;
+    const auto j = sqr(t.x);
+    const auto e2 = sqr(e);
+
+    t.x = a * (b - f);
+    t.y = sqr(g) - (e2 + e2 + e2);
+    t.z = b * h;
+    return {-h, j + j + j, i};
+}
+
+/// Adds the affine point Q to T and returns the line through T and Q.
+Line addition_step(G2Projective& t, const Affine<Fp2>& q) noexcept
+{
+    const auto theta = t.y - q.y * t.z;
+    const auto lambda = t.x - q.x * t.z;
+    const auto c = sqr(theta);
+    const auto d = sqr(lambda);
+    const auto e = lambda * d;
+    const auto f = t.z * c;
+    const auto g = t.x * d;
+    const auto h = e + f - (g + g);
+    t.x = lambda * h;
+    t.y = theta * (g - h) - e * t.y;
+    t.z = t.z * e;
+    return {lambda, -theta, theta * q.x - lambda * q.y};
+}
+
+/// Multiplies f by the line evaluated at the G1 point P.
+Fp12 mul_by_line(const Fp12& f, const Line& l, const Affine<Fp>& p) noexcept
+{
+    return mul_by_line(f, l.c0 * p.y, l.c1 * p.x, l.c3);
+}
+
+/// The Miller loop of the optimal ate pairing for all the pairs (P_i, Q_i) at once:
+/// the squarings of f are shared.
+Fp12 miller_loop(const std::vector<Affine<Fp>>& ps, const std::vector<Affine<Fp2>>& qs)
+{
+    const auto one = Fp2{to_fp(1), {}};
+    std::vector<G2Projective> ts(qs.size());
+    for (size_t k = 0; k < qs.size(); ++k)
+        ts[k] = {qs[k].x, qs[k].y, one};
+
+    Fp12 f{{one, {}, {}}, {}};
+    for (size_t i = 1; i < std::size(ATE_LOOP_NAF); ++i)
+    {
+        if (i != 1)
+            f = sqr(f);
+        for (size_t k = 0; k < qs.size(); ++k)
+        {
+            f = mul_by_line(f, doubling_step(ts[k]), ps[k]);
+            if (ATE_LOOP_NAF[i] == 1)
+                f = mul_by_line(f, addition_step(ts[k], qs[k]), ps[k]);
+            else if (ATE_LOOP_NAF[i] == -1)
+                f = mul_by_line(f, addition_step(ts[k], {qs[k].x, -qs[k].y}), ps[k]);
+        }
+    }
+
+    // The final lines through pi(Q) and -pi^2(Q).
+    for (size_t k = 0; k < qs.size(); ++k)
+    {
+        const auto q1 = psi(qs[k]);
+        const auto q2 = Affine<Fp2>{qs[k].x * FROBENIUS2[1], -(qs[k].y * FROBENIUS2[2])};
+        f = mul_by_line(f, addition_step(ts[k], q1), ps[k]);
+        f = mul_by_line(f, addition_step(ts[k], q2), ps[k]);
+    }
+    return f;
+}
+}  // namespace
+
+bool bn254_add(uint8_t output[64], const uint8_t input[128]) noexcept
+{
+    Jacobian<Fp> p;
+    Jacobian<Fp> q;
+    if (!decode_g1(p, &input[0]) || !decode_g1(q, &input[64]))
+        return false;
+    encode_g1(output, add(p, q));
+    return true;
+}
+
+bool bn254_mul(uint8_t output[64], const uint8_t input[96]) noexcept
+{
+    Jacobian<Fp> p;
+    if (!decode_g1(p, input))
+        return false;
+    encode_g1(output, mul_glv(p, load_uint256(&input[64])));
+    return true;
+}
+
+bool bn254_pairing_check(bool& result, const uint8_t* input, size_t num_pairs)
+{
+    // The pairs with the infinity do not contribute to the product and are skipped.
+    std::vector<Affine<Fp>> ps;
+    std::vector<Affine<Fp2>> qs;
+    for (size_t k = 0; k < num_pairs; ++k)
+    {
+        const auto* pair = &input[k * 192];
+        Jacobian<Fp> p;
+        Affine<Fp2> q;
+        bool q_infinity = false;
+        if (!decode_g1(p, &pair[0]) || !decode_g2(q, q_infinity, &pair[64]))
+            return false;
+        if (!is_zero(p.z) && !q_infinity)
+        {
+            ps.push_back({p.x, p.y});
+            qs.push_back(q);
+        }
+    }
+
+    const auto one = Fp12{{{to_fp(1), {}}, {}, {}}, {}};
+    result = ps.empty() || final_exponentiation(miller_loop(ps, qs)) == one;
+    return true;
+}
+}  // namespace precompiles
@@ -0,0 +1,30 @@
+// EVMC: Ethereum Client-VM Connector API.
+// Copyright 2026 The EVMC Authors.
+// Licensed under the Apache License, Version 2.0.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace precompiles
+{
+/// Adds the two BN254 (alt_bn128) G1 points as specified in the EIP-196.
+///
+/// The @p input are the two points of 64 bytes: the big-endian x and y coordinates,
+/// the (0, 0) is the point at infinity. Writes the sum of the same encoding to the @p output.
+/// Returns false if any point is invalid.
+bool bn254_add(uint8_t output[64], const uint8_t input[128]) noexcept;
+
+/// Multiplies the BN254 G1 point by the scalar as specified in the EIP-196.
+///
+/// The @p input is the point of 64 bytes followed by the 32-byte big-endian scalar.
+/// Writes the product to the @p output. Returns false if the point is invalid.
+bool bn254_mul(uint8_t output[64], const uint8_t input[96]) noexcept;
+
+/// Checks if the product of the BN254 pairings is one as specified in the EIP-197.
+///
+/// The @p input are the @p num_pairs pairs of 192 bytes: the G1 point of the EIP-196 encoding
+/// and the G2 point of 128 bytes: the x and y coordinates, each with the imaginary part first.
+/// Stores the check result in the @p result. Returns false if any point is invalid.
+bool bn254_pairing_check(bool& result, const uint8_t* input, size_t num_pairs);
+}  // namespace precompiles
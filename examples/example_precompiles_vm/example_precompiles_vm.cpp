@@ -3,52 +3,401 @@
 // Licensed under the Apache License, Version 2.0.
 
 #include "example_precompiles_vm.h"
+#include "bn254.hpp"
+#include "expmod.hpp"
+#include "result_cache.hpp"
+#include "sha256.hpp"
+#include <qrvmc/qrvmc.hpp>
 #include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <new>
+#include <vector>
 
 namespace
 {
-qrvmc_result execute_identity(const qrvmc_message* msg)
+/// Returns the number of 32-byte words of the input, rounded up.
+uint64_t num_words(size_t input_size)
 {
-    auto result = qrvmc_result{};
+    return (uint64_t{input_size} + 31) / 32;
+}
 
-    // Check the gas cost.
-    auto gas_cost = 15 + 3 * ((int64_t(msg->input_size) + 31) / 32);
-    auto gas_left = msg->gas - gas_cost;
-    if (gas_left < 0)
-    {
-        result.status_code = QRVMC_OUT_OF_GAS;
-        return result;
-    }
+/// Returns the result with the status code and no output.
+qrvmc_result make_result(qrvmc_status_code status_code)
+{
+    auto result = qrvmc_result{};
+    result.status_code = status_code;
+    return result;
+}
 
-    // Execute.
-    auto data = new uint8_t[msg->input_size];
-    std::copy_n(msg->input_data, msg->input_size, data);
+/// Returns the successful result with the copy of the @p output.
+/// Returns the ::QRVMC_OUT_OF_GAS result if the copy cannot be allocated.
+qrvmc_result make_output_result(const uint8_t* output, size_t output_size)
+{
+    auto data = new (std::nothrow) uint8_t[output_size];
+    if (data == nullptr)
+        return make_result(QRVMC_OUT_OF_GAS);
+    std::copy_n(output, output_size, data);
 
-    // Return the result.
+    auto result = qrvmc_result{};
     result.status_code = QRVMC_SUCCESS;
     result.output_data = data;
-    result.output_size = msg->input_size;
+    result.output_size = output_size;
     result.release = [](const qrvmc_result* r) { delete[] r->output_data; };
-    result.gas_left = gas_left;
     return result;
 }
 
-qrvmc_result execute_empty(const qrvmc_message* msg)
+/// Reads the @p size bytes of the input at the @p offset. The bytes beyond the input are zero.
+void read_input(uint8_t* output, size_t size, const uint8_t* input, size_t input_size,
+                uint64_t offset)
 {
-    auto result = qrvmc_result{};
-    result.status_code = QRVMC_SUCCESS;
-    result.gas_left = msg->gas;
+    std::fill_n(output, size, 0);
+    if (offset < input_size)
+        std::copy_n(&input[offset], std::min<uint64_t>(size, input_size - offset), output);
+}
+
+/// Reads the 32-byte big-endian length at the @p offset of the input.
+/// The lengths not fitting 64 bits are clamped to the max uint64 value.
+uint64_t read_length(const uint8_t* input, size_t input_size, uint64_t offset)
+{
+    uint8_t word[32];
+    read_input(word, sizeof(word), input, input_size, offset);
+    if (std::any_of(&word[0], &word[24], [](uint8_t b) { return b != 0; }))
+        return std::numeric_limits<uint64_t>::max();
+    return qrvmc::load64be(&word[24]);
+}
+
+uint64_t empty_gas(const uint8_t* /*input*/, size_t /*input_size*/)
+{
+    return 0;
+}
+
+qrvmc_result execute_empty(const uint8_t* /*input*/, size_t /*input_size*/)
+{
+    return make_result(QRVMC_SUCCESS);
+}
+
+uint64_t identity_gas(const uint8_t* /*input*/, size_t input_size)
+{
+    return 15 + 3 * num_words(input_size);
+}
+
+qrvmc_result execute_identity(const uint8_t* input, size_t input_size)
+{
+    // The output is the input itself. The VM copies it unless the caller allows aliasing.
+    auto result = make_result(QRVMC_SUCCESS);
+    result.output_data = input;
+    result.output_size = input_size;
+    return result;
+}
+
+uint64_t sha256_gas(const uint8_t* /*input*/, size_t input_size)
+{
+    return 60 + 12 * num_words(input_size);
+}
+
+qrvmc_result execute_sha256(const uint8_t* input, size_t input_size)
+{
+    // The input is hashed in place and the hash is written directly to the output.
+    // The output does not fit the result's optional storage (24 bytes), so it is allocated.
+    auto output = new (std::nothrow) uint8_t[32];
+    if (output == nullptr)
+        return make_result(QRVMC_OUT_OF_GAS);
+    precompiles::sha256(output, input, input_size);
+
+    auto result = make_result(QRVMC_SUCCESS);
+    result.output_data = output;
+    result.output_size = 32;
+    result.release = [](const qrvmc_result* r) { delete[] r->output_data; };
     return result;
 }
 
-qrvmc_result not_implemented()
+uint64_t expmod_gas(const uint8_t* input, size_t input_size)
+{
+    // The exponent starts after the header and the base.
+    const auto base_len = read_length(input, input_size, 0);
+    const auto exp_len = read_length(input, input_size, 32);
+    const auto mod_len = read_length(input, input_size, 64);
+    const auto exp_offset = 96 + std::min(base_len, std::numeric_limits<uint64_t>::max() - 96);
+    uint8_t exp_head[32];
+    const auto exp_head_size = static_cast<size_t>(std::min<uint64_t>(exp_len, 32));
+    read_input(exp_head, exp_head_size, input, input_size, exp_offset);
+    return precompiles::expmod_gas(base_len, exp_len, mod_len, exp_head, exp_head_size);
+}
+
+/// The EXPMOD implementation.
+using expmod_fn = void (*)(uint8_t*,
+                           const precompiles::Number&,
+                           const precompiles::Number&,
+                           const precompiles::Number&);
+
+/// Returns the number of the @p size bytes at the @p offset of the input.
+/// Only the bytes within the input are referenced, the bytes past its end are zeros.
+precompiles::Number input_number(const uint8_t* input,
+                                 size_t input_size,
+                                 uint64_t offset,
+                                 uint64_t size) noexcept
+{
+    if (offset >= input_size)
+        return {nullptr, 0, size};
+    const auto data_size = static_cast<size_t>(std::min<uint64_t>(size, input_size - offset));
+    return {&input[offset], data_size, size};
+}
+
+template <expmod_fn Fn>
+qrvmc_result execute_expmod(const uint8_t* input, size_t input_size)
+{
+    const auto base_len = read_length(input, input_size, 0);
+    const auto exp_len = read_length(input, input_size, 32);
+    const auto mod_len = read_length(input, input_size, 64);
+    if (mod_len == 0)
+        return make_result(QRVMC_SUCCESS);
+
+    // The arguments are used in place. The lengths are not bounded by the input size
+    // and the exponent length is not bounded by the gas cost in practice either
+    // (8/3 gas per byte for the small modulus), so the missing bytes are never materialized.
+    constexpr auto max_offset = std::numeric_limits<uint64_t>::max();
+    const auto exp_offset = 96 + std::min(base_len, max_offset - 96);
+    const auto mod_offset = exp_offset + std::min(exp_len, max_offset - exp_offset);
+    const auto base = input_number(input, input_size, 96, base_len);
+    const auto exp = input_number(input, input_size, exp_offset, exp_len);
+    const auto mod = input_number(input, input_size, mod_offset, mod_len);
+
+    // The sizes of the output, the base and the modulus are covered by the quadratic gas cost,
+    // but the gas limit may still exceed the available memory.
+    uint8_t* output = nullptr;
+    try
+    {
+        output = new uint8_t[static_cast<size_t>(mod_len)];
+        Fn(output, base, exp, mod);
+    }
+    catch (const std::bad_alloc&)
+    {
+        delete[] output;
+        return make_result(QRVMC_OUT_OF_GAS);
+    }
+
+    auto result = make_result(QRVMC_SUCCESS);
+    result.output_data = output;
+    result.output_size = static_cast<size_t>(mod_len);
+    result.release = [](const qrvmc_result* r) { delete[] r->output_data; };
+    return result;
+}
+
+uint64_t bnadd_gas(const uint8_t* /*input*/, size_t /*input_size*/)
+{
+    return 150;  // EIP-1108.
+}
+
+qrvmc_result execute_bnadd(const uint8_t* input, size_t input_size)
+{
+    // The input is zero-padded or truncated to 128 bytes.
+    uint8_t args[128];
+    read_input(args, sizeof(args), input, input_size, 0);
+    uint8_t output[64];
+    if (!precompiles::bn254_add(output, args))
+        return make_result(QRVMC_PRECOMPILE_FAILURE);
+    return make_output_result(output, sizeof(output));
+}
+
+uint64_t bnmul_gas(const uint8_t* /*input*/, size_t /*input_size*/)
+{
+    return 6000;  // EIP-1108.
+}
+
+qrvmc_result execute_bnmul(const uint8_t* input, size_t input_size)
+{
+    // The input is zero-padded or truncated to 96 bytes.
+    uint8_t args[96];
+    read_input(args, sizeof(args), input, input_size, 0);
+    uint8_t output[64];
+    if (!precompiles::bn254_mul(output, args))
+        return make_result(QRVMC_PRECOMPILE_FAILURE);
+    return make_output_result(output, sizeof(output));
+}
+
+uint64_t bnpairing_gas(const uint8_t* /*input*/, size_t input_size)
+{
+    // EIP-1108. The cost not fitting 64 bits is clamped.
+    const auto num_pairs = input_size / 192;
+    constexpr auto max_pairs = (std::numeric_limits<uint64_t>::max() - 45000) / 34000;
+    return num_pairs <= max_pairs ? 45000 + 34000 * uint64_t{num_pairs} :
+                                    std::numeric_limits<uint64_t>::max();
+}
+
+qrvmc_result execute_bnpairing(const uint8_t* input, size_t input_size)
+{
+    // The input must be the sequence of the 192-byte pairs.
+    if (input_size % 192 != 0)
+        return make_result(QRVMC_PRECOMPILE_FAILURE);
+
+    // The pairs are all checked in one go with the shared final exponentiation.
+    bool check = false;
+    if (!precompiles::bn254_pairing_check(check, input, input_size / 192))
+        return make_result(QRVMC_PRECOMPILE_FAILURE);
+    uint8_t output[32]{};
+    output[31] = check ? 1 : 0;
+    return make_output_result(output, sizeof(output));
+}
+
+/// The precompiled contract implementation.
+struct Precompile
+{
+    qrvmc_example_precompile_gas_fn gas = empty_gas;
+    qrvmc_example_precompile_execute_fn execute = execute_empty;
+
+    /// Whether the results can be cached. Set for the ones costlier than the cache lookup.
+    bool cacheable = false;
+};
+
+/// The built-in implementations selectable by name with the "precompile.<id>" option.
+constexpr struct
+{
+    const char* name;
+    Precompile precompile;
+} builtin_precompiles[] = {
+    {"empty", {empty_gas, execute_empty, false}},
+    {"identity", {identity_gas, execute_identity, false}},
+    {"sha256", {sha256_gas, execute_sha256, true}},
+    {"expmod", {expmod_gas, execute_expmod<precompiles::expmod>, true}},
+    {"expmod_naive", {expmod_gas, execute_expmod<precompiles::expmod_naive>, true}},
+    {"bnadd", {bnadd_gas, execute_bnadd, true}},
+    {"bnmul", {bnmul_gas, execute_bnmul, true}},
+    {"bnpairing", {bnpairing_gas, execute_bnpairing, true}},
+};
+
+/// The built-in implementations registered at the VM creation.
+constexpr struct
+{
+    uint16_t id;
+    const char* name;
+} default_precompiles[] = {
+    {0x0001, "identity"},   // DEPOSITROOT
+    {0x0002, "sha256"},     // SHA256
+    {0x0004, "identity"},   // Identity
+    {0x0005, "expmod"},     // EXPMOD
+    {0x0006, "bnadd"},      // BNADD
+    {0x0007, "bnmul"},      // BNMUL
+    {0x0008, "bnpairing"},  // BNPAIRING
+};
+
+/// Finds the built-in implementation by name. Returns null if not found.
+const Precompile* find_builtin_precompile(const char* name) noexcept
+{
+    for (const auto& builtin : builtin_precompiles)
+    {
+        if (std::strcmp(builtin.name, name) == 0)
+            return &builtin.precompile;
+    }
+    return nullptr;
+}
+
+/// The Example Precompiles VM instance.
+///
+/// The precompiles are kept in the two-level table indexed by the high and the low byte
+/// of the 16-bit id: 256 pointers to the pages of 256 entries. The pages without any
+/// registered precompile point to the shared page of empty entries, so the lookup is
+/// the two indexed loads without any checks and the table takes the memory only for
+/// the used pages.
+class PrecompilesVM : public qrvmc_vm
+{
+public:
+    PrecompilesVM();
+
+    /// Returns the precompile registered at the id.
+    const Precompile& get(uint16_t id) const noexcept
+    {
+        return m_pages[id >> 8]->entries[id & 0xff];
+    }
+
+    /// Returns the result cache or null if disabled.
+    precompiles::ResultCache* cache() const noexcept { return m_cache.get(); }
+
+    /// Replaces the result cache with the empty one of the @p capacity bytes.
+    /// The 0 capacity disables the cache.
+    void set_cache(size_t capacity)
+    {
+        m_cache_capacity = capacity;
+        m_cache = capacity != 0 ? std::make_unique<precompiles::ResultCache>(capacity) : nullptr;
+    }
+
+    /// Registers the precompile at the id. Clears the result cache.
+    void set(uint16_t id, const Precompile& precompile)
+    {
+        auto& page = m_owned_pages[id >> 8];
+        if (page == nullptr)
+        {
+            page = std::make_unique<Page>();
+            m_pages[id >> 8] = page.get();
+        }
+        page->entries[id & 0xff] = precompile;
+        if (m_cache != nullptr)
+            set_cache(m_cache_capacity);
+    }
+
+private:
+    /// The page of the table: the precompiles with the same high byte of the id.
+    struct Page
+    {
+        Precompile entries[256];
+    };
+
+    /// The page of the empty entries shared by all instances.
+    static const Page empty_page;
+
+    /// The pages of the table, the owned or the empty one.
+    const Page* m_pages[256];
+
+    /// The owned pages.
+    std::unique_ptr<Page> m_owned_pages[256];
+
+    size_t m_cache_capacity = 0;
+    std::unique_ptr<precompiles::ResultCache> m_cache;
+};
+
+const PrecompilesVM::Page PrecompilesVM::empty_page{};
+
+/// Returns true if the output of the @p result points into the input.
+bool aliases_input(const qrvmc_result& result, const uint8_t* input, size_t input_size)
+{
+    // The std::less is the total order also for the pointers to unrelated objects.
+    const std::less<const uint8_t*> less;
+    return result.output_size != 0 && !less(result.output_data, input) &&
+           less(result.output_data, input + input_size);
+}
+
+/// Executes the precompile or serves the result from the cache.
+qrvmc_result execute_cached(precompiles::ResultCache& cache,
+                            const Precompile& precompile,
+                            uint16_t id,
+                            const uint8_t* input,
+                            size_t input_size)
 {
+    const auto hash = precompiles::ResultCache::hash(id, input, input_size);
     auto result = qrvmc_result{};
-    result.status_code = QRVMC_REJECTED;
+    if (cache.find(result, hash, id, input, input_size))
+        return result;
+
+    result = precompile.execute(input, input_size);
+    if (result.status_code == QRVMC_SUCCESS || result.status_code == QRVMC_PRECOMPILE_FAILURE)
+    {
+        try
+        {
+            cache.insert(hash, id, input, input_size, result);
+        }
+        catch (const std::bad_alloc&)
+        {
+            // The result is returned without caching it.
+        }
+    }
     return result;
 }
 
-qrvmc_result execute(qrvmc_vm* /*vm*/,
+qrvmc_result execute(qrvmc_vm* instance,
                      const qrvmc_host_interface* /*host*/,
                      qrvmc_host_context* /*context*/,
                      enum qrvmc_revision /*rev*/,
@@ -58,50 +407,115 @@ qrvmc_result execute(qrvmc_vm* /*vm*/,
 {
     // The EIP-1352 (https://eips.ethereum.org/EIPS/eip-1352) defines
     // the range 0 - Qffff (2 bytes) of addresses reserved for precompiled contracts.
-    // Check if the code address is within the reserved range.
+    // Reject the execution request if the code address is not within the reserved range.
+    const qrvmc::address addr = msg->code_address;
+    const auto id = qrvmc::precompile_id(addr);
+    if (id == 0 && !qrvmc::is_zero(addr))
+        return make_result(QRVMC_REJECTED);
 
-    constexpr auto prefix_size = sizeof(qrvmc_address) - 2;
-    const auto& addr = msg->code_address;
-    // Check if the address prefix is all zeros.
-    if (std::any_of(&addr.bytes[0], &addr.bytes[prefix_size], [](uint8_t x) { return x != 0; }))
+    // Check the gas cost and execute. The failed execution consumes all the gas.
+    const auto& vm = *static_cast<const PrecompilesVM*>(instance);
+    const auto& precompile = vm.get(id);
+    const auto gas_cost = precompile.gas(msg->input_data, msg->input_size);
+    if (msg->gas < 0 || gas_cost > static_cast<uint64_t>(msg->gas))
+        return make_result(QRVMC_OUT_OF_GAS);
+
+    auto* const cache = vm.cache();
+    const auto use_cache =
+        cache != nullptr && precompile.cacheable && cache->fits(msg->input_size);
+    auto result = use_cache ?
+                      execute_cached(*cache, precompile, id, msg->input_data, msg->input_size) :
+                      precompile.execute(msg->input_data, msg->input_size);
+    if ((msg->flags & QRVMC_ALLOW_OUTPUT_ALIASING) == 0 &&
+        aliases_input(result, msg->input_data, msg->input_size))
     {
-        // If not, reject the execution request.
-        auto result = qrvmc_result{};
-        result.status_code = QRVMC_REJECTED;
-        return result;
+        const auto status_code = result.status_code;
+        result = make_output_result(result.output_data, result.output_size);
+        if (result.status_code == QRVMC_SUCCESS)
+            result.status_code = status_code;
     }
+    result.gas_left =
+        result.status_code == QRVMC_SUCCESS ? msg->gas - static_cast<int64_t>(gas_cost) : 0;
+    return result;
+}
 
-    // Extract the precompiled contract id from last 2 bytes of the code address.
-    const auto id = (addr.bytes[prefix_size] << 8) | addr.bytes[prefix_size + 1];
-    switch (id)
+/// The implementation of the qrvmc_vm::set_option() method.
+///
+/// The option "precompile.<id>" registers the built-in implementation of the given name
+/// at the id (decimal or 0x-prefixed hex). The option "cache.size" sets the result cache
+/// capacity in bytes. See qrvmc_create_example_precompiles_vm().
+qrvmc_set_option_result set_option(qrvmc_vm* instance, const char* name, const char* value)
+{
+    auto& vm = *static_cast<PrecompilesVM*>(instance);
+    if (std::strcmp(name, "cache.size") == 0)
     {
-    case 0x0001:  // DEPOSITROOT
-    case 0x0002:  // SHA256
-    case 0x0004:  // Identity
-        return execute_identity(msg);
-
-    case 0x0005:  // EXPMOD
-    case 0x0006:  // BNADD
-    case 0x0007:  // BNMUL
-    case 0x0008:  // BNPAIRING
-        return not_implemented();
-
-    default:  // As if empty code was executed.
-        return execute_empty(msg);
+        if (value == nullptr || *value < '0' || *value > '9')
+            return QRVMC_SET_OPTION_INVALID_VALUE;
+        char* end = nullptr;
+        errno = 0;
+        const auto capacity = std::strtoull(value, &end, 10);
+        if (*end != '\0' || errno == ERANGE || capacity > std::numeric_limits<size_t>::max())
+            return QRVMC_SET_OPTION_INVALID_VALUE;
+        vm.set_cache(static_cast<size_t>(capacity));
+        return QRVMC_SET_OPTION_SUCCESS;
     }
+
+    constexpr char prefix[] = "precompile.";
+    if (std::strncmp(name, prefix, sizeof(prefix) - 1) != 0)
+        return QRVMC_SET_OPTION_INVALID_NAME;
+
+    const auto id_str = &name[sizeof(prefix) - 1];
+    char* end = nullptr;
+    const auto id = std::strtoul(id_str, &end, 0);
+    if (end == id_str || *end != '\0' || id > 0xffff)
+        return QRVMC_SET_OPTION_INVALID_NAME;
+
+    if (value == nullptr)
+        return QRVMC_SET_OPTION_INVALID_VALUE;
+    const auto* precompile = find_builtin_precompile(value);
+    if (precompile == nullptr)
+        return QRVMC_SET_OPTION_INVALID_VALUE;
+
+    vm.set(static_cast<uint16_t>(id), *precompile);
+    return QRVMC_SET_OPTION_SUCCESS;
 }
-}  // namespace
 
-qrvmc_vm* qrvmc_create_example_precompiles_vm()
-{
-    static struct qrvmc_vm vm = {
+PrecompilesVM::PrecompilesVM()
+  : qrvmc_vm{
         QRVMC_ABI_VERSION,
         "example_precompiles_vm",
         PROJECT_VERSION,
-        [](qrvmc_vm*) {},
-        execute,
+        [](qrvmc_vm* vm) { delete static_cast<PrecompilesVM*>(vm); },
+        ::execute,
         [](qrvmc_vm*) { return qrvmc_capabilities_flagset{QRVMC_CAPABILITY_PRECOMPILES}; },
-        nullptr,
-    };
-    return &vm;
+        ::set_option,
+    }
+{
+    std::fill(std::begin(m_pages), std::end(m_pages), &empty_page);
+    for (const auto& p : default_precompiles)
+        set(p.id, *find_builtin_precompile(p.name));
+}
+}  // namespace
+
+qrvmc_vm* qrvmc_create_example_precompiles_vm()
+{
+    return new PrecompilesVM;
+}
+
+void qrvmc_example_precompiles_vm_register(qrvmc_vm* vm,
+                                           uint16_t id,
+                                           qrvmc_example_precompile_gas_fn gas,
+                                           qrvmc_example_precompile_execute_fn execute)
+{
+    static_cast<PrecompilesVM*>(vm)->set(id, {gas, execute, true});
+}
+
+qrvmc_example_precompiles_cache_stats qrvmc_example_precompiles_vm_cache_stats(qrvmc_vm* vm)
+{
+    const auto* cache = static_cast<PrecompilesVM*>(vm)->cache();
+    if (cache == nullptr)
+        return {};
+    const auto stats = cache->stats();
+    return {stats.hits,      stats.misses,  stats.insertions,
+            stats.evictions, stats.entries, stats.bytes};
 }
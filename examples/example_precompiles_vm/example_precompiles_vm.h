@@ -10,11 +10,85 @@
 extern "C" {
 #endif
 
+/**
+ * The gas cost function of a precompiled contract.
+ *
+ * Returns the gas cost of the execution with the given input.
+ * The cost not fitting 64 bits should be clamped to UINT64_MAX.
+ */
+typedef uint64_t (*qrvmc_example_precompile_gas_fn)(const uint8_t* input, size_t input_size);
+
+/**
+ * The execution function of a precompiled contract.
+ *
+ * Called only if the gas cost has been covered. Returns the result with the status code
+ * and the output. The VM sets the qrvmc_result::gas_left: to the gas remaining after the cost
+ * in case of ::QRVMC_SUCCESS and to 0 otherwise.
+ *
+ * The output MAY point into the input, without the qrvmc_result::release function.
+ * The VM returns it as is to the callers allowing the ::QRVMC_ALLOW_OUTPUT_ALIASING
+ * and a copy to the others.
+ *
+ * The result must depend only on the input: the results with the ::QRVMC_SUCCESS and
+ * ::QRVMC_PRECOMPILE_FAILURE status codes may be served from the VM's result cache.
+ */
+typedef struct qrvmc_result (*qrvmc_example_precompile_execute_fn)(const uint8_t* input,
+                                                                   size_t input_size);
+
 /**
  * Creates QRVMC Example Precompiles VM.
+ *
+ * The precompiled contracts are registered per VM instance in the table indexed by
+ * the 16-bit precompile id. The ids without the registered implementation are executed
+ * as if the code was empty.
+ *
+ * The built-in implementations can be registered with the option "precompile.<id>", e.g.
+ * set_option("precompile.0x0005", "expmod_naive"). The names are: "empty", "identity",
+ * "sha256", "expmod", "expmod_naive", "bnadd", "bnmul" and "bnpairing".
+ *
+ * The results can be memoized in the cache enabled with the option "cache.size" of
+ * the cache capacity in bytes, e.g. set_option("cache.size", "67108864"). Setting the option
+ * replaces the cache with the empty one, the 0 capacity disables it (default). Registering
+ * a precompile clears the cache. The "empty" and "identity" are never cached.
+ * The cache is safe to use by concurrent executions.
  */
 QRVMC_EXPORT struct qrvmc_vm* qrvmc_create_example_precompiles_vm(void);
 
+/**
+ * Registers the precompiled contract implementation in the Example Precompiles VM instance.
+ *
+ * Replaces the implementation previously registered at the @p id.
+ *
+ * @param vm       The VM instance created with qrvmc_create_example_precompiles_vm().
+ * @param id       The precompile id: the last 2 bytes of the precompile address.
+ * @param gas      The gas cost function.
+ * @param execute  The execution function.
+ */
+QRVMC_EXPORT void qrvmc_example_precompiles_vm_register(
+    struct qrvmc_vm* vm,
+    uint16_t id,
+    qrvmc_example_precompile_gas_fn gas,
+    qrvmc_example_precompile_execute_fn execute);
+
+/** The Example Precompiles VM result cache statistics. */
+struct qrvmc_example_precompiles_cache_stats
+{
+    uint64_t hits;       /**< The number of the executions served from the cache. */
+    uint64_t misses;     /**< The number of the executions not found in the cache. */
+    uint64_t insertions; /**< The number of the results inserted to the cache. */
+    uint64_t evictions;  /**< The number of the results evicted to make space. */
+    uint64_t entries;    /**< The number of the cached results. */
+    uint64_t bytes;      /**< The memory taken by the cached results. */
+};
+
+/**
+ * Returns the result cache statistics of the Example Precompiles VM instance.
+ *
+ * The statistics are all zero if the cache is disabled.
+ */
+QRVMC_EXPORT struct qrvmc_example_precompiles_cache_stats
+qrvmc_example_precompiles_vm_cache_stats(struct qrvmc_vm* vm);
+
 #ifdef __cplusplus
 }
 #endif
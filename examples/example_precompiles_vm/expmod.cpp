@@ -0,0 +1,671 @@
+// EVMC: Ethereum Client-VM Connector API.
+// Copyright 2026 The EVMC Authors.
+// Licensed under the Apache License, Version 2.0.
+
+/// @file
+/// The modular exponentiation of arbitrary size numbers (EIP-198).
+///
+/// The numbers are the little-endian vectors of 64-bit words. The odd moduli use the Montgomery
+/// multiplication (CIOS) with the number of words fixed at compile time for the common sizes,
+/// so the inner loops are fully unrolled, and the sliding window exponentiation.
+/// The even modulus m = q * 2^k is split: the result mod q is computed in the Montgomery form,
+/// the result mod 2^k with the truncated multiplications, and both are combined with the CRT.
+
+#include "expmod.hpp"
+#include <qrvmc/qrvmc.hpp>
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace precompiles
+{
+namespace
+{
+using qrvmc::internal::umul;
+
+/// The arbitrary size number: the little-endian vector of 64-bit words.
+using Words = std::vector<uint64_t>;
+
+constexpr auto max_uint64 = std::numeric_limits<uint64_t>::max();
+
+/// Multiplication saturated to the max uint64 value.
+inline uint64_t mul_sat(uint64_t a, uint64_t b) noexcept
+{
+    const auto p = umul(a, b);
+    return p.hi == 0 ? p.lo : max_uint64;
+}
+
+/// Addition saturated to the max uint64 value.
+inline uint64_t add_sat(uint64_t a, uint64_t b) noexcept
+{
+    return a <= max_uint64 - b ? a + b : max_uint64;
+}
+
+/// Computes acc + a * b + carry, stores the low word in @p r and returns the high word.
+inline uint64_t mac(uint64_t& r, uint64_t acc, uint64_t a, uint64_t b, uint64_t carry) noexcept
+{
+#ifdef __SIZEOF_INT128__
+    // Cannot overflow: (2^64 - 1)^2 + 2 * (2^64 - 1) = 2^128 - 1.
+    const auto s = static_cast<qrvmc::internal::uint128>(a) * b + acc + carry;
+    r = static_cast<uint64_t>(s);
+    return static_cast<uint64_t>(s >> 64);
+#else
+    const auto p = umul(a, b);
+    const auto s1 = p.lo + acc;
+    const auto s2 = s1 + carry;
+    r = s2;
+    return p.hi + (s1 < acc) + (s2 < carry);
+#endif
+}
+
+/// Returns the number of significant bits of the big-endian number.
+uint64_t bit_length(const uint8_t* data, size_t size) noexcept
+{
+    size_t i = 0;
+    while (i < size && data[i] == 0)
+        ++i;
+    if (i == size)
+        return 0;
+    auto top_bits = 0;
+    for (auto b = data[i]; b != 0; b >>= 1)
+        ++top_bits;
+    return uint64_t{8} * (size - i - 1) + static_cast<uint64_t>(top_bits);
+}
+
+/// Returns the number of significant bits of the number. The zero bytes past the stored ones
+/// only shift the stored bits up, so the huge exponent costs nothing unless it is non-zero.
+uint64_t bit_length(const Number& x) noexcept
+{
+    const auto stored_bits = bit_length(x.data, x.data_size);
+    return stored_bits != 0 ? stored_bits + 8 * (x.size - x.data_size) : 0;
+}
+
+/// Returns the bit of the number at the position @p i counted from the lowest bit.
+inline bool bit(const Number& x, uint64_t i) noexcept
+{
+    const auto pos = x.size - 1 - i / 8;
+    return pos < x.data_size && ((x.data[pos] >> (i % 8)) & 1) != 0;
+}
+
+/// Loads the number with the zero high words removed.
+Words load(const Number& x)
+{
+    Words r(static_cast<size_t>((x.size + 7) / 8));
+    for (size_t j = 0; j < x.data_size; ++j)
+    {
+        const auto i = static_cast<size_t>(x.size) - 1 - j;
+        r[i / 8] |= uint64_t{x.data[j]} << (8 * (i % 8));
+    }
+    while (!r.empty() && r.back() == 0)
+        r.pop_back();
+    return r;
+}
+
+/// Stores the number as the big-endian number of the @p size bytes.
+void store(uint8_t* output, size_t size, const Words& x) noexcept
+{
+    for (size_t i = 0; i < size; ++i)
+    {
+        output[size - 1 - i] =
+            i / 8 < x.size() ? static_cast<uint8_t>(x[i / 8] >> (8 * (i % 8))) : uint8_t{0};
+    }
+}
+
+/// Computes the full product of @p a and @p b with the schoolbook multiplication.
+Words mul(const Words& a, const Words& b)
+{
+    Words r(a.size() + b.size());
+    for (size_t j = 0; j < b.size(); ++j)
+    {
+        uint64_t carry = 0;
+        for (size_t i = 0; i < a.size(); ++i)
+            carry = mac(r[i + j], r[i + j], a[i], b[j], carry);
+        r[j + a.size()] = carry;
+    }
+    return r;
+}
+
+/// Computes r = a * b mod 2^(64 n) with only the partial products of the low n words.
+/// The @p r must not alias the arguments.
+void mul_low(uint64_t* r, const uint64_t* a, const uint64_t* b, size_t n) noexcept
+{
+    std::fill_n(r, n, 0);
+    for (size_t j = 0; j < n; ++j)
+    {
+        uint64_t carry = 0;
+        for (size_t i = 0; i < n - j; ++i)
+            carry = mac(r[i + j], r[i + j], a[i], b[j], carry);
+    }
+}
+
+/// Computes the remainder of @p u divided by @p v. The high word of @p v must not be zero.
+///
+/// Uses the Knuth's Algorithm D (The Art of Computer Programming, Vol. 2, 4.3.1),
+/// see qrvmc::udivrem() for the fixed-size variant. The remainder has the size of @p v.
+Words rem(const Words& u, const Words& v)
+{
+    const auto n = v.size();
+    auto m = u.size();
+    while (m > 0 && u[m - 1] == 0)
+        --m;
+
+    Words r(n);
+    if (m < n)
+    {
+        std::copy_n(u.begin(), m, r.begin());
+        return r;
+    }
+
+    if (n == 1)
+    {
+        // The short division.
+        uint64_t rm = 0;
+        for (size_t j = m; j-- > 0;)
+            rm = qrvmc::internal::udivrem_2by1(rm, u[j], v[0]).hi;
+        r[0] = rm;
+        return r;
+    }
+
+    // Normalize: shift the divisor so its most significant bit is set.
+    const auto shift = qrvmc::internal::clz(v[n - 1]);
+    Words vn(n);
+    Words un(m + 1);
+    for (size_t i = n - 1; i > 0; --i)
+        vn[i] = (v[i] << shift) | (shift != 0 ? v[i - 1] >> (64 - shift) : 0);
+    vn[0] = v[0] << shift;
+    un[m] = shift != 0 ? u[m - 1] >> (64 - shift) : 0;
+    for (size_t i = m - 1; i > 0; --i)
+        un[i] = (u[i] << shift) | (shift != 0 ? u[i - 1] >> (64 - shift) : 0);
+    un[0] = u[0] << shift;
+
+    const auto d = vn[n - 1];
+    for (size_t j = m - n + 1; j-- > 0;)
+    {
+        // Estimate the quotient digit qhat from the top two digits of the dividend.
+        uint64_t qhat = 0;
+        uint64_t rhat = 0;
+        bool rhat_overflow = false;
+        if (un[j + n] >= d)
+        {
+            qhat = max_uint64;
+            rhat = un[j + n - 1] + d;
+            rhat_overflow = rhat < d;
+        }
+        else
+        {
+            const auto qr = qrvmc::internal::udivrem_2by1(un[j + n], un[j + n - 1], d);
+            qhat = qr.lo;
+            rhat = qr.hi;
+        }
+
+        // Correct the estimate, at most 2 times.
+        while (!rhat_overflow)
+        {
+            const auto p = umul(qhat, vn[n - 2]);
+            if (p.hi < rhat || (p.hi == rhat && p.lo <= un[j + n - 2]))
+                break;
+            --qhat;
+            rhat += d;
+            rhat_overflow = rhat < d;
+        }
+
+        // Multiply and subtract.
+        uint64_t borrow = 0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            const auto p = umul(qhat, vn[i]);
+            const auto lo = p.lo + borrow;
+            const auto hi = p.hi + (lo < borrow);
+            const auto t = un[i + j] - lo;
+            borrow = hi + (un[i + j] < lo);
+            un[i + j] = t;
+        }
+        const auto top = un[j + n];
+        un[j + n] = top - borrow;
+
+        if (top < borrow)
+        {
+            // The estimate was too big by one: add the divisor back.
+            uint64_t carry = 0;
+            for (size_t i = 0; i < n; ++i)
+            {
+                const auto s = un[i + j] + vn[i];
+                const auto c1 = s < vn[i];
+                un[i + j] = s + carry;
+                carry = uint64_t{c1} | uint64_t{un[i + j] < s};
+            }
+            un[j + n] += carry;
+        }
+    }
+
+    // Denormalize the remainder.
+    for (size_t i = 0; i < n; ++i)
+        r[i] = (un[i] >> shift) | (shift != 0 ? un[i + 1] << (64 - shift) : 0);
+    return r;
+}
+
+/// Returns the width of the sliding window for the exponent of the given number of bits.
+/// The thresholds minimize the number of multiplications (see the OpenSSL's BN_window_bits).
+unsigned window_bits(uint64_t exp_bits) noexcept
+{
+    if (exp_bits > 671)
+        return 6;
+    if (exp_bits > 239)
+        return 5;
+    if (exp_bits > 79)
+        return 4;
+    if (exp_bits > 23)
+        return 3;
+    return 1;
+}
+
+/// The Montgomery multiplication modulo the odd modulus of the N words.
+/// The N of 0 selects the number of words at run time.
+///
+/// Uses the separated operand scanning (SOS): the full product is computed first
+/// and reduced afterwards. The inner loops are the single multiply-accumulate chains
+/// and the squaring computes the cross products once.
+template <size_t N>
+class Montgomery
+{
+    const uint64_t* mod_;
+    size_t size_;
+    uint64_t mod_inv_ = 0;  ///< The -mod^-1 mod 2^64.
+    Words scratch_;         ///< The product buffer for the run time number of words.
+
+    /// Computes the product u = a * b of 2n words.
+    void product(uint64_t* u, const uint64_t* a, const uint64_t* b) const noexcept
+    {
+        const auto n = size();
+        for (size_t i = 0; i < n; ++i)
+        {
+            const auto bi = b[i];
+            uint64_t c = 0;
+            for (size_t j = 0; j < n; ++j)
+                c = mac(u[i + j], i == 0 ? 0 : u[i + j], a[j], bi, c);
+            u[i + n] = c;
+        }
+    }
+
+    /// Computes the square u = a^2 of 2n words: the doubled cross products plus the squares.
+    void square(uint64_t* u, const uint64_t* a) const noexcept
+    {
+        const auto n = size();
+        u[0] = 0;
+        u[2 * n - 1] = 0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            const auto ai = a[i];
+            uint64_t c = 0;
+            for (size_t j = i + 1; j < n; ++j)
+                c = mac(u[i + j], i == 0 ? 0 : u[i + j], a[j], ai, c);
+            if (i + 1 < n)
+                u[i + n] = c;
+        }
+
+        uint64_t shifted_out = 0;
+        uint64_t c = 0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            const auto lo = u[2 * i];
+            const auto hi = u[2 * i + 1];
+            c = mac(u[2 * i], (lo << 1) | shifted_out, a[i], a[i], c);
+            const auto s = (hi << 1) | (lo >> 63);
+            shifted_out = hi >> 63;
+            u[2 * i + 1] = s + c;
+            c = u[2 * i + 1] < c;
+        }
+    }
+
+    /// Computes t = u / 2^(64 n) mod m of the product u of 2n words, the t is in the high half.
+    void reduce(uint64_t* u) const noexcept
+    {
+        const auto n = size();
+        const auto* m = mod_;
+        const auto mod_inv = mod_inv_;
+        uint64_t top = 0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            // The q makes the word u[i] zero.
+            const auto q = u[i] * mod_inv;
+            uint64_t c = 0;
+            for (size_t j = 0; j < n; ++j)
+                c = mac(u[i + j], u[i + j], q, m[j], c);
+            const auto s = u[i + n] + top;
+            top = s < top;
+            u[i + n] = s + c;
+            top += u[i + n] < c;
+        }
+
+        // The t < 2m, subtract m if t >= m.
+        auto* t = &u[n];
+        bool ge = top != 0;
+        if (!ge)
+        {
+            size_t i = n;
+            while (i > 0 && t[i - 1] == m[i - 1])
+                --i;
+            ge = i == 0 || t[i - 1] > m[i - 1];
+        }
+        if (ge)
+        {
+            uint64_t borrow = 0;
+            for (size_t j = 0; j < n; ++j)
+            {
+                const auto d = t[j] - m[j];
+                const auto b1 = t[j] < m[j];
+                t[j] = d - borrow;
+                borrow = uint64_t{b1} | uint64_t{d < borrow};
+            }
+        }
+    }
+
+public:
+    /// Prepares the multiplication modulo the odd @p mod of N words.
+    explicit Montgomery(const Words& mod) : mod_{mod.data()}, size_{mod.size()}
+    {
+        if (N == 0)
+            scratch_.resize(2 * size_);
+
+        // The Newton's iteration doubles the number of correct low bits,
+        // starting with 3 bits correct for any odd number.
+        uint64_t inv = mod[0];
+        for (int i = 0; i < 5; ++i)
+            inv *= 2 - mod[0] * inv;
+        mod_inv_ = 0 - inv;
+    }
+
+    /// The number of words.
+    size_t size() const noexcept { return N != 0 ? N : size_; }
+
+    /// Computes r = a * b / 2^(64 n) mod m of a, b < m. The @p r may alias the arguments.
+    void mul(uint64_t* r, const uint64_t* a, const uint64_t* b) noexcept
+    {
+        // The product buffer on the stack is known not to alias the arguments.
+        if constexpr (N != 0)
+        {
+            uint64_t u[2 * N];
+            product(u, a, b);
+            reduce(u);
+            std::copy_n(&u[N], N, r);
+        }
+        else
+        {
+            product(scratch_.data(), a, b);
+            reduce(scratch_.data());
+            std::copy_n(&scratch_[size_], size_, r);
+        }
+    }
+
+    /// Computes r = a^2 / 2^(64 n) mod m of a < m. The @p r may alias the @p a.
+    void sqr(uint64_t* r, const uint64_t* a) noexcept
+    {
+        if constexpr (N != 0)
+        {
+            uint64_t u[2 * N];
+            square(u, a);
+            reduce(u);
+            std::copy_n(&u[N], N, r);
+        }
+        else
+        {
+            square(scratch_.data(), a);
+            reduce(scratch_.data());
+            std::copy_n(&scratch_[size_], size_, r);
+        }
+    }
+};
+
+/// Computes base^exp mod mod of the odd modulus with the sliding window exponentiation
+/// in the Montgomery form.
+template <size_t N>
+Words expmod_odd(const Words& base, const Number& exp, const Words& mod)
+{
+    // The modulus extended to N words, the Montgomery form uses R = 2^(64 n).
+    auto m = mod;
+    m.resize(N != 0 ? N : mod.size());
+    Montgomery<N> mont{m};
+    const auto n = mont.size();
+
+    // The R mod m and R^2 mod m.
+    Words r(n + 1);
+    r[n] = 1;
+    auto one = rem(r, mod);
+    one.resize(n);
+    Words r2(2 * n + 1);
+    r2[2 * n] = 1;
+    r2 = rem(r2, mod);
+    r2.resize(n);
+
+    // The base in the Montgomery form: (base mod m) * R^2 / R.
+    auto x = rem(base, mod);
+    x.resize(n);
+    mont.mul(x.data(), x.data(), r2.data());
+
+    // The odd powers x, x^3, ..., x^(2^k - 1).
+    const auto exp_bits = bit_length(exp);
+    const auto k = window_bits(exp_bits);
+    std::vector<Words> powers(size_t{1} << (k - 1), Words(n));
+    powers[0] = x;
+    if (powers.size() > 1)
+    {
+        Words x2(n);
+        mont.sqr(x2.data(), x.data());
+        for (size_t i = 1; i < powers.size(); ++i)
+            mont.mul(powers[i].data(), powers[i - 1].data(), x2.data());
+    }
+
+    // Scan the exponent from the top bit: square for the zero bits and process the window
+    // of up to k bits starting and ending with the bit one otherwise.
+    auto acc = one;
+    for (auto i = exp_bits; i > 0;)
+    {
+        if (!bit(exp, i - 1))
+        {
+            mont.sqr(acc.data(), acc.data());
+            --i;
+            continue;
+        }
+
+        auto len = std::min<uint64_t>(k, i);
+        while (!bit(exp, i - len))
+            --len;
+        size_t window = 0;
+        for (auto j = i; j > i - len; --j)
+            window = (window << 1) | size_t{bit(exp, j - 1)};
+        for (uint64_t j = 0; j < len; ++j)
+            mont.sqr(acc.data(), acc.data());
+        mont.mul(acc.data(), acc.data(), powers[window >> 1].data());
+        i -= len;
+    }
+
+    // Convert out of the Montgomery form: acc * 1 / R.
+    Words unit(n);
+    unit[0] = 1;
+    mont.mul(acc.data(), acc.data(), unit.data());
+    acc.resize(mod.size());
+    return acc;
+}
+
+/// Selects the fixed-width Montgomery multiplication for the common modulus sizes.
+Words expmod_odd(const Words& base, const Number& exp, const Words& mod)
+{
+    switch (mod.size())
+    {
+    case 1:
+    case 2:
+    case 3:
+    case 4:
+        return expmod_odd<4>(base, exp, mod);
+    case 8:
+        return expmod_odd<8>(base, exp, mod);
+    case 16:
+        return expmod_odd<16>(base, exp, mod);
+    case 32:
+        return expmod_odd<32>(base, exp, mod);
+    case 64:
+        return expmod_odd<64>(base, exp, mod);
+    default:
+        return expmod_odd<0>(base, exp, mod);
+    }
+}
+
+/// Computes base^exp mod 2^(64 n) with the binary exponentiation.
+Words expmod_pow2(const Words& base, const Number& exp, size_t n)
+{
+    Words x(n);
+    std::copy_n(base.begin(), std::min(n, base.size()), x.begin());
+    Words acc(n);
+    acc[0] = 1;
+    Words t(n);
+    for (auto i = bit_length(exp); i > 0; --i)
+    {
+        mul_low(t.data(), acc.data(), acc.data(), n);
+        if (bit(exp, i - 1))
+            mul_low(acc.data(), t.data(), x.data(), n);
+        else
+            acc.swap(t);
+    }
+    return acc;
+}
+
+/// Computes q^-1 mod 2^(64 n) of the odd @p q with the Newton's iteration.
+Words inverse_pow2(const Words& q, size_t n)
+{
+    Words qn(n);
+    std::copy_n(q.begin(), std::min(n, q.size()), qn.begin());
+    Words inv(n);
+    inv[0] = 1;
+    Words t(n);
+    Words u(n);
+    for (size_t bits = 1; bits < 64 * n; bits *= 2)
+    {
+        // inv = inv * (2 - q * inv)
+        mul_low(t.data(), qn.data(), inv.data(), n);
+        uint64_t borrow = 0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            const auto s = i == 0 ? uint64_t{2} : uint64_t{0};
+            const auto d = s - t[i];
+            const auto b1 = s < t[i];
+            t[i] = d - borrow;
+            borrow = uint64_t{b1} | uint64_t{d < borrow};
+        }
+        mul_low(u.data(), inv.data(), t.data(), n);
+        inv.swap(u);
+    }
+    return inv;
+}
+}  // namespace
+
+uint64_t expmod_gas(uint64_t base_len,
+                    uint64_t exp_len,
+                    uint64_t mod_len,
+                    const uint8_t* exp_head,
+                    size_t exp_head_size) noexcept
+{
+    const auto max_len = std::max(base_len, mod_len);
+    const auto words = max_len / 8 + (max_len % 8 != 0);
+    const auto complexity = mul_sat(words, words);
+
+    const auto head_bits = bit_length(exp_head, exp_head_size);
+    const auto head_iterations = head_bits != 0 ? head_bits - 1 : 0;
+    const auto iterations =
+        exp_len <= 32 ? head_iterations : add_sat(mul_sat(8, exp_len - 32), head_iterations);
+
+    const auto cost = mul_sat(complexity, std::max<uint64_t>(iterations, 1));
+    if (cost == max_uint64)
+        return max_uint64;
+    return std::max<uint64_t>(200, cost / 3);
+}
+
+void expmod(uint8_t* output, const Number& base, const Number& exp, const Number& mod)
+{
+    const auto m = load(mod);
+    if (m.empty())
+    {
+        std::fill_n(output, static_cast<size_t>(mod.size), 0);
+        return;
+    }
+    const auto b = load(base);
+
+    // Split the modulus m = q * 2^k.
+    size_t k = 0;
+    while (m[k / 64] == 0)
+        k += 64;
+    while (((m[k / 64] >> (k % 64)) & 1) == 0)
+        ++k;
+    if (k == 0)
+    {
+        store(output, static_cast<size_t>(mod.size), expmod_odd(b, exp, m));
+        return;
+    }
+
+    const auto word_shift = k / 64;
+    const auto bit_shift = k % 64;
+    Words q(m.size() - word_shift);
+    for (size_t i = 0; i < q.size(); ++i)
+    {
+        const auto j = i + word_shift;
+        q[i] = m[j] >> bit_shift;
+        if (bit_shift != 0 && j + 1 < m.size())
+            q[i] |= m[j + 1] << (64 - bit_shift);
+    }
+    while (q.back() == 0)
+        q.pop_back();
+
+    // The result mod q (zero for q = 1) and mod 2^k.
+    const auto n = (k + 63) / 64;
+    const auto mask = bit_shift != 0 ? (uint64_t{1} << bit_shift) - 1 : max_uint64;
+    auto a1 = q.size() == 1 && q[0] == 1 ? Words(1) : expmod_odd(b, exp, q);
+    auto a2 = expmod_pow2(b, exp, n);
+
+    // Combine with the CRT: r = a1 + q * ((a2 - a1) * q^-1 mod 2^k).
+    a1.resize(std::max(a1.size(), n));
+    Words diff(n);
+    uint64_t borrow = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        const auto d = a2[i] - a1[i];
+        const auto b1 = a2[i] < a1[i];
+        diff[i] = d - borrow;
+        borrow = uint64_t{b1} | uint64_t{d < borrow};
+    }
+    const auto q_inv = inverse_pow2(q, n);
+    Words y(n);
+    mul_low(y.data(), diff.data(), q_inv.data(), n);
+    y[n - 1] &= mask;
+
+    auto r = mul(q, y);
+    r.resize(std::max(r.size(), a1.size()) + 1);
+    uint64_t carry = 0;
+    for (size_t i = 0; i < r.size(); ++i)
+    {
+        const auto s = r[i] + (i < a1.size() ? a1[i] : 0);
+        const auto c1 = s < r[i];
+        r[i] = s + carry;
+        carry = uint64_t{c1} | uint64_t{r[i] < s};
+    }
+    store(output, static_cast<size_t>(mod.size), r);
+}
+
+void expmod_naive(uint8_t* output, const Number& base, const Number& exp, const Number& mod)
+{
+    const auto m = load(mod);
+    if (m.empty())
+    {
+        std::fill_n(output, static_cast<size_t>(mod.size), 0);
+        return;
+    }
+
+    const auto x = rem(load(base), m);
+    auto acc = rem(Words{1}, m);
+    for (auto i = bit_length(exp); i > 0; --i)
+    {
+        acc = rem(mul(acc, acc), m);
+        if (bit(exp, i - 1))
+            acc = rem(mul(acc, x), m);
+    }
+    store(output, static_cast<size_t>(mod.size), acc);
+}
+}  // namespace precompiles
@@ -0,0 +1,42 @@
+// EVMC: Ethereum Client-VM Connector API.
+// Copyright 2026 The EVMC Authors.
+// Licensed under the Apache License, Version 2.0.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace precompiles
+{
+/// The big-endian number of the @p size bytes of which only the leading @p data_size bytes
+/// are stored at @p data. The bytes past them are zeros, so the number can be the slice
+/// of the precompile input running past its end without copying it into a padded buffer.
+struct Number
+{
+    const uint8_t* data = nullptr;  ///< The leading bytes.
+    size_t data_size = 0;           ///< The number of the leading bytes, at most the size.
+    uint64_t size = 0;              ///< The size in bytes.
+};
+
+/// Computes the EXPMOD gas cost as specified in the EIP-2565.
+///
+/// The @p exp_head are the first min(exp_len, 32) bytes of the exponent.
+/// The cost not fitting 64 bits is clamped to the max uint64 value.
+uint64_t expmod_gas(uint64_t base_len,
+                    uint64_t exp_len,
+                    uint64_t mod_len,
+                    const uint8_t* exp_head,
+                    size_t exp_head_size) noexcept;
+
+/// Computes base^exp mod mod of the big-endian numbers and writes it to the @p output
+/// of the mod.size bytes. The zero modulus results in zero.
+///
+/// Uses the Montgomery multiplication with the fixed-width variants for the 256, 512, 1024,
+/// 2048 and 4096-bit moduli and the sliding window exponentiation. The even moduli are split
+/// into the odd and the power of two factors and the results are combined with the CRT.
+void expmod(uint8_t* output, const Number& base, const Number& exp, const Number& mod);
+
+/// The same as expmod() but with the binary exponentiation and the schoolbook
+/// multiplication followed by the long division. This is the reference and the baseline.
+void expmod_naive(uint8_t* output, const Number& base, const Number& exp, const Number& mod);
+}  // namespace precompiles
@@ -0,0 +1,232 @@
+// EVMC: Ethereum Client-VM Connector API.
+// Copyright 2026 The EVMC Authors.
+// Licensed under the Apache License, Version 2.0.
+
+#include "result_cache.hpp"
+#include <qrvmc/helpers.h>
+#include <qrvmc/qrvmc.hpp>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace precompiles
+{
+namespace
+{
+/// The cached output shared by the cache entry and the results served from it.
+struct CachedOutput
+{
+    mutable std::atomic<uint32_t> ref_count{1};
+    qrvmc_status_code status_code = QRVMC_SUCCESS;
+    std::vector<uint8_t> data;
+};
+
+void release(const CachedOutput* output) noexcept
+{
+    if (output->ref_count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        delete output;
+}
+
+/// The deleter of the CachedOutput owned by std::unique_ptr until it is added to the cache.
+struct ReleaseOutput
+{
+    void operator()(const CachedOutput* output) const noexcept { release(output); }
+};
+
+/// The cache entry.
+struct Entry
+{
+    uint64_t hash = 0;
+    uint16_t id = 0;
+    bool referenced = false;  ///< Accessed since the last pass of the CLOCK hand.
+    size_t bytes = 0;         ///< The memory taken by the entry.
+    std::vector<uint8_t> input;
+    const CachedOutput* output = nullptr;
+};
+
+/// The memory taken by the entry in addition to the input and the output.
+constexpr size_t entry_overhead = sizeof(Entry) + sizeof(CachedOutput);
+}  // namespace
+
+struct ResultCache::Shard
+{
+    std::mutex mutex;
+    size_t capacity = 0;
+    size_t bytes = 0;
+
+    /// The entries in the CLOCK order and the index of the entries by the hash.
+    std::vector<Entry> entries;
+    std::unordered_map<uint64_t, size_t> index;
+    size_t hand = 0;
+
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t insertions = 0;
+    uint64_t evictions = 0;
+
+    ~Shard()
+    {
+        for (const auto& e : entries)
+            release(e.output);
+    }
+
+    /// Removes the entry at the position @p i. The last entry takes its place.
+    void remove(size_t i) noexcept
+    {
+        release(entries[i].output);
+        bytes -= entries[i].bytes;
+        index.erase(entries[i].hash);
+        if (i != entries.size() - 1)
+        {
+            entries[i] = std::move(entries.back());
+            index[entries[i].hash] = i;
+        }
+        entries.pop_back();
+    }
+
+    /// Evicts the first entry under the CLOCK hand not referenced since the previous pass.
+    void evict() noexcept
+    {
+        while (true)
+        {
+            if (hand >= entries.size())
+                hand = 0;
+            auto& e = entries[hand];
+            if (!e.referenced)
+                break;
+            e.referenced = false;
+            ++hand;
+        }
+        remove(hand);
+        ++evictions;
+    }
+};
+
+ResultCache::ResultCache(size_t capacity) : m_shards{new Shard[num_shards]}
+{
+    const auto shard_capacity = capacity / num_shards;
+    for (size_t i = 0; i < num_shards; ++i)
+        m_shards[i].capacity = shard_capacity;
+    m_max_input_size = shard_capacity - std::min(shard_capacity, entry_overhead);
+}
+
+ResultCache::~ResultCache() = default;
+
+uint64_t ResultCache::hash(uint16_t id, const uint8_t* input, size_t input_size) noexcept
+{
+    using qrvmc::fnv::fnv1a_by64;
+    auto h = fnv1a_by64(qrvmc::fnv::offset_basis, (uint64_t{id} << 48) ^ input_size);
+    size_t i = 0;
+    for (; i + 8 <= input_size; i += 8)
+        h = fnv1a_by64(h, qrvmc::load64le(&input[i]));
+    if (i != input_size)
+    {
+        uint8_t tail[8]{};
+        std::copy(&input[i], &input[input_size], tail);
+        h = fnv1a_by64(h, qrvmc::load64le(tail));
+    }
+    // The multiplication only carries upwards, so mix the high bits into the low ones.
+    return h ^ (h >> 32);
+}
+
+bool ResultCache::find(
+    qrvmc_result& result, uint64_t hash, uint16_t id, const uint8_t* input, size_t input_size)
+{
+    auto& shard = m_shards[hash >> 60];
+    const CachedOutput* output = nullptr;
+    {
+        const std::lock_guard lock{shard.mutex};
+        const auto it = shard.index.find(hash);
+        if (it == shard.index.end())
+        {
+            ++shard.misses;
+            return false;
+        }
+        auto& e = shard.entries[it->second];
+        if (e.id != id || e.input.size() != input_size ||
+            !std::equal(e.input.begin(), e.input.end(), input))
+        {
+            ++shard.misses;
+            return false;
+        }
+        e.referenced = true;
+        ++shard.hits;
+        output = e.output;
+        output->ref_count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    result = {};
+    result.status_code = output->status_code;
+    result.output_data = output->data.data();
+    result.output_size = output->data.size();
+    result.release = [](const qrvmc_result* r) {
+        release(static_cast<const CachedOutput*>(qrvmc_get_const_optional_storage(r)->pointer));
+    };
+    qrvmc_get_optional_storage(&result)->pointer = const_cast<CachedOutput*>(output);
+    return true;
+}
+
+void ResultCache::insert(uint64_t hash,
+                         uint16_t id,
+                         const uint8_t* input,
+                         size_t input_size,
+                         const qrvmc_result& result)
+{
+    auto& shard = m_shards[hash >> 60];
+    const auto bytes = entry_overhead + input_size + result.output_size;
+    if (bytes > shard.capacity)
+        return;
+
+    // Copy the input and the output before taking the lock.
+    Entry entry;
+    entry.hash = hash;
+    entry.id = id;
+    entry.bytes = bytes;
+    entry.input.assign(input, input + input_size);
+    std::unique_ptr<CachedOutput, ReleaseOutput> output{new CachedOutput};
+    output->status_code = result.status_code;
+    output->data.assign(result.output_data, result.output_data + result.output_size);
+    entry.output = output.get();
+
+    const std::lock_guard lock{shard.mutex};
+    // Replace the entry of the same hash: inserted concurrently or of the colliding input.
+    if (const auto it = shard.index.find(hash); it != shard.index.end())
+        shard.remove(it->second);
+    while (shard.bytes + bytes > shard.capacity)
+        shard.evict();
+
+    const auto pos = shard.index.emplace(hash, shard.entries.size()).first;
+    try
+    {
+        shard.entries.push_back(std::move(entry));
+    }
+    catch (...)
+    {
+        shard.index.erase(pos);
+        throw;
+    }
+    output.release();  // Owned by the entry now.
+    shard.bytes += bytes;
+    ++shard.insertions;
+}
+
+ResultCache::Stats ResultCache::stats() const
+{
+    Stats stats;
+    for (size_t i = 0; i < num_shards; ++i)
+    {
+        auto& shard = m_shards[i];
+        const std::lock_guard lock{shard.mutex};
+        stats.hits += shard.hits;
+        stats.misses += shard.misses;
+        stats.insertions += shard.insertions;
+        stats.evictions += shard.evictions;
+        stats.entries += shard.entries.size();
+        stats.bytes += shard.bytes;
+    }
+    return stats;
+}
+}  // namespace precompiles
@@ -0,0 +1,78 @@
+// EVMC: Ethereum Client-VM Connector API.
+// Copyright 2026 The EVMC Authors.
+// Licensed under the Apache License, Version 2.0.
+#pragma once
+
+#include <qrvmc/qrvmc.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace precompiles
+{
+/// The bounded cache of the precompile results keyed by the precompile id and the input.
+///
+/// The cache is split into the shards selected by the input hash, each with its own lock
+/// and the CLOCK eviction of the entries not accessed since the previous sweep. The hits are
+/// compared with the full cached input. The results served from the cache reference
+/// the cached output, so no copy is made.
+class ResultCache
+{
+public:
+    /// The cache statistics.
+    struct Stats
+    {
+        uint64_t hits = 0;        ///< The number of the lookups finding the result.
+        uint64_t misses = 0;      ///< The number of the lookups not finding the result.
+        uint64_t insertions = 0;  ///< The number of the inserted results.
+        uint64_t evictions = 0;   ///< The number of the results evicted to make space.
+        uint64_t entries = 0;     ///< The number of the cached results.
+        uint64_t bytes = 0;       ///< The memory taken by the cached results.
+    };
+
+    /// Creates the cache taking at most the @p capacity bytes.
+    explicit ResultCache(size_t capacity);
+
+    ~ResultCache();
+
+    /// Returns false if the result of the input of the @p input_size cannot fit the cache.
+    /// Such inputs are not worth hashing.
+    bool fits(size_t input_size) const noexcept { return input_size <= m_max_input_size; }
+
+    /// Returns the hash of the precompile input used as the cache key.
+    static uint64_t hash(uint16_t id, const uint8_t* input, size_t input_size) noexcept;
+
+    /// Looks up the result of the precompile @p id with the input of the @p hash.
+    /// If found, sets the status code and the output of the @p result and returns true.
+    /// The @p result must be released with its qrvmc_result::release().
+    bool find(qrvmc_result& result,
+              uint64_t hash,
+              uint16_t id,
+              const uint8_t* input,
+              size_t input_size);
+
+    /// Inserts the status code and the output of the @p result, evicting the entries
+    /// if needed. The results bigger than the capacity of a shard are not inserted.
+    /// If the allocation fails, std::bad_alloc is thrown and the result is not inserted,
+    /// but the entries removed to make space stay removed.
+    void insert(uint64_t hash,
+                uint16_t id,
+                const uint8_t* input,
+                size_t input_size,
+                const qrvmc_result& result);
+
+    /// Returns the statistics summed over all the shards.
+    Stats stats() const;
+
+private:
+    struct Shard;
+
+    /// The number of the shards. The shard is selected by the top bits of the hash.
+    static constexpr size_t num_shards = 16;
+
+    std::unique_ptr<Shard[]> m_shards;
+
+    /// The max input size of the result fitting the shard.
+    size_t m_max_input_size = 0;
+};
+}  // namespace precompiles
@@ -0,0 +1,332 @@
+// EVMC: Ethereum Client-VM Connector API.
+// Copyright 2026 The EVMC Authors.
+// Licensed under the Apache License, Version 2.0.
+
+/// @file
+/// SHA-256 (FIPS 180-4) with the implementation selected at run time by the CPU features:
+/// - SHA-NI: the x86 SHA extensions do 2 rounds and the message schedule steps per instruction.
+/// - AVX2: the rounds of a single block are sequential, so only the message schedules are
+///   vectorized: the schedules of up to 8 blocks are computed at once, one block per lane.
+///   The rounds use the precomputed schedules afterwards.
+/// - scalar: the portable implementation.
+
+#include "sha256.hpp"
+#include <cstring>
+
+/// @cond internal
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+/// The x86 implementations are compiled in with the target attributes.
+#define SHA256_X86 1
+#include <cpuid.h>
+#include <immintrin.h>
+#else
+#define SHA256_X86 0
+#endif
+/// @endcond
+
+namespace precompiles
+{
+namespace
+{
+/// The SHA-256 round constants.
+alignas(16) constexpr uint32_t K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4,
+    0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe,
+    0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f,
+    0x4a7484aa, 0x5cb0a9dc, 0x76f988da, 0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
+    0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc,
+    0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+    0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070, 0x19a4c116,
+    0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7,
+    0xc67178f2,
+};
+
+/// The SHA-256 initial hash value.
+constexpr uint32_t initial_state[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+    0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+};
+
+/// The compression function: updates the @p state with the consecutive 64-byte blocks.
+using CompressFn = void (*)(uint32_t state[8], const uint8_t* blocks, size_t num_blocks);
+
+inline uint32_t rotr(uint32_t x, unsigned n) noexcept
+{
+    return (x >> n) | (x << (32 - n));
+}
+
+inline uint32_t load32be(const uint8_t* p) noexcept
+{
+    return (uint32_t{p[0]} << 24) | (uint32_t{p[1]} << 16) | (uint32_t{p[2]} << 8) | p[3];
+}
+
+/// The 64 rounds of the block with the message schedule words already added
+/// to the round constants: the word of the round t is wk[t * stride].
+inline void rounds(uint32_t state[8], const uint32_t* wk, size_t stride) noexcept
+{
+    auto a = state[0];
+    auto b = state[1];
+    auto c = state[2];
+    auto d = state[3];
+    auto e = state[4];
+    auto f = state[5];
+    auto g = state[6];
+    auto h = state[7];
+    for (size_t t = 0; t < 64; ++t)
+    {
+        const auto t1 =
+            h + (rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25)) + ((e & f) ^ (~e & g)) + wk[t * stride];
+        const auto t2 = (rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+        h = g;
+        g = f;
+        f = e;
+        e = d + t1;
+        d = c;
+        c = b;
+        b = a;
+        a = t1 + t2;
+    }
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
+}
+
+void compress_scalar(uint32_t state[8], const uint8_t* blocks, size_t num_blocks)
+{
+    for (; num_blocks != 0; --num_blocks, blocks += 64)
+    {
+        uint32_t w[64];
+        for (size_t t = 0; t < 16; ++t)
+            w[t] = load32be(&blocks[t * 4]);
+        for (size_t t = 16; t < 64; ++t)
+        {
+            const auto s0 = rotr(w[t - 15], 7) ^ rotr(w[t - 15], 18) ^ (w[t - 15] >> 3);
+            const auto s1 = rotr(w[t - 2], 17) ^ rotr(w[t - 2], 19) ^ (w[t - 2] >> 10);
+            w[t] = w[t - 16] + s0 + w[t - 7] + s1;
+        }
+        for (size_t t = 0; t < 64; ++t)
+            w[t] += K[t];
+        rounds(state, w, 1);
+    }
+}
+
+#if SHA256_X86
+__attribute__((target("avx2"))) inline __m256i rotr(__m256i x, int n) noexcept
+{
+    return _mm256_or_si256(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32 - n));
+}
+
+__attribute__((target("avx2"))) void compress_avx2(uint32_t state[8],
+                                                   const uint8_t* blocks,
+                                                   size_t num_blocks)
+{
+    // The byte swap of each 32-bit word.
+    const auto bswap = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12, 3,
+                                        2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+
+    while (num_blocks > 1)
+    {
+        const auto n = num_blocks < 8 ? num_blocks : 8;
+
+        // The offsets of the blocks in the lanes. The unused lanes repeat the first block.
+        alignas(32) int32_t offsets[8] = {};
+        for (size_t i = 0; i < n; ++i)
+            offsets[i] = static_cast<int32_t>(i * 64);
+        const auto index = _mm256_load_si256(reinterpret_cast<const __m256i*>(offsets));
+
+        // The schedule words of the round t of all blocks are in the row t.
+        alignas(32) uint32_t wk[64 * 8];
+        __m256i w[64];
+        for (size_t t = 0; t < 16; ++t)
+        {
+            const auto words = _mm256_i32gather_epi32(
+                reinterpret_cast<const int*>(&blocks[t * 4]), index, 1);
+            w[t] = _mm256_shuffle_epi8(words, bswap);
+        }
+        for (size_t t = 16; t < 64; ++t)
+        {
+            const auto w15 = w[t - 15];
+            const auto w2 = w[t - 2];
+            const auto s0 = _mm256_xor_si256(_mm256_xor_si256(rotr(w15, 7), rotr(w15, 18)),
+                                             _mm256_srli_epi32(w15, 3));
+            const auto s1 = _mm256_xor_si256(_mm256_xor_si256(rotr(w2, 17), rotr(w2, 19)),
+                                             _mm256_srli_epi32(w2, 10));
+            w[t] = _mm256_add_epi32(_mm256_add_epi32(w[t - 16], s0),
+                                    _mm256_add_epi32(w[t - 7], s1));
+        }
+        for (size_t t = 0; t < 64; ++t)
+        {
+            const auto k = _mm256_set1_epi32(static_cast<int>(K[t]));
+            _mm256_store_si256(reinterpret_cast<__m256i*>(&wk[t * 8]), _mm256_add_epi32(w[t], k));
+        }
+
+        for (size_t i = 0; i < n; ++i)
+            rounds(state, &wk[i], 8);
+
+        blocks += n * 64;
+        num_blocks -= n;
+    }
+    compress_scalar(state, blocks, num_blocks);
+}
+
+__attribute__((target("sha,sse4.1"))) void compress_shani(uint32_t state[8],
+                                                          const uint8_t* blocks,
+                                                          size_t num_blocks)
+{
+    // The byte swap of each 32-bit word.
+    const auto bswap = _mm_set_epi64x(0x0c0d0e0f08090a0b, 0x0405060700010203);
+
+    // The instructions operate on the state words in the ABEF and CDGH order.
+    auto tmp = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[0])),
+                                 0xb1);  // CDAB
+    auto state1 = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[4])),
+                                    0x1b);                 // EFGH
+    auto state0 = _mm_alignr_epi8(tmp, state1, 8);         // ABEF
+    state1 = _mm_blend_epi16(state1, tmp, 0xf0);           // CDGH
+
+    for (; num_blocks != 0; --num_blocks, blocks += 64)
+    {
+        const auto abef = state0;
+        const auto cdgh = state1;
+
+        // The message schedule of the 4 rounds in each group: msg[i % 4] is the group i.
+        __m128i msg[4];
+        for (size_t i = 0; i < 16; ++i)
+        {
+            auto& m = msg[i % 4];
+            if (i < 4)
+            {
+                m = _mm_shuffle_epi8(
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(&blocks[i * 16])), bswap);
+            }
+            else
+            {
+                // The group i from the groups i-4 (in m), i-3, i-2 and i-1.
+                m = _mm_sha256msg1_epu32(m, msg[(i - 3) % 4]);
+                m = _mm_add_epi32(m, _mm_alignr_epi8(msg[(i - 1) % 4], msg[(i - 2) % 4], 4));
+                m = _mm_sha256msg2_epu32(m, msg[(i - 1) % 4]);
+            }
+
+            const auto wk =
+                _mm_add_epi32(m, _mm_load_si128(reinterpret_cast<const __m128i*>(&K[i * 4])));
+            state1 = _mm_sha256rnds2_epu32(state1, state0, wk);
+            state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(wk, 0x0e));
+        }
+
+        state0 = _mm_add_epi32(state0, abef);
+        state1 = _mm_add_epi32(state1, cdgh);
+    }
+
+    tmp = _mm_shuffle_epi32(state0, 0x1b);        // FEBA
+    state1 = _mm_shuffle_epi32(state1, 0xb1);     // DCHG
+    state0 = _mm_blend_epi16(tmp, state1, 0xf0);  // DCBA
+    state1 = _mm_alignr_epi8(state1, tmp, 8);     // HGFE
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[0]), state0);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[4]), state1);
+}
+
+bool has_shani() noexcept
+{
+    unsigned eax = 0;
+    unsigned ebx = 0;
+    unsigned ecx = 0;
+    unsigned edx = 0;
+    if (__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) == 0)
+        return false;
+    return (ebx & (1u << 29)) != 0 && __builtin_cpu_supports("sse4.1");
+}
+#endif
+
+CompressFn get_compress_fn(Sha256Impl impl) noexcept
+{
+    switch (impl)
+    {
+#if SHA256_X86
+    case Sha256Impl::shani:
+        return compress_shani;
+    case Sha256Impl::avx2:
+        return compress_avx2;
+#endif
+    default:
+        return compress_scalar;
+    }
+}
+
+void sha256(uint8_t hash[32], const uint8_t* data, size_t size, CompressFn compress) noexcept
+{
+    uint32_t state[8];
+    std::memcpy(state, initial_state, sizeof(state));
+
+    // The full blocks are hashed in place.
+    const auto num_blocks = size / 64;
+    if (num_blocks != 0)
+        compress(state, data, num_blocks);
+
+    // The remaining bytes, the 0x80 byte and the bit length in the 1 or 2 final blocks.
+    const auto tail_size = size % 64;
+    uint8_t tail[128] = {};
+    if (tail_size != 0)
+        std::memcpy(tail, &data[num_blocks * 64], tail_size);
+    tail[tail_size] = 0x80;
+    const auto tail_blocks = tail_size < 56 ? size_t{1} : size_t{2};
+    const auto bit_size = uint64_t{size} * 8;
+    for (size_t i = 0; i < 8; ++i)
+        tail[tail_blocks * 64 - 1 - i] = static_cast<uint8_t>(bit_size >> (i * 8));
+    compress(state, tail, tail_blocks);
+
+    for (size_t i = 0; i < 8; ++i)
+    {
+        hash[i * 4 + 0] = static_cast<uint8_t>(state[i] >> 24);
+        hash[i * 4 + 1] = static_cast<uint8_t>(state[i] >> 16);
+        hash[i * 4 + 2] = static_cast<uint8_t>(state[i] >> 8);
+        hash[i * 4 + 3] = static_cast<uint8_t>(state[i]);
+    }
+}
+}  // namespace
+
+bool is_supported(Sha256Impl impl) noexcept
+{
+    switch (impl)
+    {
+    case Sha256Impl::scalar:
+        return true;
+#if SHA256_X86
+    case Sha256Impl::avx2:
+        return __builtin_cpu_supports("avx2");
+    case Sha256Impl::shani:
+        return has_shani();
+#endif
+    default:
+        return false;
+    }
+}
+
+Sha256Impl best_sha256_impl() noexcept
+{
+    static const auto best = [] {
+        if (is_supported(Sha256Impl::shani))
+            return Sha256Impl::shani;
+        if (is_supported(Sha256Impl::avx2))
+            return Sha256Impl::avx2;
+        return Sha256Impl::scalar;
+    }();
+    return best;
+}
+
+void sha256(uint8_t hash[32], const uint8_t* data, size_t size, Sha256Impl impl) noexcept
+{
+    sha256(hash, data, size, get_compress_fn(impl));
+}
+
+void sha256(uint8_t hash[32], const uint8_t* data, size_t size) noexcept
+{
+    static const auto compress = get_compress_fn(best_sha256_impl());
+    sha256(hash, data, size, compress);
+}
+}  // namespace precompiles
@@ -0,0 +1,31 @@
+// EVMC: Ethereum Client-VM Connector API.
+// Copyright 2026 The EVMC Authors.
+// Licensed under the Apache License, Version 2.0.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace precompiles
+{
+/// The SHA-256 implementations.
+enum class Sha256Impl
+{
+    scalar,  ///< The portable implementation.
+    avx2,    ///< The message schedules of up to 8 blocks computed at once with AVX2.
+    shani,   ///< The x86 SHA extensions (SHA-NI).
+};
+
+/// Checks if the SHA-256 implementation is supported by the CPU.
+bool is_supported(Sha256Impl impl) noexcept;
+
+/// Returns the fastest SHA-256 implementation supported by the CPU.
+Sha256Impl best_sha256_impl() noexcept;
+
+/// Computes the SHA-256 hash of the @p data of the @p size with the given implementation.
+/// The implementation must be supported by the CPU.
+void sha256(uint8_t hash[32], const uint8_t* data, size_t size, Sha256Impl impl) noexcept;
+
+/// Computes the SHA-256 hash of the @p data of the @p size with the fastest implementation.
+void sha256(uint8_t hash[32], const uint8_t* data, size_t size) noexcept;
+}  // namespace precompiles
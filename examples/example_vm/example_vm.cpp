@@ -6,32 +6,81 @@
 /// Example implementation of the QRVMC VM interface.
 ///
 /// This VM implements a subset of QRVM instructions in simplistic, incorrect and unsafe way:
-/// - memory bounds are not checked,
 /// - stack bounds are not checked,
-/// - most of the operations are done with 32-bit precision (instead of QRVM 256-bit precision).
+/// - the gas cost of each instruction is 1 (plus the QRVM memory expansion and copy costs),
+/// - the arithmetic is done with QRVM 256-bit precision, but jump destinations are truncated
+///   to 32 bits.
 /// Yet, it is capable of coping with some example QRVM bytecode inputs, which is very useful
 /// in integration testing. The implementation is done in simple C++ for readability and uses
-/// pure C API and some C helpers.
+/// the C API, some C helpers and the qrvmc::uint256 arithmetic.
 
 #include "example_vm.h"
 #include <qrvmc/helpers.h>
 #include <qrvmc/instructions.h>
 #include <qrvmc/qrvmc.h>
+#include <qrvmc/qrvmc.hpp>
 #include <algorithm>
+#include <array>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/// @cond internal
+#if defined(__GNUC__)
+/// The computed goto (labels as values) GNU extension is supported.
+#define EXAMPLE_VM_COMPUTED_GOTO 1
+#else
+#define EXAMPLE_VM_COMPUTED_GOTO 0
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+/// The memory is managed with mmap().
+#define EXAMPLE_VM_MMAP 1
+#include <sys/mman.h>
+#include <unistd.h>
+#else
+#define EXAMPLE_VM_MMAP 0
+#endif
+/// @endcond
 
 /// The Example VM methods, helper and types are contained in the anonymous namespace.
 /// Technically, this limits the visibility of these elements (internal linkage).
 /// This is not strictly required, but is good practice and promotes position independent code.
 namespace
 {
+/// The maximum number of the prepared codes in the VM cache.
+constexpr size_t max_cached_programs = 1024;
+
+struct Program;
+
 /// The example VM instance struct extending the qrvmc_vm.
 struct ExampleVM : qrvmc_vm
 {
     int verbose = 0;  ///< The verbosity level.
-    ExampleVM();      ///< Constructor to initialize the qrvmc_vm struct.
+
+    /// Use the computed goto dispatch (if supported), the switch dispatch otherwise.
+    bool computed_goto = EXAMPLE_VM_COMPUTED_GOTO != 0;
+
+    /// Charge the gas and check the stack once per basic block instead of per instruction.
+    bool block_charging = false;
+
+    /// Execute the code prepared into the instruction stream with superinstructions.
+    bool fusion = false;
+
+    /// The cache of the prepared codes, by the bytecode owned by the prepared code.
+    std::unordered_map<std::string_view, std::shared_ptr<const Program>> cache;
+    std::mutex cache_mutex;  ///< The mutex guarding the cache.
+
+    ExampleVM();  ///< Constructor to initialize the qrvmc_vm struct.
+
+    /// Returns the prepared code from the cache or prepares it.
+    std::shared_ptr<const Program> get_prepared(const uint8_t* code, size_t code_size);
 };
 
 /// The implementation of the qrvmc_vm::destroy() method.
@@ -46,7 +95,16 @@ qrvmc_capabilities_flagset get_capabilities(qrvmc_vm* /*instance*/)
     return QRVMC_CAPABILITY_QRVM1;
 }
 
-/// Example VM options.
+/// Example VM options:
+/// - verbose: the verbosity level (-1 - 9),
+/// - dispatch: the interpreter dispatch mode, "cgoto" (the default if supported) or "switch",
+/// - charging: the gas charging mode, "instruction" (the default) or "block".
+///   In the "block" mode the code is split into basic blocks before execution and the gas
+///   and the stack requirements of a block are checked once at the block entry.
+/// - fusion: "on" or "off" (the default). If on, the code is prepared into the instruction
+///   stream with decoded immediates and the common instruction sequences fused into
+///   superinstructions, see Program. The prepared codes are cached by the VM instance.
+///   The gas is charged per instruction, the charging option is ignored.
 ///
 /// The implementation of the qrvmc_vm::set_option() method.
 /// VMs are allowed to omit this method implementation.
@@ -68,198 +126,1265 @@ enum qrvmc_set_option_result set_option(qrvmc_vm* instance, const char* name, co
         return QRVMC_SET_OPTION_SUCCESS;
     }
 
+    if (std::strcmp(name, "dispatch") == 0)
+    {
+        if (value == nullptr)
+            return QRVMC_SET_OPTION_INVALID_VALUE;
+
+        if (std::strcmp(value, "switch") == 0)
+            vm->computed_goto = false;
+        else if (EXAMPLE_VM_COMPUTED_GOTO && std::strcmp(value, "cgoto") == 0)
+            vm->computed_goto = true;
+        else
+            return QRVMC_SET_OPTION_INVALID_VALUE;
+        return QRVMC_SET_OPTION_SUCCESS;
+    }
+
+    if (std::strcmp(name, "charging") == 0)
+    {
+        if (value == nullptr)
+            return QRVMC_SET_OPTION_INVALID_VALUE;
+
+        if (std::strcmp(value, "instruction") == 0)
+            vm->block_charging = false;
+        else if (std::strcmp(value, "block") == 0)
+            vm->block_charging = true;
+        else
+            return QRVMC_SET_OPTION_INVALID_VALUE;
+        return QRVMC_SET_OPTION_SUCCESS;
+    }
+
+    if (std::strcmp(name, "fusion") == 0)
+    {
+        if (value == nullptr)
+            return QRVMC_SET_OPTION_INVALID_VALUE;
+
+        if (std::strcmp(value, "off") == 0)
+            vm->fusion = false;
+        else if (std::strcmp(value, "on") == 0)
+            vm->fusion = true;
+        else
+            return QRVMC_SET_OPTION_INVALID_VALUE;
+        return QRVMC_SET_OPTION_SUCCESS;
+    }
+
     return QRVMC_SET_OPTION_INVALID_NAME;
 }
 
 /// The Example VM stack representation.
 struct Stack
 {
-    qrvmc_uint256be items[1024] = {};  ///< The array of stack items.
-    qrvmc_uint256be* pointer = items;  ///< The pointer to the currently first empty stack slot.
+    qrvmc::uint256 items[1024] = {};  ///< The array of stack items.
+    qrvmc::uint256* pointer = items;  ///< The pointer to the currently first empty stack slot.
 
     /// Pops an item from the top of the stack.
-    qrvmc_uint256be pop() { return *--pointer; }
+    qrvmc::uint256 pop() { return *--pointer; }
 
     /// Pushes an item to the top of the stack.
-    void push(qrvmc_uint256be value) { *pointer++ = value; }
+    void push(const qrvmc::uint256& value) { *pointer++ = value; }
 };
 
 /// The Example VM memory representation.
-struct Memory
+///
+/// The address space for the maximum memory size is reserved by the first expansion, so
+/// the frames never using the memory reserve none, and then the memory never moves.
+/// It is committed (made accessible) in growing chunks as the memory expands.
+/// The pages are faulted in lazily by the OS when touched the first time.
+/// When the reservation fails, the expansion fails as if the gas were insufficient.
+///
+/// The touched pages are tracked, so clearing the memory for reuse does not depend on
+/// the memory size, only on the number of touched pages. These are zeroed in place, unless
+/// there are many of them: then they are returned to the OS (where supported) instead of
+/// being kept resident.
+class Memory
 {
-    uint32_t size = 0;        ///< The current size of the memory.
-    uint8_t data[1024] = {};  ///< The fixed-size memory buffer.
+public:
+    /// The maximum memory size. The expansion to this size costs more than 2^31 gas.
+    static constexpr size_t max_size = size_t{32} * 1024 * 1024;
+
+    Memory() : m_page_shift{page_shift()}, m_touched(((max_size >> m_page_shift) + 63) / 64) {}
+
+    ~Memory()
+    {
+        if (m_data == nullptr)
+            return;  // Never reserved.
+#if EXAMPLE_VM_MMAP
+        munmap(m_data, max_size);
+#else
+        std::free(m_data);
+#endif
+    }
+
+    Memory(const Memory&) = delete;
+    Memory& operator=(const Memory&) = delete;
+
+    /// The current size of the memory, the multiple of 32.
+    size_t size() const noexcept { return m_size; }
 
     /// Expands the "active" QRVM memory by the given memory region defined by
-    /// @p offset and @p region_size. The region of size 0 also expands the memory
-    /// (what is different behavior than QRVM specifies).
+    /// @p offset and @p region_size, charging the QRVM memory expansion cost from @p gas_left.
     /// Returns pointer to the beginning of the region in the memory,
-    /// or nullptr if the memory cannot be expanded to the required size.
-    uint8_t* expand(uint32_t offset, uint32_t region_size)
+    /// or nullptr if the memory cannot be expanded to the required size or the gas is
+    /// insufficient.
+    uint8_t* expand(uint64_t offset, uint64_t region_size, int64_t& gas_left) noexcept
     {
-        uint32_t new_size = offset + region_size;
-        if (new_size > sizeof(data))
-            return nullptr;  // Cannot expand more than fixed max memory size.
+        if (region_size == 0)
+            return &empty_region;  // The empty region does not expand the memory.
 
-        if (new_size > size)
-            size = new_size;  // Update current memory size.
+        if (offset > max_size || region_size > max_size - offset)
+            return nullptr;  // Cannot expand more than the max memory size.
 
-        return &data[offset];
+        const auto new_size = (offset + region_size + 31) / 32 * 32;
+        if (new_size > m_size)
+        {
+            gas_left -= cost(new_size) - cost(m_size);
+            if (gas_left < 0 || !commit(new_size))
+                return nullptr;
+            m_size = static_cast<size_t>(new_size);  // Update current memory size.
+        }
+
+        touch(static_cast<size_t>(offset), static_cast<size_t>(region_size));
+        return &m_data[offset];
     }
 
-    /// Stores the given value bytes in the memory at the given offset.
-    /// The Memory::size is updated accordingly.
-    /// Returns true if successful, false if the memory cannot be expanded to the required size.
-    bool store(uint32_t offset, const uint8_t* value_data, uint32_t value_size)
+    /// Clears the memory for reuse by following execution.
+    void clear() noexcept
     {
-        uint8_t* p = expand(offset, value_size);
-        if (p == nullptr)
+        if (m_size == 0)
+            return;  // Nothing has been touched.
+
+        const auto page_size = size_t{1} << m_page_shift;
+        if (m_size <= page_size)
+        {
+            // The common case of the small memory.
+            std::memset(m_data, 0, m_size);
+            m_touched[0] = 0;
+            m_num_touched = 0;
+            m_size = 0;
+            return;
+        }
+
+        const auto discard = (m_num_touched << m_page_shift) > discard_threshold;
+        const auto num_pages = (m_size + page_size - 1) >> m_page_shift;
+        for (size_t page = 0; page < num_pages;)
+        {
+            if (!is_touched(page))
+            {
+                ++page;
+                continue;
+            }
+
+            // Process the run of touched pages at once.
+            const auto begin = page;
+            for (; page < num_pages && is_touched(page); ++page)
+                m_touched[page / 64] &= ~(uint64_t{1} << (page % 64));
+            const auto offset = begin << m_page_shift;
+            const auto size = std::min(page << m_page_shift, m_size) - offset;
+            if (!discard || !discard_pages(offset, (page - begin) << m_page_shift))
+                std::memset(&m_data[offset], 0, size);
+        }
+        m_num_touched = 0;
+        m_size = 0;
+    }
+
+private:
+    /// The number of bytes in the touched pages above which these are returned to the OS
+    /// instead of being zeroed. Zeroing in place is a lot cheaper than faulting the pages in
+    /// again, so only the big memories are discarded to not keep them resident.
+    static constexpr size_t discard_threshold = size_t{4} * 1024 * 1024;
+
+    /// The minimum size of the committed region.
+    static constexpr size_t min_commit_size = 64 * 1024;
+
+    /// The non-null location of the empty regions, also before the memory is reserved.
+    static inline uint8_t empty_region = 0;
+
+    uint8_t* m_data = nullptr;  ///< The beginning of the reserved address space, if reserved.
+    size_t m_size = 0;          ///< The current size of the memory.
+    size_t m_committed = 0;     ///< The size of the accessible part of the reserved space.
+    unsigned m_page_shift;      ///< The log2 of the page size, the touched memory granularity.
+
+    std::vector<uint64_t> m_touched;  ///< The bitset of the touched pages.
+    size_t m_num_touched = 0;         ///< The number of the touched pages.
+
+    /// Returns the log2 of the OS page size.
+    static unsigned page_shift() noexcept
+    {
+#if EXAMPLE_VM_MMAP
+        const auto page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#else
+        const size_t page_size = 4096;
+#endif
+        unsigned shift = 0;
+        while ((size_t{1} << (shift + 1)) <= page_size)
+            ++shift;
+        return shift;
+    }
+
+    /// Returns the QRVM cost of the memory of the given size (the multiple of 32).
+    static int64_t cost(uint64_t size) noexcept
+    {
+        const auto num_words = static_cast<int64_t>(size / 32);
+        return 3 * num_words + num_words * num_words / 512;
+    }
+
+    /// Reserves the address space for the maximum memory size.
+    bool reserve() noexcept
+    {
+#if EXAMPLE_VM_MMAP
+        void* p = mmap(nullptr, max_size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE,
+                       -1, 0);
+        if (p == MAP_FAILED)
+            return false;
+        m_data = static_cast<uint8_t*>(p);
+#else
+        // The zeroed allocation of this size is backed by the lazily committed pages
+        // in most allocators.
+        m_data = static_cast<uint8_t*>(std::calloc(max_size, 1));
+        if (m_data == nullptr)
+            return false;
+        m_committed = max_size;
+#endif
+        return true;
+    }
+
+    /// Makes the memory region of @p size accessible, reserving the memory first if needed.
+    /// The committed size is at least doubled so the syscall is amortized.
+    bool commit(uint64_t size) noexcept
+    {
+        if (size <= m_committed)
+            return true;
+        if (m_data == nullptr && !reserve())
+            return false;
+#if EXAMPLE_VM_MMAP
+        const auto new_committed =
+            std::min(max_size, std::max({static_cast<size_t>(size), 2 * m_committed,
+                                         min_commit_size}));
+        if (mprotect(m_data + m_committed, new_committed - m_committed,
+                     PROT_READ | PROT_WRITE) != 0)
             return false;
+        m_committed = new_committed;
+#endif
+        return true;
+    }
+
+    bool is_touched(size_t page) const noexcept
+    {
+        return (m_touched[page / 64] & (uint64_t{1} << (page % 64))) != 0;
+    }
+
+    /// Marks the pages of the non-empty memory region as touched.
+    void touch(size_t offset, size_t size) noexcept
+    {
+        const auto last = (offset + size - 1) >> m_page_shift;
+        for (auto page = offset >> m_page_shift; page <= last; ++page)
+        {
+            auto& word = m_touched[page / 64];
+            const auto bit = uint64_t{1} << (page % 64);
+            m_num_touched += (word & bit) == 0;
+            word |= bit;
+        }
+    }
+
+    /// Returns the pages of the memory region to the OS. On success the pages are
+    /// zero-filled on the next access.
+    bool discard_pages(size_t offset, size_t size) noexcept
+    {
+#if EXAMPLE_VM_MMAP && defined(__linux__)
+        return madvise(&m_data[offset], size, MADV_DONTNEED) == 0;
+#else
+        // Elsewhere MADV_DONTNEED does not guarantee the zero-filled pages.
+        (void)offset;
+        (void)size;
+        return false;
+#endif
+    }
+};
+
+/// The superinstructions: the common sequences of QRVM instructions fused into a single
+/// instruction of the prepared code. The opcodes follow the 256 QRVM opcodes.
+enum Superinstruction : uint16_t
+{
+    SI_PUSH_ADD = 256,   ///< PUSH x ADD: adds the immediate to the stack top.
+    SI_PUSH_AND,         ///< PUSH x AND: the bitwise AND of the stack top and the immediate.
+    SI_PUSH_OR,          ///< PUSH x OR: the bitwise OR of the stack top and the immediate.
+    SI_PUSH_XOR,         ///< PUSH x XOR: the bitwise XOR of the stack top and the immediate.
+    SI_PUSH_SHL,         ///< PUSH x SHL: shifts the stack top left by the immediate.
+    SI_PUSH_SHR,         ///< PUSH x SHR: shifts the stack top right by the immediate.
+    SI_PUSH_SWAP1_SUB,   ///< PUSH x SWAP1 SUB: subtracts the immediate from the stack top.
+    SI_PUSH_MLOAD,       ///< PUSH x MLOAD: loads the memory word at the immediate offset.
+    SI_PUSH_MSTORE,      ///< PUSH x MSTORE: stores the stack top at the immediate offset.
+    SI_PUSH_SLOAD,       ///< PUSH x SLOAD: loads the storage at the immediate key.
+    SI_PUSH_JUMP,        ///< PUSH x JUMP: jumps to the target resolved in preparation.
+    SI_PUSH_JUMPI,       ///< PUSH x JUMPI: the conditional jump to the resolved target.
+    SI_DUP1_PUSH_JUMPI,  ///< DUP1 PUSH x JUMPI: jumps if the stack top is not zero.
+    SI_DUP1_SWAP1,       ///< DUP1 SWAP1: the same as DUP1.
+    SI_SWAP1_POP,        ///< SWAP1 POP: removes the item below the stack top.
+    SI_END,              ///< The end of the superinstructions.
+};
+
+constexpr size_t num_superinstructions = SI_END - SI_PUSH_ADD;
+
+/// The fusion rule: the sequence of QRVM instructions replaced by the superinstruction.
+struct Fusion
+{
+    Superinstruction superinstruction;  ///< The superinstruction.
+    const char* name;                   ///< The name of the instruction sequence.
+    size_t length;                      ///< The number of instructions in the sequence.
+    uint8_t sequence[3];                ///< The opcodes, OP_PUSH1 matches any PUSH.
+};
+
+/// The fusion rules, by the superinstruction. Only the rules with a single PUSH are allowed.
+constexpr Fusion fusions[num_superinstructions] = {
+    {SI_PUSH_ADD, "PUSH ADD", 2, {OP_PUSH1, OP_ADD}},
+    {SI_PUSH_AND, "PUSH AND", 2, {OP_PUSH1, OP_AND}},
+    {SI_PUSH_OR, "PUSH OR", 2, {OP_PUSH1, OP_OR}},
+    {SI_PUSH_XOR, "PUSH XOR", 2, {OP_PUSH1, OP_XOR}},
+    {SI_PUSH_SHL, "PUSH SHL", 2, {OP_PUSH1, OP_SHL}},
+    {SI_PUSH_SHR, "PUSH SHR", 2, {OP_PUSH1, OP_SHR}},
+    {SI_PUSH_SWAP1_SUB, "PUSH SWAP1 SUB", 3, {OP_PUSH1, OP_SWAP1, OP_SUB}},
+    {SI_PUSH_MLOAD, "PUSH MLOAD", 2, {OP_PUSH1, OP_MLOAD}},
+    {SI_PUSH_MSTORE, "PUSH MSTORE", 2, {OP_PUSH1, OP_MSTORE}},
+    {SI_PUSH_SLOAD, "PUSH SLOAD", 2, {OP_PUSH1, OP_SLOAD}},
+    {SI_PUSH_JUMP, "PUSH JUMP", 2, {OP_PUSH1, OP_JUMP}},
+    {SI_PUSH_JUMPI, "PUSH JUMPI", 2, {OP_PUSH1, OP_JUMPI}},
+    {SI_DUP1_PUSH_JUMPI, "DUP1 PUSH JUMPI", 3, {OP_DUP1, OP_PUSH1, OP_JUMPI}},
+    {SI_DUP1_SWAP1, "DUP1 SWAP1", 2, {OP_DUP1, OP_SWAP1}},
+    {SI_SWAP1_POP, "SWAP1 POP", 2, {OP_SWAP1, OP_POP}},
+};
+
+/// Returns the gas cost of the QRVM instruction in the revision.
+/// The cost of each instruction is 1 in all revisions so far.
+constexpr int16_t instruction_cost(qrvmc_revision /*rev*/, uint8_t /*opcode*/) noexcept
+{
+    return 1;
+}
+
+/// Checks if all PUSH instructions cost the same, as assumed by the fusion rules.
+constexpr bool same_push_costs(qrvmc_revision rev) noexcept
+{
+    for (int op = OP_PUSH2; op <= OP_PUSH32; ++op)
+    {
+        if (instruction_cost(rev, static_cast<uint8_t>(op)) != instruction_cost(rev, OP_PUSH1))
+            return false;
+    }
+    return true;
+}
+
+/// The gas costs of the instructions and the superinstructions in the revision,
+/// by the opcode. The cost of the superinstruction is the sum of the fused instructions costs.
+///
+/// The interpreter is instantiated per revision, so the costs are the compile-time constants.
+template <qrvmc_revision Rev>
+struct GasCosts
+{
+    static_assert(same_push_costs(Rev), "PUSHes in the fusion rules must cost the same");
 
-        std::memcpy(p, value_data, value_size);
+    /// The costs table.
+    static constexpr auto table = [] {
+        std::array<int16_t, 256 + num_superinstructions> t{};
+        for (size_t op = 0; op < 256; ++op)
+            t[op] = instruction_cost(Rev, static_cast<uint8_t>(op));
+        for (const auto& fusion : fusions)
+        {
+            for (size_t i = 0; i < fusion.length; ++i)
+                t[fusion.superinstruction] += t[fusion.sequence[i]];
+        }
+        return t;
+    }();
+
+    /// All QRVM instructions cost the same, so the cost of the executed instruction
+    /// is not looked up in the table.
+    static constexpr bool uniform = [] {
+        for (size_t op = 1; op < 256; ++op)
+        {
+            if (table[op] != table[0])
+                return false;
+        }
         return true;
+    }();
+};
+
+/// The requirements of the basic block, checked at the block entry.
+struct Block
+{
+    int32_t gas = 0;               ///< The gas cost of the block's instructions.
+    int32_t stack_required = 0;    ///< The minimum stack height required by the block.
+    int32_t stack_max_growth = 0;  ///< The maximum stack height growth in the block.
+    bool is_jumpdest = false;      ///< The block starts with the JUMPDEST instruction.
+};
+
+/// Splits the code into basic blocks. The block starts at the beginning of the code,
+/// at each JUMPDEST and after each instruction ending the block (or jumping).
+/// The requirements of the block are put at the index of its first instruction.
+///
+/// The gas costs are the same as in the per instruction charging.
+/// The stack requirements come from the QRVM instruction metrics of the revision.
+template <qrvmc_revision Rev>
+void analyze(std::vector<Block>& blocks, const uint8_t* code, size_t code_size)
+{
+    static const auto metrics = qrvmc_get_instruction_metrics_table(Rev);
+
+    blocks.assign(code_size, Block{});
+    Block* block = nullptr;
+    int32_t stack_change = 0;  // The stack height change from the block entry.
+    for (size_t pc = 0; pc < code_size; ++pc)
+    {
+        const auto op = code[pc];
+        if (block == nullptr || op == OP_JUMPDEST)
+        {
+            block = &blocks[pc];
+            block->is_jumpdest = op == OP_JUMPDEST;
+            stack_change = 0;
+        }
+
+        const auto& m = metrics[op];
+        block->gas += GasCosts<Rev>::table[op];
+        block->stack_required =
+            std::max(block->stack_required, m.stack_height_required - stack_change);
+        stack_change += m.stack_height_change;
+        block->stack_max_growth = std::max(block->stack_max_growth, stack_change);
+
+        if (op >= OP_PUSH1 && op <= OP_PUSH32)
+            pc += size_t{op} - OP_PUSH1 + 1;
+
+        switch (op)
+        {
+        case OP_STOP:
+        case OP_JUMP:
+        case OP_JUMPI:
+        case OP_RETURN:
+        case OP_REVERT:
+        case OP_INVALID:
+            block = nullptr;  // The next instruction starts the new block.
+            break;
+        default:
+            break;
+        }
     }
+}
+
+/// Charges the gas and checks the stack requirements of the block at its entry.
+/// Returns ::QRVMC_SUCCESS if the block can be executed without the per instruction checks.
+inline qrvmc_status_code enter_block(const Block& block, int64_t& gas_left, const Stack& stack)
+{
+    gas_left -= block.gas;
+    if (gas_left < 0)
+        return QRVMC_OUT_OF_GAS;
+    const auto stack_height = stack.pointer - stack.items;
+    if (stack_height < block.stack_required)
+        return QRVMC_STACK_UNDERFLOW;
+    if (stack_height + block.stack_max_growth > 1024)
+        return QRVMC_STACK_OVERFLOW;
+    return QRVMC_SUCCESS;
+}
+
+/// The instruction of the prepared code.
+struct Instruction
+{
+    uint16_t opcode;  ///< The QRVM opcode or the Superinstruction.
+    uint32_t arg;     ///< The index of the immediate value or the jump target instruction.
 };
 
-/// Creates 256-bit value out of 32-bit input.
-inline qrvmc_uint256be to_uint256(uint32_t x)
+/// The jump target of the position not being a JUMPDEST.
+constexpr uint32_t no_jump_target = ~uint32_t{0};
+
+/// The code prepared for execution: the stream of the instructions with the immediates
+/// of PUSHes decoded and the common sequences fused into superinstructions.
+///
+/// The prepared code is equivalent to the bytecode: the gas cost of the superinstruction
+/// is the sum of the fused instructions costs and only the last of them has the side effects,
+/// so running out of gas or failing in the middle of the sequence gives the same result.
+/// The JUMPDESTs are never fused, and the jump targets of the fused PUSH JUMPs are
+/// resolved to the instruction indexes in preparation. Differently from the bytecode
+/// execution, the JUMPDEST inside push data is rejected.
+struct Program
 {
-    qrvmc_uint256be value = {};
-    value.bytes[31] = static_cast<uint8_t>(x);
-    value.bytes[30] = static_cast<uint8_t>(x >> 8);
-    value.bytes[29] = static_cast<uint8_t>(x >> 16);
-    value.bytes[28] = static_cast<uint8_t>(x >> 24);
-    return value;
+    /// The bytecode, the key of the VM cache.
+    const std::vector<uint8_t> bytecode;
+
+    std::vector<Instruction> instructions;  ///< The instructions.
+    std::vector<qrvmc::uint256> values;     ///< The immediate values.
+
+    /// The instruction indexes of the JUMPDESTs by the code position,
+    /// ::no_jump_target for the other positions.
+    std::vector<uint32_t> jump_targets;
+
+    /// The number of the sequences fused into each superinstruction.
+    std::array<uint32_t, num_superinstructions> num_fused{};
+
+    Program(const uint8_t* code, size_t code_size)
+      : bytecode(code, code + code_size), jump_targets(code_size, no_jump_target)
+    {}
+
+    /// Returns the instruction index of the JUMPDEST at the code position @p dst,
+    /// or ::no_jump_target.
+    uint32_t jump_target(uint64_t dst) const noexcept
+    {
+        return dst < jump_targets.size() ? jump_targets[static_cast<size_t>(dst)] :
+                                           no_jump_target;
+    }
+};
+
+/// Prepares the code for execution in the fusion mode.
+std::shared_ptr<Program> prepare(const uint8_t* code, size_t code_size)
+{
+    auto program = std::make_shared<Program>(code, code_size);
+
+    // Decode the instructions. The push data missing at the code end are zeros.
+    struct Decoded
+    {
+        uint8_t opcode;
+        size_t pc;
+        qrvmc::uint256 value;
+    };
+    std::vector<Decoded> decoded;
+    for (size_t pc = 0; pc < code_size; ++pc)
+    {
+        Decoded d{code[pc], pc, {}};
+        if (d.opcode >= OP_PUSH1 && d.opcode <= OP_PUSH32)
+        {
+            const auto num_push_bytes = size_t{d.opcode} - OP_PUSH1 + 1;
+            const auto available = std::min(num_push_bytes, code_size - pc - 1);
+            qrvmc::uint256be bytes;
+            std::memcpy(&bytes.bytes[sizeof(bytes) - num_push_bytes], &code[pc + 1], available);
+            d.value = qrvmc::to_uint256(bytes);
+            pc += num_push_bytes;
+        }
+        decoded.push_back(d);
+    }
+
+    const auto matches = [&decoded](const Fusion& fusion, size_t i) noexcept {
+        if (decoded.size() - i < fusion.length)
+            return false;
+        for (size_t j = 0; j < fusion.length; ++j)
+        {
+            const auto opcode = decoded[i + j].opcode;
+            const auto expected = fusion.sequence[j];
+            if (expected == OP_PUSH1 ? (opcode < OP_PUSH1 || opcode > OP_PUSH32) :
+                                       opcode != expected)
+                return false;
+        }
+        return true;
+    };
+
+    auto& instructions = program->instructions;
+    for (size_t i = 0; i < decoded.size();)
+    {
+        const auto& d = decoded[i];
+        if (d.opcode == OP_JUMPDEST)
+            program->jump_targets[d.pc] = static_cast<uint32_t>(instructions.size());
+
+        // The longest matching sequence is fused.
+        const Fusion* fusion = nullptr;
+        for (const auto& f : fusions)
+        {
+            if ((fusion == nullptr || f.length > fusion->length) && matches(f, i))
+                fusion = &f;
+        }
+
+        Instruction instruction{d.opcode, 0};
+        size_t length = 1;
+        if (fusion != nullptr)
+        {
+            instruction.opcode = static_cast<uint16_t>(fusion->superinstruction);
+            length = fusion->length;
+            ++program->num_fused[fusion->superinstruction - SI_PUSH_ADD];
+        }
+
+        // The immediate of the (single) PUSH in the sequence.
+        for (size_t j = i; j < i + length; ++j)
+        {
+            if (decoded[j].opcode < OP_PUSH1 || decoded[j].opcode > OP_PUSH32)
+                continue;
+            if (instruction.opcode == SI_PUSH_JUMP || instruction.opcode == SI_PUSH_JUMPI ||
+                instruction.opcode == SI_DUP1_PUSH_JUMPI)
+            {
+                // Jump destinations are truncated to 32 bits, as in the bytecode execution.
+                // The target is resolved when all JUMPDESTs are known.
+                instruction.arg = static_cast<uint32_t>(decoded[j].value[0]);
+            }
+            else
+            {
+                instruction.arg = static_cast<uint32_t>(program->values.size());
+                program->values.push_back(decoded[j].value);
+            }
+        }
+
+        instructions.push_back(instruction);
+        i += length;
+    }
+
+    for (auto& instruction : instructions)
+    {
+        if (instruction.opcode == SI_PUSH_JUMP || instruction.opcode == SI_PUSH_JUMPI ||
+            instruction.opcode == SI_DUP1_PUSH_JUMPI)
+            instruction.arg = program->jump_target(instruction.arg);
+    }
+    return program;
 }
 
+std::shared_ptr<const Program> ExampleVM::get_prepared(const uint8_t* code, size_t code_size)
+{
+    const auto key = std::string_view{reinterpret_cast<const char*>(code), code_size};
+    {
+        const std::lock_guard lock{cache_mutex};
+        if (const auto it = cache.find(key); it != cache.end())
+            return it->second;
+    }
+
+    // Prepare without holding the lock. Concurrent preparations of the same code are fine.
+    std::shared_ptr<const Program> program = prepare(code, code_size);
+
+    if (verbose > 1)
+    {
+        // The report of the fused sequences.
+        std::printf("prepared %zu bytes into %zu instructions", code_size,
+                    program->instructions.size());
+        for (size_t i = 0; i < num_superinstructions; ++i)
+        {
+            if (program->num_fused[i] != 0)
+                std::printf(", %s: %u", fusions[i].name, program->num_fused[i]);
+        }
+        std::puts("");
+    }
+
+    const std::lock_guard lock{cache_mutex};
+    if (cache.size() >= max_cached_programs)
+        cache.clear();  // The prepared codes being executed are kept alive by the callers.
+    const auto& bytecode = program->bytecode;
+    const auto program_key =
+        std::string_view{reinterpret_cast<const char*>(bytecode.data()), bytecode.size()};
+    return cache.emplace(program_key, std::move(program)).first->second;
+}
+
+/// The Example VM execution frame: the stack and the memory of a single execution.
+struct Frame
+{
+    Stack stack;                ///< The stack.
+    Memory memory;              ///< The memory.
+    std::vector<Block> blocks;  ///< The basic blocks of the code (in the block charging mode).
+    int32_t msg_depth = 0;      ///< The depth of the message of the execution using the frame.
+};
+
+/// The pool of execution frames reused by the executions in a thread.
+///
+/// The frames are allocated (and zeroed) once and reused by all following executions,
+/// including the nested ones: the frame index is the current depth of execute() calls.
+/// Frames never move, so the stack pointer stays valid. The memory of a frame is reserved
+/// only when used, so the deep call chains of the frames without memory stay cheap.
+/// The frames in use share the log buffer: the logs of the nested execution called directly
+/// by the execution in the frame below are passed to the host with the logs of the latter.
+struct FramePool
+{
+    std::vector<std::unique_ptr<Frame>> frames;  ///< The allocated frames.
+    size_t depth = 0;                            ///< The number of frames in use.
+    qrvmc::LogBuffer logs;                       ///< The logs not yet passed to the host.
+};
+
+/// Returns the frame pool of the calling thread, shared by all the interpreter variants.
+FramePool& thread_frame_pool() noexcept
+{
+    static thread_local FramePool pool;
+    return pool;
+}
+
+/// The frame of the execution acquired from the per-thread pool for the execution lifetime.
+///
+/// When released, the frame is reset to the initial state: the stack is emptied,
+/// only the touched region of the memory is cleared and the logs of the frame are dropped,
+/// unless committed.
+class ScopedFrame
+{
+    FramePool& pool;
+    Frame& frame;
+    size_t logs_checkpoint;  ///< The size of the log buffer at the frame start.
+
+    static Frame& acquire(FramePool& pool)
+    {
+        if (pool.depth == pool.frames.size())
+            pool.frames.push_back(std::make_unique<Frame>());
+        return *pool.frames[pool.depth++];
+    }
+
+public:
+    ScopedFrame(FramePool& p, int32_t msg_depth)
+      : pool{p}, frame{acquire(p)}, logs_checkpoint{p.logs.size()}
+    {
+        frame.msg_depth = msg_depth;
+    }
+
+    ~ScopedFrame()
+    {
+        frame.stack.pointer = frame.stack.items;
+        frame.memory.clear();
+        pool.logs.truncate(logs_checkpoint);
+        --pool.depth;
+    }
+
+    ScopedFrame(const ScopedFrame&) = delete;
+    ScopedFrame& operator=(const ScopedFrame&) = delete;
+
+    Stack& stack() { return frame.stack; }    ///< The frame's stack.
+    Memory& memory() { return frame.memory; }  ///< The frame's memory.
+    std::vector<Block>& blocks() { return frame.blocks; }  ///< The frame's basic blocks.
+    qrvmc::LogBuffer& logs() { return pool.logs; }         ///< The shared log buffer.
+
+    /// Commits the logs of the successful execution. If called directly by the execution
+    /// in the frame below, the logs are left to it: it passes them to the host with its own
+    /// ones, in the order. Otherwise, e.g. when called by another VM, the logs are passed
+    /// to the host now, before the caller continues.
+    void commit_logs(const qrvmc_host_interface* host,
+                     qrvmc_host_context* context,
+                     const qrvmc_message& msg)
+    {
+        if (pool.depth > 1 && pool.frames[pool.depth - 2]->msg_depth == msg.depth - 1)
+            logs_checkpoint = pool.logs.size();
+        else
+            pool.logs.flush(host, context, msg);
+    }
+};
+
 /// Creates 256-bit value out of an 160-bit address.
-inline qrvmc_uint256be to_uint256(qrvmc_address address)
+inline qrvmc::uint256 to_uint256(const qrvmc_address& address)
 {
-    qrvmc_uint256be value = {};
+    qrvmc::uint256be value;
     size_t offset = sizeof(value) - sizeof(address);
     std::memcpy(&value.bytes[offset], address.bytes, sizeof(address.bytes));
-    return value;
+    return qrvmc::to_uint256(value);
 }
 
 /// Truncates 256-bit value to 32-bit value.
-inline uint32_t to_uint32(qrvmc_uint256be value)
+inline uint32_t to_uint32(const qrvmc::uint256& value)
+{
+    return static_cast<uint32_t>(value[0]);
+}
+
+/// Converts 256-bit value to the memory offset or size. The values not fitting 64 bits
+/// are saturated, so the memory expansion fails.
+inline uint64_t to_memory_size(const qrvmc::uint256& value)
 {
-    return (uint32_t{value.bytes[28]} << 24) | (uint32_t{value.bytes[29]} << 16) |
-           (uint32_t{value.bytes[30]} << 8) | (uint32_t{value.bytes[31]});
+    return (value[1] | value[2] | value[3]) != 0 ? ~uint64_t{0} : value[0];
 }
 
 /// Truncates 256-bit value to 160-bit address.
-inline qrvmc_address to_address(qrvmc_uint256be value)
+inline qrvmc_address to_address(const qrvmc::uint256& value)
 {
+    const auto bytes = qrvmc::to_uint256be(value);
     qrvmc_address address = {};
-    size_t offset = sizeof(value) - sizeof(address);
-    std::memcpy(address.bytes, &value.bytes[offset], sizeof(address.bytes));
+    size_t offset = sizeof(bytes) - sizeof(address);
+    std::memcpy(address.bytes, &bytes.bytes[offset], sizeof(address.bytes));
     return address;
 }
 
-
-/// The example implementation of the qrvmc_vm::execute() method.
-qrvmc_result execute(qrvmc_vm* instance,
-                     const qrvmc_host_interface* host,
-                     qrvmc_host_context* context,
-                     enum qrvmc_revision /*rev*/,
-                     const qrvmc_message* msg,
-                     const uint8_t* code,
-                     size_t code_size)
+/// Returns the @p value shifted by @p n bits with the shift @p op.
+/// Shifts by 256 bits or more result in zero.
+template <typename Op>
+inline qrvmc::uint256 shift(const qrvmc::uint256& n, const qrvmc::uint256& value, Op op)
 {
-    auto* vm = static_cast<ExampleVM*>(instance);
+    if ((n[1] | n[2] | n[3]) != 0)
+        return {};
+    return op(value, n[0]);
+}
 
-    if (vm->verbose > 0)
-        std::puts("execution started\n");
+
+/// @cond internal
+#if EXAMPLE_VM_COMPUTED_GOTO
+/// Encloses the code using the labels as values, silencing the -Wpedantic warnings
+/// about the extension only there. The labels as values are used only if supported
+/// by the compiler.
+#define BEGIN_LABELS_AS_VALUES \
+    _Pragma("GCC diagnostic push") _Pragma("GCC diagnostic ignored \"-Wpedantic\"")
+#define END_LABELS_AS_VALUES _Pragma("GCC diagnostic pop")
+#endif
+
+/// Defines the entry of the instruction implementation,
+/// being both the switch case and the computed goto target.
+#if EXAMPLE_VM_COMPUTED_GOTO
+#define TARGET(OPCODE, NAME) \
+    case OPCODE:             \
+    op_##NAME
+#else
+#define TARGET(OPCODE, NAME) case OPCODE
+#endif
+
+/// The opcode of the instruction at the pc: of the prepared code in the fusion mode,
+/// of the bytecode otherwise.
+#define OPCODE() (Fused ? instructions[pc].opcode : code[pc])
+
+/// The gas cost of the instruction at the pc in the revision,
+/// the constant if all QRVM instructions cost the same.
+#define GAS_COST()                                            \
+    (!Fused && GasCosts<Rev>::uniform ? GasCosts<Rev>::table[0] : \
+                                        GasCosts<Rev>::table[OPCODE()])
+
+/// Dispatches the instruction at the pc after charging its gas cost,
+/// unless charged already by the block.
+#define DISPATCH()                                                        \
+    do                                                                    \
+    {                                                                     \
+        if (pc >= end_pc)                                                 \
+            goto end;                                                     \
+        if (!BlockCharging && (gas_left -= GAS_COST()) < 0)               \
+            return qrvmc_make_result(QRVMC_OUT_OF_GAS, 0, 0, nullptr, 0); \
+        BEGIN_LABELS_AS_VALUES                                            \
+        goto* table[OPCODE()];                                            \
+        END_LABELS_AS_VALUES                                              \
+    } while (false)
+
+/// Enters the basic block: charges its gas and checks its stack requirements.
+#define ENTER_BLOCK(BLOCK)                                               \
+    do                                                                   \
+    {                                                                    \
+        const auto block_status = enter_block(BLOCK, gas_left, stack);   \
+        if (block_status != QRVMC_SUCCESS)                               \
+            return qrvmc_make_result(block_status, 0, 0, nullptr, 0);    \
+    } while (false)
+
+/// Continues with the next instruction: with the direct jump to its implementation
+/// in the computed goto mode, by the outer loop otherwise.
+#if EXAMPLE_VM_COMPUTED_GOTO
+#define NEXT()                  \
+    if (UseComputedGoto)        \
+    {                           \
+        ++pc;                   \
+        DISPATCH();             \
+    }                           \
+    break
+#else
+#define NEXT() break
+#endif
+/// @endcond
+
+/// The interpreter loop. The instruction implementations are shared by the dispatch modes:
+/// - the switch: all instructions return to the single indirect jump of the loop's switch,
+/// - the computed goto: each instruction ends with its own indirect jump to the next one,
+///   what makes the jumps better predictable.
+/// In the block charging mode, the gas and the stack are checked only at the basic block
+/// entries: at the beginning of the code, at JUMPDESTs and after the not taken JUMPI.
+/// In the fusion mode, the instructions of the prepared @p program are executed
+/// instead of the bytecode, the pc being the instruction index.
+/// The interpreter is instantiated per revision @p Rev, with the gas costs being constants.
+/// If the host accepts the batches of logs (::QRVMC_HOST_EMIT_LOGS), the logs are buffered
+/// and passed to the host before each call and when the execution succeeds, so the logs
+/// of the failed execution never reach the host and the order of the logs is kept, whoever
+/// executes the calls. Otherwise, the logs are passed to the host one by one right away.
+template <qrvmc_revision Rev, bool UseComputedGoto, bool BlockCharging, bool Fused>
+qrvmc_result interpret(const qrvmc_host_interface* host,
+                       qrvmc_host_context* context,
+                       const qrvmc_message* msg,
+                       const uint8_t* code,
+                       size_t code_size,
+                       const Program* program)
+{
+    static_assert(!(BlockCharging && Fused), "the prepared code is charged per instruction");
 
     int64_t gas_left = msg->gas;
-    Stack stack;
-    Memory memory;
+    qrvmc::TxContextCache tx_context{host, context, *msg};
 
-    for (size_t pc = 0; pc < code_size; ++pc)
+    // Use the preallocated frame instead of zeroing 32 KB of the stack and mapping the memory.
+    ScopedFrame frame{thread_frame_pool(), msg->depth};
+    Stack& stack = frame.stack();
+    Memory& memory = frame.memory();
+    qrvmc::LogBuffer& logs = frame.logs();
+
+    size_t pc = 0;
+
+    const Instruction* instructions = Fused ? program->instructions.data() : nullptr;
+    const qrvmc::uint256* values = Fused ? program->values.data() : nullptr;
+    const size_t end_pc = Fused ? program->instructions.size() : code_size;
+
+    const Block* blocks = nullptr;
+    if (BlockCharging && code_size != 0)
     {
-        // Check remaining gas, assume each instruction costs 1.
-        gas_left -= 1;
-        if (gas_left < 0)
+        analyze<Rev>(frame.blocks(), code, code_size);
+        blocks = frame.blocks().data();
+        if (!blocks[0].is_jumpdest)  // Otherwise, entered by the JUMPDEST.
+            ENTER_BLOCK(blocks[0]);
+    }
+
+#if EXAMPLE_VM_COMPUTED_GOTO
+    // The computed goto targets of all opcodes and superinstructions.
+    // The superinstructions are not reachable when executing the bytecode.
+#define SI(NAME) (Fused ? &&op_##NAME : &&op_undefined)
+    BEGIN_LABELS_AS_VALUES
+    static void* const table[256 + num_superinstructions] = {
+        // 0x00
+        &&op_STOP, &&op_ADD, &&op_MUL, &&op_SUB, &&op_DIV, &&op_undefined, &&op_MOD,
+        &&op_undefined, &&op_undefined, &&op_undefined, &&op_undefined, &&op_undefined,
+        &&op_undefined, &&op_undefined, &&op_undefined, &&op_undefined,
+        // 0x10
+        &&op_LT, &&op_GT, &&op_undefined, &&op_undefined, &&op_EQ, &&op_ISZERO, &&op_AND,
+        &&op_OR, &&op_XOR, &&op_NOT, &&op_undefined, &&op_SHL, &&op_SHR, &&op_undefined,
+        &&op_undefined, &&op_undefined,
+        // 0x20
+        &&op_undefined, &&op_undefined, &&op_undefined, &&op_undefined, &&op_undefined,
+        &&op_undefined, &&op_undefined, &&op_undefined, &&op_undefined, &&op_undefined,
+        &&op_undefined, &&op_undefined, &&op_undefined, &&op_undefined, &&op_undefined,
+        &&op_undefined,
+        // 0x30
+        &&op_ADDRESS, &&op_undefined, &&op_undefined, &&op_undefined, &&op_undefined,
+        &&op_CALLDATALOAD, &&op_undefined, &&op_CALLDATACOPY, &&op_undefined, &&op_undefined,
+        &&op_undefined, &&op_undefined, &&op_undefined, &&op_undefined, &&op_undefined,
+        &&op_undefined,
+        // 0x40
+        &&op_BLOCKHASH, &&op_undefined, &&op_undefined, &&op_NUMBER, &&op_undefined,
+        &&op_undefined, &&op_undefined, &&op_undefined, &&op_undefined, &&op_undefined,
+        &&op_undefined, &&op_undefined, &&op_undefined, &&op_undefined, &&op_undefined,
+        &&op_undefined,
+        // 0x50
+        &&op_POP, &&op_MLOAD, &&op_MSTORE, &&op_undefined, &&op_SLOAD, &&op_SSTORE,
+        &&op_JUMP, &&op_JUMPI, &&op_undefined, &&op_MSIZE, &&op_undefined, &&op_JUMPDEST,
+        &&op_undefined, &&op_undefined, &&op_undefined, &&op_undefined,
+        // 0x60
+        &&op_PUSH, &&op_PUSH, &&op_PUSH, &&op_PUSH, &&op_PUSH, &&op_PUSH, &&op_PUSH, &&op_PUSH,
+        &&op_PUSH, &&op_PUSH, &&op_PUSH, &&op_PUSH, &&op_PUSH, &&op_PUSH, &&op_PUSH, &&op_PUSH,
+        // 0x70
+        &&op_PUSH, &&op_PUSH, &&op_PUSH, &&op_PUSH, &&op_PUSH, &&op_PUSH, &&op_PUSH, &&op_PUSH,
+        &&op_PUSH, &&op_PUSH, &&op_PUSH, &&op_PUSH, &&op_PUSH, &&op_PUSH, &&op_PUSH, &&op_PUSH,
+        // 0x80
+        &&op_DUP1, &&op_undefined, &&op_undefined, &&op_undefined, &&op_undefined,
+        &&op_undefined, &&op_undefined, &&op_undefined, &&op_undefined, &&op_undefined,
+        &&op_undefined, &&op_undefined, &&op_undefined, &&op_undefined, &&op_undefined,
+        &&op_undefined,
+        // 0x90
+        &&op_SWAP1, &&op_undefined, &&op_undefined, &&op_undefined, &&op_undefined,
+        &&op_undefined, &&op_undefined, &&op_undefined, &&op_undefined, &&op_undefined,
+        &&op_undefined, &&op_undefined, &&op_undefined, &&op_undefined, &&op_undefined,
+        &&op_undefined,
+        // 0xA0
+        &&op_LOG, &&op_LOG, &&op_LOG, &&op_LOG, &&op_LOG, &&op_undefined, &&op_undefined,
+        &&op_undefined, &&op_undefined, &&op_undefined, &&op_undefined, &&op_undefined,
+        &&op_undefined, &&op_undefined, &&op_undefined, &&op_undefined,
+        // 0xB0
+        &&op_undefined, &&op_undefined, &&op_undefined, &&op_undefined, &&op_undefined,
+        &&op_undefined, &&op_undefined, &&op_undefined, &&op_undefined, &&op_undefined,
+        &&op_undefined, &&op_undefined, &&op_undefined, &&op_undefined, &&op_undefined,
+        &&op_undefined,
+        // 0xC0
+        &&op_undefined, &&op_undefined, &&op_undefined, &&op_undefined, &&op_undefined,
+        &&op_undefined, &&op_undefined, &&op_undefined, &&op_undefined, &&op_undefined,
+        &&op_undefined, &&op_undefined, &&op_undefined, &&op_undefined, &&op_undefined,
+        &&op_undefined,
+        // 0xD0
+        &&op_undefined, &&op_undefined, &&op_undefined, &&op_undefined, &&op_undefined,
+        &&op_undefined, &&op_undefined, &&op_undefined, &&op_undefined, &&op_undefined,
+        &&op_undefined, &&op_undefined, &&op_undefined, &&op_undefined, &&op_undefined,
+        &&op_undefined,
+        // 0xE0
+        &&op_undefined, &&op_undefined, &&op_undefined, &&op_undefined, &&op_undefined,
+        &&op_undefined, &&op_undefined, &&op_undefined, &&op_undefined, &&op_undefined,
+        &&op_undefined, &&op_undefined, &&op_undefined, &&op_undefined, &&op_undefined,
+        &&op_undefined,
+        // 0xF0
+        &&op_undefined, &&op_CALL, &&op_undefined, &&op_RETURN, &&op_undefined, &&op_undefined,
+        &&op_undefined, &&op_undefined, &&op_undefined, &&op_undefined, &&op_undefined,
+        &&op_undefined, &&op_undefined, &&op_REVERT, &&op_undefined, &&op_undefined,
+        // The superinstructions.
+        SI(PUSH_ADD), SI(PUSH_AND), SI(PUSH_OR), SI(PUSH_XOR), SI(PUSH_SHL), SI(PUSH_SHR),
+        SI(PUSH_SWAP1_SUB), SI(PUSH_MLOAD), SI(PUSH_MSTORE), SI(PUSH_SLOAD), SI(PUSH_JUMP),
+        SI(PUSH_JUMPI), SI(DUP1_PUSH_JUMPI), SI(DUP1_SWAP1), SI(SWAP1_POP),
+    };
+    END_LABELS_AS_VALUES
+#undef SI
+    if (UseComputedGoto)
+        DISPATCH();
+#endif
+
+    for (; pc < end_pc; ++pc)
+    {
+        // Check remaining gas.
+        if (!BlockCharging && (gas_left -= GAS_COST()) < 0)
             return qrvmc_make_result(QRVMC_OUT_OF_GAS, 0, 0, nullptr, 0);
 
-        switch (code[pc])
+        switch (OPCODE())
         {
         default:
+#if EXAMPLE_VM_COMPUTED_GOTO
+        op_undefined:
+#endif
             return qrvmc_make_result(QRVMC_UNDEFINED_INSTRUCTION, 0, 0, nullptr, 0);
 
-        case OP_STOP:
+        TARGET(OP_STOP, STOP):
+            frame.commit_logs(host, context, *msg);
             return qrvmc_make_result(QRVMC_SUCCESS, gas_left, 0, nullptr, 0);
 
-        case OP_ADD:
+        TARGET(OP_ADD, ADD):
         {
-            uint32_t a = to_uint32(stack.pop());
-            uint32_t b = to_uint32(stack.pop());
-            uint32_t sum = a + b;
-            stack.push(to_uint256(sum));
-            break;
+            const auto a = stack.pop();
+            const auto b = stack.pop();
+            stack.push(a + b);
+            NEXT();
         }
 
-        case OP_ADDRESS:
+        TARGET(OP_MUL, MUL):
         {
-            qrvmc_uint256be value = to_uint256(msg->recipient);
-            stack.push(value);
-            break;
+            const auto a = stack.pop();
+            const auto b = stack.pop();
+            stack.push(a * b);
+            NEXT();
         }
 
-        case OP_CALLDATALOAD:
+        TARGET(OP_SUB, SUB):
         {
-            uint32_t offset = to_uint32(stack.pop());
-            qrvmc_uint256be value = {};
+            const auto a = stack.pop();
+            const auto b = stack.pop();
+            stack.push(a - b);
+            NEXT();
+        }
+
+        TARGET(OP_DIV, DIV):
+        {
+            const auto a = stack.pop();
+            const auto b = stack.pop();
+            stack.push(a / b);
+            NEXT();
+        }
+
+        TARGET(OP_MOD, MOD):
+        {
+            const auto a = stack.pop();
+            const auto b = stack.pop();
+            stack.push(a % b);
+            NEXT();
+        }
+
+        TARGET(OP_LT, LT):
+        {
+            const auto a = stack.pop();
+            const auto b = stack.pop();
+            stack.push(a < b ? 1 : 0);
+            NEXT();
+        }
+
+        TARGET(OP_GT, GT):
+        {
+            const auto a = stack.pop();
+            const auto b = stack.pop();
+            stack.push(a > b ? 1 : 0);
+            NEXT();
+        }
+
+        TARGET(OP_EQ, EQ):
+        {
+            const auto a = stack.pop();
+            const auto b = stack.pop();
+            stack.push(a == b ? 1 : 0);
+            NEXT();
+        }
+
+        TARGET(OP_ISZERO, ISZERO):
+        {
+            const auto a = stack.pop();
+            stack.push(!a ? 1 : 0);
+            NEXT();
+        }
+
+        TARGET(OP_AND, AND):
+        {
+            const auto a = stack.pop();
+            const auto b = stack.pop();
+            stack.push(a & b);
+            NEXT();
+        }
+
+        TARGET(OP_OR, OR):
+        {
+            const auto a = stack.pop();
+            const auto b = stack.pop();
+            stack.push(a | b);
+            NEXT();
+        }
+
+        TARGET(OP_XOR, XOR):
+        {
+            const auto a = stack.pop();
+            const auto b = stack.pop();
+            stack.push(a ^ b);
+            NEXT();
+        }
+
+        TARGET(OP_NOT, NOT):
+        {
+            stack.push(~stack.pop());
+            NEXT();
+        }
+
+        TARGET(OP_SHL, SHL):
+        {
+            const auto s = stack.pop();
+            const auto value = stack.pop();
+            stack.push(shift(s, value, [](const qrvmc::uint256& v, uint64_t n) { return v << n; }));
+            NEXT();
+        }
+
+        TARGET(OP_SHR, SHR):
+        {
+            const auto s = stack.pop();
+            const auto value = stack.pop();
+            stack.push(shift(s, value, [](const qrvmc::uint256& v, uint64_t n) { return v >> n; }));
+            NEXT();
+        }
+
+        TARGET(OP_ADDRESS, ADDRESS):
+        {
+            stack.push(to_uint256(msg->recipient));
+            NEXT();
+        }
+
+        TARGET(OP_CALLDATALOAD, CALLDATALOAD):
+        {
+            const auto offset = to_memory_size(stack.pop());
+            qrvmc::uint256be value;
 
             if (offset < msg->input_size)
             {
-                size_t copy_size = std::min(msg->input_size - offset, sizeof(value));
+                const auto available = msg->input_size - static_cast<size_t>(offset);
+                const auto copy_size = std::min(available, sizeof(value));
                 std::memcpy(value.bytes, &msg->input_data[offset], copy_size);
             }
 
-            stack.push(value);
-            break;
+            stack.push(qrvmc::to_uint256(value));
+            NEXT();
         }
 
-        case OP_NUMBER:
+        TARGET(OP_CALLDATACOPY, CALLDATACOPY):
         {
-            qrvmc_uint256be value =
-                to_uint256(static_cast<uint32_t>(host->get_tx_context(context).block_number));
-            stack.push(value);
-            break;
+            const auto mem_offset = to_memory_size(stack.pop());
+            const auto input_offset = to_memory_size(stack.pop());
+            const auto size = to_memory_size(stack.pop());
+            uint8_t* p = memory.expand(mem_offset, size, gas_left);
+            if (p == nullptr)
+                return qrvmc_make_result(QRVMC_OUT_OF_GAS, 0, 0, nullptr, 0);
+
+            gas_left -= 3 * static_cast<int64_t>((size + 31) / 32);  // The copy cost.
+            if (gas_left < 0)
+                return qrvmc_make_result(QRVMC_OUT_OF_GAS, 0, 0, nullptr, 0);
+
+            size_t copy_size = 0;
+            if (input_offset < msg->input_size)
+            {
+                const auto available = msg->input_size - static_cast<size_t>(input_offset);
+                copy_size = std::min(available, static_cast<size_t>(size));
+            }
+            if (copy_size != 0)
+                std::memcpy(p, &msg->input_data[input_offset], copy_size);
+            std::memset(p + copy_size, 0, static_cast<size_t>(size) - copy_size);
+            NEXT();
         }
 
-        case OP_MSTORE:
+        TARGET(OP_BLOCKHASH, BLOCKHASH):
         {
-            uint32_t index = to_uint32(stack.pop());
-            qrvmc_uint256be value = stack.pop();
-            if (!memory.store(index, value.bytes, sizeof(value)))
-                return qrvmc_make_result(QRVMC_FAILURE, 0, 0, nullptr, 0);
-            break;
+            const auto number = static_cast<int64_t>(to_uint32(stack.pop()));
+            stack.push(qrvmc::to_uint256(host->get_block_hash(context, number)));
+            NEXT();
         }
 
-        case OP_SLOAD:
+        TARGET(OP_NUMBER, NUMBER):
         {
-            qrvmc_uint256be index = stack.pop();
-            qrvmc_uint256be value = host->get_storage(context, &msg->recipient, &index);
-            stack.push(value);
-            break;
+            const auto number = tx_context.get().block_number;
+            stack.push(static_cast<uint32_t>(number));
+            NEXT();
+        }
+
+        TARGET(OP_POP, POP):
+        {
+            stack.pop();
+            NEXT();
+        }
+
+        TARGET(OP_MLOAD, MLOAD):
+        {
+            const auto offset = to_memory_size(stack.pop());
+            const uint8_t* p = memory.expand(offset, 32, gas_left);
+            if (p == nullptr)
+                return qrvmc_make_result(QRVMC_OUT_OF_GAS, 0, 0, nullptr, 0);
+            qrvmc::uint256be value;
+            std::memcpy(value.bytes, p, sizeof(value));
+            stack.push(qrvmc::to_uint256(value));
+            NEXT();
+        }
+
+        TARGET(OP_MSTORE, MSTORE):
+        {
+            const auto offset = to_memory_size(stack.pop());
+            const auto value = qrvmc::to_uint256be(stack.pop());
+            uint8_t* p = memory.expand(offset, sizeof(value), gas_left);
+            if (p == nullptr)
+                return qrvmc_make_result(QRVMC_OUT_OF_GAS, 0, 0, nullptr, 0);
+            std::memcpy(p, value.bytes, sizeof(value));
+            NEXT();
         }
 
-        case OP_SSTORE:
+        TARGET(OP_SLOAD, SLOAD):
         {
-            qrvmc_uint256be index = stack.pop();
-            qrvmc_uint256be value = stack.pop();
+            const qrvmc_bytes32 index = qrvmc::to_uint256be(stack.pop());
+            stack.push(qrvmc::to_uint256(host->get_storage(context, &msg->recipient, &index)));
+            NEXT();
+        }
+
+        TARGET(OP_SSTORE, SSTORE):
+        {
+            const qrvmc_bytes32 index = qrvmc::to_uint256be(stack.pop());
+            const qrvmc_bytes32 value = qrvmc::to_uint256be(stack.pop());
             host->set_storage(context, &msg->recipient, &index, &value);
-            break;
+            NEXT();
         }
 
-        case OP_MSIZE:
+        TARGET(OP_JUMP, JUMP):
         {
-            qrvmc_uint256be value = to_uint256(memory.size);
-            stack.push(value);
-            break;
+            uint32_t dst = to_uint32(stack.pop());
+            if (Fused)
+            {
+                const auto target = program->jump_target(dst);
+                if (target == no_jump_target)
+                    return qrvmc_make_result(QRVMC_BAD_JUMP_DESTINATION, 0, 0, nullptr, 0);
+                pc = size_t{target} - 1;  // The pc is incremented by NEXT().
+                NEXT();
+            }
+            // Simplification: the JUMPDEST inside push data is not rejected,
+            // unless the code has been analyzed for the block charging.
+            if (dst >= code_size ||
+                (BlockCharging ? !blocks[dst].is_jumpdest : code[dst] != OP_JUMPDEST))
+                return qrvmc_make_result(QRVMC_BAD_JUMP_DESTINATION, 0, 0, nullptr, 0);
+            pc = size_t{dst} - 1;  // The pc is incremented by NEXT().
+            NEXT();
+        }
+
+        TARGET(OP_JUMPI, JUMPI):
+        {
+            uint32_t dst = to_uint32(stack.pop());
+            const auto condition = stack.pop();
+            if (Fused && condition)
+            {
+                const auto target = program->jump_target(dst);
+                if (target == no_jump_target)
+                    return qrvmc_make_result(QRVMC_BAD_JUMP_DESTINATION, 0, 0, nullptr, 0);
+                pc = size_t{target} - 1;  // The pc is incremented by NEXT().
+            }
+            else if (condition)
+            {
+                if (dst >= code_size ||
+                    (BlockCharging ? !blocks[dst].is_jumpdest : code[dst] != OP_JUMPDEST))
+                    return qrvmc_make_result(QRVMC_BAD_JUMP_DESTINATION, 0, 0, nullptr, 0);
+                pc = size_t{dst} - 1;  // The pc is incremented by NEXT().
+            }
+            else if (BlockCharging && pc + 1 < code_size && !blocks[pc + 1].is_jumpdest)
+                ENTER_BLOCK(blocks[pc + 1]);
+            NEXT();
+        }
+
+        TARGET(OP_MSIZE, MSIZE):
+        {
+            stack.push(memory.size());
+            NEXT();
+        }
+
+        TARGET(OP_JUMPDEST, JUMPDEST):
+        {
+            if (BlockCharging)
+                ENTER_BLOCK(blocks[pc]);
+            NEXT();
         }
 
         case OP_PUSH1:
@@ -293,85 +1418,333 @@ qrvmc_result execute(qrvmc_vm* instance,
         case OP_PUSH29:
         case OP_PUSH30:
         case OP_PUSH31:
-        case OP_PUSH32:
+        TARGET(OP_PUSH32, PUSH):
         {
-            qrvmc_uint256be value = {};
+            if (Fused)
+            {
+                stack.push(values[instructions[pc].arg]);
+                NEXT();
+            }
+            qrvmc::uint256be value;
             size_t num_push_bytes = size_t{code[pc]} - OP_PUSH1 + 1;
             size_t offset = sizeof(value) - num_push_bytes;
             std::memcpy(&value.bytes[offset], &code[pc + 1], num_push_bytes);
             pc += num_push_bytes;
-            stack.push(value);
-            break;
+            stack.push(qrvmc::to_uint256(value));
+            NEXT();
         }
 
-        case OP_DUP1:
+        TARGET(OP_DUP1, DUP1):
         {
-            qrvmc_uint256be value = stack.pop();
+            const auto value = stack.pop();
             stack.push(value);
             stack.push(value);
-            break;
+            NEXT();
+        }
+
+        TARGET(OP_SWAP1, SWAP1):
+        {
+            const auto a = stack.pop();
+            const auto b = stack.pop();
+            stack.push(a);
+            stack.push(b);
+            NEXT();
         }
 
-        case OP_CALL:
+        case OP_LOG0:
+        case OP_LOG1:
+        case OP_LOG2:
+        case OP_LOG3:
+        TARGET(OP_LOG4, LOG):
+        {
+            const auto offset = to_memory_size(stack.pop());
+            const auto size = to_memory_size(stack.pop());
+            const uint8_t* data = memory.expand(offset, size, gas_left);
+            if (data == nullptr)
+                return qrvmc_make_result(QRVMC_OUT_OF_GAS, 0, 0, nullptr, 0);
+
+            const auto num_topics = static_cast<size_t>(OPCODE() - OP_LOG0);
+            qrvmc::bytes32 topics[4];
+            for (size_t i = 0; i < num_topics; ++i)
+                topics[i] = qrvmc::to_uint256be(stack.pop());
+            if ((msg->flags & QRVMC_HOST_EMIT_LOGS) != 0)
+                logs.append(msg->recipient, data, static_cast<size_t>(size), topics, num_topics);
+            else
+                host->emit_log(context, &msg->recipient, data, static_cast<size_t>(size),
+                               topics, num_topics);
+            NEXT();
+        }
+
+        TARGET(OP_CALL, CALL):
         {
             qrvmc_message call_msg = {};
+            // The host capabilities.
+            call_msg.flags = msg->flags & (QRVMC_HOST_TX_CONTEXT_PTR | QRVMC_HOST_EMIT_LOGS);
+            call_msg.depth = msg->depth + 1;
             call_msg.gas = to_uint32(stack.pop());
             call_msg.recipient = to_address(stack.pop());
-            call_msg.value = stack.pop();
+            call_msg.sender = msg->recipient;
+            call_msg.code_address = call_msg.recipient;
+            call_msg.value = qrvmc::to_uint256be(stack.pop());
 
-            uint32_t call_input_offset = to_uint32(stack.pop());
-            uint32_t call_input_size = to_uint32(stack.pop());
-            call_msg.input_data = memory.expand(call_input_offset, call_input_size);
-            call_msg.input_size = call_input_size;
+            const auto call_input_offset = to_memory_size(stack.pop());
+            const auto call_input_size = to_memory_size(stack.pop());
+            call_msg.input_data = memory.expand(call_input_offset, call_input_size, gas_left);
+            call_msg.input_size = static_cast<size_t>(call_input_size);
 
-            uint32_t call_output_offset = to_uint32(stack.pop());
-            uint32_t call_output_size = to_uint32(stack.pop());
-            uint8_t* call_output_ptr = memory.expand(call_output_offset, call_output_size);
+            const auto call_output_offset = to_memory_size(stack.pop());
+            auto call_output_size = to_memory_size(stack.pop());
+            uint8_t* call_output_ptr =
+                memory.expand(call_output_offset, call_output_size, gas_left);
 
             if (call_msg.input_data == nullptr || call_output_ptr == nullptr)
-                return qrvmc_make_result(QRVMC_FAILURE, 0, 0, nullptr, 0);
+                return qrvmc_make_result(QRVMC_OUT_OF_GAS, 0, 0, nullptr, 0);
 
+            // The call may be executed by another VM, emitting its logs to the host directly,
+            // so the logs so far are passed to the host first to keep the order.
+            logs.flush(host, context, *msg);
+            const auto logs_checkpoint = logs.size();
             qrvmc_result call_result = host->call(context, &call_msg);
+            if (call_result.status_code != QRVMC_SUCCESS)
+                logs.truncate(logs_checkpoint);  // Drop the logs of the failed call.
 
-            qrvmc_uint256be value = to_uint256(call_result.status_code == QRVMC_SUCCESS ? 1 : 0);
-            stack.push(value);
+            stack.push(call_result.status_code == QRVMC_SUCCESS ? 1 : 0);
 
             if (call_output_size > call_result.output_size)
-                call_output_size = static_cast<uint32_t>(call_result.output_size);
-            memory.store(call_output_offset, call_result.output_data, call_output_size);
+                call_output_size = call_result.output_size;
+            if (call_output_size != 0)
+                std::memcpy(call_output_ptr, call_result.output_data, call_output_size);
 
             if (call_result.release != nullptr)
                 call_result.release(&call_result);
-            break;
+            NEXT();
         }
 
-        case OP_RETURN:
+        TARGET(OP_RETURN, RETURN):
         {
-            uint32_t output_offset = to_uint32(stack.pop());
-            uint32_t output_size = to_uint32(stack.pop());
-            uint8_t* output_ptr = memory.expand(output_offset, output_size);
+            const auto output_offset = to_memory_size(stack.pop());
+            const auto output_size = to_memory_size(stack.pop());
+            const uint8_t* output_ptr = memory.expand(output_offset, output_size, gas_left);
             if (output_ptr == nullptr)
-                return qrvmc_make_result(QRVMC_FAILURE, 0, 0, nullptr, 0);
+                return qrvmc_make_result(QRVMC_OUT_OF_GAS, 0, 0, nullptr, 0);
 
-            return qrvmc_make_result(QRVMC_SUCCESS, gas_left, 0, output_ptr, output_size);
+            frame.commit_logs(host, context, *msg);
+            return qrvmc_make_result(QRVMC_SUCCESS, gas_left, 0, output_ptr,
+                                     static_cast<size_t>(output_size));
         }
 
-        case OP_REVERT:
+        TARGET(OP_REVERT, REVERT):
         {
-            uint32_t output_offset = to_uint32(stack.pop());
-            uint32_t output_size = to_uint32(stack.pop());
-            uint8_t* output_ptr = memory.expand(output_offset, output_size);
+            const auto output_offset = to_memory_size(stack.pop());
+            const auto output_size = to_memory_size(stack.pop());
+            const uint8_t* output_ptr = memory.expand(output_offset, output_size, gas_left);
             if (output_ptr == nullptr)
-                return qrvmc_make_result(QRVMC_FAILURE, 0, 0, nullptr, 0);
+                return qrvmc_make_result(QRVMC_OUT_OF_GAS, 0, 0, nullptr, 0);
+
+            return qrvmc_make_result(QRVMC_REVERT, gas_left, 0, output_ptr,
+                                     static_cast<size_t>(output_size));
+        }
+
+        // The superinstructions, executed only in the fusion mode.
+
+        TARGET(SI_PUSH_ADD, PUSH_ADD):
+        {
+            auto& top = stack.pointer[-1];
+            top = top + values[instructions[pc].arg];
+            NEXT();
+        }
+
+        TARGET(SI_PUSH_AND, PUSH_AND):
+        {
+            auto& top = stack.pointer[-1];
+            top = top & values[instructions[pc].arg];
+            NEXT();
+        }
+
+        TARGET(SI_PUSH_OR, PUSH_OR):
+        {
+            auto& top = stack.pointer[-1];
+            top = top | values[instructions[pc].arg];
+            NEXT();
+        }
+
+        TARGET(SI_PUSH_XOR, PUSH_XOR):
+        {
+            auto& top = stack.pointer[-1];
+            top = top ^ values[instructions[pc].arg];
+            NEXT();
+        }
+
+        TARGET(SI_PUSH_SHL, PUSH_SHL):
+        {
+            auto& top = stack.pointer[-1];
+            top = shift(values[instructions[pc].arg], top,
+                        [](const qrvmc::uint256& v, uint64_t n) { return v << n; });
+            NEXT();
+        }
+
+        TARGET(SI_PUSH_SHR, PUSH_SHR):
+        {
+            auto& top = stack.pointer[-1];
+            top = shift(values[instructions[pc].arg], top,
+                        [](const qrvmc::uint256& v, uint64_t n) { return v >> n; });
+            NEXT();
+        }
+
+        TARGET(SI_PUSH_SWAP1_SUB, PUSH_SWAP1_SUB):
+        {
+            auto& top = stack.pointer[-1];
+            top = top - values[instructions[pc].arg];
+            NEXT();
+        }
 
-            return qrvmc_make_result(QRVMC_REVERT, gas_left, 0, output_ptr, output_size);
+        TARGET(SI_PUSH_MLOAD, PUSH_MLOAD):
+        {
+            const auto offset = to_memory_size(values[instructions[pc].arg]);
+            const uint8_t* p = memory.expand(offset, 32, gas_left);
+            if (p == nullptr)
+                return qrvmc_make_result(QRVMC_OUT_OF_GAS, 0, 0, nullptr, 0);
+            qrvmc::uint256be value;
+            std::memcpy(value.bytes, p, sizeof(value));
+            stack.push(qrvmc::to_uint256(value));
+            NEXT();
+        }
+
+        TARGET(SI_PUSH_MSTORE, PUSH_MSTORE):
+        {
+            const auto offset = to_memory_size(values[instructions[pc].arg]);
+            const auto value = qrvmc::to_uint256be(stack.pop());
+            uint8_t* p = memory.expand(offset, sizeof(value), gas_left);
+            if (p == nullptr)
+                return qrvmc_make_result(QRVMC_OUT_OF_GAS, 0, 0, nullptr, 0);
+            std::memcpy(p, value.bytes, sizeof(value));
+            NEXT();
+        }
+
+        TARGET(SI_PUSH_SLOAD, PUSH_SLOAD):
+        {
+            const qrvmc_bytes32 index = qrvmc::to_uint256be(values[instructions[pc].arg]);
+            stack.push(qrvmc::to_uint256(host->get_storage(context, &msg->recipient, &index)));
+            NEXT();
+        }
+
+        TARGET(SI_PUSH_JUMP, PUSH_JUMP):
+        {
+            const auto target = instructions[pc].arg;
+            if (target == no_jump_target)
+                return qrvmc_make_result(QRVMC_BAD_JUMP_DESTINATION, 0, 0, nullptr, 0);
+            pc = size_t{target} - 1;  // The pc is incremented by NEXT().
+            NEXT();
+        }
+
+        TARGET(SI_PUSH_JUMPI, PUSH_JUMPI):
+        {
+            if (stack.pop())
+            {
+                const auto target = instructions[pc].arg;
+                if (target == no_jump_target)
+                    return qrvmc_make_result(QRVMC_BAD_JUMP_DESTINATION, 0, 0, nullptr, 0);
+                pc = size_t{target} - 1;  // The pc is incremented by NEXT().
+            }
+            NEXT();
+        }
+
+        TARGET(SI_DUP1_PUSH_JUMPI, DUP1_PUSH_JUMPI):
+        {
+            if (stack.pointer[-1])
+            {
+                const auto target = instructions[pc].arg;
+                if (target == no_jump_target)
+                    return qrvmc_make_result(QRVMC_BAD_JUMP_DESTINATION, 0, 0, nullptr, 0);
+                pc = size_t{target} - 1;  // The pc is incremented by NEXT().
+            }
+            NEXT();
+        }
+
+        TARGET(SI_DUP1_SWAP1, DUP1_SWAP1):
+        {
+            stack.push(stack.pointer[-1]);
+            NEXT();
+        }
+
+        TARGET(SI_SWAP1_POP, SWAP1_POP):
+        {
+            stack.pointer[-2] = stack.pointer[-1];
+            --stack.pointer;
+            NEXT();
         }
         }
     }
 
+#if EXAMPLE_VM_COMPUTED_GOTO
+end:
+#endif
+    frame.commit_logs(host, context, *msg);
     return qrvmc_make_result(QRVMC_SUCCESS, gas_left, 0, nullptr, 0);
 }
 
+/// Executes the code with the interpreter instantiated for the revision and the VM options.
+qrvmc_result run(ExampleVM* vm,
+                 const qrvmc_host_interface* host,
+                 qrvmc_host_context* context,
+                 enum qrvmc_revision rev,
+                 const qrvmc_message* msg,
+                 const uint8_t* code,
+                 size_t code_size)
+{
+    // The prepared code is kept alive by the execution, even if evicted from the cache.
+    const auto program = vm->fusion ? vm->get_prepared(code, code_size) : nullptr;
+
+    return qrvmc::dispatch_revision(rev, [&](auto revision) {
+        constexpr auto Rev = decltype(revision)::value;
+        if (program != nullptr)
+        {
+            if (vm->computed_goto)
+                return interpret<Rev, true, false, true>(host, context, msg, code, code_size,
+                                                         program.get());
+            return interpret<Rev, false, false, true>(host, context, msg, code, code_size,
+                                                      program.get());
+        }
+        if (vm->block_charging)
+        {
+            if (vm->computed_goto)
+                return interpret<Rev, true, true, false>(host, context, msg, code, code_size,
+                                                         nullptr);
+            return interpret<Rev, false, true, false>(host, context, msg, code, code_size,
+                                                      nullptr);
+        }
+        if (vm->computed_goto)
+            return interpret<Rev, true, false, false>(host, context, msg, code, code_size,
+                                                      nullptr);
+        return interpret<Rev, false, false, false>(host, context, msg, code, code_size, nullptr);
+    });
+}
+
+/// The example implementation of the qrvmc_vm::execute() method.
+qrvmc_result execute(qrvmc_vm* instance,
+                     const qrvmc_host_interface* host,
+                     qrvmc_host_context* context,
+                     enum qrvmc_revision rev,
+                     const qrvmc_message* msg,
+                     const uint8_t* code,
+                     size_t code_size)
+{
+    auto* vm = static_cast<ExampleVM*>(instance);
+
+    if (vm->verbose > 0)
+        std::puts("execution started\n");
+
+    // The allocation failures (of the frame, the prepared code or the basic blocks) must not
+    // escape the C API. The execution fails as if it could not pay for the resources.
+    try
+    {
+        return run(vm, host, context, rev, msg, code, code_size);
+    }
+    catch (const std::bad_alloc&)
+    {
+        return qrvmc_make_result(QRVMC_OUT_OF_GAS, 0, 0, nullptr, 0);
+    }
+}
 
 /// @cond internal
 #if !defined(PROJECT_VERSION)
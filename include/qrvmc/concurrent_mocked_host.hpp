@@ -0,0 +1,422 @@
+// EVMC: Ethereum Client-VM Connector API.
+// Copyright 2026 The EVMC Authors.
+// Licensed under the Apache License, Version 2.0.
+#pragma once
+
+#include <qrvmc/mocked_host.hpp>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <thread>
+#include <unordered_set>
+
+namespace qrvmc
+{
+/// Mocked QRVMC Host implementation safe to be shared by concurrently executing VMs.
+///
+/// The account state is the same as in MockedHost, but it is split into shards selected
+/// by the address hash. Each shard is protected by its own reader-writer lock so accesses
+/// to different accounts rarely contend and concurrent reads of the same account never block.
+///
+/// All recordings (account accesses, calls, LOGs and block hash requests) are appended
+/// to buffers owned by the calling thread, so recording requires no synchronization.
+/// The buffers of all threads are merged on demand by the recorded_*() methods.
+/// These methods, as well as clear_recordings(), MUST NOT be invoked while any execution
+/// using this host is in progress.
+///
+/// The EIP-2929 account access status is tracked per thread, i.e. each thread is assumed to
+/// execute its own transaction. The storage access status is kept in the shared state.
+class ConcurrentMockedHost : public Host
+{
+public:
+    /// LOG record.
+    using log_record = MockedHost::log_record;
+
+    /// The number of state shards.
+    static constexpr size_t num_shards = 64;
+
+    /// The QRVMC transaction context to be returned by get_tx_context().
+    /// Must not be modified while any execution is in progress.
+    qrvmc_tx_context tx_context = {};
+
+    /// The block header hash value to be returned by get_block_hash()
+    /// for the blocks without hashes in ConcurrentMockedHost::block_hashes.
+    /// Must not be modified while any execution is in progress.
+    bytes32 block_hash = {};
+
+    /// The hashes of the recent blocks to be returned by get_block_hash().
+    /// Must not be modified while any execution is in progress.
+    BlockHashes block_hashes;
+
+    /// Controls whether get_block_hash() calls are recorded, see MockedHost::record_blockhashes.
+    /// Must not be modified while any execution is in progress.
+    bool record_blockhashes = true;
+
+    /// The call result to be returned by the call() method.
+    /// Must not be modified while any execution is in progress.
+    qrvmc_result call_result = {};
+
+    /// The maximum number of entries in the account accesses record of a single thread.
+    static constexpr auto max_recorded_account_accesses = MockedHost::max_recorded_account_accesses;
+
+    /// The maximum number of entries in the calls record of a single thread.
+    static constexpr auto max_recorded_calls = MockedHost::max_recorded_calls;
+
+    /// The highest id of the precompiled contracts known to the host.
+    static constexpr auto max_precompile_id = MockedHost::max_precompile_id;
+
+    /// The flags of the optional host interface members provided by the host,
+    /// to be set in the messages of the executions with this host.
+    static constexpr auto host_flags = MockedHost::host_flags;
+
+private:
+    /// The state shard: a subset of accounts guarded by a reader-writer lock.
+    struct alignas(64) Shard
+    {
+        mutable std::shared_mutex mutex;
+        std::unordered_map<address, MockedAccount> accounts;
+    };
+
+    /// The recordings of a single thread.
+    struct Recording
+    {
+        std::thread::id owner;
+        std::vector<address> account_accesses;
+        std::unordered_set<address> accessed_accounts;
+        std::vector<qrvmc_message> calls;
+        std::vector<log_record> logs;
+        std::vector<int64_t> blockhashes;
+        RecordingArena arena;
+    };
+
+    /// The unique id of this host instance used to validate thread-local caches.
+    const uint64_t m_id = next_id();
+
+    std::array<Shard, num_shards> m_shards;
+
+    /// The registry of per-thread recordings. Only locked when a thread uses the host
+    /// for the first time and when the recordings are merged.
+    mutable std::mutex m_recordings_mutex;
+    mutable std::vector<std::unique_ptr<Recording>> m_recordings;
+
+    static uint64_t next_id() noexcept
+    {
+        static std::atomic<uint64_t> counter{0};
+        return ++counter;
+    }
+
+    Shard& shard(const address& addr) noexcept
+    {
+        return m_shards[std::hash<address>{}(addr) % num_shards];
+    }
+
+    const Shard& shard(const address& addr) const noexcept
+    {
+        return m_shards[std::hash<address>{}(addr) % num_shards];
+    }
+
+    /// Returns the recordings of the calling thread, registering them on the first use.
+    Recording& local_recording() const
+    {
+        thread_local uint64_t cached_id = 0;
+        thread_local Recording* cached = nullptr;
+        if (cached_id == m_id)
+            return *cached;
+
+        const std::lock_guard lock{m_recordings_mutex};
+        const auto this_thread = std::this_thread::get_id();
+        const auto it =
+            std::find_if(m_recordings.begin(), m_recordings.end(),
+                         [this_thread](const auto& r) { return r->owner == this_thread; });
+        if (it != m_recordings.end())
+        {
+            cached = it->get();
+        }
+        else
+        {
+            auto recording = std::make_unique<Recording>();
+            recording->owner = this_thread;
+            recording->account_accesses.reserve(max_recorded_account_accesses);
+            recording->calls.reserve(max_recorded_calls);
+            cached = m_recordings.emplace_back(std::move(recording)).get();
+        }
+        cached_id = m_id;
+        return *cached;
+    }
+
+    /// Record an account access.
+    /// @param addr  The address of the accessed account.
+    void record_account_access(const address& addr) const
+    {
+        auto& accesses = local_recording().account_accesses;
+        if (accesses.size() < max_recorded_account_accesses)
+            accesses.emplace_back(addr);
+    }
+
+    /// Concatenates the given recorded vector of all threads.
+    template <typename T>
+    std::vector<T> merge(std::vector<T> Recording::*member) const
+    {
+        const std::lock_guard lock{m_recordings_mutex};
+        std::vector<T> out;
+        for (const auto& r : m_recordings)
+            out.insert(out.end(), ((*r).*member).begin(), ((*r).*member).end());
+        return out;
+    }
+
+public:
+    /// Inserts or replaces the account at the given address.
+    void set_account(const address& addr, MockedAccount account)
+    {
+        auto& s = shard(addr);
+        const std::unique_lock lock{s.mutex};
+        s.accounts[addr] = std::move(account);
+    }
+
+    /// Returns the copy of the account at the given address, if it exists.
+    std::optional<MockedAccount> get_account(const address& addr) const
+    {
+        const auto& s = shard(addr);
+        const std::shared_lock lock{s.mutex};
+        const auto it = s.accounts.find(addr);
+        if (it == s.accounts.end())
+            return std::nullopt;
+        return it->second;
+    }
+
+    /// Invokes @p fn with the reference to the account at the given address
+    /// (created if not present) while holding the exclusive lock of its shard.
+    template <typename Fn>
+    decltype(auto) update_account(const address& addr, Fn&& fn)
+    {
+        auto& s = shard(addr);
+        const std::unique_lock lock{s.mutex};
+        return std::forward<Fn>(fn)(s.accounts[addr]);
+    }
+
+    /// Returns the record of account accesses of all threads.
+    std::vector<address> recorded_account_accesses() const
+    {
+        return merge(&Recording::account_accesses);
+    }
+
+    /// Returns the record of call messages of all threads.
+    ///
+    /// The input data of the messages stays valid until clear_recordings() is invoked.
+    std::vector<qrvmc_message> recorded_calls() const { return merge(&Recording::calls); }
+
+    /// Returns the record of LOGs of all threads.
+    ///
+    /// The data and topics of the LOGs stay valid until clear_recordings() is invoked.
+    std::vector<log_record> recorded_logs() const { return merge(&Recording::logs); }
+
+    /// Returns the record of block numbers for which get_block_hash() was called in all threads.
+    std::vector<int64_t> recorded_blockhashes() const { return merge(&Recording::blockhashes); }
+
+    /// Clears the recordings of all threads, including the account access statuses.
+    void clear_recordings()
+    {
+        const std::lock_guard lock{m_recordings_mutex};
+        for (auto& r : m_recordings)
+        {
+            r->account_accesses.clear();
+            r->accessed_accounts.clear();
+            r->calls.clear();
+            r->logs.clear();
+            r->blockhashes.clear();
+            r->arena.reset();
+        }
+    }
+
+    /// Returns true if an account exists (QRVMC Host method).
+    bool account_exists(const address& addr) const noexcept override
+    {
+        record_account_access(addr);
+        const auto& s = shard(addr);
+        const std::shared_lock lock{s.mutex};
+        return s.accounts.count(addr) != 0;
+    }
+
+    /// Get the account's storage value at the given key (QRVMC Host method).
+    bytes32 get_storage(const address& addr, const bytes32& key) const noexcept override
+    {
+        record_account_access(addr);
+        const auto& s = shard(addr);
+        const std::shared_lock lock{s.mutex};
+
+        const auto account_iter = s.accounts.find(addr);
+        if (account_iter == s.accounts.end())
+            return {};
+
+        const auto storage_iter = account_iter->second.storage.find(key);
+        if (storage_iter != account_iter->second.storage.end())
+            return storage_iter->second.current;
+        return {};
+    }
+
+    /// Set the account's storage value (QRVMC Host method).
+    qrvmc_storage_status set_storage(const address& addr,
+                                     const bytes32& key,
+                                     const bytes32& value) noexcept override
+    {
+        record_account_access(addr);
+        auto& s = shard(addr);
+        const std::unique_lock lock{s.mutex};
+        return update_storage_value(s.accounts[addr].storage[key], value);
+    }
+
+    /// Get the account's balance (QRVMC Host method).
+    uint256be get_balance(const address& addr) const noexcept override
+    {
+        record_account_access(addr);
+        const auto& s = shard(addr);
+        const std::shared_lock lock{s.mutex};
+        const auto it = s.accounts.find(addr);
+        if (it == s.accounts.end())
+            return {};
+        return it->second.balance;
+    }
+
+    /// Get the account's code size (QRVMC host method).
+    size_t get_code_size(const address& addr) const noexcept override
+    {
+        record_account_access(addr);
+        const auto& s = shard(addr);
+        const std::shared_lock lock{s.mutex};
+        const auto it = s.accounts.find(addr);
+        if (it == s.accounts.end())
+            return 0;
+        return it->second.code.size();
+    }
+
+    /// Get the account's code hash (QRVMC host method).
+    bytes32 get_code_hash(const address& addr) const noexcept override
+    {
+        record_account_access(addr);
+        const auto& s = shard(addr);
+        const std::shared_lock lock{s.mutex};
+        const auto it = s.accounts.find(addr);
+        if (it == s.accounts.end())
+            return {};
+        return it->second.codehash;
+    }
+
+    /// Copy the account's code to the given buffer (QRVMC host method).
+    size_t copy_code(const address& addr,
+                     size_t code_offset,
+                     uint8_t* buffer_data,
+                     size_t buffer_size) const noexcept override
+    {
+        record_account_access(addr);
+        const auto& s = shard(addr);
+        const std::shared_lock lock{s.mutex};
+        const auto it = s.accounts.find(addr);
+        if (it == s.accounts.end())
+            return 0;
+
+        const auto& code = it->second.code;
+
+        if (code_offset >= code.size())
+            return 0;
+
+        const auto n = std::min(buffer_size, code.size() - code_offset);
+
+        if (n > 0)
+            std::copy_n(&code[code_offset], n, buffer_data);
+        return n;
+    }
+
+    /// Call/create other contract (QRVMC host method).
+    Result call(const qrvmc_message& msg) noexcept override
+    {
+        record_account_access(msg.recipient);
+
+        auto& r = local_recording();
+        if (r.calls.size() < max_recorded_calls)
+        {
+            r.calls.emplace_back(msg);
+            auto& call_msg = r.calls.back();
+            call_msg.input_data = r.arena.copy(call_msg.input_data, call_msg.input_size);
+        }
+        return Result{call_result};
+    }
+
+    /// Get transaction context (QRVMC host method).
+    qrvmc_tx_context get_tx_context() const noexcept override { return tx_context; }
+
+    /// Get transaction context pointer (QRVMC host method).
+    const qrvmc_tx_context* get_tx_context_ptr() const noexcept override { return &tx_context; }
+
+    /// Get the block header hash (QRVMC host method).
+    bytes32 get_block_hash(int64_t block_number) const noexcept override
+    {
+        if (record_blockhashes)
+            local_recording().blockhashes.emplace_back(block_number);
+        const auto hash = block_hashes.find(block_number);
+        return hash != nullptr ? *hash : block_hash;
+    }
+
+    /// Emit LOG (QRVMC host method).
+    void emit_log(const address& addr,
+                  const uint8_t* data,
+                  size_t data_size,
+                  const bytes32 topics[],
+                  size_t topics_count) noexcept override
+    {
+        auto& r = local_recording();
+        r.logs.push_back({addr, {r.arena.copy(data, data_size), data_size},
+                          {r.arena.copy(topics, topics_count), topics_count}});
+    }
+
+    /// Emit the batch of LOGs (QRVMC host method).
+    ///
+    /// Records the logs as emit_log() does, but looks up the thread's recording once.
+    void emit_logs(const qrvmc_log* logs, size_t num_logs) noexcept override
+    {
+        auto& r = local_recording();
+        for (size_t i = 0; i < num_logs; ++i)
+        {
+            const auto& log = logs[i];
+            const auto* topics = static_cast<const bytes32*>(log.topics);
+            r.logs.push_back({log.address,
+                              {r.arena.copy(log.data, log.data_size), log.data_size},
+                              {r.arena.copy(topics, log.topics_count), log.topics_count}});
+        }
+    }
+
+    /// Record an account access.
+    ///
+    /// Works as MockedHost::access_account() except the set of accessed accounts
+    /// is kept per thread.
+    qrvmc_access_status access_account(const address& addr) noexcept override
+    {
+        auto& r = local_recording();
+        const auto already_accessed = !r.accessed_accounts.insert(addr).second;
+
+        record_account_access(addr);
+
+        // Accessing precompiled contracts is always warm.
+        const auto id = precompile_id(addr);
+        if (id != 0 && id <= max_precompile_id)
+            return QRVMC_ACCESS_WARM;
+
+        return already_accessed ? QRVMC_ACCESS_WARM : QRVMC_ACCESS_COLD;
+    }
+
+    /// Access the account's storage value at the given key.
+    ///
+    /// Works as MockedHost::access_storage().
+    qrvmc_access_status access_storage(const address& addr, const bytes32& key) noexcept override
+    {
+        auto& s = shard(addr);
+        const std::unique_lock lock{s.mutex};
+        auto& value = s.accounts[addr].storage[key];
+        const auto access_status = value.access_status;
+        value.access_status = QRVMC_ACCESS_WARM;
+        return access_status;
+    }
+};
+}  // namespace qrvmc
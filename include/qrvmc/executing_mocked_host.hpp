@@ -0,0 +1,296 @@
+// EVMC: Ethereum Client-VM Connector API.
+// Copyright 2026 The EVMC Authors.
+// Licensed under the Apache License, Version 2.0.
+#pragma once
+
+#include <qrvmc/mocked_host.hpp>
+
+namespace qrvmc
+{
+/// Mocked QRVMC Host implementation executing nested calls with a real VM.
+///
+/// Instead of returning the canned MockedHost::call_result, the call() method executes
+/// the code of the callee (or the init code for contract creation) with the provided VM.
+/// The value is transferred between accounts and all state modifications of a failed call
+/// and the logs recorded in it are reverted. The state journal and the call-frame stack
+/// are preallocated for the maximum call depth so nested execution does not allocate
+/// in the common case.
+///
+/// The created contract addresses are a deterministic function of the sender and the nonce
+/// (or the salt and the init code for ::QRVMC_CREATE2), but not the ones from the specification.
+/// The EIP-2929 account access status is not reverted. The executed messages have
+/// the MockedHost::host_flags set.
+class ExecutingMockedHost : public MockedHost
+{
+public:
+    /// The maximum depth of nested calls.
+    static constexpr int max_depth = 1024;
+
+    /// Constructs the host executing nested calls with @p vm in the @p rev revision.
+    /// The VM is not owned and must outlive the host.
+    ExecutingMockedHost(VM& vm, qrvmc_revision rev) : m_vm{vm}, m_rev{rev}
+    {
+        m_frames.reserve(max_depth + 1);
+        m_journal.reserve(4 * (max_depth + 1));
+    }
+
+    /// Returns the current depth of nested calls executed by the host.
+    size_t depth() const noexcept { return m_frames.size(); }
+
+    /// Set the account's storage value (QRVMC Host method).
+    qrvmc_storage_status set_storage(const address& addr,
+                                     const bytes32& key,
+                                     const bytes32& value) noexcept override
+    {
+        journal_storage(addr, key);
+        return MockedHost::set_storage(addr, key, value);
+    }
+
+    /// Access the account's storage value at the given key (QRVMC Host method).
+    qrvmc_access_status access_storage(const address& addr, const bytes32& key) noexcept override
+    {
+        journal_storage(addr, key);
+        return MockedHost::access_storage(addr, key);
+    }
+
+    /// Call/create other contract (QRVMC host method).
+    ///
+    /// The call is executed in a new call frame. In case of failure the state modifications
+    /// of the frame are reverted.
+    Result call(const qrvmc_message& msg) noexcept override
+    {
+        record_call(msg);
+
+        if (msg.depth > max_depth)
+            return Result{QRVMC_CALL_DEPTH_EXCEEDED};
+
+        const bool is_create = msg.kind == QRVMC_CREATE || msg.kind == QRVMC_CREATE2;
+        auto new_address = address{};
+        if (is_create)
+        {
+            // The sender's nonce is bumped even if the creation fails.
+            auto& sender = journal_account(msg.sender, JournalEntry::nonce);
+            new_address = derive_create_address(msg, sender.nonce);
+            ++sender.nonce;
+        }
+
+        m_frames.push_back({m_journal.size(), recorded_logs.size()});
+        auto result = is_create ? execute_create(msg, new_address) : execute_call(msg);
+        if (result.status_code != QRVMC_SUCCESS)
+            revert(m_frames.back());
+        m_frames.pop_back();
+
+        // The modifications of the outermost frame are final, the journal can be rewound.
+        if (m_frames.empty())
+            m_journal.clear();
+        return result;
+    }
+
+private:
+    /// The entry of the journal of state modifications.
+    struct JournalEntry
+    {
+        enum Kind
+        {
+            created,  ///< The account has been created.
+            storage,  ///< The storage entry has been modified.
+            balance,  ///< The balance has been modified.
+            nonce,    ///< The nonce has been modified.
+            code,     ///< The code has been modified.
+        };
+
+        Kind kind;
+        address addr;
+        bytes32 key;
+        bool existed = false;         ///< The storage entry existed.
+        StorageValue prev_storage{};  ///< The previous storage entry.
+        uint256be prev_balance{};     ///< The previous balance.
+        int prev_nonce = 0;           ///< The previous nonce.
+    };
+
+    VM& m_vm;
+    qrvmc_revision m_rev;
+
+    /// The state of the host at the start of the call frame.
+    struct Checkpoint
+    {
+        size_t journal_size;  ///< The size of the journal.
+        size_t logs_size;     ///< The number of the recorded logs.
+    };
+
+    /// The call-frame stack. Each frame is represented by the checkpoint at its start.
+    std::vector<Checkpoint> m_frames;
+
+    /// The journal of state modifications made in the nested call frames.
+    std::vector<JournalEntry> m_journal;
+
+    /// Records the state of the account (or its creation) in the journal and returns it.
+    /// Nothing is recorded outside of nested call frames, as there is nothing to revert to.
+    MockedAccount& journal_account(const address& addr, JournalEntry::Kind kind)
+    {
+        const auto it = accounts.find(addr);
+        if (it == accounts.end())
+        {
+            if (!m_frames.empty())
+                m_journal.push_back({JournalEntry::created, addr, {}});
+            return accounts[addr];
+        }
+
+        auto& acc = it->second;
+        if (!m_frames.empty())
+        {
+            auto& e = m_journal.emplace_back(JournalEntry{kind, addr, {}});
+            e.prev_balance = acc.balance;
+            e.prev_nonce = acc.nonce;
+        }
+        return acc;
+    }
+
+    /// Records the state of the storage entry in the journal.
+    void journal_storage(const address& addr, const bytes32& key)
+    {
+        if (m_frames.empty())
+            return;
+
+        const auto it = accounts.find(addr);
+        if (it == accounts.end())
+        {
+            m_journal.push_back({JournalEntry::created, addr, {}});
+            return;
+        }
+
+        auto& e = m_journal.emplace_back(JournalEntry{JournalEntry::storage, addr, key});
+        const auto& storage = it->second.storage;
+        const auto storage_it = storage.find(key);
+        if (storage_it != storage.end())
+        {
+            e.existed = true;
+            e.prev_storage = storage_it->second;
+        }
+    }
+
+    /// Reverts the state modifications recorded in the journal and drops the logs recorded
+    /// after the given checkpoint.
+    void revert(const Checkpoint& checkpoint) noexcept
+    {
+        if (recorded_logs.size() > checkpoint.logs_size)
+            recorded_logs.resize(checkpoint.logs_size);
+        while (m_journal.size() > checkpoint.journal_size)
+        {
+            const auto& e = m_journal.back();
+            switch (e.kind)
+            {
+            case JournalEntry::created:
+                accounts.erase(e.addr);
+                break;
+            case JournalEntry::storage:
+                if (e.existed)
+                    accounts[e.addr].storage[e.key] = e.prev_storage;
+                else
+                    accounts[e.addr].storage.erase(e.key);
+                break;
+            case JournalEntry::balance:
+                accounts[e.addr].balance = e.prev_balance;
+                break;
+            case JournalEntry::nonce:
+                accounts[e.addr].nonce = e.prev_nonce;
+                break;
+            case JournalEntry::code:
+                accounts[e.addr].code.clear();
+                accounts[e.addr].codehash = {};
+                break;
+            }
+            m_journal.pop_back();
+        }
+    }
+
+    /// Transfers the value between accounts. Returns false in case of insufficient balance.
+    bool transfer(const address& from, const address& to, const uint256be& value)
+    {
+        if (is_zero(value))
+            return true;
+
+        auto& sender = journal_account(from, JournalEntry::balance);
+        if (sender.balance < value)
+            return false;
+        sender.balance = to_uint256be(to_uint256(sender.balance) - to_uint256(value));
+
+        auto& recipient = journal_account(to, JournalEntry::balance);
+        recipient.balance = to_uint256be(to_uint256(recipient.balance) + to_uint256(value));
+        return true;
+    }
+
+    /// Executes the code of the callee of the message call.
+    Result execute_call(const qrvmc_message& msg)
+    {
+        if (msg.kind == QRVMC_CALL && !transfer(msg.sender, msg.recipient, msg.value))
+            return Result{QRVMC_INSUFFICIENT_BALANCE};
+
+        const auto it = accounts.find(msg.code_address);
+        if (it == accounts.end() || it->second.code.empty())
+            return Result{QRVMC_SUCCESS, msg.gas, 0};
+
+        // The reference to the code stays valid: the nodes of unordered_map are stable
+        // and the callee account cannot be erased by reverting the nested frames.
+        const auto& code = it->second.code;
+        auto call_msg = msg;
+        call_msg.flags |= host_flags;
+        return m_vm.execute(*this, m_rev, call_msg, code.data(), code.size());
+    }
+
+    /// Executes the init code of the contract creation and deploys the new contract.
+    Result execute_create(const qrvmc_message& msg, const address& new_address)
+    {
+        auto& acc = journal_account(new_address, JournalEntry::nonce);
+        if (acc.nonce != 0 || !acc.code.empty())
+            return Result{QRVMC_FAILURE, 0, 0, new_address};  // Address collision.
+        acc.nonce = 1;
+
+        if (!transfer(msg.sender, new_address, msg.value))
+            return Result{QRVMC_INSUFFICIENT_BALANCE, 0, 0, new_address};
+
+        auto create_msg = msg;
+        create_msg.recipient = new_address;
+        create_msg.input_data = nullptr;
+        create_msg.input_size = 0;
+        create_msg.flags |= host_flags;
+        auto result = m_vm.execute(*this, m_rev, create_msg, msg.input_data, msg.input_size);
+        if (result.status_code != QRVMC_SUCCESS)
+        {
+            result.create_address = new_address;
+            return result;
+        }
+
+        if (!m_frames.empty())
+            m_journal.push_back({JournalEntry::code, new_address, {}});
+        auto& created = accounts[new_address];
+        created.code.assign(result.output_data, result.output_size);
+        return Result{QRVMC_SUCCESS, result.gas_left, result.gas_refund, new_address};
+    }
+
+protected:
+    /// Derives the address of the contract created by @p msg from the sender with the given
+    /// @p nonce (before the creation).
+    static address derive_create_address(const qrvmc_message& msg, int nonce) noexcept
+    {
+        using namespace fnv;
+        auto h = fnv1a_by64(offset_basis, std::hash<address>{}(msg.sender));
+        if (msg.kind == QRVMC_CREATE2)
+        {
+            h = fnv1a_by64(h, std::hash<bytes32>{}(msg.create2_salt));
+            for (size_t i = 0; i < msg.input_size; ++i)
+                h = fnv1a_by64(h, msg.input_data[i]);
+        }
+        else
+            h = fnv1a_by64(h, static_cast<uint64_t>(nonce));
+
+        address addr;
+        for (size_t i = 0; i < sizeof(addr.bytes); ++i)
+        {
+            h = fnv1a_by64(h, i);
+            addr.bytes[i] = static_cast<uint8_t>(h >> 56);
+        }
+        return addr;
+    }
+};
+}  // namespace qrvmc
@@ -5,7 +5,11 @@
 
 #include <qrvmc/qrvmc.hpp>
 #include <algorithm>
+#include <array>
 #include <cassert>
+#include <cstring>
+#include <istream>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -44,6 +48,142 @@ struct StorageValue
     {}
 };
 
+/// Updates the current value of the storage entry @p s to @p value and returns
+/// the storage status as specified by EIP-2200.
+inline qrvmc_storage_status update_storage_value(StorageValue& s, const bytes32& value) noexcept
+{
+    // Follow the EIP-2200 specification as closely as possible.
+    // https://eips.ethereum.org/EIPS/eip-2200
+    // Warning: this is not the most efficient implementation. The storage status can be
+    // figured out by combining only 4 checks:
+    // - original != current (dirty)
+    // - original == value (restored)
+    // - current != 0
+    // - value != 0
+    const auto status = [&original = s.original, &current = s.current, &value]() {
+        // Clause 1 is irrelevant:
+        // 1. "If gasleft is less than or equal to gas stipend,
+        //    fail the current call frame with ‘out of gas’ exception"
+
+        // 2. "If current value equals new value (this is a no-op)"
+        if (current == value)
+        {
+            // "SLOAD_GAS is deducted"
+            return QRVMC_STORAGE_ASSIGNED;
+        }
+        // 3. "If current value does not equal new value"
+        else
+        {
+            // 3.1. "If original value equals current value
+            //      (this storage slot has not been changed by the current execution context)"
+            if (original == current)
+            {
+                // 3.1.1 "If original value is 0"
+                if (is_zero(original))
+                {
+                    // "SSTORE_SET_GAS is deducted"
+                    return QRVMC_STORAGE_ADDED;
+                }
+                // 3.1.2 "Otherwise"
+                else
+                {
+                    // "SSTORE_RESET_GAS gas is deducted"
+                    auto st = QRVMC_STORAGE_MODIFIED;
+
+                    // "If new value is 0"
+                    if (is_zero(value))
+                    {
+                        // "add SSTORE_CLEARS_SCHEDULE gas to refund counter"
+                        st = QRVMC_STORAGE_DELETED;
+                    }
+
+                    return st;
+                }
+            }
+            // 3.2. "If original value does not equal current value
+            //      (this storage slot is dirty),
+            //      SLOAD_GAS gas is deducted.
+            //      Apply both of the following clauses."
+            else
+            {
+                // Because we need to apply "both following clauses"
+                // we first collect information which clause is triggered
+                // then assign status code to combination of these clauses.
+                enum
+                {
+                    None = 0,
+                    RemoveClearsSchedule = 1 << 0,
+                    AddClearsSchedule = 1 << 1,
+                    RestoredBySet = 1 << 2,
+                    RestoredByReset = 1 << 3,
+                };
+                int triggered_clauses = None;
+
+                // 3.2.1. "If original value is not 0"
+                if (!is_zero(original))
+                {
+                    // 3.2.1.1. "If current value is 0"
+                    if (is_zero(current))
+                    {
+                        // "(also means that new value is not 0)"
+                        assert(!is_zero(value));
+                        // "remove SSTORE_CLEARS_SCHEDULE gas from refund counter"
+                        triggered_clauses |= RemoveClearsSchedule;
+                    }
+                    // 3.2.1.2. "If new value is 0"
+                    if (is_zero(value))
+                    {
+                        // "(also means that current value is not 0)"
+                        assert(!is_zero(current));
+                        // "add SSTORE_CLEARS_SCHEDULE gas to refund counter"
+                        triggered_clauses |= AddClearsSchedule;
+                    }
+                }
+
+                // 3.2.2. "If original value equals new value (this storage slot is reset)"
+                // Except: we use term 'storage slot restored'.
+                if (original == value)
+                {
+                    // 3.2.2.1. "If original value is 0"
+                    if (is_zero(original))
+                    {
+                        // "add SSTORE_SET_GAS - SLOAD_GAS to refund counter"
+                        triggered_clauses |= RestoredBySet;
+                    }
+                    // 3.2.2.2. "Otherwise"
+                    else
+                    {
+                        // "add SSTORE_RESET_GAS - SLOAD_GAS gas to refund counter"
+                        triggered_clauses |= RestoredByReset;
+                    }
+                }
+
+                switch (triggered_clauses)
+                {
+                case RemoveClearsSchedule:
+                    return QRVMC_STORAGE_DELETED_ADDED;
+                case AddClearsSchedule:
+                    return QRVMC_STORAGE_MODIFIED_DELETED;
+                case RemoveClearsSchedule | RestoredByReset:
+                    return QRVMC_STORAGE_DELETED_RESTORED;
+                case RestoredBySet:
+                    return QRVMC_STORAGE_ADDED_DELETED;
+                case RestoredByReset:
+                    return QRVMC_STORAGE_MODIFIED_RESTORED;
+                case None:
+                    return QRVMC_STORAGE_ASSIGNED;
+                default:
+                    assert(false);  // Other combinations are impossible.
+                    return qrvmc_storage_status{};
+                }
+            }
+        }
+    }();
+
+    s.current = value;  // Finally update the current storage value.
+    return status;
+}
+
 /// Mocked account.
 struct MockedAccount
 {
@@ -71,21 +211,225 @@ struct MockedAccount
     }
 };
 
+/// The hashes of the most recent blocks, as available to the BLOCKHASH instruction.
+///
+/// The hashes are kept in a ring buffer of 256 slots indexed by the block number modulo 256,
+/// so setting the hash of a block overwrites the hash of the block 256 numbers older.
+/// Lookups and updates are O(1) and never allocate.
+class BlockHashes
+{
+public:
+    /// The number of the most recent blocks with available hashes.
+    static constexpr size_t size = 256;
+
+    /// Sets the hash of the block with the given number.
+    void set(int64_t block_number, const bytes32& hash) noexcept
+    {
+        m_slots[slot(block_number)] = {block_number, hash};
+    }
+
+    /// Returns the pointer to the hash of the block with the given number
+    /// or null if the hash is not available.
+    const bytes32* find(int64_t block_number) const noexcept
+    {
+        if (block_number < 0)
+            return nullptr;
+        const auto& s = m_slots[slot(block_number)];
+        return s.number == block_number ? &s.hash : nullptr;
+    }
+
+    /// Removes all the hashes.
+    void clear() noexcept { m_slots.fill({}); }
+
+    /// Loads the chain history from the input stream.
+    ///
+    /// Each entry is a block number followed by the hex-encoded block hash,
+    /// separated by whitespace, e.g. one "<number> <hash>" pair per line.
+    /// Returns false if the input is invalid, including the last entry truncated
+    /// or followed by an unexpected token. The entries loaded before the error are kept.
+    bool load(std::istream& in)
+    {
+        while (in >> std::ws && !in.eof())
+        {
+            int64_t number = 0;
+            if (!(in >> number))
+                return false;
+
+            std::string hash_hex;
+            if (!(in >> hash_hex))
+                return false;  // The block number without the hash.
+
+            const auto hash = from_hex<bytes32>(hash_hex);
+            if (number < 0 || !hash)
+                return false;
+            set(number, *hash);
+        }
+        return !in.fail();
+    }
+
+private:
+    struct Slot
+    {
+        int64_t number = -1;  ///< The block number or -1 if the slot is empty.
+        bytes32 hash;         ///< The block hash.
+    };
+
+    std::array<Slot, size> m_slots{};
+
+    static size_t slot(int64_t block_number) noexcept
+    {
+        return static_cast<size_t>(block_number) % size;
+    }
+};
+
+/// Bump allocator for the data recorded by the mocked hosts.
+///
+/// The memory is allocated from chunks which are never moved, so the returned pointers stay
+/// valid until reset(). The reset() rewinds the allocator and keeps the chunks for reuse,
+/// therefore recording in a loop of executions reaches a steady state with no heap allocations.
+/// Copies of the arena share the already allocated chunks (keeping the views into them valid),
+/// but allocate new data in their own chunks.
+class RecordingArena
+{
+    /// The default chunk size. Bigger allocations get dedicated chunks.
+    static constexpr size_t chunk_size = 16 * 1024;
+
+    struct Chunk
+    {
+        std::shared_ptr<uint8_t[]> data;
+        size_t size = 0;
+    };
+
+    std::vector<Chunk> m_chunks;
+    size_t m_current = 0;  ///< The index of the chunk allocations are made from.
+    size_t m_offset = 0;   ///< The offset of the free space in the current chunk.
+
+public:
+    RecordingArena() = default;
+    RecordingArena(RecordingArena&&) = default;
+    RecordingArena& operator=(RecordingArena&&) = default;
+
+    /// Copy constructor. Shares the chunks of @p other but never allocates from them.
+    RecordingArena(const RecordingArena& other) : m_chunks{other.m_chunks}
+    {
+        m_current = m_chunks.size();
+    }
+
+    /// Copy assignment operator. See the copy constructor.
+    RecordingArena& operator=(const RecordingArena& other)
+    {
+        m_chunks = other.m_chunks;
+        m_current = m_chunks.size();
+        m_offset = 0;
+        return *this;
+    }
+
+    /// Allocates uninitialized memory of the given size aligned to @p alignment.
+    uint8_t* allocate(size_t size, size_t alignment = alignof(bytes32))
+    {
+        while (m_current < m_chunks.size())
+        {
+            auto& chunk = m_chunks[m_current];
+            const auto offset = (m_offset + alignment - 1) & ~(alignment - 1);
+            if (offset + size <= chunk.size)
+            {
+                m_offset = offset + size;
+                return chunk.data.get() + offset;
+            }
+            ++m_current;
+            m_offset = 0;
+        }
+
+        const auto new_chunk_size = std::max(size, chunk_size);
+        m_chunks.push_back(
+            {std::shared_ptr<uint8_t[]>{new uint8_t[new_chunk_size]}, new_chunk_size});
+        m_current = m_chunks.size() - 1;
+        m_offset = size;
+        return m_chunks.back().data.get();
+    }
+
+    /// Copies the array of trivially copyable objects to the arena.
+    /// Returns the pointer to the copy, or the null pointer if the array is empty.
+    template <typename T>
+    const T* copy(const T* data, size_t size)
+    {
+        if (size == 0)
+            return nullptr;
+        auto* p = allocate(size * sizeof(T), alignof(T));
+        std::memcpy(p, data, size * sizeof(T));
+        return reinterpret_cast<const T*>(p);
+    }
+
+    /// Rewinds the allocator. All memory previously allocated from the arena is invalidated.
+    ///
+    /// Chunks shared with the copies of the arena are released, the other ones are reused.
+    void reset() noexcept
+    {
+        m_chunks.erase(std::remove_if(m_chunks.begin(), m_chunks.end(),
+                                      [](const Chunk& c) { return c.data.use_count() != 1; }),
+                       m_chunks.end());
+        m_current = 0;
+        m_offset = 0;
+    }
+};
+
+/// Non-owning view of an array of bytes32 values, e.g. LOG topics.
+class bytes32_view
+{
+    const bytes32* m_data = nullptr;
+    size_t m_size = 0;
+
+public:
+    /// Default constructor of the empty view.
+    constexpr bytes32_view() noexcept = default;
+
+    /// Constructor from the pointer and the number of elements.
+    constexpr bytes32_view(const bytes32* data, size_t size) noexcept : m_data{data}, m_size{size}
+    {}
+
+    /// Converting constructor from the vector of bytes32.
+    bytes32_view(const std::vector<bytes32>& v) noexcept  // NOLINT(hicpp-explicit-conversions)
+      : m_data{v.data()}, m_size{v.size()}
+    {}
+
+    constexpr const bytes32* data() const noexcept { return m_data; }
+    constexpr size_t size() const noexcept { return m_size; }
+    constexpr bool empty() const noexcept { return m_size == 0; }
+    constexpr const bytes32* begin() const noexcept { return m_data; }
+    constexpr const bytes32* end() const noexcept { return m_data + m_size; }
+    constexpr const bytes32& operator[](size_t i) const noexcept { return m_data[i]; }
+
+    /// Equal operator comparing the viewed elements.
+    friend bool operator==(const bytes32_view& a, const bytes32_view& b) noexcept
+    {
+        return std::equal(a.begin(), a.end(), b.begin(), b.end());
+    }
+
+    /// Not-equal operator comparing the viewed elements.
+    friend bool operator!=(const bytes32_view& a, const bytes32_view& b) noexcept
+    {
+        return !(a == b);
+    }
+};
+
 /// Mocked QRVMC Host implementation.
 class MockedHost : public Host
 {
 public:
     /// LOG record.
+    ///
+    /// The data and topics are views into the recording arena of the host,
+    /// valid until MockedHost::clear_recordings() is invoked.
     struct log_record
     {
         /// The address of the account which created the log.
         address creator;
 
         /// The data attached to the log.
-        bytes data;
+        bytes_view data;
 
         /// The log topics.
-        std::vector<bytes32> topics;
+        bytes32_view topics;
 
         /// Equal operator.
         bool operator==(const log_record& other) const noexcept
@@ -100,15 +444,23 @@ public:
     /// The QRVMC transaction context to be returned by get_tx_context().
     qrvmc_tx_context tx_context = {};
 
-    /// The block header hash value to be returned by get_block_hash().
+    /// The block header hash value to be returned by get_block_hash()
+    /// for the blocks without hashes in MockedHost::block_hashes.
     bytes32 block_hash = {};
 
+    /// The hashes of the recent blocks to be returned by get_block_hash().
+    BlockHashes block_hashes;
+
     /// The call result to be returned by the call() method.
     qrvmc_result call_result = {};
 
     /// The record of all block numbers for which get_block_hash() was called.
     mutable std::vector<int64_t> recorded_blockhashes;
 
+    /// Controls whether get_block_hash() calls are recorded in MockedHost::recorded_blockhashes.
+    /// Disable to replay or benchmark BLOCKHASH-heavy code without the growing record.
+    bool record_blockhashes = true;
+
     /// The record of all account accesses.
     mutable std::vector<address> recorded_account_accesses;
 
@@ -123,13 +475,22 @@ public:
     /// This is arbitrary value useful in fuzzing when we don't want the record to explode.
     static constexpr auto max_recorded_calls = 100;
 
+    /// The highest id of the precompiled contracts known to the host.
+    /// Accessing the precompiled contracts 1 - max_precompile_id is always warm.
+    static constexpr uint16_t max_precompile_id = 9;
+
+    /// The flags of the optional host interface members provided by the host,
+    /// to be set in the messages of the executions with this host.
+    static constexpr uint32_t host_flags = QRVMC_HOST_TX_CONTEXT_PTR | QRVMC_HOST_EMIT_LOGS;
+
     /// The record of all LOGs passed to the emit_log() method.
     std::vector<log_record> recorded_logs;
 
 private:
-    /// The copy of call inputs for the recorded_calls record.
-    std::vector<bytes> m_recorded_calls_inputs;
+    /// The arena storing the copies of call inputs and LOG data and topics.
+    RecordingArena m_arena;
 
+protected:
     /// Record an account access.
     /// @param addr  The address of the accessed account.
     void record_account_access(const address& addr) const
@@ -141,7 +502,37 @@ private:
             recorded_account_accesses.emplace_back(addr);
     }
 
+    /// Record a call message in MockedHost::recorded_calls, including the copy of its input.
+    /// @param msg  The call message.
+    void record_call(const qrvmc_message& msg)
+    {
+        record_account_access(msg.recipient);
+
+        if (recorded_calls.empty())
+            recorded_calls.reserve(max_recorded_calls);
+
+        if (recorded_calls.size() < max_recorded_calls)
+        {
+            recorded_calls.emplace_back(msg);
+            auto& call_msg = recorded_calls.back();
+            call_msg.input_data = m_arena.copy(call_msg.input_data, call_msg.input_size);
+        }
+    }
+
 public:
+    /// Clears all the records and rewinds the recording arena.
+    ///
+    /// This is intended to be invoked between executions. The memory of the records is reused,
+    /// so no heap allocations are needed to record the next execution of similar shape.
+    void clear_recordings() noexcept
+    {
+        recorded_blockhashes.clear();
+        recorded_account_accesses.clear();
+        recorded_calls.clear();
+        recorded_logs.clear();
+        m_arena.reset();
+    }
+
     /// Returns true if an account exists (QRVMC Host method).
     bool account_exists(const address& addr) const noexcept override
     {
@@ -177,136 +568,7 @@ public:
         // storage values after the execution terminates.
         auto& s = accounts[addr].storage[key];
 
-        // Follow the EIP-2200 specification as closely as possible.
-        // https://eips.ethereum.org/EIPS/eip-2200
-        // Warning: this is not the most efficient implementation. The storage status can be
-        // figured out by combining only 4 checks:
-        // - original != current (dirty)
-        // - original == value (restored)
-        // - current != 0
-        // - value != 0
-        const auto status = [&original = s.original, &current = s.current, &value]() {
-            // Clause 1 is irrelevant:
-            // 1. "If gasleft is less than or equal to gas stipend,
-            //    fail the current call frame with ‘out of gas’ exception"
-
-            // 2. "If current value equals new value (this is a no-op)"
-            if (current == value)
-            {
-                // "SLOAD_GAS is deducted"
-                return QRVMC_STORAGE_ASSIGNED;
-            }
-            // 3. "If current value does not equal new value"
-            else
-            {
-                // 3.1. "If original value equals current value
-                //      (this storage slot has not been changed by the current execution context)"
-                if (original == current)
-                {
-                    // 3.1.1 "If original value is 0"
-                    if (is_zero(original))
-                    {
-                        // "SSTORE_SET_GAS is deducted"
-                        return QRVMC_STORAGE_ADDED;
-                    }
-                    // 3.1.2 "Otherwise"
-                    else
-                    {
-                        // "SSTORE_RESET_GAS gas is deducted"
-                        auto st = QRVMC_STORAGE_MODIFIED;
-
-                        // "If new value is 0"
-                        if (is_zero(value))
-                        {
-                            // "add SSTORE_CLEARS_SCHEDULE gas to refund counter"
-                            st = QRVMC_STORAGE_DELETED;
-                        }
-
-                        return st;
-                    }
-                }
-                // 3.2. "If original value does not equal current value
-                //      (this storage slot is dirty),
-                //      SLOAD_GAS gas is deducted.
-                //      Apply both of the following clauses."
-                else
-                {
-                    // Because we need to apply "both following clauses"
-                    // we first collect information which clause is triggered
-                    // then assign status code to combination of these clauses.
-                    enum
-                    {
-                        None = 0,
-                        RemoveClearsSchedule = 1 << 0,
-                        AddClearsSchedule = 1 << 1,
-                        RestoredBySet = 1 << 2,
-                        RestoredByReset = 1 << 3,
-                    };
-                    int triggered_clauses = None;
-
-                    // 3.2.1. "If original value is not 0"
-                    if (!is_zero(original))
-                    {
-                        // 3.2.1.1. "If current value is 0"
-                        if (is_zero(current))
-                        {
-                            // "(also means that new value is not 0)"
-                            assert(!is_zero(value));
-                            // "remove SSTORE_CLEARS_SCHEDULE gas from refund counter"
-                            triggered_clauses |= RemoveClearsSchedule;
-                        }
-                        // 3.2.1.2. "If new value is 0"
-                        if (is_zero(value))
-                        {
-                            // "(also means that current value is not 0)"
-                            assert(!is_zero(current));
-                            // "add SSTORE_CLEARS_SCHEDULE gas to refund counter"
-                            triggered_clauses |= AddClearsSchedule;
-                        }
-                    }
-
-                    // 3.2.2. "If original value equals new value (this storage slot is reset)"
-                    // Except: we use term 'storage slot restored'.
-                    if (original == value)
-                    {
-                        // 3.2.2.1. "If original value is 0"
-                        if (is_zero(original))
-                        {
-                            // "add SSTORE_SET_GAS - SLOAD_GAS to refund counter"
-                            triggered_clauses |= RestoredBySet;
-                        }
-                        // 3.2.2.2. "Otherwise"
-                        else
-                        {
-                            // "add SSTORE_RESET_GAS - SLOAD_GAS gas to refund counter"
-                            triggered_clauses |= RestoredByReset;
-                        }
-                    }
-
-                    switch (triggered_clauses)
-                    {
-                    case RemoveClearsSchedule:
-                        return QRVMC_STORAGE_DELETED_ADDED;
-                    case AddClearsSchedule:
-                        return QRVMC_STORAGE_MODIFIED_DELETED;
-                    case RemoveClearsSchedule | RestoredByReset:
-                        return QRVMC_STORAGE_DELETED_RESTORED;
-                    case RestoredBySet:
-                        return QRVMC_STORAGE_ADDED_DELETED;
-                    case RestoredByReset:
-                        return QRVMC_STORAGE_MODIFIED_RESTORED;
-                    case None:
-                        return QRVMC_STORAGE_ASSIGNED;
-                    default:
-                        assert(false);  // Other combinations are impossible.
-                        return qrvmc_storage_status{};
-                    }
-                }
-            }
-        }();
-
-        s.current = value;  // Finally update the current storage value.
-        return status;
+        return update_storage_value(s, value);
     }
 
     /// Get the account's balance (QRVMC Host method).
@@ -366,36 +628,23 @@ public:
     /// Call/create other contract (QRVMC host method).
     Result call(const qrvmc_message& msg) noexcept override
     {
-        record_account_access(msg.recipient);
-
-        if (recorded_calls.empty())
-        {
-            recorded_calls.reserve(max_recorded_calls);
-            m_recorded_calls_inputs.reserve(max_recorded_calls);  // Iterators will not invalidate.
-        }
-
-        if (recorded_calls.size() < max_recorded_calls)
-        {
-            recorded_calls.emplace_back(msg);
-            auto& call_msg = recorded_calls.back();
-            if (call_msg.input_size > 0)
-            {
-                m_recorded_calls_inputs.emplace_back(call_msg.input_data, call_msg.input_size);
-                const auto& input_copy = m_recorded_calls_inputs.back();
-                call_msg.input_data = input_copy.data();
-            }
-        }
+        record_call(msg);
         return Result{call_result};
     }
 
     /// Get transaction context (QRVMC host method).
     qrvmc_tx_context get_tx_context() const noexcept override { return tx_context; }
 
+    /// Get transaction context pointer (QRVMC host method).
+    const qrvmc_tx_context* get_tx_context_ptr() const noexcept override { return &tx_context; }
+
     /// Get the block header hash (QRVMC host method).
     bytes32 get_block_hash(int64_t block_number) const noexcept override
     {
-        recorded_blockhashes.emplace_back(block_number);
-        return block_hash;
+        if (record_blockhashes)
+            recorded_blockhashes.emplace_back(block_number);
+        const auto hash = block_hashes.find(block_number);
+        return hash != nullptr ? *hash : block_hash;
     }
 
     /// Emit LOG (QRVMC host method).
@@ -405,7 +654,26 @@ public:
                   const bytes32 topics[],
                   size_t topics_count) noexcept override
     {
-        recorded_logs.push_back({addr, {data, data_size}, {topics, topics + topics_count}});
+        recorded_logs.push_back({addr, {m_arena.copy(data, data_size), data_size},
+                                 {m_arena.copy(topics, topics_count), topics_count}});
+    }
+
+    /// Emit the batch of LOGs (QRVMC host method).
+    ///
+    /// Records the logs as emit_log() does, growing MockedHost::recorded_logs at most once.
+    void emit_logs(const qrvmc_log* logs, size_t num_logs) noexcept override
+    {
+        const auto new_size = recorded_logs.size() + num_logs;
+        if (new_size > recorded_logs.capacity())
+            recorded_logs.reserve(std::max(new_size, 2 * recorded_logs.capacity()));
+        for (size_t i = 0; i < num_logs; ++i)
+        {
+            const auto& log = logs[i];
+            const auto* topics = static_cast<const bytes32*>(log.topics);
+            recorded_logs.push_back({log.address,
+                                     {m_arena.copy(log.data, log.data_size), log.data_size},
+                                     {m_arena.copy(topics, log.topics_count), log.topics_count}});
+        }
     }
 
     /// Record an account access.
@@ -434,8 +702,8 @@ public:
         record_account_access(addr);
 
         // Accessing precompiled contracts is always warm.
-        if (addr >= "Q0000000000000000000000000000000000000001"_address &&
-            addr <= "Q0000000000000000000000000000000000000009"_address)
+        const auto id = precompile_id(addr);
+        if (id != 0 && id <= max_precompile_id)
             return QRVMC_ACCESS_WARM;
 
         return already_accessed ? QRVMC_ACCESS_WARM : QRVMC_ACCESS_COLD;
@@ -0,0 +1,152 @@
+// EVMC: Ethereum Client-VM Connector API.
+// Copyright 2026 The EVMC Authors.
+// Licensed under the Apache License, Version 2.0.
+#pragma once
+
+#include <qrvmc/mocked_host.hpp>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/// The parallel execution of the blocks of transactions.
+///
+/// The transactions are executed speculatively by multiple threads, each against
+/// the multi-version state: the base state of the block and the state modifications of
+/// the preceding transactions of the block, already executed. Then the transactions are
+/// committed in order. The values read by the speculative execution are validated against
+/// the state committed so far, and the transactions which have read stale values are executed
+/// again. Therefore the results are deterministic and the same as of the serial execution,
+/// regardless of the number of threads and the scheduling.
+namespace qrvmc::parallel
+{
+/// The state of the accounts, in the MockedHost data model.
+using State = std::unordered_map<address, MockedAccount>;
+
+/// The pool of threads executing the indexed tasks with work stealing.
+///
+/// The tasks are split into contiguous ranges, one per thread, executed in the increasing order.
+/// The thread which has finished its range steals the upper half of the remaining range
+/// of another thread. The thread invoking run() is one of the workers.
+class ThreadPool
+{
+public:
+    /// The task: invoked with the index of the worker thread and the index of the task.
+    /// The tasks must not throw.
+    using Task = std::function<void(size_t worker, size_t task)>;
+
+    /// Creates the pool of @p num_threads workers (at least one), including the calling thread.
+    explicit ThreadPool(size_t num_threads);
+
+    /// Stops and joins the threads.
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /// Returns the number of workers.
+    size_t size() const noexcept { return m_num_workers; }
+
+    /// Executes the tasks 0 to @p num_tasks - 1 and waits for all of them to complete.
+    void run(size_t num_tasks, const Task& task);
+
+private:
+    /// The range of the tasks not yet started by a worker.
+    struct alignas(64) Range
+    {
+        std::mutex mutex;
+        size_t begin = 0;
+        size_t end = 0;
+    };
+
+    size_t m_num_workers;
+    std::unique_ptr<Range[]> m_ranges;
+    std::vector<std::thread> m_threads;
+
+    std::mutex m_mutex;  ///< Guards the fields below.
+    std::condition_variable m_start;
+    std::condition_variable m_done;
+    const Task* m_task = nullptr;
+    uint64_t m_generation = 0;  ///< Bumped for each run().
+    size_t m_num_running = 0;   ///< The number of the threads executing the current run().
+    bool m_stop = false;
+
+    /// The loop of the worker thread.
+    void thread_loop(size_t worker);
+
+    /// Executes the tasks of the worker's range, then the stolen ones, until none is left.
+    void work(size_t worker, const Task& task);
+
+    /// Returns the next task of the worker's range, stealing from the other workers
+    /// if the range is exhausted. Returns false if all ranges are exhausted.
+    bool next_task(size_t worker, size_t& task);
+};
+
+/// The LOG emitted by the transaction.
+struct Log
+{
+    address creator;              ///< The address of the account which created the log.
+    bytes data;                   ///< The data attached to the log.
+    std::vector<bytes32> topics;  ///< The log topics.
+};
+
+/// The result of the transaction.
+struct TxResult
+{
+    /// The result of the call.
+    Result result;
+
+    /// The logs emitted by the transaction. Empty if the transaction failed.
+    std::vector<Log> logs;
+
+    /// Whether the transaction has been executed again, after reading the stale state.
+    bool reexecuted = false;
+};
+
+/// The result of the block.
+struct BlockResult
+{
+    /// The results of the transactions, in order.
+    std::vector<TxResult> transactions;
+
+    /// The number of the transactions executed again.
+    size_t num_reexecuted = 0;
+};
+
+/// The executor of the blocks of transactions.
+///
+/// Each transaction is the message executed as the call by qrvmc::ExecutingMockedHost:
+/// the value is transferred and the code of the callee is executed, including the nested calls.
+/// Each transaction starts with the original storage values being the current ones
+/// and with all the accounts and storage slots cold.
+class Executor
+{
+public:
+    /// Creates the executor of the transactions with @p vm in the @p rev revision
+    /// with @p num_threads threads. The VM must support concurrent executions.
+    /// The VM is not owned and must outlive the executor.
+    Executor(VM& vm,
+             qrvmc_revision rev,
+             size_t num_threads = std::max(std::thread::hardware_concurrency(), 1u));
+
+    ~Executor();
+
+    /// The QRVMC transaction context of the executed transactions.
+    qrvmc_tx_context tx_context = {};
+
+    /// Executes the transactions and commits their state modifications to @p state.
+    BlockResult execute(State& state, const std::vector<qrvmc_message>& transactions);
+
+    /// Returns the number of threads.
+    size_t num_threads() const noexcept { return m_pool.size(); }
+
+private:
+    struct Impl;
+
+    ThreadPool m_pool;
+    std::unique_ptr<Impl> m_impl;
+};
+}  // namespace qrvmc::parallel
@@ -84,7 +84,35 @@ enum qrvmc_call_kind
 /** The flags for ::qrvmc_message. */
 enum qrvmc_flags
 {
-    QRVMC_STATIC = 1 /**< Static call mode. */
+    QRVMC_STATIC = 1, /**< Static call mode. */
+
+    /**
+     * The output may alias the input.
+     *
+     * The caller guarantees the memory of qrvmc_message::input_data stays valid and unmodified
+     * until the qrvmc_result is released. The VM MAY then return the qrvmc_result::output_data
+     * pointing into the input instead of a copy. The caller forwarding such a result beyond
+     * the lifetime of the input must copy the output.
+     */
+    QRVMC_ALLOW_OUTPUT_ALIASING = 2,
+
+    /**
+     * The host provides the transaction context pointer.
+     *
+     * The host interface has the qrvmc_host_interface::get_tx_context_ptr member.
+     * Hosts built with the QRVMC headers not declaring this member must not set this flag.
+     * This is the property of the host: VMs SHOULD keep it in the messages of nested calls.
+     */
+    QRVMC_HOST_TX_CONTEXT_PTR = 4,
+
+    /**
+     * The host accepts the batches of logs.
+     *
+     * The host interface has the qrvmc_host_interface::emit_logs member.
+     * Hosts built with the QRVMC headers not declaring this member must not set this flag.
+     * This is the property of the host: VMs SHOULD keep it in the messages of nested calls.
+     */
+    QRVMC_HOST_EMIT_LOGS = 8
 };
 
 /**
@@ -99,7 +127,8 @@ struct qrvmc_message
 
     /**
      * Additional flags modifying the call execution behavior.
-     * In the current version the only valid values are ::QRVMC_STATIC or 0.
+     * In the current version the valid values are the combinations of ::QRVMC_STATIC,
+     * ::QRVMC_ALLOW_OUTPUT_ALIASING, ::QRVMC_HOST_TX_CONTEXT_PTR and ::QRVMC_HOST_EMIT_LOGS.
      */
     uint32_t flags;
 
@@ -219,6 +248,20 @@ struct qrvmc_host_context;
  */
 typedef struct qrvmc_tx_context (*qrvmc_get_tx_context_fn)(struct qrvmc_host_context* context);
 
+/**
+ * Get transaction context pointer callback function.
+ *
+ *  The alternative to ::qrvmc_get_tx_context_fn not copying the transaction context.
+ *  The returned context MUST stay valid and unchanged during the execution
+ *  of the message, e.g. the Host keeps it once per transaction.
+ *
+ *  @param      context  The pointer to the Host execution context.
+ *  @return              The pointer to the transaction context or NULL if not available:
+ *                       the VM uses ::qrvmc_get_tx_context_fn then.
+ */
+typedef const struct qrvmc_tx_context* (*qrvmc_get_tx_context_ptr_fn)(
+    struct qrvmc_host_context* context);
+
 /**
  * Get block hash callback function.
  *
@@ -416,6 +459,8 @@ struct qrvmc_result
      *
      * The memory containing the output data is owned by QRVM and has to be
      * freed with qrvmc_result::release().
+     * If the message has the ::QRVMC_ALLOW_OUTPUT_ALIASING flag, the output MAY point into
+     * the qrvmc_message::input_data instead. Such output is valid as long as the input.
      *
      * This pointer MAY be NULL.
      * If qrvmc_result::output_size is 0 this pointer MUST NOT be dereferenced.
@@ -701,6 +746,49 @@ typedef void (*qrvmc_emit_log_fn)(struct qrvmc_host_context* context,
                                   const qrvmc_bytes32 topics[],
                                   size_t topics_count);
 
+/**
+ * The log in the batch passed to ::qrvmc_emit_logs_fn.
+ *
+ * The data and the topics point into the memory owned by the VM.
+ */
+struct qrvmc_log
+{
+    /** The address of the contract that generated the log. */
+    qrvmc_address address;
+
+    /** The pointer to unindexed data attached to the log. */
+    const uint8_t* data;
+
+    /** The length of the data. */
+    size_t data_size;
+
+    /** The pointer to the array of topics attached to the log. */
+    const qrvmc_bytes32* topics;
+
+    /** The number of the topics. Valid values are between 0 and 4 inclusively. */
+    size_t topics_count;
+};
+
+/**
+ * Log batch callback function.
+ *
+ * The alternative to ::qrvmc_emit_log_fn informing about multiple LOGs at once,
+ * what is equivalent to the ::qrvmc_emit_log_fn calls for each of them in the order.
+ * The VM MAY buffer the LOGs of the execution and pass them in a single batch
+ * when the execution ends successfully (the LOGs of the failed executions are dropped),
+ * but always before the following ::qrvmc_call_fn call, so the order of the LOGs
+ * of the nested calls is preserved. The LOGs of the successful nested execution called
+ * directly by the execution in the same VM MAY be left to the latter.
+ *
+ * @param context   The pointer to the Host execution context. See ::qrvmc_host_context.
+ * @param logs      The pointer to the array of the logs. The array and the memory pointed to
+ *                  by the logs are valid only until this function returns.
+ * @param num_logs  The number of the logs.
+ */
+typedef void (*qrvmc_emit_logs_fn)(struct qrvmc_host_context* context,
+                                   const struct qrvmc_log* logs,
+                                   size_t num_logs);
+
 /**
  * Access status per EIP-2929: Gas cost increases for state access opcodes.
  */
@@ -805,6 +893,22 @@ struct qrvmc_host_interface
 
     /** Access storage callback function. */
     qrvmc_access_storage_fn access_storage;
+
+    /**
+     * Get transaction context pointer callback function.
+     *
+     * Present only if the executed message has the ::QRVMC_HOST_TX_CONTEXT_PTR flag,
+     * so the VM MUST NOT access it otherwise. This MAY be NULL.
+     */
+    qrvmc_get_tx_context_ptr_fn get_tx_context_ptr;
+
+    /**
+     * Emit logs callback function.
+     *
+     * Present only if the executed message has the ::QRVMC_HOST_EMIT_LOGS flag,
+     * so the VM MUST NOT access it otherwise. This MAY be NULL.
+     */
+    qrvmc_emit_logs_fn emit_logs;
 };
 
 
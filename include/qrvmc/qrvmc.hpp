@@ -7,11 +7,14 @@
 #include <qrvmc/hex.hpp>
 #include <qrvmc/qrvmc.h>
 
+#include <cstring>
 #include <functional>
 #include <initializer_list>
 #include <ostream>
 #include <string_view>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 static_assert(QRVMC_LATEST_STABLE_REVISION <= QRVMC_MAX_REVISION,
               "latest stable revision ill-defined");
@@ -279,6 +282,463 @@ inline constexpr bytes32::operator bool() const noexcept
     return !is_zero(*this);
 }
 
+/// Returns the id of the precompiled contract at the given address or 0 if the address
+/// is not in the range reserved for precompiled contracts.
+///
+/// The EIP-1352 (https://eips.ethereum.org/EIPS/eip-1352) reserves the addresses with
+/// the 18-byte zero prefix, i.e. the range Q0001 - Qffff, for precompiled contracts.
+/// The first 16 bytes of the prefix are checked with a single 16-byte load and compare,
+/// the remaining 2 bytes are loaded together with the id.
+inline uint16_t precompile_id(const address& a) noexcept
+{
+    uint64_t prefix[2];
+    std::memcpy(prefix, a.bytes, sizeof(prefix));
+    const auto tail = load32be(&a.bytes[16]);
+    if ((prefix[0] | prefix[1]) != 0 || (tail >> 16) != 0)
+        return 0;
+    return static_cast<uint16_t>(tail);
+}
+
+/// Checks if the given address is in the range reserved for precompiled contracts.
+/// See precompile_id().
+inline bool is_precompile(const address& a) noexcept
+{
+    return precompile_id(a) != 0;
+}
+
+/// The 256-bit unsigned integer with native arithmetic.
+///
+/// The value is kept in 4 64-bit words in the native order: the words[0] is the least
+/// significant one. All arithmetic operations are done modulo 2^256.
+/// Use to_uint256() and to_uint256be() to convert from and to the big-endian qrvmc::uint256be.
+struct uint256
+{
+    /// The 64-bit words, the least significant first.
+    uint64_t words[4] = {};
+
+    /// Default constructor. Initializes the value to zero.
+    constexpr uint256() noexcept = default;
+
+    /// Converting constructor from unsigned integer value.
+    constexpr uint256(uint64_t v) noexcept : words{v, 0, 0, 0} {}  // NOLINT
+
+    /// Constructor from the words, the least significant first.
+    /// The omitted most significant words are zero.
+    constexpr uint256(uint64_t w0, uint64_t w1, uint64_t w2 = 0, uint64_t w3 = 0) noexcept
+      : words{w0, w1, w2, w3}
+    {}
+
+    /// Returns the reference to the word at the index @p i, the least significant first.
+    constexpr uint64_t& operator[](size_t i) noexcept { return words[i]; }
+
+    /// Returns the word at the index @p i, the least significant first.
+    constexpr const uint64_t& operator[](size_t i) const noexcept { return words[i]; }
+
+    /// Explicit operator converting to bool.
+    constexpr explicit operator bool() const noexcept
+    {
+        return (words[0] | words[1] | words[2] | words[3]) != 0;
+    }
+
+    /// Explicit operator converting to the uint64_t by truncation.
+    constexpr explicit operator uint64_t() const noexcept { return words[0]; }
+};
+
+/// Converts the big-endian qrvmc::uint256be to the qrvmc::uint256.
+inline constexpr uint256 to_uint256(const uint256be& v) noexcept
+{
+    return {load64be(&v.bytes[24]), load64be(&v.bytes[16]), load64be(&v.bytes[8]),
+            load64be(&v.bytes[0])};
+}
+
+/// Converts the qrvmc::uint256 to the big-endian qrvmc::uint256be.
+inline constexpr uint256be to_uint256be(const uint256& v) noexcept
+{
+    uint256be r;
+    for (size_t i = 0; i < 4; ++i)
+    {
+        for (size_t j = 0; j < 8; ++j)
+            r.bytes[(3 - i) * 8 + j] = static_cast<uint8_t>(v[i] >> (56 - 8 * j));
+    }
+    return r;
+}
+
+namespace internal
+{
+/// The 128-bit result of the 64-bit multiplication.
+struct uint128_parts
+{
+    uint64_t hi;  ///< The high 64 bits.
+    uint64_t lo;  ///< The low 64 bits.
+};
+
+#ifdef __SIZEOF_INT128__
+/// The unsigned 128-bit integer type, the compiler extension.
+__extension__ using uint128 = unsigned __int128;
+#endif
+
+/// Full 64 x 64 -> 128 multiplication. Compiles to the single MUL/MULX instruction
+/// if the unsigned __int128 type is supported.
+inline constexpr uint128_parts umul(uint64_t x, uint64_t y) noexcept
+{
+#ifdef __SIZEOF_INT128__
+    const auto p = static_cast<uint128>(x) * y;
+    return {static_cast<uint64_t>(p >> 64), static_cast<uint64_t>(p)};
+#else
+    const auto xl = x & 0xffffffff;
+    const auto xh = x >> 32;
+    const auto yl = y & 0xffffffff;
+    const auto yh = y >> 32;
+
+    const auto t0 = xl * yl;
+    const auto t1 = xh * yl;
+    const auto t2 = xl * yh;
+    const auto t3 = xh * yh;
+
+    const auto u1 = t1 + (t0 >> 32);
+    const auto u2 = t2 + (u1 & 0xffffffff);
+
+    const auto lo = (u2 << 32) | (t0 & 0xffffffff);
+    const auto hi = t3 + (u2 >> 32) + (u1 >> 32);
+    return {hi, lo};
+#endif
+}
+
+/// Divides the 128-bit number {hi, lo} by the 64-bit @p d, requires hi < d.
+/// Returns the quotient in the lo part and the remainder in the hi part.
+inline constexpr uint128_parts udivrem_2by1(uint64_t hi, uint64_t lo, uint64_t d) noexcept
+{
+#ifdef __SIZEOF_INT128__
+    const auto n = (static_cast<uint128>(hi) << 64) | lo;
+    return {static_cast<uint64_t>(n % d), static_cast<uint64_t>(n / d)};
+#else
+    // The long division bit by bit.
+    uint64_t q = 0;
+    for (int i = 0; i < 64; ++i)
+    {
+        const auto carry = hi >> 63;
+        hi = (hi << 1) | (lo >> 63);
+        lo <<= 1;
+        q <<= 1;
+        if (carry != 0 || hi >= d)
+        {
+            hi -= d;
+            q |= 1;
+        }
+    }
+    return {hi, q};
+#endif
+}
+
+/// Counts the leading zero bits of the non-zero @p x.
+inline constexpr unsigned clz(uint64_t x) noexcept
+{
+#ifdef __GNUC__
+    return static_cast<unsigned>(__builtin_clzll(x));
+#else
+    unsigned n = 0;
+    for (auto mask = uint64_t{1} << 63; (x & mask) == 0; mask >>= 1)
+        ++n;
+    return n;
+#endif
+}
+}  // namespace internal
+
+/// The "equal to" comparison operator for the qrvmc::uint256 type.
+inline constexpr bool operator==(const uint256& a, const uint256& b) noexcept
+{
+    return ((a[0] ^ b[0]) | (a[1] ^ b[1]) | (a[2] ^ b[2]) | (a[3] ^ b[3])) == 0;
+}
+
+/// The "not equal to" comparison operator for the qrvmc::uint256 type.
+inline constexpr bool operator!=(const uint256& a, const uint256& b) noexcept
+{
+    return !(a == b);
+}
+
+/// The "less than" comparison operator for the qrvmc::uint256 type.
+inline constexpr bool operator<(const uint256& a, const uint256& b) noexcept
+{
+    // Compute the borrow of a - b.
+    bool borrow = false;
+    for (size_t i = 0; i < 4; ++i)
+        borrow = a[i] < b[i] || (a[i] == b[i] && borrow);
+    return borrow;
+}
+
+/// The "greater than" comparison operator for the qrvmc::uint256 type.
+inline constexpr bool operator>(const uint256& a, const uint256& b) noexcept
+{
+    return b < a;
+}
+
+/// The "less than or equal to" comparison operator for the qrvmc::uint256 type.
+inline constexpr bool operator<=(const uint256& a, const uint256& b) noexcept
+{
+    return !(b < a);
+}
+
+/// The "greater than or equal to" comparison operator for the qrvmc::uint256 type.
+inline constexpr bool operator>=(const uint256& a, const uint256& b) noexcept
+{
+    return !(a < b);
+}
+
+/// Addition modulo 2^256.
+inline constexpr uint256 operator+(const uint256& a, const uint256& b) noexcept
+{
+    uint256 r;
+    uint64_t carry = 0;
+    for (size_t i = 0; i < 4; ++i)
+    {
+        const auto s = a[i] + b[i];
+        const auto c1 = s < a[i];
+        r[i] = s + carry;
+        carry = uint64_t{c1} | uint64_t{r[i] < s};
+    }
+    return r;
+}
+
+/// Subtraction modulo 2^256.
+inline constexpr uint256 operator-(const uint256& a, const uint256& b) noexcept
+{
+    uint256 r;
+    uint64_t borrow = 0;
+    for (size_t i = 0; i < 4; ++i)
+    {
+        const auto d = a[i] - b[i];
+        const auto b1 = a[i] < b[i];
+        r[i] = d - borrow;
+        borrow = uint64_t{b1} | uint64_t{d < borrow};
+    }
+    return r;
+}
+
+/// Negation modulo 2^256.
+inline constexpr uint256 operator-(const uint256& a) noexcept
+{
+    return uint256{} - a;
+}
+
+/// Multiplication modulo 2^256.
+///
+/// Only the 10 partial products contributing to the low 256 bits are computed.
+inline constexpr uint256 operator*(const uint256& a, const uint256& b) noexcept
+{
+    uint256 r;
+    for (size_t j = 0; j < 4; ++j)
+    {
+        uint64_t carry = 0;
+        for (size_t i = 0; i < 4 - j; ++i)
+        {
+            const auto p = internal::umul(a[i], b[j]);
+            const auto s1 = r[i + j] + p.lo;
+            const auto c1 = s1 < p.lo;
+            const auto s2 = s1 + carry;
+            const auto c2 = s2 < carry;
+            r[i + j] = s2;
+            carry = p.hi + c1 + c2;
+        }
+    }
+    return r;
+}
+
+/// Bitwise NOT.
+inline constexpr uint256 operator~(const uint256& a) noexcept
+{
+    return {~a[0], ~a[1], ~a[2], ~a[3]};
+}
+
+/// Bitwise AND.
+inline constexpr uint256 operator&(const uint256& a, const uint256& b) noexcept
+{
+    return {a[0] & b[0], a[1] & b[1], a[2] & b[2], a[3] & b[3]};
+}
+
+/// Bitwise OR.
+inline constexpr uint256 operator|(const uint256& a, const uint256& b) noexcept
+{
+    return {a[0] | b[0], a[1] | b[1], a[2] | b[2], a[3] | b[3]};
+}
+
+/// Bitwise XOR.
+inline constexpr uint256 operator^(const uint256& a, const uint256& b) noexcept
+{
+    return {a[0] ^ b[0], a[1] ^ b[1], a[2] ^ b[2], a[3] ^ b[3]};
+}
+
+/// Left shift. The shift by 256 or more bits results in zero.
+inline constexpr uint256 operator<<(const uint256& a, uint64_t shift) noexcept
+{
+    if (shift >= 256)
+        return {};
+
+    const auto word_shift = static_cast<size_t>(shift / 64);
+    const auto bit_shift = shift % 64;
+    uint256 r;
+    for (size_t i = word_shift; i < 4; ++i)
+    {
+        r[i] = a[i - word_shift] << bit_shift;
+        if (bit_shift != 0 && i > word_shift)
+            r[i] |= a[i - word_shift - 1] >> (64 - bit_shift);
+    }
+    return r;
+}
+
+/// Logical right shift. The shift by 256 or more bits results in zero.
+inline constexpr uint256 operator>>(const uint256& a, uint64_t shift) noexcept
+{
+    if (shift >= 256)
+        return {};
+
+    const auto word_shift = static_cast<size_t>(shift / 64);
+    const auto bit_shift = shift % 64;
+    uint256 r;
+    for (size_t i = 0; i + word_shift < 4; ++i)
+    {
+        r[i] = a[i + word_shift] >> bit_shift;
+        if (bit_shift != 0 && i + word_shift + 1 < 4)
+            r[i] |= a[i + word_shift + 1] << (64 - bit_shift);
+    }
+    return r;
+}
+
+/// The result of the division: the quotient and the remainder.
+struct div_result
+{
+    uint256 quot;  ///< The quotient.
+    uint256 rem;   ///< The remainder.
+};
+
+/// Unsigned division with remainder.
+///
+/// Uses the Knuth's Algorithm D (The Art of Computer Programming, Vol. 2, 4.3.1)
+/// with 64-bit digits. The division by zero results in zero quotient and zero remainder,
+/// as specified for the QRVM DIV and MOD instructions.
+inline constexpr div_result udivrem(const uint256& u, const uint256& v) noexcept
+{
+    // The number of significant words of the divisor and the dividend.
+    size_t n = 4;
+    while (n > 0 && v[n - 1] == 0)
+        --n;
+    size_t m = 4;
+    while (m > 0 && u[m - 1] == 0)
+        --m;
+
+    if (n == 0)
+        return {};
+    if (m < n || u < v)
+        return {{}, u};
+
+    div_result r;
+
+    if (n == 1)
+    {
+        // The short division.
+        uint64_t rem = 0;
+        for (size_t j = m; j-- > 0;)
+        {
+            const auto qr = internal::udivrem_2by1(rem, u[j], v[0]);
+            r.quot[j] = qr.lo;
+            rem = qr.hi;
+        }
+        r.rem[0] = rem;
+        return r;
+    }
+
+    // Normalize: shift the divisor so its most significant bit is set.
+    const auto shift = internal::clz(v[n - 1]);
+    uint64_t vn[4]{};
+    uint64_t un[5]{};
+    for (size_t i = n - 1; i > 0; --i)
+        vn[i] = (v[i] << shift) | (shift != 0 ? v[i - 1] >> (64 - shift) : 0);
+    vn[0] = v[0] << shift;
+    un[m] = shift != 0 ? u[m - 1] >> (64 - shift) : 0;
+    for (size_t i = m - 1; i > 0; --i)
+        un[i] = (u[i] << shift) | (shift != 0 ? u[i - 1] >> (64 - shift) : 0);
+    un[0] = u[0] << shift;
+
+    const auto d = vn[n - 1];
+    for (size_t j = m - n + 1; j-- > 0;)
+    {
+        // Estimate the quotient digit qhat from the top two digits of the dividend.
+        uint64_t qhat = 0;
+        uint64_t rhat = 0;
+        bool rhat_overflow = false;
+        if (un[j + n] >= d)
+        {
+            qhat = ~uint64_t{0};
+            rhat = un[j + n - 1] + d;
+            rhat_overflow = rhat < d;
+        }
+        else
+        {
+            const auto qr = internal::udivrem_2by1(un[j + n], un[j + n - 1], d);
+            qhat = qr.lo;
+            rhat = qr.hi;
+        }
+
+        // Correct the estimate, at most 2 times.
+        while (!rhat_overflow)
+        {
+            const auto p = internal::umul(qhat, vn[n - 2]);
+            if (p.hi < rhat || (p.hi == rhat && p.lo <= un[j + n - 2]))
+                break;
+            --qhat;
+            rhat += d;
+            rhat_overflow = rhat < d;
+        }
+
+        // Multiply and subtract.
+        uint64_t borrow = 0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            const auto p = internal::umul(qhat, vn[i]);
+            const auto lo = p.lo + borrow;
+            const auto hi = p.hi + (lo < borrow);
+            const auto t = un[i + j] - lo;
+            borrow = hi + (un[i + j] < lo);
+            un[i + j] = t;
+        }
+        const auto top = un[j + n];
+        un[j + n] = top - borrow;
+
+        if (top < borrow)
+        {
+            // The estimate was too big by one: add the divisor back.
+            --qhat;
+            uint64_t carry = 0;
+            for (size_t i = 0; i < n; ++i)
+            {
+                const auto s = un[i + j] + vn[i];
+                const auto c1 = s < vn[i];
+                un[i + j] = s + carry;
+                carry = uint64_t{c1} | uint64_t{un[i + j] < s};
+            }
+            un[j + n] += carry;
+        }
+
+        r.quot[j] = qhat;
+    }
+
+    // Denormalize the remainder.
+    for (size_t i = 0; i < n; ++i)
+        r.rem[i] = (un[i] >> shift) | (shift != 0 ? un[i + 1] << (64 - shift) : 0);
+    return r;
+}
+
+/// Unsigned division. The division by zero results in zero.
+inline constexpr uint256 operator/(const uint256& a, const uint256& b) noexcept
+{
+    return udivrem(a, b).quot;
+}
+
+/// Unsigned modulo. The modulo by zero results in zero.
+inline constexpr uint256 operator%(const uint256& a, const uint256& b) noexcept
+{
+    return udivrem(a, b).rem;
+}
+
 namespace literals
 {
 /// Converts a raw literal into value of type T.
@@ -332,6 +792,44 @@ inline const char* to_string(qrvmc_revision rev) noexcept
 }
 
 
+/// The compile-time revision: the type of the argument passed by dispatch_revision().
+template <qrvmc_revision Rev>
+using revision_constant = std::integral_constant<qrvmc_revision, Rev>;
+
+/// Calls @p f with the revision @p rev converted to the compile-time constant,
+/// the argument of type revision_constant.
+///
+/// This lets a VM instantiate the revision-specific code (e.g. the interpreter loop with
+/// the instruction costs being constants) once per revision and select it once
+/// at the beginning of the execution, instead of checking the revision in the instruction
+/// implementations. The @p f must return the same type for all revisions.
+///
+/// The @p rev must be a known revision, i.e. not above ::QRVMC_MAX_REVISION.
+/// Unknown revisions are dispatched as the earliest one (::QRVMC_SHANGHAI).
+///
+/// @code
+/// return qrvmc::dispatch_revision(rev, [&](auto revision) {
+///     return interpret<decltype(revision)::value>(msg, code, code_size);
+/// });
+/// @endcode
+template <typename F, qrvmc_revision Rev = QRVMC_MAX_REVISION>
+constexpr decltype(auto) dispatch_revision(qrvmc_revision rev, F&& f)
+{
+    if constexpr (Rev == QRVMC_SHANGHAI)
+    {
+        (void)rev;
+        return std::forward<F>(f)(revision_constant<Rev>{});
+    }
+    else
+    {
+        if (rev == Rev)
+            return std::forward<F>(f)(revision_constant<Rev>{});
+        return dispatch_revision<F, static_cast<qrvmc_revision>(Rev - 1)>(rev,
+                                                                          std::forward<F>(f));
+    }
+}
+
+
 /// Alias for qrvmc_make_result().
 constexpr auto make_result = qrvmc_make_result;
 
@@ -486,6 +984,11 @@ public:
     /// @copydoc qrvmc_host_interface::get_tx_context
     virtual qrvmc_tx_context get_tx_context() const noexcept = 0;
 
+    /// @copydoc qrvmc_host_interface::get_tx_context_ptr
+    ///
+    /// Returns null by default: the context is not available as a pointer.
+    virtual const qrvmc_tx_context* get_tx_context_ptr() const noexcept { return nullptr; }
+
     /// @copydoc qrvmc_host_interface::get_block_hash
     virtual bytes32 get_block_hash(int64_t block_number) const noexcept = 0;
 
@@ -496,6 +999,19 @@ public:
                           const bytes32 topics[],
                           size_t num_topics) noexcept = 0;
 
+    /// @copydoc qrvmc_host_interface::emit_logs
+    ///
+    /// Calls emit_log() for each of the logs by default.
+    virtual void emit_logs(const qrvmc_log* logs, size_t num_logs) noexcept
+    {
+        for (size_t i = 0; i < num_logs; ++i)
+        {
+            const auto& log = logs[i];
+            emit_log(log.address, log.data, log.data_size,
+                     static_cast<const bytes32*>(log.topics), log.topics_count);
+        }
+    }
+
     /// @copydoc qrvmc_host_interface::access_account
     virtual qrvmc_access_status access_account(const address& addr) noexcept = 0;
 
@@ -598,6 +1114,163 @@ public:
 };
 
 
+/// The transaction context fetched from the host lazily, at most once per execution.
+///
+/// To be used by VM implementations for the instructions like NUMBER or TIMESTAMP, so
+/// the context is not copied from the host by each of them. If the message has
+/// the ::QRVMC_HOST_TX_CONTEXT_PTR flag, the host's context is referenced without a copy.
+class TxContextCache
+{
+    const qrvmc_host_interface* m_host = nullptr;
+    qrvmc_host_context* m_context = nullptr;
+    bool m_has_ptr_fn = false;
+    const qrvmc_tx_context* m_tx_context = nullptr;
+    qrvmc_tx_context m_copy;  // Not initialized until fetched.
+
+public:
+    /// Creates the cache for the execution of the @p msg.
+    /// The @p host is not accessed until the context is requested.
+    TxContextCache(const qrvmc_host_interface* host,
+                   qrvmc_host_context* context,
+                   const qrvmc_message& msg) noexcept
+      : m_host{host},
+        m_context{context},
+        m_has_ptr_fn{(msg.flags & QRVMC_HOST_TX_CONTEXT_PTR) != 0}
+    {}
+
+    TxContextCache(const TxContextCache&) = delete;
+    TxContextCache& operator=(const TxContextCache&) = delete;
+
+    /// Returns the transaction context, fetching it from the host on the first use.
+    const qrvmc_tx_context& get() noexcept
+    {
+        if (m_tx_context == nullptr)
+            m_tx_context = fetch();
+        return *m_tx_context;
+    }
+
+private:
+    const qrvmc_tx_context* fetch() noexcept
+    {
+        if (m_has_ptr_fn && m_host->get_tx_context_ptr != nullptr)
+        {
+            if (const auto* tx_context = m_host->get_tx_context_ptr(m_context))
+                return tx_context;
+        }
+        m_copy = m_host->get_tx_context(m_context);
+        return &m_copy;
+    }
+};
+
+
+/// The buffer of the logs of an execution, passed to the host in a single batch.
+///
+/// To be used by VM implementations for the LOG instructions: the logs are appended
+/// to the buffer and flushed to the host when the execution ends successfully and before
+/// each call, what keeps the order of the logs of the nested calls. The buffer may be shared
+/// by the nested executions with the VM: each one checkpoints the size at its start and
+/// truncates the buffer to it when failed, and the one called directly by the execution
+/// in the same VM may leave its logs to the caller instead of flushing.
+/// The logs of the failed executions are dropped without reaching the host. The data and
+/// the topics are copied to the single growing blob, the ::qrvmc_log descriptors pointing
+/// into it are made when flushing. If the message has the ::QRVMC_HOST_EMIT_LOGS flag,
+/// the batch is passed to qrvmc_host_interface::emit_logs, otherwise the logs are emitted
+/// one by one.
+/// The buffer keeps its memory when cleared, so it can be reused without allocations.
+class LogBuffer
+{
+    /// The log with the data and the topics at the offsets in the blob.
+    struct Entry
+    {
+        address addr;
+        size_t topics_offset;
+        size_t topics_count;
+        size_t data_offset;
+        size_t data_size;
+    };
+
+    std::vector<Entry> m_entries;
+    std::vector<uint8_t> m_blob;
+    std::vector<qrvmc_log> m_batch;
+
+public:
+    /// Returns true if there are no buffered logs.
+    bool empty() const noexcept { return m_entries.empty(); }
+
+    /// Returns the number of the buffered logs.
+    size_t size() const noexcept { return m_entries.size(); }
+
+    /// Appends the log, copying its data and topics.
+    void append(const address& addr,
+                const uint8_t* data,
+                size_t data_size,
+                const bytes32 topics[],
+                size_t topics_count)
+    {
+        const auto topics_size = topics_count * sizeof(bytes32);
+        const auto topics_offset = m_blob.size();
+        m_blob.resize(topics_offset + topics_size + data_size);
+        if (topics_size != 0)
+            std::memcpy(&m_blob[topics_offset], topics, topics_size);
+        if (data_size != 0)
+            std::memcpy(&m_blob[topics_offset + topics_size], data, data_size);
+        m_entries.push_back(
+            {addr, topics_offset, topics_count, topics_offset + topics_size, data_size});
+    }
+
+    /// Passes the buffered logs to the @p host and clears the buffer.
+    /// The @p msg is the message of the execution, the ::QRVMC_HOST_EMIT_LOGS flag of which
+    /// tells if the host accepts the batches.
+    void flush(const qrvmc_host_interface* host,
+               qrvmc_host_context* context,
+               const qrvmc_message& msg)
+    {
+        if (m_entries.empty())
+            return;
+
+        const auto* const blob = m_blob.data();
+        if ((msg.flags & QRVMC_HOST_EMIT_LOGS) != 0 && host->emit_logs != nullptr)
+        {
+            m_batch.clear();
+            for (const auto& e : m_entries)
+            {
+                m_batch.push_back({e.addr, &blob[e.data_offset], e.data_size,
+                                   reinterpret_cast<const qrvmc_bytes32*>(&blob[e.topics_offset]),
+                                   e.topics_count});
+            }
+            host->emit_logs(context, m_batch.data(), m_batch.size());
+        }
+        else
+        {
+            for (const auto& e : m_entries)
+            {
+                host->emit_log(context, &e.addr, &blob[e.data_offset], e.data_size,
+                               reinterpret_cast<const qrvmc_bytes32*>(&blob[e.topics_offset]),
+                               e.topics_count);
+            }
+        }
+        clear();
+    }
+
+    /// Drops the buffered logs.
+    void clear() noexcept
+    {
+        m_entries.clear();
+        m_blob.clear();
+    }
+
+    /// Drops the buffered logs following the first @p size ones, e.g. the logs appended
+    /// after the size checkpoint by the failed execution.
+    void truncate(size_t size) noexcept
+    {
+        if (size >= m_entries.size())
+            return;
+        m_blob.resize(m_entries[size].topics_offset);
+        m_entries.erase(m_entries.begin() + static_cast<std::ptrdiff_t>(size), m_entries.end());
+    }
+};
+
+
 /// Abstract class to be used by Host implementations.
 ///
 /// When implementing QRVMC Host, you can directly inherit from the qrvmc::Host class.
@@ -633,6 +1306,163 @@ public:
 };
 
 
+/// Base class template for Host implementations bound to the host interface at compile time.
+///
+/// The alternative to qrvmc::Host avoiding the virtual calls. The Derived class implements
+/// the methods of the HostInterface, but as non-virtual ones. The host interface functions
+/// call them directly, so they can be inlined and each host call from the VM is a single
+/// indirect call. Use as `class MyHost : public qrvmc::StaticHost<MyHost>`.
+template <typename Derived>
+class StaticHost
+{
+public:
+    /// Provides access to the host interface of the Derived class.
+    /// @returns  Reference to the host interface object.
+    static const qrvmc_host_interface& get_interface() noexcept
+    {
+        static constexpr qrvmc_host_interface interface = {
+            Thunks::account_exists, Thunks::get_storage,    Thunks::set_storage,
+            Thunks::get_balance,    Thunks::get_code_size,  Thunks::get_code_hash,
+            Thunks::copy_code,      Thunks::call,           Thunks::get_tx_context,
+            Thunks::get_block_hash, Thunks::emit_log,       Thunks::access_account,
+            Thunks::access_storage, Thunks::get_tx_context_ptr, Thunks::emit_logs,
+        };
+        return interface;
+    }
+
+    /// Converts the Host object to the opaque host context pointer.
+    /// @returns  Pointer to qrvmc_host_context.
+    qrvmc_host_context* to_context() noexcept
+    {
+        return reinterpret_cast<qrvmc_host_context*>(static_cast<Derived*>(this));
+    }
+
+    /// Converts the opaque host context pointer back to the Derived object.
+    static Derived* from_context(qrvmc_host_context* context) noexcept
+    {
+        return reinterpret_cast<Derived*>(context);
+    }
+
+    /// @copydoc HostInterface::get_tx_context_ptr
+    const qrvmc_tx_context* get_tx_context_ptr() const noexcept { return nullptr; }
+
+    /// @copydoc HostInterface::emit_logs
+    void emit_logs(const qrvmc_log* logs, size_t num_logs) noexcept
+    {
+        for (size_t i = 0; i < num_logs; ++i)
+        {
+            const auto& log = logs[i];
+            static_cast<Derived*>(this)->emit_log(log.address, log.data, log.data_size,
+                                                  static_cast<const bytes32*>(log.topics),
+                                                  log.topics_count);
+        }
+    }
+
+private:
+    /// The host interface functions. Kept in the nested struct, so they do not hide
+    /// the methods of the Derived class inherited from its other bases.
+    struct Thunks
+    {
+        static bool account_exists(qrvmc_host_context* h, const qrvmc_address* addr) noexcept
+        {
+            return from_context(h)->account_exists(*addr);
+        }
+
+        static qrvmc_bytes32 get_storage(qrvmc_host_context* h,
+                                         const qrvmc_address* addr,
+                                         const qrvmc_bytes32* key) noexcept
+        {
+            return from_context(h)->get_storage(*addr, *key);
+        }
+
+        static qrvmc_storage_status set_storage(qrvmc_host_context* h,
+                                                const qrvmc_address* addr,
+                                                const qrvmc_bytes32* key,
+                                                const qrvmc_bytes32* value) noexcept
+        {
+            return from_context(h)->set_storage(*addr, *key, *value);
+        }
+
+        static qrvmc_uint256be get_balance(qrvmc_host_context* h,
+                                           const qrvmc_address* addr) noexcept
+        {
+            return from_context(h)->get_balance(*addr);
+        }
+
+        static size_t get_code_size(qrvmc_host_context* h, const qrvmc_address* addr) noexcept
+        {
+            return from_context(h)->get_code_size(*addr);
+        }
+
+        static qrvmc_bytes32 get_code_hash(qrvmc_host_context* h,
+                                           const qrvmc_address* addr) noexcept
+        {
+            return from_context(h)->get_code_hash(*addr);
+        }
+
+        static size_t copy_code(qrvmc_host_context* h,
+                                const qrvmc_address* addr,
+                                size_t code_offset,
+                                uint8_t* buffer_data,
+                                size_t buffer_size) noexcept
+        {
+            return from_context(h)->copy_code(*addr, code_offset, buffer_data, buffer_size);
+        }
+
+        static qrvmc_result call(qrvmc_host_context* h, const qrvmc_message* msg) noexcept
+        {
+            return from_context(h)->call(*msg).release_raw();
+        }
+
+        static qrvmc_tx_context get_tx_context(qrvmc_host_context* h) noexcept
+        {
+            return from_context(h)->get_tx_context();
+        }
+
+        static const qrvmc_tx_context* get_tx_context_ptr(qrvmc_host_context* h) noexcept
+        {
+            return from_context(h)->get_tx_context_ptr();
+        }
+
+        static qrvmc_bytes32 get_block_hash(qrvmc_host_context* h, int64_t block_number) noexcept
+        {
+            return from_context(h)->get_block_hash(block_number);
+        }
+
+        static void emit_log(qrvmc_host_context* h,
+                             const qrvmc_address* addr,
+                             const uint8_t* data,
+                             size_t data_size,
+                             const qrvmc_bytes32 topics[],
+                             size_t num_topics) noexcept
+        {
+            from_context(h)->emit_log(*addr, data, data_size, static_cast<const bytes32*>(topics),
+                                      num_topics);
+        }
+
+        static void emit_logs(qrvmc_host_context* h,
+                              const qrvmc_log* logs,
+                              size_t num_logs) noexcept
+        {
+            from_context(h)->emit_logs(logs, num_logs);
+        }
+
+        static qrvmc_access_status access_account(qrvmc_host_context* h,
+                                                  const qrvmc_address* addr) noexcept
+        {
+            return from_context(h)->access_account(*addr);
+        }
+
+        static qrvmc_access_status access_storage(qrvmc_host_context* h,
+                                                  const qrvmc_address* addr,
+                                                  const qrvmc_bytes32* key) noexcept
+        {
+            return from_context(h)->access_storage(*addr, *key);
+        }
+    };
+};
+
+
 /// @copybrief qrvmc_vm
 ///
 /// This is a RAII wrapper for qrvmc_vm, and object of this type
@@ -817,6 +1647,11 @@ inline qrvmc_tx_context get_tx_context(qrvmc_host_context* h) noexcept
     return Host::from_context(h)->get_tx_context();
 }
 
+inline const qrvmc_tx_context* get_tx_context_ptr(qrvmc_host_context* h) noexcept
+{
+    return Host::from_context(h)->get_tx_context_ptr();
+}
+
 inline qrvmc_bytes32 get_block_hash(qrvmc_host_context* h, int64_t block_number) noexcept
 {
     return Host::from_context(h)->get_block_hash(block_number);
@@ -833,6 +1668,11 @@ inline void emit_log(qrvmc_host_context* h,
                                     num_topics);
 }
 
+inline void emit_logs(qrvmc_host_context* h, const qrvmc_log* logs, size_t num_logs) noexcept
+{
+    Host::from_context(h)->emit_logs(logs, num_logs);
+}
+
 inline qrvmc_access_status access_account(qrvmc_host_context* h, const qrvmc_address* addr) noexcept
 {
     return Host::from_context(h)->access_account(*addr);
@@ -855,7 +1695,8 @@ inline const qrvmc_host_interface& Host::get_interface() noexcept
         ::qrvmc::internal::copy_code,      ::qrvmc::internal::call,
         ::qrvmc::internal::get_tx_context, ::qrvmc::internal::get_block_hash,
         ::qrvmc::internal::emit_log,       ::qrvmc::internal::access_account,
-        ::qrvmc::internal::access_storage,
+        ::qrvmc::internal::access_storage, ::qrvmc::internal::get_tx_context_ptr,
+        ::qrvmc::internal::emit_logs,
     };
     return interface;
 }
@@ -0,0 +1,345 @@
+// EVMC: Ethereum Client-VM Connector API.
+// Copyright 2026 The EVMC Authors.
+// Licensed under the Apache License, Version 2.0.
+#pragma once
+
+#include <qrvmc/qrvmc.hpp>
+#include <algorithm>
+#include <vector>
+
+namespace qrvmc
+{
+/// The storage slot: the account address and the storage key.
+struct StorageSlot
+{
+    address addr;  ///< The account address.
+    bytes32 key;   ///< The storage key.
+
+    /// The "equal to" comparison operator.
+    friend bool operator==(const StorageSlot& a, const StorageSlot& b) noexcept
+    {
+        return a.key == b.key && a.addr == b.addr;
+    }
+
+    /// The "less than" comparison operator: by the last word of the key, then by the key,
+    /// then by the address. Both the small sequential keys and the hashed keys mostly differ
+    /// in the last word, what makes the comparison cheap. This is not the lexicographic order.
+    friend bool operator<(const StorageSlot& a, const StorageSlot& b) noexcept
+    {
+        const auto a_word = load64le(&a.key.bytes[24]);
+        const auto b_word = load64le(&b.key.bytes[24]);
+        if (a_word != b_word)
+            return a_word < b_word;
+        return a.key < b.key || (a.key == b.key && a.addr < b.addr);
+    }
+};
+
+namespace internal
+{
+/// Returns true if the sorted vectors have a common element.
+///
+/// The elements of the much smaller vector are looked up in the bigger one with the binary
+/// search advancing from the previous match, the vectors of similar sizes are merged.
+template <typename T>
+bool sorted_intersect(const std::vector<T>& a, const std::vector<T>& b) noexcept
+{
+    const auto& small = a.size() <= b.size() ? a : b;
+    const auto& big = a.size() <= b.size() ? b : a;
+    if (small.empty() || big.back() < small.front() || small.back() < big.front())
+        return false;
+
+    if (small.size() * 8 < big.size())
+    {
+        auto it = big.begin();
+        for (const auto& x : small)
+        {
+            it = std::lower_bound(it, big.end(), x);
+            if (it == big.end())
+                return false;
+            if (!(x < *it))
+                return true;
+        }
+        return false;
+    }
+
+    auto i = a.begin();
+    auto j = b.begin();
+    while (i != a.end() && j != b.end())
+    {
+        if (*i < *j)
+            ++i;
+        else if (*j < *i)
+            ++j;
+        else
+            return true;
+    }
+    return false;
+}
+
+/// Sorts the vector and removes the duplicates.
+template <typename T>
+void sort_unique(std::vector<T>& v)
+{
+    std::sort(v.begin(), v.end());
+    v.erase(std::unique(v.begin(), v.end()), v.end());
+}
+}  // namespace internal
+
+/// The set of the accessed accounts and storage slots.
+///
+/// While recording, the elements are appended in any order and with duplicates,
+/// what costs a single vector append per access. Only the repeated accesses to the same
+/// element (e.g. the SSTORE of the slot just loaded) are skipped by add().
+/// The normalize() sorts and deduplicates the elements. Only the normalized sets can be
+/// checked for intersection.
+struct AccessSet
+{
+    std::vector<address> accounts;   ///< The accounts.
+    std::vector<StorageSlot> slots;  ///< The storage slots.
+
+    /// Adds the account.
+    void add(const address& addr)
+    {
+        if (accounts.empty() || accounts.back() != addr)
+            accounts.push_back(addr);
+    }
+
+    /// Adds the storage slot.
+    void add(const address& addr, const bytes32& key)
+    {
+        if (slots.empty() || !(slots.back().key == key && slots.back().addr == addr))
+            slots.push_back({addr, key});
+    }
+
+    /// Returns true if the set has no accounts and no storage slots.
+    bool empty() const noexcept { return accounts.empty() && slots.empty(); }
+
+    /// Removes all the elements, keeping the memory for reuse.
+    void clear() noexcept
+    {
+        accounts.clear();
+        slots.clear();
+    }
+
+    /// Sorts the elements and removes the duplicates.
+    void normalize()
+    {
+        internal::sort_unique(accounts);
+        internal::sort_unique(slots);
+    }
+
+    /// Returns true if the normalized sets have a common account or storage slot.
+    bool intersects(const AccessSet& other) const noexcept
+    {
+        return internal::sorted_intersect(slots, other.slots) ||
+               internal::sorted_intersect(accounts, other.accounts);
+    }
+};
+
+/// The read set and the write set of an execution.
+struct ReadWriteSet
+{
+    AccessSet reads;   ///< The state read by the execution.
+    AccessSet writes;  ///< The state modified by the execution.
+
+    /// Removes all the elements, keeping the memory for reuse.
+    void clear() noexcept
+    {
+        reads.clear();
+        writes.clear();
+    }
+
+    /// Normalizes both sets.
+    void normalize()
+    {
+        reads.normalize();
+        writes.normalize();
+    }
+};
+
+/// Returns true if the @p later execution conflicts with the @p earlier one, i.e. it has read
+/// the state modified by the @p earlier one. The @p later execution speculated to run
+/// before the @p earlier one must be then executed again to be serializable after it.
+/// The writes of the same state do not conflict if the write sets are applied in the order.
+/// Both sets must be normalized.
+inline bool conflicts(const ReadWriteSet& earlier, const ReadWriteSet& later) noexcept
+{
+    return later.reads.intersects(earlier.writes);
+}
+
+/// The Host decorator recording the read and write sets of the execution.
+///
+/// All host methods are forwarded to the wrapped host, and the accessed state is recorded:
+/// - the account reads: account_exists(), get_balance(), get_code_size(), get_code_hash(),
+///   copy_code() and the account of the code executed by call(),
+/// - the storage reads: get_storage() and set_storage(), as the returned storage status
+///   depends on the current value,
+/// - the storage writes: set_storage(),
+/// - the account reads and writes: the sender and the recipient of the call transferring
+///   the value, the creator and the created account of the contract creation.
+/// The account entries cover the balance, the nonce and the code of the account together.
+/// The transaction and the block context, the logs and the ::qrvmc_access_status of
+/// the accounts and the storage slots (local to the transaction) are not recorded.
+///
+/// The sets over-approximate the accesses: the state modifications of the failed calls
+/// are recorded as well. The accesses of the nested executions are recorded only if these
+/// use this host, e.g. the wrapped host executes the nested calls with the RecordingHost.
+class RecordingHost : public Host
+{
+    HostInterface& m_host;
+    mutable ReadWriteSet m_set;  ///< Recorded also by the const host methods.
+
+public:
+    /// Creates the decorator of the @p host. The host is not owned and must outlive it.
+    explicit RecordingHost(HostInterface& host) noexcept : m_host{host} {}
+
+    /// Returns the wrapped host.
+    HostInterface& host() const noexcept { return m_host; }
+
+    /// Normalizes and returns the sets recorded since the previous clear().
+    const ReadWriteSet& read_write_set()
+    {
+        m_set.normalize();
+        return m_set;
+    }
+
+    /// Clears the recorded sets, e.g. before the next execution.
+    void clear() noexcept { m_set.clear(); }
+
+    /// @copydoc HostInterface::account_exists
+    bool account_exists(const address& addr) const noexcept override
+    {
+        record_read(addr);
+        return m_host.account_exists(addr);
+    }
+
+    /// @copydoc HostInterface::get_storage
+    bytes32 get_storage(const address& addr, const bytes32& key) const noexcept override
+    {
+        record_read(addr, key);
+        return m_host.get_storage(addr, key);
+    }
+
+    /// @copydoc HostInterface::set_storage
+    qrvmc_storage_status set_storage(const address& addr,
+                                     const bytes32& key,
+                                     const bytes32& value) noexcept override
+    {
+        record_read(addr, key);
+        m_set.writes.add(addr, key);
+        return m_host.set_storage(addr, key, value);
+    }
+
+    /// @copydoc HostInterface::get_balance
+    uint256be get_balance(const address& addr) const noexcept override
+    {
+        record_read(addr);
+        return m_host.get_balance(addr);
+    }
+
+    /// @copydoc HostInterface::get_code_size
+    size_t get_code_size(const address& addr) const noexcept override
+    {
+        record_read(addr);
+        return m_host.get_code_size(addr);
+    }
+
+    /// @copydoc HostInterface::get_code_hash
+    bytes32 get_code_hash(const address& addr) const noexcept override
+    {
+        record_read(addr);
+        return m_host.get_code_hash(addr);
+    }
+
+    /// @copydoc HostInterface::copy_code
+    size_t copy_code(const address& addr,
+                     size_t code_offset,
+                     uint8_t* buffer_data,
+                     size_t buffer_size) const noexcept override
+    {
+        record_read(addr);
+        return m_host.copy_code(addr, code_offset, buffer_data, buffer_size);
+    }
+
+    /// @copydoc HostInterface::call
+    Result call(const qrvmc_message& msg) noexcept override
+    {
+        const bool is_create = msg.kind == QRVMC_CREATE || msg.kind == QRVMC_CREATE2;
+        if (is_create)
+            record_write(msg.sender);  // The nonce.
+        else
+            record_read(msg.code_address);
+
+        if (msg.kind == QRVMC_CALL && !is_zero(msg.value))
+        {
+            record_write(msg.sender);
+            record_write(msg.recipient);
+        }
+
+        auto result = m_host.call(msg);
+        if (is_create && result.create_address != address{})
+            record_write(result.create_address);
+        return result;
+    }
+
+    /// @copydoc HostInterface::get_tx_context
+    qrvmc_tx_context get_tx_context() const noexcept override { return m_host.get_tx_context(); }
+
+    /// @copydoc HostInterface::get_tx_context_ptr
+    const qrvmc_tx_context* get_tx_context_ptr() const noexcept override
+    {
+        return m_host.get_tx_context_ptr();
+    }
+
+    /// @copydoc HostInterface::get_block_hash
+    bytes32 get_block_hash(int64_t block_number) const noexcept override
+    {
+        return m_host.get_block_hash(block_number);
+    }
+
+    /// @copydoc HostInterface::emit_log
+    void emit_log(const address& addr,
+                  const uint8_t* data,
+                  size_t data_size,
+                  const bytes32 topics[],
+                  size_t num_topics) noexcept override
+    {
+        m_host.emit_log(addr, data, data_size, topics, num_topics);
+    }
+
+    /// @copydoc HostInterface::emit_logs
+    void emit_logs(const qrvmc_log* logs, size_t num_logs) noexcept override
+    {
+        m_host.emit_logs(logs, num_logs);
+    }
+
+    /// @copydoc HostInterface::access_account
+    qrvmc_access_status access_account(const address& addr) noexcept override
+    {
+        return m_host.access_account(addr);
+    }
+
+    /// @copydoc HostInterface::access_storage
+    qrvmc_access_status access_storage(const address& addr, const bytes32& key) noexcept override
+    {
+        return m_host.access_storage(addr, key);
+    }
+
+private:
+    /// Records the read of the account.
+    void record_read(const address& addr) const { m_set.reads.add(addr); }
+
+    /// Records the read of the storage slot.
+    void record_read(const address& addr, const bytes32& key) const
+    {
+        m_set.reads.add(addr, key);
+    }
+
+    /// Records the modification of the account, which reads it as well.
+    void record_write(const address& addr)
+    {
+        m_set.reads.add(addr);
+        m_set.writes.add(addr);
+    }
+};
+}  // namespace qrvmc
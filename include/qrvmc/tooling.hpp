@@ -2,12 +2,27 @@
 // Copyright 2020 The EVMC Authors.
 // Licensed under the Apache License, Version 2.0.
 
-#include <qrvmc/qrvmc.hpp>
+#include <qrvmc/mocked_host.hpp>
 #include <iosfwd>
 #include <string>
+#include <unordered_map>
 
 namespace qrvmc::tooling
 {
+/// The initial state of the execution.
+struct State
+{
+    /// The code of the accounts available to nested calls.
+    std::unordered_map<address, bytes> accounts;
+
+    /// The hashes of the recent blocks available to the BLOCKHASH instruction.
+    BlockHashes block_hashes;
+};
+
+/// Executes the code with the VM and prints the result to @p out.
+///
+/// Nested calls are executed with the same VM by qrvmc::ExecutingMockedHost
+/// initialized with the given @p state.
 int run(VM& vm,
         qrvmc_revision rev,
         int64_t gas,
@@ -15,5 +30,6 @@ int run(VM& vm,
         bytes_view input,
         bool create,
         bool bench,
-        std::ostream& out);
+        std::ostream& out,
+        const State& state = {});
 }  // namespace qrvmc::tooling
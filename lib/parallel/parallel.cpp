@@ -0,0 +1,558 @@
+// EVMC: Ethereum Client-VM Connector API.
+// Copyright 2026 The EVMC Authors.
+// Licensed under the Apache License, Version 2.0.
+
+#include <qrvmc/executing_mocked_host.hpp>
+#include <qrvmc/parallel.hpp>
+#include <qrvmc/recording_host.hpp>
+#include <array>
+#include <optional>
+
+namespace qrvmc::parallel
+{
+ThreadPool::ThreadPool(size_t num_threads)
+  : m_num_workers{std::max(num_threads, size_t{1})}, m_ranges{new Range[m_num_workers]}
+{
+    m_threads.reserve(m_num_workers - 1);
+    for (size_t worker = 1; worker < m_num_workers; ++worker)
+        m_threads.emplace_back([this, worker] { thread_loop(worker); });
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        const std::lock_guard lock{m_mutex};
+        m_stop = true;
+    }
+    m_start.notify_all();
+    for (auto& thread : m_threads)
+        thread.join();
+}
+
+void ThreadPool::run(size_t num_tasks, const Task& task)
+{
+    for (size_t worker = 0; worker < m_num_workers; ++worker)
+    {
+        auto& range = m_ranges[worker];
+        const std::lock_guard lock{range.mutex};
+        range.begin = num_tasks * worker / m_num_workers;
+        range.end = num_tasks * (worker + 1) / m_num_workers;
+    }
+
+    if (!m_threads.empty())
+    {
+        {
+            const std::lock_guard lock{m_mutex};
+            m_task = &task;
+            m_num_running = m_threads.size();
+            ++m_generation;
+        }
+        m_start.notify_all();
+    }
+
+    work(0, task);
+
+    std::unique_lock lock{m_mutex};
+    m_done.wait(lock, [this] { return m_num_running == 0; });
+    m_task = nullptr;
+}
+
+void ThreadPool::thread_loop(size_t worker)
+{
+    uint64_t generation = 0;
+    while (true)
+    {
+        const Task* task = nullptr;
+        {
+            std::unique_lock lock{m_mutex};
+            m_start.wait(lock, [&] { return m_stop || m_generation != generation; });
+            if (m_stop)
+                return;
+            generation = m_generation;
+            task = m_task;
+        }
+
+        work(worker, *task);
+
+        {
+            const std::lock_guard lock{m_mutex};
+            --m_num_running;
+        }
+        m_done.notify_one();
+    }
+}
+
+void ThreadPool::work(size_t worker, const Task& task)
+{
+    size_t index = 0;
+    while (next_task(worker, index))
+        task(worker, index);
+}
+
+bool ThreadPool::next_task(size_t worker, size_t& task)
+{
+    auto& own = m_ranges[worker];
+    {
+        const std::lock_guard lock{own.mutex};
+        if (own.begin != own.end)
+        {
+            task = own.begin++;
+            return true;
+        }
+    }
+
+    for (size_t i = 1; i < m_num_workers; ++i)
+    {
+        auto& victim = m_ranges[(worker + i) % m_num_workers];
+        size_t begin = 0;
+        size_t end = 0;
+        {
+            const std::lock_guard lock{victim.mutex};
+            if (victim.begin == victim.end)
+                continue;
+            begin = victim.begin + (victim.end - victim.begin) / 2;
+            end = victim.end;
+            victim.end = begin;
+        }
+
+        // The stolen range is not empty: the half is rounded down, so it gets the last task.
+        task = begin;
+        const std::lock_guard lock{own.mutex};
+        own.begin = begin + 1;
+        own.end = end;
+        return true;
+    }
+    return false;
+}
+
+namespace
+{
+/// The hash of the storage slot.
+struct StorageSlotHash
+{
+    size_t operator()(const StorageSlot& slot) const noexcept
+    {
+        return std::hash<bytes32>{}(slot.key) ^ std::hash<address>{}(slot.addr);
+    }
+};
+
+/// Returns the copy of the account without the storage.
+MockedAccount account_fields(const MockedAccount& acc)
+{
+    MockedAccount copy;
+    copy.nonce = acc.nonce;
+    copy.code = acc.code;
+    copy.codehash = acc.codehash;
+    copy.balance = acc.balance;
+    return copy;
+}
+
+/// Returns true if the accounts are the same, not comparing the storage.
+bool same_fields(const MockedAccount& a, const MockedAccount& b) noexcept
+{
+    return a.nonce == b.nonce && a.balance == b.balance && a.codehash == b.codehash &&
+           a.code == b.code;
+}
+
+/// Returns the current value of the storage slot in the state.
+bytes32 storage_value(const State& state, const StorageSlot& slot) noexcept
+{
+    const auto it = state.find(slot.addr);
+    if (it == state.end())
+        return {};
+    const auto storage_it = it->second.storage.find(slot.key);
+    return storage_it != it->second.storage.end() ? storage_it->second.current : bytes32{};
+}
+
+/// The map of the values written by the transactions, each value tagged with the index
+/// of the transaction. Safe to be accessed concurrently.
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class VersionedMap
+{
+    static constexpr size_t num_shards = 64;
+
+    /// The shard: a subset of the keys guarded by a lock.
+    /// The versions of each key are sorted by the transaction index.
+    struct alignas(64) Shard
+    {
+        mutable std::mutex mutex;
+        std::unordered_map<Key, std::vector<std::pair<size_t, Value>>, Hash> versions;
+    };
+
+    std::array<Shard, num_shards> m_shards;
+
+    Shard& shard(const Key& key) noexcept { return m_shards[Hash{}(key) % num_shards]; }
+
+    const Shard& shard(const Key& key) const noexcept
+    {
+        return m_shards[Hash{}(key) % num_shards];
+    }
+
+public:
+    /// Adds the value written by the transaction @p tx.
+    void insert(const Key& key, size_t tx, const Value& value)
+    {
+        auto& s = shard(key);
+        const std::lock_guard lock{s.mutex};
+        auto& versions = s.versions[key];
+        const auto it = std::lower_bound(versions.begin(), versions.end(), tx,
+                                         [](const auto& v, size_t t) { return v.first < t; });
+        versions.insert(it, {tx, value});
+    }
+
+    /// Returns the value written by the last of the transactions preceding @p tx, if any.
+    std::optional<Value> find(const Key& key, size_t tx) const
+    {
+        const auto& s = shard(key);
+        const std::lock_guard lock{s.mutex};
+        const auto it = s.versions.find(key);
+        if (it == s.versions.end())
+            return {};
+        const auto& versions = it->second;
+        const auto v = std::lower_bound(versions.begin(), versions.end(), tx,
+                                        [](const auto& v_, size_t t) { return v_.first < t; });
+        if (v == versions.begin())
+            return {};
+        return std::prev(v)->second;
+    }
+
+    /// Removes all the values.
+    void clear() noexcept
+    {
+        for (auto& s : m_shards)
+            s.versions.clear();
+    }
+};
+
+/// The state modifications of the block's transactions already executed.
+struct Versions
+{
+    VersionedMap<address, MockedAccount> accounts;
+    VersionedMap<StorageSlot, bytes32, StorageSlotHash> storage;
+
+    /// Removes all the versions.
+    void clear() noexcept
+    {
+        accounts.clear();
+        storage.clear();
+    }
+};
+
+/// The state read and written by the transaction.
+struct TxRecord
+{
+    /// The accounts as read, before the modifications by the transaction, or none.
+    std::vector<std::pair<address, std::optional<MockedAccount>>> account_reads;
+
+    /// The storage values as read, before the modifications by the transaction.
+    std::vector<std::pair<StorageSlot, bytes32>> storage_reads;
+
+    /// The modified accounts, without the storage.
+    std::vector<std::pair<address, MockedAccount>> account_writes;
+
+    /// The modified storage values.
+    std::vector<std::pair<StorageSlot, bytes32>> storage_writes;
+
+    /// Removes all the entries.
+    void clear() noexcept
+    {
+        account_reads.clear();
+        storage_reads.clear();
+        account_writes.clear();
+        storage_writes.clear();
+    }
+
+    /// Returns true if the values read are the current values in the @p state.
+    bool is_valid(const State& state) const noexcept
+    {
+        for (const auto& [addr, acc] : account_reads)
+        {
+            const auto it = state.find(addr);
+            if (it == state.end() ? acc.has_value() : !acc || !same_fields(*acc, it->second))
+                return false;
+        }
+        for (const auto& [slot, value] : storage_reads)
+        {
+            if (storage_value(state, slot) != value)
+                return false;
+        }
+        return true;
+    }
+
+    /// Applies the modifications to the @p state. The storage values written are the original
+    /// values for the next transaction.
+    void commit(State& state) const
+    {
+        for (const auto& [addr, acc] : account_writes)
+        {
+            auto& committed = state[addr];
+            committed.nonce = acc.nonce;
+            committed.code = acc.code;
+            committed.codehash = acc.codehash;
+            committed.balance = acc.balance;
+        }
+        for (const auto& [slot, value] : storage_writes)
+            state[slot.addr].storage[slot.key] = StorageValue{value};
+    }
+
+    /// Publishes the modifications as the versions written by the transaction @p tx.
+    void publish(Versions& versions, size_t tx) const
+    {
+        for (const auto& [addr, acc] : account_writes)
+            versions.accounts.insert(addr, tx, acc);
+        for (const auto& [slot, value] : storage_writes)
+            versions.storage.insert(slot, tx, value);
+    }
+};
+
+/// The host executing the single transaction.
+///
+/// The accounts and the storage values are loaded to the MockedHost state on the first access,
+/// from the versions written by the preceding transactions, if provided, or from the base
+/// state. The loaded values are recorded as the read set. After the execution, the loaded values
+/// modified by the transaction are recorded as the write set.
+class TxHost : public ExecutingMockedHost
+{
+    const State* m_base = nullptr;
+    const Versions* m_versions = nullptr;
+    size_t m_tx = 0;
+    TxRecord* m_record = nullptr;
+
+    /// The loaded accounts missing in the state and the loaded storage slots of these accounts.
+    /// The other loaded accounts and storage slots, including the zero ones, are in the
+    /// MockedHost state. These are few, so are searched linearly.
+    mutable std::vector<address> m_missing_accounts;
+    mutable std::vector<StorageSlot> m_missing_slots;
+
+public:
+    using ExecutingMockedHost::ExecutingMockedHost;
+
+    /// Executes the transaction @p tx with the message @p msg. The logs of the successful
+    /// transaction are copied to @p logs.
+    Result execute(const qrvmc_message& msg,
+                   const State& base,
+                   const Versions* versions,
+                   size_t tx,
+                   TxRecord& record,
+                   std::vector<Log>& logs)
+    {
+        accounts.clear();
+        clear_recordings();
+        m_missing_accounts.clear();
+        m_missing_slots.clear();
+        record.clear();
+        m_base = &base;
+        m_versions = versions;
+        m_tx = tx;
+        m_record = &record;
+
+        auto result = call(msg);
+
+        for (const auto& [addr, acc] : record.account_reads)
+        {
+            const auto it = accounts.find(addr);
+            if (it != accounts.end() && (!acc || !same_fields(*acc, it->second)))
+                record.account_writes.emplace_back(addr, account_fields(it->second));
+        }
+        for (const auto& [slot, value] : record.storage_reads)
+        {
+            const auto current = storage_value(accounts, slot);
+            if (current != value)
+                record.storage_writes.emplace_back(slot, current);
+        }
+
+        logs.clear();
+        if (result.status_code == QRVMC_SUCCESS)
+        {
+            for (const auto& log : recorded_logs)
+            {
+                logs.push_back({log.creator, bytes{log.data},
+                                std::vector<bytes32>{log.topics.begin(), log.topics.end()}});
+            }
+        }
+        return result;
+    }
+
+    // The host methods load the accessed state before delegating to ExecutingMockedHost.
+
+    bool account_exists(const address& addr) const noexcept override
+    {
+        load_account(addr);
+        return ExecutingMockedHost::account_exists(addr);
+    }
+
+    bytes32 get_storage(const address& addr, const bytes32& key) const noexcept override
+    {
+        load_storage(addr, key);
+        return ExecutingMockedHost::get_storage(addr, key);
+    }
+
+    qrvmc_storage_status set_storage(const address& addr,
+                                     const bytes32& key,
+                                     const bytes32& value) noexcept override
+    {
+        load_storage(addr, key);
+        return ExecutingMockedHost::set_storage(addr, key, value);
+    }
+
+    uint256be get_balance(const address& addr) const noexcept override
+    {
+        load_account(addr);
+        return ExecutingMockedHost::get_balance(addr);
+    }
+
+    size_t get_code_size(const address& addr) const noexcept override
+    {
+        load_account(addr);
+        return ExecutingMockedHost::get_code_size(addr);
+    }
+
+    bytes32 get_code_hash(const address& addr) const noexcept override
+    {
+        load_account(addr);
+        return ExecutingMockedHost::get_code_hash(addr);
+    }
+
+    size_t copy_code(const address& addr,
+                     size_t code_offset,
+                     uint8_t* buffer_data,
+                     size_t buffer_size) const noexcept override
+    {
+        load_account(addr);
+        return ExecutingMockedHost::copy_code(addr, code_offset, buffer_data, buffer_size);
+    }
+
+    Result call(const qrvmc_message& msg) noexcept override
+    {
+        load_account(msg.sender);
+        if (msg.kind == QRVMC_CREATE || msg.kind == QRVMC_CREATE2)
+        {
+            const auto it = accounts.find(msg.sender);
+            load_account(derive_create_address(msg, it != accounts.end() ? it->second.nonce : 0));
+        }
+        else
+        {
+            load_account(msg.recipient);
+            load_account(msg.code_address);
+        }
+        return ExecutingMockedHost::call(msg);
+    }
+
+    qrvmc_access_status access_storage(const address& addr, const bytes32& key) noexcept override
+    {
+        load_storage(addr, key);
+        return ExecutingMockedHost::access_storage(addr, key);
+    }
+
+private:
+    // Loading the state on the first access is not an observable modification,
+    // so it is done by the const host methods as well.
+
+    /// Loads the account, without the storage, if not loaded yet.
+    void load_account(const address& addr) const
+    {
+        if (accounts.count(addr) != 0 ||
+            std::find(m_missing_accounts.begin(), m_missing_accounts.end(), addr) !=
+                m_missing_accounts.end())
+            return;
+
+        std::optional<MockedAccount> acc;
+        if (m_versions != nullptr)
+            acc = m_versions->accounts.find(addr, m_tx);
+        if (!acc)
+        {
+            const auto it = m_base->find(addr);
+            if (it != m_base->end())
+                acc = account_fields(it->second);
+        }
+
+        if (acc)
+            const_cast<TxHost*>(this)->accounts.emplace(addr, *acc);
+        else
+            m_missing_accounts.push_back(addr);
+        m_record->account_reads.emplace_back(addr, std::move(acc));
+    }
+
+    /// Loads the storage value, and the account, if not loaded yet.
+    void load_storage(const address& addr, const bytes32& key) const
+    {
+        load_account(addr);
+        auto& local = const_cast<TxHost*>(this)->accounts;
+        const auto it = local.find(addr);
+        if (it != local.end() && it->second.storage.count(key) != 0)
+            return;
+        const StorageSlot slot{addr, key};
+        if (std::find(m_missing_slots.begin(), m_missing_slots.end(), slot) !=
+            m_missing_slots.end())
+            return;
+
+        std::optional<bytes32> value;
+        if (m_versions != nullptr)
+            value = m_versions->storage.find(slot, m_tx);
+        if (!value)
+            value = storage_value(*m_base, slot);
+
+        if (it != local.end())
+            it->second.storage.emplace(key, StorageValue{*value});
+        else
+            m_missing_slots.push_back(slot);
+        m_record->storage_reads.emplace_back(slot, *value);
+    }
+};
+}  // namespace
+
+struct Executor::Impl
+{
+    std::vector<std::unique_ptr<TxHost>> hosts;  ///< The hosts of the worker threads.
+    std::vector<TxRecord> records;               ///< The records of the transactions.
+    Versions versions;
+};
+
+Executor::Executor(VM& vm, qrvmc_revision rev, size_t num_threads)
+  : m_pool{num_threads}, m_impl{std::make_unique<Impl>()}
+{
+    for (size_t i = 0; i < m_pool.size(); ++i)
+        m_impl->hosts.emplace_back(std::make_unique<TxHost>(vm, rev));
+}
+
+Executor::~Executor() = default;
+
+BlockResult Executor::execute(State& state, const std::vector<qrvmc_message>& transactions)
+{
+    auto& impl = *m_impl;
+    const auto n = transactions.size();
+    for (auto& host : impl.hosts)
+        host->tx_context = tx_context;
+    if (impl.records.size() < n)
+        impl.records.resize(n);
+    impl.versions.clear();
+
+    BlockResult block;
+    block.transactions.resize(n);
+
+    // Execute all transactions speculatively. The base state is not modified until all are done.
+    m_pool.run(n, [&](size_t worker, size_t tx) {
+        auto& record = impl.records[tx];
+        auto& result = block.transactions[tx];
+        result.result = impl.hosts[worker]->execute(transactions[tx], state, &impl.versions, tx,
+                                                    record, result.logs);
+        record.publish(impl.versions, tx);
+    });
+
+    // Commit in order, executing again the transactions which have read stale values.
+    auto& host = *impl.hosts.front();
+    for (size_t tx = 0; tx < n; ++tx)
+    {
+        auto& record = impl.records[tx];
+        if (!record.is_valid(state))
+        {
+            auto& result = block.transactions[tx];
+            result.result = host.execute(transactions[tx], state, nullptr, tx, record, result.logs);
+            result.reexecuted = true;
+            ++block.num_reexecuted;
+        }
+        record.commit(state);
+    }
+    return block;
+}
+}  // namespace qrvmc::parallel
@@ -2,8 +2,8 @@
 // Copyright 2019-2020 The EVMC Authors.
 // Licensed under the Apache License, Version 2.0.
 
+#include <qrvmc/executing_mocked_host.hpp>
 #include <qrvmc/hex.hpp>
-#include <qrvmc/mocked_host.hpp>
 #include <qrvmc/qrvmc.hpp>
 #include <qrvmc/tooling.hpp>
 #include <chrono>
@@ -50,7 +50,10 @@ auto bench(MockedHost& host,
         // Benchmark loop.
         const auto num_iterations = std::max(static_cast<int>(target_bench_time / probe_time), 1);
         for (int i = 0; i < num_iterations; ++i)
+        {
+            host.clear_recordings();
             vm.execute(host, rev, msg, code.data(), code.size());
+        }
         const auto bench_time = (clock::now() - bench_start) / num_iterations;
 
         out << "Time:     " << std::chrono::duration_cast<unit>(bench_time).count() << unit_name
@@ -66,14 +69,20 @@ int run(VM& vm,
         bytes_view input,
         bool create,
         bool bench,
-        std::ostream& out)
+        std::ostream& out,
+        const State& state)
 {
     out << (create ? "Creating and executing on " : "Executing on ") << rev << " with " << gas
         << " gas limit\n";
 
-    MockedHost host;
+    ExecutingMockedHost host{vm, rev};
+    for (const auto& [addr, account_code] : state.accounts)
+        host.accounts[addr].code = account_code;
+    host.block_hashes = state.block_hashes;
+    host.record_blockhashes = false;
 
     qrvmc_message msg{};
+    msg.flags = MockedHost::host_flags;
     msg.gas = gas;
     msg.input_data = input.data();
     msg.input_size = input.size();
@@ -83,6 +92,7 @@ int run(VM& vm,
     {
         qrvmc_message create_msg{};
         create_msg.kind = QRVMC_CREATE;
+        create_msg.flags = MockedHost::host_flags;
         create_msg.recipient = create_address;
         create_msg.gas = create_gas;
 
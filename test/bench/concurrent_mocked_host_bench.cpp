@@ -0,0 +1,78 @@
+// EVMC: Ethereum Client-VM Connector API.
+// Copyright 2026 The EVMC Authors.
+// Licensed under the Apache License, Version 2.0.
+
+#include <benchmark/benchmark.h>
+#include <qrvmc/concurrent_mocked_host.hpp>
+#include <mutex>
+#include <thread>
+
+namespace
+{
+/// The MockedHost guarded by a single global lock: the only way of sharing it between threads.
+struct LockedMockedHost
+{
+    std::mutex mutex;
+    qrvmc::MockedHost host;
+
+    qrvmc::bytes32 get_storage(const qrvmc::address& addr, const qrvmc::bytes32& key)
+    {
+        const std::lock_guard lock{mutex};
+        return host.get_storage(addr, key);
+    }
+
+    qrvmc_storage_status set_storage(const qrvmc::address& addr,
+                                     const qrvmc::bytes32& key,
+                                     const qrvmc::bytes32& value)
+    {
+        const std::lock_guard lock{mutex};
+        return host.set_storage(addr, key, value);
+    }
+};
+
+/// Selects the address used by the thread. With the "hot" argument all threads share one account.
+qrvmc::address thread_address(const benchmark::State& state) noexcept
+{
+    const bool hot = state.range(0) != 0;
+    return qrvmc::address{hot ? uint64_t{1} : static_cast<uint64_t>(state.thread_index() + 1)};
+}
+
+/// Executes the SLOAD/SSTORE mix of a simple counter contract: 4 reads per write.
+template <typename HostT>
+void storage_mix(benchmark::State& state, HostT& host)
+{
+    const auto addr = thread_address(state);
+    uint64_t i = 0;
+    for ([[maybe_unused]] auto _ : state)
+    {
+        const auto key = qrvmc::bytes32{i % 16};
+        for (int r = 0; r < 4; ++r)
+            benchmark::DoNotOptimize(host.get_storage(addr, key));
+        benchmark::DoNotOptimize(host.set_storage(addr, key, qrvmc::bytes32{++i}));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * 5);
+}
+
+void locked_mocked_host(benchmark::State& state)
+{
+    static LockedMockedHost host;
+    storage_mix(state, host);
+}
+
+void concurrent_mocked_host(benchmark::State& state)
+{
+    static qrvmc::ConcurrentMockedHost host;
+    storage_mix(state, host);
+}
+
+/// Runs the benchmark for independent and shared ("hot") accounts
+/// with the number of threads from 1 up to the number of cores.
+void threads_up_to_core_count(benchmark::internal::Benchmark* b)
+{
+    const auto max_threads = static_cast<int>(std::max(std::thread::hardware_concurrency(), 2u));
+    b->ArgNames({"hot"})->Args({0})->Args({1})->ThreadRange(1, max_threads)->UseRealTime();
+}
+}  // namespace
+
+BENCHMARK(locked_mocked_host)->Apply(threads_up_to_core_count);
+BENCHMARK(concurrent_mocked_host)->Apply(threads_up_to_core_count);
@@ -0,0 +1,94 @@
+// EVMC: Ethereum Client-VM Connector API.
+// Copyright 2026 The EVMC Authors.
+// Licensed under the Apache License, Version 2.0.
+
+#include "examples/example_host.h"
+#include <benchmark/benchmark.h>
+#include <qrvmc/qrvmc.hpp>
+#include <vector>
+
+using namespace qrvmc::literals;
+
+namespace
+{
+constexpr auto contract = "Q7070000000000000000000000000000000000070"_address;
+
+/// The ExampleHost accessed through the C interface, as by a VM.
+class ExampleHostContext
+{
+    const qrvmc_host_interface* m_host = example_host_get_interface();
+    qrvmc_host_context* m_context = example_host_create_context({});
+
+public:
+    ExampleHostContext() = default;
+    ExampleHostContext(const ExampleHostContext&) = delete;
+    ExampleHostContext& operator=(const ExampleHostContext&) = delete;
+    ~ExampleHostContext() { example_host_destroy_context(m_context); }
+
+    const qrvmc_host_interface& host() const noexcept { return *m_host; }
+    qrvmc_host_context* context() const noexcept { return m_context; }
+};
+
+/// Returns the storage keys spread over the key space, as the keccak-derived mapping slots.
+std::vector<qrvmc::bytes32> storage_keys(size_t n)
+{
+    std::vector<qrvmc::bytes32> keys(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        keys[i] = qrvmc::bytes32{i * 0x9e3779b97f4a7c15};
+        keys[i].bytes[0] = static_cast<uint8_t>(i);
+    }
+    return keys;
+}
+
+/// Reads all the storage slots of the contract.
+void example_host_get_storage(benchmark::State& state)
+{
+    const auto keys = storage_keys(static_cast<size_t>(state.range(0)));
+    ExampleHostContext h;
+    example_host_reserve(h.context(), 1, keys.size());
+    for (const auto& key : keys)
+        h.host().set_storage(h.context(), &contract, &key, &key);
+
+    for ([[maybe_unused]] auto _ : state)
+    {
+        for (const auto& key : keys)
+            benchmark::DoNotOptimize(h.host().get_storage(h.context(), &contract, &key));
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(keys.size()));
+}
+
+/// Modifies all the existing storage slots of the contract.
+void example_host_set_storage(benchmark::State& state)
+{
+    const auto keys = storage_keys(static_cast<size_t>(state.range(0)));
+    ExampleHostContext h;
+    example_host_reserve(h.context(), 1, keys.size());
+    for (const auto& key : keys)
+        h.host().set_storage(h.context(), &contract, &key, &key);
+
+    qrvmc::bytes32 value{};
+    for ([[maybe_unused]] auto _ : state)
+    {
+        ++value.bytes[31];
+        for (const auto& key : keys)
+            benchmark::DoNotOptimize(h.host().set_storage(h.context(), &contract, &key, &value));
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(keys.size()));
+}
+
+/// Gets the hash of the code of the size given as the benchmark argument, as EXTCODEHASH.
+void example_host_get_code_hash(benchmark::State& state)
+{
+    const std::vector<uint8_t> code(static_cast<size_t>(state.range(0)), 0x5b);
+    ExampleHostContext h;
+    example_host_set_code(h.context(), &contract, code.data(), code.size());
+
+    for ([[maybe_unused]] auto _ : state)
+        benchmark::DoNotOptimize(h.host().get_code_hash(h.context(), &contract));
+}
+}  // namespace
+
+BENCHMARK(example_host_get_storage)->RangeMultiplier(16)->Range(16, 64 * 1024);
+BENCHMARK(example_host_set_storage)->RangeMultiplier(16)->Range(16, 64 * 1024);
+BENCHMARK(example_host_get_code_hash)->RangeMultiplier(8)->Range(64, 24 * 1024);
@@ -0,0 +1,38 @@
+// EVMC: Ethereum Client-VM Connector API.
+// Copyright 2026 The EVMC Authors.
+// Licensed under the Apache License, Version 2.0.
+
+#include "examples/example_jit_vm/example_jit_vm.h"
+#include <benchmark/benchmark.h>
+#include <qrvmc/hex.hpp>
+#include <qrvmc/mocked_host.hpp>
+
+namespace
+{
+/// Executes the code given as the hex argument in the example JIT VM.
+/// The code is compiled once, in the first execution, and then taken from the VM cache.
+void example_jit_vm_execute(benchmark::State& state, const char* code_hex, int num_instructions)
+{
+    auto vm = qrvmc::VM{qrvmc_create_example_jit_vm()};
+    qrvmc::MockedHost host;
+    const auto code = qrvmc::from_hex(code_hex).value();
+    qrvmc_message msg{};
+    msg.gas = 100000;
+
+    for ([[maybe_unused]] auto _ : state)
+    {
+        const auto r = vm.execute(host, QRVMC_SHANGHAI, msg, code.data(), code.size());
+        benchmark::DoNotOptimize(r.gas_left);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * num_instructions);
+}
+}  // namespace
+
+// The same codes as in the example_vm benchmarks.
+BENCHMARK_CAPTURE(example_jit_vm_execute, loop, "6103e85b600190038060035700", 1000 * 7 + 2);
+BENCHMARK_CAPTURE(example_jit_vm_execute,
+                  arithmetic_loop,
+                  "6103e85b808002800160071860031b60051750600190038060035700",
+                  1000 * 19 + 2);
+BENCHMARK_CAPTURE(example_jit_vm_execute, stop, "00", 1);
+BENCHMARK_CAPTURE(example_jit_vm_execute, mstore_return, "602a60005260206000f3", 5);
@@ -0,0 +1,193 @@
+// EVMC: Ethereum Client-VM Connector API.
+// Copyright 2026 The EVMC Authors.
+// Licensed under the Apache License, Version 2.0.
+
+#include "examples/example_vm/example_vm.h"
+#include <benchmark/benchmark.h>
+#include <qrvmc/executing_mocked_host.hpp>
+#include <qrvmc/hex.hpp>
+#include <cstdio>
+#include <string_view>
+
+using namespace qrvmc::literals;
+
+namespace
+{
+/// Executes the tiny contract given as the hex argument in the example VM.
+void example_vm_execute(benchmark::State& state, const char* code_hex)
+{
+    auto vm = qrvmc::VM{qrvmc_create_example_vm()};
+    qrvmc::MockedHost host;
+    const auto code = qrvmc::from_hex(code_hex).value();
+    qrvmc_message msg{};
+    msg.gas = 1000;
+
+    for ([[maybe_unused]] auto _ : state)
+    {
+        const auto r = vm.execute(host, QRVMC_SHANGHAI, msg, code.data(), code.size());
+        benchmark::DoNotOptimize(r.gas_left);
+    }
+}
+
+/// Executes the contract calling the contract returning 32 bytes 16 times.
+void example_vm_nested_calls(benchmark::State& state)
+{
+    auto vm = qrvmc::VM{qrvmc_create_example_vm()};
+    qrvmc::ExecutingMockedHost host{vm, QRVMC_SHANGHAI};
+    host.record_blockhashes = false;
+    host.accounts["Q000000000000000000000000000000000000000a"_address].code =
+        qrvmc::from_hex("602a60005260206000f3").value();
+
+    std::string code_hex;
+    for (int i = 0; i < 16; ++i)
+        code_hex += "60206000600060006000600a61fffff1";  // call(0xffff, 0x0a, 0, 0, 0, 0, 32)
+    const auto code = qrvmc::from_hex(code_hex).value();
+    qrvmc_message msg{};
+    msg.gas = 100000;
+
+    for ([[maybe_unused]] auto _ : state)
+    {
+        const auto r = vm.execute(host, QRVMC_SHANGHAI, msg, code.data(), code.size());
+        benchmark::DoNotOptimize(r.gas_left);
+        host.clear_recordings();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * 16);
+}
+
+/// Executes the contract emitting 64 LOG2s with 32 bytes of data, as the event-heavy
+/// transaction, ending with STOP or with the hex @p end code. The argument is the message
+/// flags: the logs are passed to the host in the single batch with the ::QRVMC_HOST_EMIT_LOGS,
+/// one by one otherwise.
+void example_vm_logs(benchmark::State& state, const char* end)
+{
+    auto vm = qrvmc::VM{qrvmc_create_example_vm()};
+    qrvmc::MockedHost host;
+
+    std::string code_hex = "602a600052";  // mstore(0, 42)
+    for (int i = 0; i < 64; ++i)
+        code_hex += "600260016020600060a2";  // log2(0, 32, 1, 2)
+    code_hex += end;
+    const auto code = qrvmc::from_hex(code_hex).value();
+    qrvmc_message msg{};
+    msg.gas = 100000;
+    msg.flags = static_cast<uint32_t>(state.range(0));
+
+    for ([[maybe_unused]] auto _ : state)
+    {
+        const auto r = vm.execute(host, QRVMC_SHANGHAI, msg, code.data(), code.size());
+        benchmark::DoNotOptimize(r.gas_left);
+        host.clear_recordings();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * 64);
+}
+
+/// The loop of 1000 iterations with the body (JUMPDEST PUSH1 SWAP1 SUB DUP1 PUSH1 JUMPI)
+/// of 7 instructions.
+constexpr auto loop = "6103e85b600190038060035700";
+
+/// The loop of 1000 iterations with the arithmetic-heavy body of 19 instructions:
+/// JUMPDEST DUP1 DUP1 MUL DUP1 ADD PUSH1 XOR PUSH1 SHL PUSH1 OR POP and the loop counter
+/// decrement and the jump as above.
+constexpr auto arithmetic_loop = "6103e85b808002800160071860031b600517506001900380600357"
+                                 "00";
+
+/// Executes the loop of 1000 iterations of the given body size (in instructions)
+/// with the given dispatch mode and the execution mode: the gas charging mode
+/// ("instruction" or "block") or "fusion" for the prepared code with superinstructions.
+void example_vm_loop(benchmark::State& state,
+                     const char* dispatch,
+                     const char* mode,
+                     const char* code_hex,
+                     int body_size)
+{
+    auto vm = qrvmc::VM{qrvmc_create_example_vm()};
+    if (vm.set_option("dispatch", dispatch) != QRVMC_SET_OPTION_SUCCESS)
+    {
+        state.SkipWithError("dispatch mode not supported");
+        return;
+    }
+    if (std::string_view{mode} == "fusion")
+        vm.set_option("fusion", "on");
+    else
+        vm.set_option("charging", mode);
+
+    qrvmc::MockedHost host;
+    const auto code = qrvmc::from_hex(code_hex).value();
+    qrvmc_message msg{};
+    msg.gas = 100000;
+
+    for ([[maybe_unused]] auto _ : state)
+    {
+        const auto r = vm.execute(host, QRVMC_SHANGHAI, msg, code.data(), code.size());
+        benchmark::DoNotOptimize(r.gas_left);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * (1000 * body_size + 2));
+}
+
+/// Executes the code touching the memory of the size given as the benchmark argument
+/// with the instruction given as the hex argument:
+/// - MSTORE: mstore(size - 32, 1),
+/// - MLOAD: pop(mload(size - 32)),
+/// - CALLDATACOPY: calldatacopy(0, 0, size) with the input of the size.
+/// The time includes clearing the memory for the next execution.
+void example_vm_memory(benchmark::State& state, const char* opcode_hex)
+{
+    auto vm = qrvmc::VM{qrvmc_create_example_vm()};
+    qrvmc::MockedHost host;
+
+    const auto size = static_cast<uint32_t>(state.range(0));
+    char size_hex[9];
+    const auto is_copy = std::string_view{opcode_hex} == "37";
+    std::snprintf(size_hex, sizeof(size_hex), "%08x", is_copy ? size : size - 32);
+    std::string code_hex;
+    if (std::string_view{opcode_hex} == "52")
+        code_hex = std::string{"6001"} + "63" + size_hex + "5200";
+    else if (std::string_view{opcode_hex} == "51")
+        code_hex = std::string{"63"} + size_hex + "515000";
+    else
+        code_hex = std::string{"63"} + size_hex + "60006000" + opcode_hex + "00";
+    const auto code = qrvmc::from_hex(code_hex).value();
+    const auto input = qrvmc::bytes(is_copy ? size : 0, 0xcc);
+
+    qrvmc_message msg{};
+    msg.gas = 100'000'000;
+    msg.input_data = input.data();
+    msg.input_size = input.size();
+
+    for ([[maybe_unused]] auto _ : state)
+    {
+        const auto r = vm.execute(host, QRVMC_SHANGHAI, msg, code.data(), code.size());
+        if (r.status_code != QRVMC_SUCCESS)
+        {
+            state.SkipWithError("execution failed");
+            return;
+        }
+        benchmark::DoNotOptimize(r.gas_left);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * size);
+}
+}  // namespace
+
+BENCHMARK_CAPTURE(example_vm_loop, switch, "switch", "instruction", loop, 7);
+BENCHMARK_CAPTURE(example_vm_loop, cgoto, "cgoto", "instruction", loop, 7);
+BENCHMARK_CAPTURE(example_vm_loop, switch_block, "switch", "block", loop, 7);
+BENCHMARK_CAPTURE(example_vm_loop, cgoto_block, "cgoto", "block", loop, 7);
+BENCHMARK_CAPTURE(example_vm_loop, arithmetic_switch, "switch", "instruction", arithmetic_loop, 19);
+BENCHMARK_CAPTURE(example_vm_loop, arithmetic_cgoto, "cgoto", "instruction", arithmetic_loop, 19);
+BENCHMARK_CAPTURE(example_vm_loop, arithmetic_switch_block, "switch", "block", arithmetic_loop, 19);
+BENCHMARK_CAPTURE(example_vm_loop, arithmetic_cgoto_block, "cgoto", "block", arithmetic_loop, 19);
+BENCHMARK_CAPTURE(example_vm_loop, switch_fusion, "switch", "fusion", loop, 7);
+BENCHMARK_CAPTURE(example_vm_loop, cgoto_fusion, "cgoto", "fusion", loop, 7);
+BENCHMARK_CAPTURE(example_vm_loop, arithmetic_switch_fusion, "switch", "fusion", arithmetic_loop,
+                  19);
+BENCHMARK_CAPTURE(example_vm_loop, arithmetic_cgoto_fusion, "cgoto", "fusion", arithmetic_loop,
+                  19);
+BENCHMARK_CAPTURE(example_vm_execute, stop, "00");
+BENCHMARK_CAPTURE(example_vm_execute, add, "6001600101");
+BENCHMARK_CAPTURE(example_vm_execute, mstore_return, "602a60005260206000f3");
+BENCHMARK(example_vm_nested_calls);
+BENCHMARK_CAPTURE(example_vm_logs, stop, "00")->Arg(0)->Arg(QRVMC_HOST_EMIT_LOGS);
+BENCHMARK_CAPTURE(example_vm_logs, revert, "60006000fd")->Arg(0)->Arg(QRVMC_HOST_EMIT_LOGS);
+BENCHMARK_CAPTURE(example_vm_memory, mstore, "52")->RangeMultiplier(32)->Range(32, 1 << 20);
+BENCHMARK_CAPTURE(example_vm_memory, mload, "51")->RangeMultiplier(32)->Range(32, 1 << 20);
+BENCHMARK_CAPTURE(example_vm_memory, calldatacopy, "37")->RangeMultiplier(32)->Range(32, 1 << 20);
@@ -0,0 +1,87 @@
+// EVMC: Ethereum Client-VM Connector API.
+// Copyright 2026 The EVMC Authors.
+// Licensed under the Apache License, Version 2.0.
+
+#include <benchmark/benchmark.h>
+#include <qrvmc/mocked_host.hpp>
+
+using namespace qrvmc::literals;
+
+namespace
+{
+constexpr auto token = "Q7070000000000000000000000000000000000070"_address;
+
+/// The topics of the ERC-20 Transfer event.
+const qrvmc::bytes32 transfer_topics[] = {
+    0xddf252ad1be2c89b69c2b068fc378daa952ba7f163c4a11628f55a4df523b3ef_bytes32,
+    0x000000000000000000000000000000000000000000000000000000000000a11c_bytes32,
+    0x0000000000000000000000000000000000000000000000000000000000000b0b_bytes32,
+};
+
+/// The LOG record owning its data, as recorded by MockedHost before the recording arena.
+struct owning_log_record
+{
+    qrvmc::address creator;
+    qrvmc::bytes data;
+    std::vector<qrvmc::bytes32> topics;
+};
+
+/// Emits the Transfer events of a batch of token transfers and clears the records,
+/// as done between executions.
+void mocked_host_emit_log(benchmark::State& state)
+{
+    const auto num_logs = static_cast<int>(state.range(0));
+    const auto amount = 0x0de0b6b3a7640000_bytes32;
+
+    qrvmc::MockedHost host;
+    for ([[maybe_unused]] auto _ : state)
+    {
+        for (int i = 0; i < num_logs; ++i)
+            host.emit_log(token, amount.bytes, sizeof(amount), transfer_topics, 3);
+        benchmark::DoNotOptimize(host.recorded_logs.data());
+        host.clear_recordings();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * num_logs);
+}
+
+void owning_log_records(benchmark::State& state)
+{
+    const auto num_logs = static_cast<int>(state.range(0));
+    const auto amount = 0x0de0b6b3a7640000_bytes32;
+
+    std::vector<owning_log_record> logs;
+    for ([[maybe_unused]] auto _ : state)
+    {
+        for (int i = 0; i < num_logs; ++i)
+            logs.push_back({token, {amount.bytes, sizeof(amount)},
+                            {std::begin(transfer_topics), std::end(transfer_topics)}});
+        benchmark::DoNotOptimize(logs.data());
+        logs.clear();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * num_logs);
+}
+
+/// Looks up the hashes of all 256 recent blocks, as a BLOCKHASH-heavy contract would.
+/// The argument controls the recording of the requests.
+void mocked_host_get_block_hash(benchmark::State& state)
+{
+    constexpr int64_t current_block = 20'000'000;
+
+    qrvmc::MockedHost host;
+    host.record_blockhashes = state.range(0) != 0;
+    for (auto n = current_block - 256; n < current_block; ++n)
+        host.block_hashes.set(n, qrvmc::bytes32{static_cast<uint64_t>(n)});
+
+    for ([[maybe_unused]] auto _ : state)
+    {
+        for (auto n = current_block - 256; n < current_block; ++n)
+            benchmark::DoNotOptimize(host.get_block_hash(n));
+        host.clear_recordings();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * 256);
+}
+}  // namespace
+
+BENCHMARK(mocked_host_emit_log)->Arg(1)->Arg(16)->Arg(256);
+BENCHMARK(owning_log_records)->Arg(1)->Arg(16)->Arg(256);
+BENCHMARK(mocked_host_get_block_hash)->ArgName("record")->Arg(0)->Arg(1);
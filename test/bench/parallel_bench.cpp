@@ -0,0 +1,103 @@
+// EVMC: Ethereum Client-VM Connector API.
+// Copyright 2026 The EVMC Authors.
+// Licensed under the Apache License, Version 2.0.
+
+#include "examples/example_vm/example_vm.h"
+#include <benchmark/benchmark.h>
+#include <qrvmc/executing_mocked_host.hpp>
+#include <qrvmc/hex.hpp>
+#include <qrvmc/parallel.hpp>
+#include <thread>
+
+using namespace qrvmc::literals;
+
+namespace
+{
+constexpr auto token = "Q7070000000000000000000000000000000000070"_address;
+
+/// The number of the transactions in the block.
+constexpr size_t block_size = 1000;
+
+/// The block of the token transfers, each moving 1 from the storage slot of the first input
+/// word to the slot of the second one: sstore(a, sub(sload(a), 1)) sstore(b, add(sload(b), 1)).
+/// The transfers are independent, except the @p hot_percent of them, which all transfer
+/// to the same slot, the hot shared counter.
+struct Block
+{
+    qrvmc::parallel::State state;
+    std::vector<qrvmc::bytes> inputs;
+    std::vector<qrvmc_message> transactions;
+
+    explicit Block(int64_t hot_percent)
+    {
+        state[token].code =
+            qrvmc::from_hex("600035805460019003905560203580546001019055").value();
+        inputs.resize(block_size);
+        transactions.resize(block_size);
+        for (size_t i = 0; i < block_size; ++i)
+        {
+            const auto from = qrvmc::bytes32{2 * i + 1};
+            const bool hot = static_cast<int64_t>(i % 100) < hot_percent;
+            const auto to = qrvmc::bytes32{hot ? 0 : 2 * i + 2};
+            state[token].storage[from] = qrvmc::bytes32{1'000'000'000};
+            inputs[i].assign(from.bytes, sizeof(from));
+            inputs[i].append(to.bytes, sizeof(to));
+
+            auto& msg = transactions[i];
+            msg.kind = QRVMC_CALL;
+            msg.gas = 100000;
+            msg.recipient = token;
+            msg.code_address = token;
+            msg.input_data = inputs[i].data();
+            msg.input_size = inputs[i].size();
+        }
+    }
+};
+
+/// Executes the block with qrvmc::parallel::Executor with the given number of threads
+/// (0 for all hardware threads) and percent of transactions incrementing the hot counter.
+/// The state is not reset between the iterations, the block keeps transferring.
+void parallel_execute(benchmark::State& state)
+{
+    const auto num_threads = state.range(0) != 0 ? static_cast<size_t>(state.range(0)) :
+                                                   std::thread::hardware_concurrency();
+    Block block{state.range(1)};
+    auto vm = qrvmc::VM{qrvmc_create_example_vm()};
+    qrvmc::parallel::Executor executor{vm, QRVMC_SHANGHAI, num_threads};
+
+    size_t num_reexecuted = 0;
+    for ([[maybe_unused]] auto _ : state)
+        num_reexecuted += executor.execute(block.state, block.transactions).num_reexecuted;
+
+    state.counters["threads"] = static_cast<double>(executor.num_threads());
+    state.counters["reexecuted"] =
+        benchmark::Counter(static_cast<double>(num_reexecuted) / block_size,
+                           benchmark::Counter::kAvgIterations);
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(block_size));
+}
+
+/// Executes the block serially with qrvmc::ExecutingMockedHost, the baseline.
+void parallel_serial_baseline(benchmark::State& state)
+{
+    Block block{state.range(0)};
+    auto vm = qrvmc::VM{qrvmc_create_example_vm()};
+    qrvmc::ExecutingMockedHost host{vm, QRVMC_SHANGHAI};
+    host.accounts = block.state;
+
+    for ([[maybe_unused]] auto _ : state)
+    {
+        for (const auto& msg : block.transactions)
+        {
+            host.clear_recordings();
+            benchmark::DoNotOptimize(host.call(msg));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(block_size));
+}
+}  // namespace
+
+BENCHMARK(parallel_serial_baseline)->ArgName("hot%")->Arg(0)->Arg(10)->Arg(100);
+BENCHMARK(parallel_execute)
+    ->ArgNames({"threads", "hot%"})
+    ->ArgsProduct({{1, 4, 0}, {0, 10, 100}})
+    ->UseRealTime();
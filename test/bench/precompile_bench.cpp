@@ -0,0 +1,282 @@
+// EVMC: Ethereum Client-VM Connector API.
+// Copyright 2026 The EVMC Authors.
+// Licensed under the Apache License, Version 2.0.
+
+#include "examples/example_precompiles_vm/bn254.hpp"
+#include "examples/example_precompiles_vm/example_precompiles_vm.h"
+#include "examples/example_precompiles_vm/expmod.hpp"
+#include "examples/example_precompiles_vm/sha256.hpp"
+#include <benchmark/benchmark.h>
+#include <qrvmc/hex.hpp>
+#include <qrvmc/qrvmc.hpp>
+#include <string>
+#include <vector>
+
+using namespace qrvmc::literals;
+
+namespace
+{
+/// The addresses accessed by a call-heavy transaction: mostly contracts, some precompiles.
+std::vector<qrvmc::address> accessed_addresses()
+{
+    std::vector<qrvmc::address> addresses;
+    for (uint64_t i = 0; i < 256; ++i)
+    {
+        if (i % 4 == 0)
+            addresses.emplace_back(i % 16);  // A precompile or the zero address.
+        else
+        {
+            auto a = qrvmc::address{i * 0x9e3779b97f4a7c15};
+            a.bytes[i % 12] = static_cast<uint8_t>(i);
+            addresses.emplace_back(a);
+        }
+    }
+    return addresses;
+}
+
+/// Classifies the addresses with the lexicographic range compare used by MockedHost before.
+void precompile_range_compare(benchmark::State& state)
+{
+    const auto addresses = accessed_addresses();
+    for ([[maybe_unused]] auto _ : state)
+    {
+        for (const auto& a : addresses)
+        {
+            benchmark::DoNotOptimize(a >= "Q0000000000000000000000000000000000000001"_address &&
+                                     a <= "Q0000000000000000000000000000000000000009"_address);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(addresses.size()));
+}
+
+/// Classifies the addresses with qrvmc::precompile_id().
+void precompile_id(benchmark::State& state)
+{
+    const auto addresses = accessed_addresses();
+    for ([[maybe_unused]] auto _ : state)
+    {
+        for (const auto& a : addresses)
+        {
+            const auto id = qrvmc::precompile_id(a);
+            benchmark::DoNotOptimize(id != 0 && id <= 9);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(addresses.size()));
+}
+
+/// Hashes the input of the size given as the benchmark argument
+/// with the given SHA-256 implementation.
+void sha256(benchmark::State& state, precompiles::Sha256Impl impl)
+{
+    if (!precompiles::is_supported(impl))
+    {
+        state.SkipWithError("not supported by the CPU");
+        return;
+    }
+
+    const auto input = qrvmc::bytes(static_cast<size_t>(state.range(0)), 0xcc);
+    uint8_t hash[32];
+    for ([[maybe_unused]] auto _ : state)
+    {
+        precompiles::sha256(hash, input.data(), input.size(), impl);
+        benchmark::DoNotOptimize(hash);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(input.size()));
+}
+
+/// Executes the SHA256 precompile with the input of the size given as the benchmark argument.
+/// This includes the gas charging and the output allocation. With the result cache enabled
+/// all but the first execution are served from the cache.
+void precompile_sha256(benchmark::State& state, bool cached)
+{
+    auto vm = qrvmc::VM{qrvmc_create_example_precompiles_vm()};
+    if (cached)
+        vm.set_option("cache.size", "16777216");
+    const auto input = qrvmc::bytes(static_cast<size_t>(state.range(0)), 0xcc);
+    qrvmc_message msg{};
+    msg.code_address.bytes[19] = 0x02;
+    msg.input_data = input.data();
+    msg.input_size = input.size();
+    msg.gas = 10'000'000;
+
+    for ([[maybe_unused]] auto _ : state)
+    {
+        const auto r = vm.execute(QRVMC_SHANGHAI, msg, nullptr, 0);
+        benchmark::DoNotOptimize(r.output_data);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(input.size()));
+}
+
+/// Executes the Identity precompile with the input of the size given as the benchmark argument.
+/// Unless the caller allows the output aliasing the input, the output is copied.
+void precompile_identity(benchmark::State& state, bool aliasing)
+{
+    auto vm = qrvmc::VM{qrvmc_create_example_precompiles_vm()};
+    const auto input = qrvmc::bytes(static_cast<size_t>(state.range(0)), 0xcc);
+    qrvmc_message msg{};
+    msg.flags = aliasing ? uint32_t{QRVMC_ALLOW_OUTPUT_ALIASING} : 0;
+    msg.code_address.bytes[19] = 0x04;
+    msg.input_data = input.data();
+    msg.input_size = input.size();
+    msg.gas = 10'000'000;
+
+    for ([[maybe_unused]] auto _ : state)
+    {
+        const auto r = vm.execute(QRVMC_SHANGHAI, msg, nullptr, 0);
+        benchmark::DoNotOptimize(r.output_data);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(input.size()));
+}
+
+/// Executes the empty precompiles at the ids spread over the whole id range.
+/// This measures the VM dispatch: the id lookup in the table and the gas charging.
+void precompile_dispatch(benchmark::State& state)
+{
+    auto vm = qrvmc::VM{qrvmc_create_example_precompiles_vm()};
+    std::vector<qrvmc_message> msgs(64);
+    for (size_t i = 0; i < msgs.size(); ++i)
+    {
+        const auto id = static_cast<uint16_t>(0x0100 + i * 1021);
+        msgs[i].code_address.bytes[18] = static_cast<uint8_t>(id >> 8);
+        msgs[i].code_address.bytes[19] = static_cast<uint8_t>(id);
+        msgs[i].gas = 1000;
+    }
+
+    for ([[maybe_unused]] auto _ : state)
+    {
+        for (const auto& msg : msgs)
+        {
+            const auto r = vm.execute(QRVMC_SHANGHAI, msg, nullptr, 0);
+            benchmark::DoNotOptimize(r.gas_left);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(msgs.size()));
+}
+
+/// The EXPMOD implementation.
+using expmod_fn = void (*)(uint8_t*,
+                           const precompiles::Number&,
+                           const precompiles::Number&,
+                           const precompiles::Number&);
+
+/// Computes the EXPMOD of the base, the exponent and the odd or even modulus of the bit size
+/// given as the benchmark argument: the worst case of the gas cost per input byte.
+/// The gas_rate counter reports the gas charged per second.
+void expmod(benchmark::State& state, expmod_fn fn, bool even_mod)
+{
+    const auto size = static_cast<size_t>(state.range(0) / 8);
+    qrvmc::bytes base(size, 0);
+    qrvmc::bytes exp(size, 0);
+    qrvmc::bytes mod(size, 0);
+    uint64_t seed = 1;
+    for (size_t i = 0; i < size; ++i)
+    {
+        seed = seed * 6364136223846793005 + 1442695040888963407;
+        base[i] = static_cast<uint8_t>(seed >> 56);
+        exp[i] = static_cast<uint8_t>(seed >> 48);
+        mod[i] = static_cast<uint8_t>(seed >> 40);
+    }
+    exp[0] |= 0x80;
+    mod[0] |= 0x80;
+    mod[size - 1] = even_mod ? uint8_t{0} : uint8_t{1};
+    const auto exp_head_size = std::min<size_t>(size, 32);
+    const auto gas = precompiles::expmod_gas(size, size, size, exp.data(), exp_head_size);
+
+    qrvmc::bytes output(size, 0);
+    for ([[maybe_unused]] auto _ : state)
+    {
+        fn(output.data(), {base.data(), size, size}, {exp.data(), size, size},
+           {mod.data(), size, size});
+        benchmark::DoNotOptimize(output.data());
+    }
+    state.counters["gas_rate"] = benchmark::Counter(
+        static_cast<double>(state.iterations() * static_cast<int64_t>(gas)),
+        benchmark::Counter::kIsRate);
+}
+/// The BN254 G1 generator (1, 2) and a G1 point of the full-size coordinates.
+const auto bn254_g1 = std::string(63, '0') + "1" + std::string(63, '0') + "2";
+const auto bn254_p = std::string(
+    "26767b7ea97bf686a4fadd5707fd8a8e5339916f43f1643f54d227adf65b2059"
+    "1e149db70fdee9ccc6ccfd9b69949a4657ab376c3371fcaeabf0ae61b87d5314");
+
+/// The BN254 G2 generator.
+const auto bn254_g2 = std::string(
+    "198e9393920d483a7260bfb731fb5d25f1aa493335a9e71297e485b7aef312c2"
+    "1800deef121f1e76426a00665e5c4479674322d4f75edadd46debd5cd992f6ed"
+    "090689d0585ff075ec9e99ad690c3395bc4b313370b38ef355acdadcd122975b"
+    "12c85ea5db8c6deb4aab71808dcb408fe3d1e7690c43d37b4ce6cc0166fa7daa");
+
+void bn254_add(benchmark::State& state)
+{
+    const auto input = qrvmc::from_hex(bn254_g1 + bn254_p).value();
+    uint8_t output[64];
+    for ([[maybe_unused]] auto _ : state)
+    {
+        precompiles::bn254_add(output, input.data());
+        benchmark::DoNotOptimize(output);
+    }
+}
+
+void bn254_mul(benchmark::State& state)
+{
+    const auto input = qrvmc::from_hex(bn254_p + std::string(64, 'e')).value();
+    uint8_t output[64];
+    for ([[maybe_unused]] auto _ : state)
+    {
+        precompiles::bn254_mul(output, input.data());
+        benchmark::DoNotOptimize(output);
+    }
+}
+
+/// Checks the pairing of the number of pairs given as the benchmark argument.
+/// The pairs_rate counter reports the pairs processed per second.
+void bn254_pairing(benchmark::State& state)
+{
+    const auto num_pairs = static_cast<size_t>(state.range(0));
+    std::string hex_input;
+    for (size_t i = 0; i < num_pairs; ++i)
+        hex_input += bn254_p + bn254_g2;
+    const auto input = qrvmc::from_hex(hex_input).value();
+    for ([[maybe_unused]] auto _ : state)
+    {
+        bool result = false;
+        precompiles::bn254_pairing_check(result, input.data(), num_pairs);
+        benchmark::DoNotOptimize(result);
+    }
+    state.counters["pairs_rate"] = benchmark::Counter(
+        static_cast<double>(state.iterations() * static_cast<int64_t>(num_pairs)),
+        benchmark::Counter::kIsRate);
+}
+}  // namespace
+
+BENCHMARK(precompile_range_compare);
+BENCHMARK(precompile_id);
+BENCHMARK_CAPTURE(sha256, scalar, precompiles::Sha256Impl::scalar)
+    ->RangeMultiplier(4)
+    ->Range(32, 64 * 1024);
+BENCHMARK_CAPTURE(sha256, avx2, precompiles::Sha256Impl::avx2)
+    ->RangeMultiplier(4)
+    ->Range(32, 64 * 1024);
+BENCHMARK_CAPTURE(sha256, shani, precompiles::Sha256Impl::shani)
+    ->RangeMultiplier(4)
+    ->Range(32, 64 * 1024);
+BENCHMARK(precompile_dispatch);
+BENCHMARK_CAPTURE(precompile_identity, copy, false)->RangeMultiplier(8)->Range(32, 32 * 1024);
+BENCHMARK_CAPTURE(precompile_identity, aliasing, true)->RangeMultiplier(8)->Range(32, 32 * 1024);
+BENCHMARK_CAPTURE(precompile_sha256, uncached, false)->RangeMultiplier(4)->Range(32, 64 * 1024);
+BENCHMARK_CAPTURE(precompile_sha256, cached, true)->RangeMultiplier(4)->Range(32, 64 * 1024);
+BENCHMARK_CAPTURE(expmod, montgomery, precompiles::expmod, false)
+    ->RangeMultiplier(2)
+    ->Range(256, 4096)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(expmod, montgomery_even, precompiles::expmod, true)
+    ->RangeMultiplier(2)
+    ->Range(256, 4096)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(expmod, naive, precompiles::expmod_naive, false)
+    ->RangeMultiplier(2)
+    ->Range(256, 4096)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(bn254_add);
+BENCHMARK(bn254_mul)->Unit(benchmark::kMicrosecond);
+BENCHMARK(bn254_pairing)->RangeMultiplier(2)->Range(1, 8)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,77 @@
+// EVMC: Ethereum Client-VM Connector API.
+// Copyright 2026 The EVMC Authors.
+// Licensed under the Apache License, Version 2.0.
+
+#include <benchmark/benchmark.h>
+#include <qrvmc/mocked_host.hpp>
+#include <qrvmc/recording_host.hpp>
+#include <vector>
+
+using namespace qrvmc::literals;
+
+namespace
+{
+constexpr auto token = "Q7070000000000000000000000000000000000070"_address;
+
+/// Returns the storage keys spread over the key space, as the keccak-derived mapping slots.
+std::vector<qrvmc::bytes32> storage_keys(size_t n, uint64_t seed)
+{
+    std::vector<qrvmc::bytes32> keys(n);
+    for (size_t i = 0; i < n; ++i)
+        keys[i] = qrvmc::bytes32{(seed + i) * 0x9e3779b97f4a7c15};
+    return keys;
+}
+
+/// Reads and modifies the storage slots of the token through the host interface,
+/// as the transaction of the ERC-20 transfers does, with the RecordingHost or without.
+/// The time includes normalizing the recorded sets.
+template <bool Record>
+void recording_host_storage(benchmark::State& state)
+{
+    const auto keys = storage_keys(static_cast<size_t>(state.range(0)), 0);
+    qrvmc::MockedHost mocked_host;
+    for (const auto& key : keys)
+        mocked_host.accounts[token].storage[key].current = key;
+    qrvmc::RecordingHost recording_host{mocked_host};
+    qrvmc::HostInterface& host = Record ? static_cast<qrvmc::HostInterface&>(recording_host) :
+                                          mocked_host;
+
+    for ([[maybe_unused]] auto _ : state)
+    {
+        for (const auto& key : keys)
+        {
+            const auto value = host.get_storage(token, key);
+            benchmark::DoNotOptimize(host.set_storage(token, key, value));
+        }
+        if (Record)
+        {
+            benchmark::DoNotOptimize(recording_host.read_write_set());
+            recording_host.clear();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(keys.size()));
+}
+
+/// Checks the conflict of the transactions with the read and write sets of the given size,
+/// not intersecting, as for the independent transactions.
+void recording_host_conflicts(benchmark::State& state)
+{
+    const auto n = static_cast<size_t>(state.range(0));
+    qrvmc::ReadWriteSet earlier;
+    qrvmc::ReadWriteSet later;
+    for (const auto& key : storage_keys(n, 0))
+        earlier.writes.slots.push_back({token, key});
+    for (const auto& key : storage_keys(n, n))
+        later.reads.slots.push_back({token, key});
+    earlier.normalize();
+    later.normalize();
+
+    for ([[maybe_unused]] auto _ : state)
+        benchmark::DoNotOptimize(qrvmc::conflicts(earlier, later));
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(2 * n));
+}
+}  // namespace
+
+BENCHMARK_TEMPLATE(recording_host_storage, false)->Arg(16)->Arg(256);
+BENCHMARK_TEMPLATE(recording_host_storage, true)->Arg(16)->Arg(256);
+BENCHMARK(recording_host_conflicts)->RangeMultiplier(16)->Range(4, 1024);
@@ -0,0 +1,141 @@
+// EVMC: Ethereum Client-VM Connector API.
+// Copyright 2026 The EVMC Authors.
+// Licensed under the Apache License, Version 2.0.
+
+#include <benchmark/benchmark.h>
+#include <qrvmc/qrvmc.hpp>
+#include <unordered_map>
+#include <vector>
+
+using namespace qrvmc::literals;
+
+namespace
+{
+constexpr auto contract = "Q7070000000000000000000000000000000000070"_address;
+
+/// The MockedHost-like host with the storage in the hash map and the other methods trivial.
+/// The Base is either qrvmc::Host (the methods override the virtual ones)
+/// or qrvmc::StaticHost (the methods are called directly).
+template <typename Base>
+class StorageHost : public Base
+{
+public:
+    std::unordered_map<qrvmc::bytes32, qrvmc::bytes32> storage;
+
+    bool account_exists(const qrvmc::address& /*addr*/) const noexcept { return true; }
+
+    qrvmc::bytes32 get_storage(const qrvmc::address& /*addr*/,
+                               const qrvmc::bytes32& key) const noexcept
+    {
+        const auto it = storage.find(key);
+        return it != storage.end() ? it->second : qrvmc::bytes32{};
+    }
+
+    qrvmc_storage_status set_storage(const qrvmc::address& /*addr*/,
+                                     const qrvmc::bytes32& key,
+                                     const qrvmc::bytes32& value) noexcept
+    {
+        auto& slot = storage[key];
+        const auto status = slot == value ? QRVMC_STORAGE_ASSIGNED : QRVMC_STORAGE_MODIFIED;
+        slot = value;
+        return status;
+    }
+
+    qrvmc::uint256be get_balance(const qrvmc::address& /*addr*/) const noexcept { return {}; }
+
+    size_t get_code_size(const qrvmc::address& /*addr*/) const noexcept { return 0; }
+
+    qrvmc::bytes32 get_code_hash(const qrvmc::address& /*addr*/) const noexcept { return {}; }
+
+    size_t copy_code(const qrvmc::address& /*addr*/,
+                     size_t /*code_offset*/,
+                     uint8_t* /*buffer_data*/,
+                     size_t /*buffer_size*/) const noexcept
+    {
+        return 0;
+    }
+
+    qrvmc::Result call(const qrvmc_message& /*msg*/) noexcept { return qrvmc::Result{}; }
+
+    qrvmc_tx_context get_tx_context() const noexcept { return {}; }
+
+    qrvmc::bytes32 get_block_hash(int64_t /*block_number*/) const noexcept { return {}; }
+
+    void emit_log(const qrvmc::address& /*addr*/,
+                  const uint8_t* /*data*/,
+                  size_t /*data_size*/,
+                  const qrvmc::bytes32 /*topics*/[],
+                  size_t /*num_topics*/) noexcept
+    {}
+
+    qrvmc_access_status access_account(const qrvmc::address& /*addr*/) noexcept
+    {
+        return QRVMC_ACCESS_WARM;
+    }
+
+    qrvmc_access_status access_storage(const qrvmc::address& /*addr*/,
+                                       const qrvmc::bytes32& /*key*/) noexcept
+    {
+        return QRVMC_ACCESS_WARM;
+    }
+};
+
+class VirtualStorageHost final : public StorageHost<qrvmc::Host>
+{};
+
+class StaticStorageHost final : public StorageHost<qrvmc::StaticHost<StaticStorageHost>>
+{};
+
+/// Reads the storage slots through the host interface, as the SLOAD-heavy contract would.
+/// The argument is the number of the slots.
+template <typename HostT>
+void host_get_storage(benchmark::State& state)
+{
+    HostT host;
+    std::vector<qrvmc::bytes32> keys;
+    for (int64_t i = 0; i < state.range(0); ++i)
+    {
+        keys.emplace_back(static_cast<uint64_t>(i));
+        host.storage[keys.back()] = keys.back();
+    }
+    const auto& iface = HostT::get_interface();
+    auto* const context = host.to_context();
+
+    for ([[maybe_unused]] auto _ : state)
+    {
+        for (const auto& key : keys)
+            benchmark::DoNotOptimize(iface.get_storage(context, &contract, &key));
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(keys.size()));
+}
+
+/// Checks the warm access and writes the storage slots through the host interface,
+/// as SSTORE does.
+template <typename HostT>
+void host_set_storage(benchmark::State& state)
+{
+    HostT host;
+    std::vector<qrvmc::bytes32> keys;
+    for (int64_t i = 0; i < state.range(0); ++i)
+        keys.emplace_back(static_cast<uint64_t>(i));
+    const auto& iface = HostT::get_interface();
+    auto* const context = host.to_context();
+
+    qrvmc::bytes32 value{};
+    for ([[maybe_unused]] auto _ : state)
+    {
+        ++value.bytes[31];
+        for (const auto& key : keys)
+        {
+            benchmark::DoNotOptimize(iface.access_storage(context, &contract, &key));
+            benchmark::DoNotOptimize(iface.set_storage(context, &contract, &key, &value));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(keys.size()));
+}
+}  // namespace
+
+BENCHMARK_TEMPLATE(host_get_storage, VirtualStorageHost)->Arg(16)->Arg(1024);
+BENCHMARK_TEMPLATE(host_get_storage, StaticStorageHost)->Arg(16)->Arg(1024);
+BENCHMARK_TEMPLATE(host_set_storage, VirtualStorageHost)->Arg(16)->Arg(1024);
+BENCHMARK_TEMPLATE(host_set_storage, StaticStorageHost)->Arg(16)->Arg(1024);
@@ -0,0 +1,164 @@
+// EVMC: Ethereum Client-VM Connector API.
+// Copyright 2026 The EVMC Authors.
+// Licensed under the Apache License, Version 2.0.
+
+#include <benchmark/benchmark.h>
+#include <qrvmc/qrvmc.hpp>
+#include <vector>
+
+namespace
+{
+/// The naive big-endian arithmetic working on bytes, as done before by the example VM
+/// and the ExecutingMockedHost.
+namespace naive
+{
+qrvmc::uint256be add(const qrvmc::uint256be& a, const qrvmc::uint256be& b) noexcept
+{
+    qrvmc::uint256be r;
+    unsigned carry = 0;
+    for (size_t i = sizeof(r.bytes); i-- > 0;)
+    {
+        const auto s = unsigned{a.bytes[i]} + unsigned{b.bytes[i]} + carry;
+        r.bytes[i] = static_cast<uint8_t>(s);
+        carry = s >> 8;
+    }
+    return r;
+}
+
+qrvmc::uint256be sub(const qrvmc::uint256be& a, const qrvmc::uint256be& b) noexcept
+{
+    qrvmc::uint256be r;
+    unsigned borrow = 0;
+    for (size_t i = sizeof(r.bytes); i-- > 0;)
+    {
+        const auto d = unsigned{a.bytes[i]} - unsigned{b.bytes[i]} - borrow;
+        r.bytes[i] = static_cast<uint8_t>(d);
+        borrow = (d >> 8) & 1;
+    }
+    return r;
+}
+
+/// The schoolbook multiplication of the bytes.
+qrvmc::uint256be mul(const qrvmc::uint256be& a, const qrvmc::uint256be& b) noexcept
+{
+    qrvmc::uint256be r;
+    for (size_t i = 0; i < 32; ++i)
+    {
+        unsigned carry = 0;
+        for (size_t j = 0; i + j < 32; ++j)
+        {
+            auto& p = r.bytes[31 - (i + j)];
+            const auto t = unsigned{p} + unsigned{a.bytes[31 - i]} * b.bytes[31 - j] + carry;
+            p = static_cast<uint8_t>(t);
+            carry = t >> 8;
+        }
+    }
+    return r;
+}
+
+/// The bit-by-bit long division.
+qrvmc::uint256be div(const qrvmc::uint256be& a, const qrvmc::uint256be& b) noexcept
+{
+    qrvmc::uint256be q;
+    if (qrvmc::is_zero(b))
+        return q;
+    qrvmc::uint256be rem;
+    for (size_t i = 0; i < 256; ++i)
+    {
+        rem = add(rem, rem);
+        if ((a.bytes[i / 8] >> (7 - i % 8)) & 1)
+            rem.bytes[31] |= 1;
+        if (!(rem < b))
+        {
+            rem = sub(rem, b);
+            q.bytes[i / 8] |= static_cast<uint8_t>(1 << (7 - i % 8));
+        }
+    }
+    return q;
+}
+}  // namespace naive
+
+/// The pseudo-random operands of various lengths.
+std::vector<qrvmc::uint256> operands(size_t n)
+{
+    std::vector<qrvmc::uint256> values;
+    uint64_t s = 0x243f6a8885a308d3;
+    for (size_t i = 0; i < n; ++i)
+    {
+        qrvmc::uint256 v;
+        for (auto& w : v.words)
+        {
+            s ^= s << 13;
+            s ^= s >> 7;
+            s ^= s << 17;
+            w = s;
+        }
+        values.push_back(v >> (i * 37 % 256));
+    }
+    return values;
+}
+
+std::vector<qrvmc::uint256be> operands_be(size_t n)
+{
+    std::vector<qrvmc::uint256be> values;
+    for (const auto& v : operands(n))
+        values.push_back(qrvmc::to_uint256be(v));
+    return values;
+}
+
+template <typename T, T (*Op)(const T&, const T&)>
+void binary_op(benchmark::State& state, const std::vector<T>& values)
+{
+    for ([[maybe_unused]] auto _ : state)
+    {
+        for (size_t i = 0; i + 1 < values.size(); ++i)
+        {
+            auto r = Op(values[i], values[i + 1]);
+            benchmark::DoNotOptimize(r);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(values.size() - 1));
+}
+
+constexpr size_t num_operands = 257;
+
+template <qrvmc::uint256 (*Op)(const qrvmc::uint256&, const qrvmc::uint256&)>
+void uint256_op(benchmark::State& state)
+{
+    binary_op<qrvmc::uint256, Op>(state, operands(num_operands));
+}
+
+template <qrvmc::uint256be (*Op)(const qrvmc::uint256be&, const qrvmc::uint256be&)>
+void naive_op(benchmark::State& state)
+{
+    binary_op<qrvmc::uint256be, Op>(state, operands_be(num_operands));
+}
+
+qrvmc::uint256 add(const qrvmc::uint256& a, const qrvmc::uint256& b) noexcept
+{
+    return a + b;
+}
+qrvmc::uint256 mul(const qrvmc::uint256& a, const qrvmc::uint256& b) noexcept
+{
+    return a * b;
+}
+qrvmc::uint256 div(const qrvmc::uint256& a, const qrvmc::uint256& b) noexcept
+{
+    return a / b;
+}
+
+/// The ADD instruction of an interpreter with the big-endian stack: the conversion
+/// to the native words, the addition and the conversion back.
+qrvmc::uint256be add_be(const qrvmc::uint256be& a, const qrvmc::uint256be& b) noexcept
+{
+    return qrvmc::to_uint256be(qrvmc::to_uint256(a) + qrvmc::to_uint256(b));
+}
+}  // namespace
+
+BENCHMARK_TEMPLATE(naive_op, naive::add)->Name("uint256_add/naive");
+BENCHMARK_TEMPLATE(uint256_op, add)->Name("uint256_add/words");
+BENCHMARK_TEMPLATE(naive_op, add_be)->Name("uint256_add/words_with_conversion");
+BENCHMARK_TEMPLATE(naive_op, naive::mul)->Name("uint256_mul/naive");
+BENCHMARK_TEMPLATE(uint256_op, mul)->Name("uint256_mul/words");
+BENCHMARK_TEMPLATE(naive_op, naive::div)->Name("uint256_div/naive");
+BENCHMARK_TEMPLATE(uint256_op, div)->Name("uint256_div/words");
@@ -0,0 +1,143 @@
+// EVMC: Ethereum Client-VM Connector API.
+// Copyright 2026 The EVMC Authors.
+// Licensed under the Apache License, Version 2.0.
+
+#include <qrvmc/concurrent_mocked_host.hpp>
+#include <gtest/gtest.h>
+#include <thread>
+
+using namespace qrvmc::literals;
+
+TEST(concurrent_mocked_host, storage)
+{
+    const auto addr = "Q2000000000000000000000000000000000000000"_address;
+    const auto key = 0x01_bytes32;
+    const auto val1 = 0x02_bytes32;
+    const auto val2 = 0x03_bytes32;
+
+    qrvmc::ConcurrentMockedHost host;
+    const auto& chost = host;
+
+    EXPECT_FALSE(chost.account_exists(addr));
+    EXPECT_EQ(chost.get_storage(addr, key), qrvmc::bytes32{});
+    EXPECT_EQ(host.set_storage(addr, key, val1), QRVMC_STORAGE_ADDED);
+    EXPECT_TRUE(chost.account_exists(addr));
+    EXPECT_EQ(chost.get_storage(addr, key), val1);
+    EXPECT_EQ(host.set_storage(addr, key, val2), QRVMC_STORAGE_ASSIGNED);
+    EXPECT_EQ(host.set_storage(addr, key, {}), QRVMC_STORAGE_ADDED_DELETED);
+
+    const auto account = chost.get_account(addr);
+    ASSERT_TRUE(account.has_value());
+    EXPECT_EQ(account->storage.at(key).current, qrvmc::bytes32{});
+    EXPECT_FALSE(chost.get_account({}).has_value());
+
+    EXPECT_EQ(host.access_storage(addr, key), QRVMC_ACCESS_COLD);
+    EXPECT_EQ(host.access_storage(addr, key), QRVMC_ACCESS_WARM);
+}
+
+TEST(concurrent_mocked_host, accounts)
+{
+    const auto addr = "Q3000000000000000000000000000000000000000"_address;
+
+    qrvmc::ConcurrentMockedHost host;
+    qrvmc::MockedAccount account;
+    account.code = {0x60, 0x00, 0x00};
+    account.codehash = 0xc0de_bytes32;
+    account.set_balance(7);
+    host.set_account(addr, account);
+
+    EXPECT_EQ(host.get_balance(addr), 0x07_bytes32);
+    EXPECT_EQ(host.get_code_size(addr), size_t{3});
+    EXPECT_EQ(host.get_code_hash(addr), 0xc0de_bytes32);
+
+    uint8_t code[4]{};
+    EXPECT_EQ(host.copy_code(addr, 1, code, sizeof(code)), size_t{2});
+    EXPECT_EQ(code[0], 0x00);
+    EXPECT_EQ(host.copy_code(addr, 3, code, sizeof(code)), size_t{0});
+
+    host.update_account(addr, [](qrvmc::MockedAccount& a) { ++a.nonce; });
+    EXPECT_EQ(host.get_account(addr)->nonce, 1);
+
+    EXPECT_EQ(host.access_account(addr), QRVMC_ACCESS_COLD);
+    EXPECT_EQ(host.access_account(addr), QRVMC_ACCESS_WARM);
+    EXPECT_EQ(host.access_account("Q0000000000000000000000000000000000000001"_address),
+              QRVMC_ACCESS_WARM);
+    EXPECT_EQ(host.recorded_account_accesses().size(), size_t{8});
+
+    host.clear_recordings();
+    EXPECT_TRUE(host.recorded_account_accesses().empty());
+    EXPECT_EQ(host.access_account(addr), QRVMC_ACCESS_COLD);
+}
+
+TEST(concurrent_mocked_host, block_hashes)
+{
+    qrvmc::ConcurrentMockedHost host;
+    host.block_hash = 0xff_bytes32;
+    host.block_hashes.set(1000, 0x03e8_bytes32);
+
+    EXPECT_EQ(host.get_block_hash(1000), 0x03e8_bytes32);
+    EXPECT_EQ(host.get_block_hash(999), 0xff_bytes32);
+    EXPECT_EQ(host.recorded_blockhashes(), (std::vector<int64_t>{1000, 999}));
+
+    host.record_blockhashes = false;
+    EXPECT_EQ(host.get_block_hash(1000), 0x03e8_bytes32);
+    EXPECT_EQ(host.recorded_blockhashes().size(), size_t{2});
+}
+
+TEST(concurrent_mocked_host, concurrent_execution)
+{
+    constexpr int num_threads = 8;
+    constexpr int num_iterations = 1000;
+    const auto shared_addr = "Q5000000000000000000000000000000000000005"_address;
+    const auto topic = 0x70_bytes32;
+    const uint8_t log_data[] = {0xda, 0x7a};
+
+    qrvmc::ConcurrentMockedHost host;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; ++t)
+    {
+        threads.emplace_back([&, t] {
+            const auto own_addr = qrvmc::address{static_cast<uint64_t>(t + 1)};
+            const auto key = qrvmc::bytes32{static_cast<uint64_t>(t)};
+            for (int i = 0; i < num_iterations; ++i)
+            {
+                host.set_storage(own_addr, key, qrvmc::bytes32{static_cast<uint64_t>(i)});
+                host.update_account(shared_addr, [](qrvmc::MockedAccount& a) { ++a.nonce; });
+                host.get_storage(shared_addr, key);
+            }
+            const uint8_t input[] = {static_cast<uint8_t>(t)};
+            qrvmc_message msg{};
+            msg.recipient = own_addr;
+            msg.input_data = input;
+            msg.input_size = sizeof(input);
+            host.call(msg);
+            host.emit_log(own_addr, log_data, sizeof(log_data), &topic, 1);
+            host.get_block_hash(t);
+        });
+    }
+    for (auto& t : threads)
+        t.join();
+
+    EXPECT_EQ(host.get_account(shared_addr)->nonce, num_threads * num_iterations);
+    for (int t = 0; t < num_threads; ++t)
+    {
+        EXPECT_EQ(host.get_storage(qrvmc::address{static_cast<uint64_t>(t + 1)},
+                                   qrvmc::bytes32{static_cast<uint64_t>(t)}),
+                  qrvmc::bytes32{num_iterations - 1});
+    }
+
+    const auto calls = host.recorded_calls();
+    ASSERT_EQ(calls.size(), size_t{num_threads});
+    for (const auto& call : calls)
+    {
+        ASSERT_EQ(call.input_size, size_t{1});
+        EXPECT_EQ(qrvmc::address{uint64_t{call.input_data[0]} + 1}, call.recipient);
+    }
+
+    const auto logs = host.recorded_logs();
+    ASSERT_EQ(logs.size(), size_t{num_threads});
+    EXPECT_EQ(logs[0].data, qrvmc::bytes(log_data, sizeof(log_data)));
+    EXPECT_EQ(logs[0].topics, std::vector<qrvmc::bytes32>{topic});
+    EXPECT_EQ(host.recorded_blockhashes().size(), size_t{num_threads});
+}
@@ -77,6 +77,96 @@ public:
     }
 };
 
+/// The Host with the storage bound to the host interface at compile time.
+class StaticStorageHost : public qrvmc::StaticHost<StaticStorageHost>
+{
+public:
+    std::map<qrvmc::bytes32, qrvmc::bytes32> storage;
+    int num_calls = 0;
+    int num_logs = 0;
+    mutable int num_tx_context_calls = 0;
+
+    bool account_exists(const qrvmc::address& addr) const noexcept { return addr.bytes[19] == 1; }
+
+    qrvmc::bytes32 get_storage(const qrvmc::address& /*addr*/,
+                               const qrvmc::bytes32& key) const noexcept
+    {
+        const auto it = storage.find(key);
+        return it != storage.end() ? it->second : qrvmc::bytes32{};
+    }
+
+    qrvmc_storage_status set_storage(const qrvmc::address& /*addr*/,
+                                     const qrvmc::bytes32& key,
+                                     const qrvmc::bytes32& value) noexcept
+    {
+        auto& slot = storage[key];
+        const auto status = slot == value ? QRVMC_STORAGE_ASSIGNED : QRVMC_STORAGE_MODIFIED;
+        slot = value;
+        return status;
+    }
+
+    qrvmc::uint256be get_balance(const qrvmc::address& /*addr*/) const noexcept
+    {
+        return qrvmc::uint256be{100};
+    }
+
+    size_t get_code_size(const qrvmc::address& /*addr*/) const noexcept { return 3; }
+
+    qrvmc::bytes32 get_code_hash(const qrvmc::address& /*addr*/) const noexcept
+    {
+        return 0xc0de_bytes32;
+    }
+
+    size_t copy_code(const qrvmc::address& /*addr*/,
+                     size_t code_offset,
+                     uint8_t* buffer_data,
+                     size_t buffer_size) const noexcept
+    {
+        const auto n = std::min(buffer_size, size_t{3} - std::min(size_t{3}, code_offset));
+        std::fill_n(buffer_data, n, uint8_t{0x5b});
+        return n;
+    }
+
+    qrvmc::Result call(const qrvmc_message& msg) noexcept
+    {
+        ++num_calls;
+        return qrvmc::Result{QRVMC_SUCCESS, msg.gas, 0, msg.input_data, msg.input_size};
+    }
+
+    qrvmc_tx_context get_tx_context() const noexcept
+    {
+        ++num_tx_context_calls;
+        qrvmc_tx_context tx{};
+        tx.block_number = 42;
+        return tx;
+    }
+
+    qrvmc::bytes32 get_block_hash(int64_t block_number) const noexcept
+    {
+        return qrvmc::bytes32{static_cast<uint64_t>(block_number)};
+    }
+
+    void emit_log(const qrvmc::address& /*addr*/,
+                  const uint8_t* /*data*/,
+                  size_t /*data_size*/,
+                  const qrvmc::bytes32 /*topics*/[],
+                  size_t /*num_topics*/) noexcept
+    {
+        ++num_logs;
+    }
+
+    qrvmc_access_status access_account(const qrvmc::address& /*addr*/) noexcept
+    {
+        return QRVMC_ACCESS_WARM;
+    }
+
+    qrvmc_access_status access_storage(const qrvmc::address& /*addr*/,
+                                       const qrvmc::bytes32& /*key*/) noexcept
+    {
+        return QRVMC_ACCESS_COLD;
+    }
+};
+
 TEST(cpp, address)
 {
     qrvmc::address a;
@@ -289,6 +379,129 @@ TEST(cpp, address_comparison)
     }
 }
 
+TEST(cpp, precompile_id)
+{
+    EXPECT_EQ(qrvmc::precompile_id({}), 0);
+    EXPECT_EQ(qrvmc::precompile_id("Q0000000000000000000000000000000000000001"_address), 1);
+    EXPECT_TRUE(qrvmc::is_precompile("Q000000000000000000000000000000000000ffff"_address));
+    EXPECT_FALSE(qrvmc::is_precompile("Q0000000000000000000000000000000000010000"_address));
+    EXPECT_FALSE(qrvmc::is_precompile({}));
+    for (size_t i = 0; i < sizeof(qrvmc::address) - 2; ++i)
+    {
+        auto a = qrvmc::address{0x0004};
+        a.bytes[i] = 1;
+        EXPECT_EQ(qrvmc::precompile_id(a), 0);
+        EXPECT_FALSE(qrvmc::is_precompile(a));
+    }
+    for (uint64_t id = 1; id <= 0xffff; id += 0xff)
+    {
+        const auto a = qrvmc::address{id};
+        EXPECT_EQ(qrvmc::precompile_id(a), id);
+        EXPECT_TRUE(qrvmc::is_precompile(a));
+    }
+}
+
+TEST(cpp, uint256)
+{
+    using qrvmc::uint256;
+    constexpr auto max = uint256{~uint64_t{0}, ~uint64_t{0}, ~uint64_t{0}, ~uint64_t{0}};
+
+    static_assert(uint256{1} + uint256{2} == uint256{3});
+    static_assert(max + uint256{1} == uint256{});
+    static_assert(uint256{} - uint256{1} == max);
+    static_assert(-uint256{1} == max);
+    static_assert(~uint256{} == max);
+    static_assert(uint256{1} << 255 == uint256{0, 0, 0, uint64_t{1} << 63});
+    static_assert(max >> 255 == uint256{1});
+    static_assert(uint256{~uint64_t{0}} * uint256{~uint64_t{0}} ==
+                  uint256{1, ~uint64_t{0} - 1, 0, 0});
+    static_assert(max * max == uint256{1});
+    static_assert(uint256{0, 1, 0, 0} < uint256{0, 0, 1, 0});
+    static_assert(uint256{~uint64_t{0}} < uint256{0, 1, 0, 0});
+    static_assert(!(max < max));
+    static_assert(max / uint256{7} * uint256{7} + max % uint256{7} == max);
+
+    EXPECT_EQ(uint256{5} - uint256{7}, -uint256{2});
+    EXPECT_EQ((uint256{0, 0, 0, 1} - uint256{1}),
+              (uint256{~uint64_t{0}, ~uint64_t{0}, ~uint64_t{0}}));
+    EXPECT_EQ((max + max), (uint256{~uint64_t{0} - 1, ~uint64_t{0}, ~uint64_t{0}, ~uint64_t{0}}));
+    EXPECT_EQ((uint256{0xf0} & uint256{0x3c}), uint256{0x30});
+    EXPECT_EQ((uint256{0xf0} | uint256{0x3c}), uint256{0xfc});
+    EXPECT_EQ((uint256{0xf0} ^ uint256{0x3c}), uint256{0xcc});
+    EXPECT_EQ(uint256{1} << 256, uint256{});
+    EXPECT_EQ(max >> 256, uint256{});
+    EXPECT_EQ(max << 0, max);
+    EXPECT_EQ((uint256{1, 2, 3, 4} << 64), (uint256{0, 1, 2, 3}));
+    EXPECT_EQ((uint256{1, 2, 3, 4} >> 128), (uint256{3, 4, 0, 0}));
+    EXPECT_EQ((uint256{0x8000000000000001} << 1), (uint256{2, 1, 0, 0}));
+    EXPECT_EQ((uint256{0, 1, 0, 0} >> 1), (uint256{0x8000000000000000}));
+
+    EXPECT_TRUE(static_cast<bool>(uint256{0, 0, 0, 1}));
+    EXPECT_FALSE(static_cast<bool>(uint256{}));
+    EXPECT_EQ(static_cast<uint64_t>(uint256{7, 1, 1, 1}), uint64_t{7});
+    EXPECT_GT((uint256{0, 0, 0, uint64_t{1} << 63}), max >> 1);
+    EXPECT_LE(uint256{3}, uint256{3});
+    EXPECT_GE(uint256{3}, uint256{3});
+    EXPECT_NE(uint256{3}, (uint256{3, 0, 0, 1}));
+}
+
+TEST(cpp, uint256_division)
+{
+    using qrvmc::uint256;
+    constexpr auto max = uint256{~uint64_t{0}, ~uint64_t{0}, ~uint64_t{0}, ~uint64_t{0}};
+
+    EXPECT_EQ(uint256{7} / uint256{}, uint256{});
+    EXPECT_EQ(uint256{7} % uint256{}, uint256{});
+    EXPECT_EQ(uint256{7} / uint256{8}, uint256{});
+    EXPECT_EQ(uint256{7} % uint256{8}, uint256{7});
+    EXPECT_EQ(max / max, uint256{1});
+    EXPECT_EQ(max % max, uint256{});
+    EXPECT_EQ(max / uint256{1}, max);
+    EXPECT_EQ((max / uint256{0, 0, 0, 1}), (uint256{~uint64_t{0}}));
+    EXPECT_EQ((max % uint256{0, 0, 0, 1}), (uint256{~uint64_t{0}, ~uint64_t{0}, ~uint64_t{0}}));
+    EXPECT_EQ((uint256{0, 0, 0, 1} / uint256{3}),
+              (uint256{0x5555555555555555, 0x5555555555555555, 0x5555555555555555}));
+
+    // The case of the quotient digit estimate too big by one (the "add back" step).
+    const auto u = uint256{0, 0, 0, 1};
+    const auto v = uint256{1, 0, 1};
+    const auto [q, r] = qrvmc::udivrem(u, v);
+    EXPECT_EQ(q, uint256{~uint64_t{0}});
+    EXPECT_EQ(r, (uint256{1, ~uint64_t{0}}));
+
+    // Compare with the multiplication for pseudo-random values of various lengths.
+    uint64_t state = 0x243f6a8885a308d3;
+    const auto next = [&state] {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    };
+    for (int i = 0; i < 1000; ++i)
+    {
+        const auto a = uint256{next(), next(), next(), next()} >> (next() % 256);
+        const auto b = uint256{next(), next(), next(), next()} >> (next() % 256);
+        if (!b)
+            continue;
+        const auto d = qrvmc::udivrem(a, b);
+        EXPECT_EQ(d.quot * b + d.rem, a);
+        EXPECT_LT(d.rem, b);
+        EXPECT_EQ(a / b, d.quot);
+        EXPECT_EQ(a % b, d.rem);
+    }
+}
+
+TEST(cpp, uint256_be_conversion)
+{
+    constexpr auto be = 0x0102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f20_bytes32;
+    constexpr auto v = qrvmc::to_uint256(be);
+    static_assert(v[0] == 0x191a1b1c1d1e1f20);
+    static_assert(v[3] == 0x0102030405060708);
+    static_assert(qrvmc::to_uint256be(v) == be);
+    EXPECT_EQ(qrvmc::to_uint256(qrvmc::uint256be{0xb4}), qrvmc::uint256{0xb4});
+    EXPECT_EQ(qrvmc::to_uint256be(qrvmc::uint256{0xb4}), qrvmc::uint256be{0xb4});
+}
+
 TEST(cpp, bytes32_comparison)
 {
     const auto zero = qrvmc::bytes32{};
@@ -604,6 +817,25 @@ TEST(cpp, vm_execute_precompiles)
     EXPECT_TRUE(std::equal(input.begin(), input.end(), res.output_data));
 }
 
+TEST(cpp, vm_execute_precompiles_dispatch)
+{
+    auto vm = qrvmc::VM{qrvmc_create_example_precompiles_vm()};
+
+    qrvmc_message msg{};
+    msg.gas = 100;
+
+    msg.code_address = "Q0000000000000000000000000000000000000006"_address;
+    EXPECT_EQ(vm.execute(QRVMC_MAX_REVISION, msg, nullptr, 0).status_code, QRVMC_OUT_OF_GAS);
+
+    msg.code_address = "Q0000000000000000000000000000000000000009"_address;
+    auto res = vm.execute(QRVMC_MAX_REVISION, msg, nullptr, 0);
+    EXPECT_EQ(res.status_code, QRVMC_SUCCESS);
+    EXPECT_EQ(res.gas_left, 100);
+
+    msg.code_address = "Q0000000000000000000000000000000000010004"_address;
+    EXPECT_EQ(vm.execute(QRVMC_MAX_REVISION, msg, nullptr, 0).status_code, QRVMC_REJECTED);
+}
+
 TEST(cpp, vm_execute_with_null_host)
 {
     // This tests only if the used VM::execute() overload is at least implemented.
@@ -653,6 +885,156 @@ TEST(cpp, host)
     host.emit_log(a, nullptr, 0, nullptr, 0);
 }
 
+TEST(cpp, static_host)
+{
+    // Execute all methods of the StaticHost through the host interface.
+    StaticStorageHost static_host;
+    auto host = qrvmc::HostContext{StaticStorageHost::get_interface(), static_host.to_context()};
+    EXPECT_EQ(StaticStorageHost::from_context(static_host.to_context()), &static_host);
+
+    const auto a = qrvmc::address{1};
+    const auto k = 0x01_bytes32;
+    const auto v = qrvmc::bytes32{{{7, 7, 7}}};
+
+    EXPECT_TRUE(host.account_exists(a));
+    EXPECT_FALSE(host.account_exists({}));
+
+    EXPECT_EQ(host.set_storage(a, k, v), QRVMC_STORAGE_MODIFIED);
+    EXPECT_EQ(host.set_storage(a, k, v), QRVMC_STORAGE_ASSIGNED);
+    EXPECT_EQ(host.get_storage(a, k), v);
+    EXPECT_EQ(host.get_storage(a, {}), qrvmc::bytes32{});
+
+    EXPECT_EQ(host.get_balance(a), qrvmc::uint256be{100});
+    EXPECT_EQ(host.get_code_size(a), 3u);
+    EXPECT_EQ(host.get_code_hash(a), 0xc0de_bytes32);
+    uint8_t code[4]{};
+    EXPECT_EQ(host.copy_code(a, 1, code, sizeof(code)), 2u);
+    EXPECT_EQ(code[1], 0x5b);
+    EXPECT_EQ(code[2], 0);
+
+    const uint8_t input[] = {1, 2};
+    qrvmc_message msg{};
+    msg.gas = 10;
+    msg.input_data = input;
+    msg.input_size = sizeof(input);
+    const auto res = host.call(msg);
+    EXPECT_EQ(res.status_code, QRVMC_SUCCESS);
+    EXPECT_EQ(res.gas_left, 10);
+    EXPECT_EQ(qrvmc::bytes(res.output_data, res.output_size), qrvmc::bytes(input, 2));
+    EXPECT_EQ(static_host.num_calls, 1);
+
+    EXPECT_EQ(host.get_tx_context().block_number, 42);
+    EXPECT_EQ(host.get_block_hash(5), qrvmc::bytes32{5});
+
+    host.emit_log(a, nullptr, 0, nullptr, 0);
+    EXPECT_EQ(static_host.num_logs, 1);
+
+    EXPECT_EQ(host.access_account(a), QRVMC_ACCESS_WARM);
+    EXPECT_EQ(host.access_storage(a, k), QRVMC_ACCESS_COLD);
+}
+
+TEST(cpp, static_host_execute)
+{
+    // The example VM stores the block number at the storage key 0 with the example code.
+    StaticStorageHost static_host;
+    auto vm = qrvmc::VM{qrvmc_create_example_vm()};
+    const auto code = qrvmc::from_hex("4360005543600052596000f3").value();
+    qrvmc_message msg{};
+    msg.gas = 100000;
+    const auto res = vm.execute(StaticStorageHost::get_interface(), static_host.to_context(),
+                                QRVMC_SHANGHAI, msg, code.data(), code.size());
+    EXPECT_EQ(res.status_code, QRVMC_SUCCESS);
+    EXPECT_EQ(static_host.storage[{}], qrvmc::bytes32{42});
+    EXPECT_EQ(static_host.num_tx_context_calls, 1);
+}
+
+TEST(cpp, tx_context_cache)
+{
+    qrvmc_message msg{};
+
+    // Without the flag the context is copied once, on the first use.
+    StaticStorageHost static_host;
+    qrvmc::TxContextCache cache{&StaticStorageHost::get_interface(), static_host.to_context(),
+                                msg};
+    EXPECT_EQ(static_host.num_tx_context_calls, 0);
+    EXPECT_EQ(cache.get().block_number, 42);
+    EXPECT_EQ(cache.get().block_number, 42);
+    EXPECT_EQ(static_host.num_tx_context_calls, 1);
+
+    // The host not providing the pointer falls back to the copy.
+    msg.flags = QRVMC_HOST_TX_CONTEXT_PTR;
+    qrvmc::TxContextCache fallback{&StaticStorageHost::get_interface(),
+                                   static_host.to_context(), msg};
+    EXPECT_EQ(fallback.get().block_number, 42);
+    EXPECT_EQ(static_host.num_tx_context_calls, 2);
+
+    // With the flag the host's context is referenced.
+    qrvmc::MockedHost mocked_host;
+    mocked_host.tx_context.block_number = 7;
+    qrvmc::TxContextCache ptr{&qrvmc::MockedHost::get_interface(), mocked_host.to_context(),
+                              msg};
+    EXPECT_EQ(&ptr.get(), &mocked_host.tx_context);
+    EXPECT_EQ(ptr.get().block_number, 7);
+}
+
+TEST(cpp, log_buffer)
+{
+    const auto a = qrvmc::address{0xa};
+    const uint8_t data[] = {1, 2, 3};
+    const qrvmc::bytes32 topics[] = {qrvmc::bytes32{1}, qrvmc::bytes32{2}};
+    qrvmc_message msg{};
+
+    qrvmc::LogBuffer logs;
+    EXPECT_TRUE(logs.empty());
+
+    // Without the flag the logs are emitted one by one.
+    qrvmc::MockedHost host;
+    logs.append(a, data, sizeof(data), topics, 2);
+    logs.append(a, nullptr, 0, nullptr, 0);
+    EXPECT_EQ(logs.size(), size_t{2});
+    logs.flush(&qrvmc::MockedHost::get_interface(), host.to_context(), msg);
+    EXPECT_TRUE(logs.empty());
+    ASSERT_EQ(host.recorded_logs.size(), size_t{2});
+    EXPECT_EQ(host.recorded_logs[0].creator, a);
+    EXPECT_EQ(host.recorded_logs[0].data, qrvmc::bytes_view(data, sizeof(data)));
+    EXPECT_EQ(host.recorded_logs[0].topics, qrvmc::bytes32_view(topics, 2));
+    EXPECT_TRUE(host.recorded_logs[1].data.empty());
+    EXPECT_TRUE(host.recorded_logs[1].topics.empty());
+
+    // With the flag the logs are passed in the batch, the same as emitted one by one.
+    msg.flags = QRVMC_HOST_EMIT_LOGS;
+    qrvmc::MockedHost batch_host;
+    logs.append(a, data, sizeof(data), topics, 2);
+    logs.append(a, nullptr, 0, nullptr, 0);
+    logs.flush(&qrvmc::MockedHost::get_interface(), batch_host.to_context(), msg);
+    EXPECT_EQ(batch_host.recorded_logs, host.recorded_logs);
+
+    // The cleared logs are not emitted.
+    logs.append(a, data, sizeof(data), topics, 1);
+    logs.clear();
+    logs.flush(&qrvmc::MockedHost::get_interface(), batch_host.to_context(), msg);
+    EXPECT_EQ(batch_host.recorded_logs.size(), size_t{2});
+
+    // The logs after the checkpoint are dropped by the truncation.
+    logs.append(a, data, 1, topics, 1);
+    logs.append(a, data, sizeof(data), topics, 2);
+    logs.truncate(2);
+    EXPECT_EQ(logs.size(), size_t{2});
+    logs.truncate(1);
+    EXPECT_EQ(logs.size(), size_t{1});
+    logs.flush(&qrvmc::MockedHost::get_interface(), batch_host.to_context(), msg);
+    ASSERT_EQ(batch_host.recorded_logs.size(), size_t{3});
+    EXPECT_EQ(batch_host.recorded_logs[2].data, qrvmc::bytes_view(data, 1));
+    EXPECT_EQ(batch_host.recorded_logs[2].topics, qrvmc::bytes32_view(topics, 1));
+
+    // The default emit_logs() of the StaticHost calls emit_log().
+    StaticStorageHost static_host;
+    logs.append(a, data, sizeof(data), topics, 2);
+    logs.append(a, data, sizeof(data), topics, 0);
+    logs.flush(&StaticStorageHost::get_interface(), static_host.to_context(), msg);
+    EXPECT_EQ(static_host.num_logs, 2);
+}
+
 TEST(cpp, host_call)
 {
     // Use example host to test Host::call() method.
@@ -949,6 +1331,35 @@ TEST(cpp, revision_to_string_invalid)
     }
 }
 
+TEST(cpp, dispatch_revision)
+{
+    constexpr auto get = [](auto revision) { return decltype(revision)::value; };
+    static_assert(qrvmc::dispatch_revision(QRVMC_MAX_REVISION, get) == QRVMC_MAX_REVISION);
+    EXPECT_EQ(qrvmc::dispatch_revision(QRVMC_SHANGHAI, get), QRVMC_SHANGHAI);
+    EXPECT_EQ(qrvmc::dispatch_revision(QRVMC_LATEST_STABLE_REVISION, get),
+              QRVMC_LATEST_STABLE_REVISION);
+
+    // The revision is the constant expression in the callee.
+    const auto size = qrvmc::dispatch_revision(QRVMC_SHANGHAI, [](auto revision) {
+        constexpr auto rev = decltype(revision)::value;
+        return std::array<int, rev>{}.size();
+    });
+    EXPECT_EQ(size, size_t{QRVMC_SHANGHAI});
+
+    // The callee's result is forwarded, also by reference.
+    int result = 0;
+    qrvmc::dispatch_revision(QRVMC_SHANGHAI, [&result](auto) -> int& { return result; }) = 1;
+    EXPECT_EQ(result, 1);
+
+    // Unknown revisions are dispatched as the earliest one.
+    if (!has_ubsan())
+    {
+        int value = 99;  // NOLINT(misc-const-correctness) Not const because GCC complains.
+        EXPECT_EQ(qrvmc::dispatch_revision(static_cast<qrvmc_revision>(value), get),
+                  QRVMC_SHANGHAI);
+    }
+}
+
 TEST(cpp, result_c_const_access)
 {
     static constexpr auto get_status = [](const qrvmc_result& c_result) noexcept {
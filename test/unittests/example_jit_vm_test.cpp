@@ -0,0 +1,269 @@
+// EVMC: Ethereum Client-VM Connector API.
+// Copyright 2026 The EVMC Authors.
+// Licensed under the Apache License, Version 2.0.
+
+#include "../../examples/example_jit_vm/example_jit_vm.h"
+#include "../../examples/example_vm/example_vm.h"
+#include <qrvmc/executing_mocked_host.hpp>
+#include <qrvmc/hex.hpp>
+#include <qrvmc/qrvmc.hpp>
+#include <gtest/gtest.h>
+#include <string>
+
+using namespace qrvmc::literals;
+
+namespace
+{
+auto jit_vm = qrvmc::VM{qrvmc_create_example_jit_vm()};
+
+class example_jit_vm : public testing::Test
+{
+protected:
+    qrvmc::MockedHost host;
+    qrvmc_message msg{};
+
+    example_jit_vm() noexcept
+    {
+        msg.sender = "Q5000000000000000000000000000000000000005"_address;
+        msg.recipient = "Qd00000000000000000000000000000000000000d"_address;
+        host.tx_context.block_number = 0xb4;
+        host.block_hashes.set(0x0101, 0xb10c_bytes32);
+    }
+
+    qrvmc::Result execute(qrvmc::VM& vm,
+                          qrvmc::MockedHost& h,
+                          int64_t gas,
+                          const char* code_hex,
+                          const char* input_hex = "")
+    {
+        const auto code = qrvmc::from_hex(code_hex).value();
+        const auto input = qrvmc::from_hex(input_hex).value();
+
+        msg.gas = gas;
+        msg.input_data = input.data();
+        msg.input_size = input.size();
+
+        return vm.execute(h, QRVMC_MAX_REVISION, msg, code.data(), code.size());
+    }
+
+    qrvmc::Result execute(int64_t gas, const char* code_hex, const char* input_hex = "")
+    {
+        return execute(jit_vm, host, gas, code_hex, input_hex);
+    }
+};
+}  // namespace
+
+TEST_F(example_jit_vm, same_results_as_interpreter)
+{
+    // The Example VM in the block charging mode is the reference.
+    auto interpreter = qrvmc::VM{qrvmc_create_example_vm()};
+    ASSERT_EQ(interpreter.set_option("charging", "block"), QRVMC_SET_OPTION_SUCCESS);
+
+    const struct
+    {
+        int64_t gas;
+        const char* code;
+        const char* input;
+    } test_cases[] = {
+        {999, "", ""},
+        {10, "60ff60005260206000f3", ""},
+        {13, "7fd0d1d2d3d4d5d6d7d8d9dadbdcdddedfe0e1e2e3e4e5e6e7e8e9eaebecedeeef60005260206000f3",
+         ""},
+        {9, "306000526014600cf3", ""},
+        {10, "60016000540160005500", ""},
+        {10, "43600052596000f3", ""},
+        {10, "60016302000000f3", ""},
+        {10, "60026301fffffffd", ""},
+        {10, "4360005260206000fd", ""},
+        {13, "6101014060005260206000f3", ""},
+        {100, "6003808080808080f1596000f3", ""},
+        {10, "600235600052596000f3",
+         "4444000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f"},
+        {10, "600035600052596000f3", "aabbccdd"},
+        {1000, "61ffff6801000000000000000052", ""},
+        {3000, "6001613fe05260006000f3", ""},
+        {2053, "6001613fe05260006000f3", ""},
+        {100, "60aa60005160205260206020f3", ""},
+        {100, "60246001600037596000f3", "aabbccddee"},
+        {100, "6fffffffffffffffffffffffffffffffff600160801b0260005260206000f3", ""},
+        {100, "600360016000030460005260206000f3", ""},
+        {100, "600a6000190660005260206000f3", ""},
+        {100, "600160ff1b60011c60005260206000f3", ""},
+        {100, "600360031460026001110160026001100160005260206000f3", ""},
+        {100, "60ff603c16600f60f0171860005260206000f3", ""},
+        {100, "6000196001016000526001600003600052596000f3", ""},  // Carries through words.
+        {1000, "60105b600190038060025760005260206000f3", ""},
+        {50, "60105b600190038060025760005260206000f3", ""},
+        {100, "600056", ""},
+        {100, "6001600a57", ""},
+        {100, "6000600a57", ""},
+        {100, "600456605b00", ""},
+        {100, "600101", ""},
+        {100, "600060005701", ""},
+        {100, "5b00", ""},
+        {100, "60016001", ""},   // The implicit STOP.
+        {100, "0c", ""},         // The undefined instruction.
+        {100, "6001600a", ""},   // PUSH1 at the code end.
+        {100, "62aabb", ""},     // The truncated push data.
+        {100, "60aa600052600260016001601fa260006000a000", ""},
+        {100, "6004600360026001600160fea4", ""},
+        {100, "60206000a060006000fd", ""},                   // The log of the reverted code.
+        {3, "60206000a0", ""},                               // Out of gas after the LOG.
+        {1000, "600161ffff68010000000000000000a1", ""},      // The LOG out of memory.
+        {100, "60006000a06000808080808080f160006000fd", ""},  // The LOG before the call.
+        {100, "6001a1", ""},                                 // The LOG stack underflow.
+    };
+
+    for (const auto flags : {uint32_t{0}, uint32_t{QRVMC_HOST_EMIT_LOGS}})
+    {
+        msg.flags = flags;
+        for (const auto& t : test_cases)
+        {
+            SCOPED_TRACE(std::string{t.code} + " " + std::to_string(flags));
+            qrvmc::MockedHost interpreter_host = host;
+            const auto expected = execute(interpreter, interpreter_host, t.gas, t.code, t.input);
+            const auto r = execute(t.gas, t.code, t.input);
+            EXPECT_EQ(r.status_code, expected.status_code);
+            EXPECT_EQ(r.gas_left, expected.gas_left);
+            EXPECT_EQ(qrvmc::hex({r.output_data, r.output_size}),
+                      qrvmc::hex({expected.output_data, expected.output_size}));
+            EXPECT_EQ(host.accounts[msg.recipient].storage.size(),
+                      interpreter_host.accounts[msg.recipient].storage.size());
+            ASSERT_EQ(host.recorded_logs.size(), interpreter_host.recorded_logs.size());
+            for (size_t i = 0; i < host.recorded_logs.size(); ++i)
+            {
+                EXPECT_EQ(host.recorded_logs[i].data, interpreter_host.recorded_logs[i].data);
+                EXPECT_EQ(host.recorded_logs[i].topics,
+                          interpreter_host.recorded_logs[i].topics);
+            }
+            host.accounts.clear();
+            host.clear_recordings();
+        }
+    }
+}
+
+TEST_F(example_jit_vm, counter_in_storage)
+{
+    // Yul: sstore(0, add(sload(0), 1)) stop()
+    auto& storage_value = host.accounts[msg.recipient].storage[{}].current;
+    storage_value = 0x00000000000000000000000000000000000000000000000000000000000000bb_bytes32;
+    const auto r = execute(10, "60016000540160005500");
+    EXPECT_EQ(r.status_code, QRVMC_SUCCESS);
+    EXPECT_EQ(r.gas_left, 3);
+    EXPECT_EQ(storage_value,
+              0x00000000000000000000000000000000000000000000000000000000000000bc_bytes32);
+}
+
+TEST_F(example_jit_vm, push32)
+{
+    // Yul: mstore(0, 0xd0...ef) return(0, 32)
+    const auto r = execute(
+        13, "7fd0d1d2d3d4d5d6d7d8d9dadbdcdddedfe0e1e2e3e4e5e6e7e8e9eaebecedeeef60005260206000f3");
+    EXPECT_EQ(r.status_code, QRVMC_SUCCESS);
+    EXPECT_EQ(r.gas_left, 4);
+    EXPECT_EQ(qrvmc::hex({r.output_data, r.output_size}),
+              "d0d1d2d3d4d5d6d7d8d9dadbdcdddedfe0e1e2e3e4e5e6e7e8e9eaebecedeeef");
+}
+
+TEST_F(example_jit_vm, call)
+{
+    // pseudo-Yul: call(3, 3, 3, 3, 3, 3, 3) return(0, msize())
+    const auto call_output = qrvmc::from_hex("aabbcc").value();
+    host.call_result.output_data = call_output.data();
+    host.call_result.output_size = call_output.size();
+    const auto r = execute(100, "6003808080808080f1596000f3");
+    EXPECT_EQ(r.status_code, QRVMC_SUCCESS);
+    EXPECT_EQ(r.gas_left, 86);
+    EXPECT_EQ(qrvmc::hex({r.output_data, r.output_size}),
+              "000000aabbcc0000000000000000000000000000000000000000000000000000");
+    ASSERT_EQ(host.recorded_calls.size(), size_t{1});
+    EXPECT_EQ(host.recorded_calls[0].gas, 3);
+    EXPECT_EQ(host.recorded_calls[0].recipient,
+              "Q0000000000000000000000000000000000000003"_address);
+    EXPECT_EQ(host.recorded_calls[0].input_size, size_t{3});
+    EXPECT_EQ(host.recorded_calls[0].depth, 1);
+}
+
+TEST_F(example_jit_vm, stack_limits)
+{
+    std::string pushes;
+    for (int i = 0; i < 1025; ++i)
+        pushes += "6000";
+    EXPECT_EQ(execute(2000, pushes.c_str() + 4).status_code, QRVMC_SUCCESS);
+    EXPECT_EQ(execute(2000, pushes.c_str()).status_code, QRVMC_STACK_OVERFLOW);
+    EXPECT_EQ(execute(100, "50").status_code, QRVMC_STACK_UNDERFLOW);
+}
+
+TEST_F(example_jit_vm, loop)
+{
+    // pseudo-Yul: for { let i := 1000 } i { i := sub(i, 1) } {}
+    const auto r = execute(100000, "6103e85b600190038060035700");
+    EXPECT_EQ(r.status_code, QRVMC_SUCCESS);
+    EXPECT_EQ(r.gas_left, 100000 - (1 + 1000 * 7 + 1));
+}
+
+TEST_F(example_jit_vm, compiled_code_reused)
+{
+    // The second execution of the same code runs the cached compiled code.
+    for (int i = 0; i < 2; ++i)
+    {
+        const auto r = execute(100, "60ff60005260206000f3");
+        EXPECT_EQ(r.status_code, QRVMC_SUCCESS);
+        EXPECT_EQ(qrvmc::hex({r.output_data, r.output_size}),
+                  "00000000000000000000000000000000000000000000000000000000000000ff");
+    }
+}
+
+TEST_F(example_jit_vm, nested_calls)
+{
+    // The compiled code is reentered by the nested executions.
+    qrvmc::ExecutingMockedHost executing_host{jit_vm, QRVMC_MAX_REVISION};
+    const auto callee = "Q000000000000000000000000000000000000000a"_address;
+    executing_host.accounts[callee].code = qrvmc::from_hex("602a60005260206000f3").value();
+    executing_host.accounts[msg.recipient].code =
+        qrvmc::from_hex("60206000600060006000600a61fffff160206000f3").value();
+
+    msg.gas = 1000;
+    msg.code_address = msg.recipient;
+    const auto r = executing_host.call(msg);
+    EXPECT_EQ(r.status_code, QRVMC_SUCCESS);
+    EXPECT_EQ(qrvmc::hex({r.output_data, r.output_size}),
+              "000000000000000000000000000000000000000000000000000000000000002a");
+    EXPECT_EQ(executing_host.recorded_calls.size(), size_t{2});
+}
+
+TEST_F(example_jit_vm, nested_logs)
+{
+    // pseudo-Yul: log1(0, 0, 1) pop(call(0xffff, 0x0a, 0, 0, 0, 0, 0)) log1(0, 0, 2)
+    qrvmc::ExecutingMockedHost executing_host{jit_vm, QRVMC_MAX_REVISION};
+    const auto callee = "Q000000000000000000000000000000000000000a"_address;
+    executing_host.accounts[msg.recipient].code =
+        qrvmc::from_hex("600160006000a160006000600060006000600a61fffff150600260006000a100")
+            .value();
+    msg.gas = 1000;
+    msg.code_address = msg.recipient;
+
+    for (const auto flags : {uint32_t{0}, uint32_t{QRVMC_HOST_EMIT_LOGS}})
+    {
+        SCOPED_TRACE(flags);
+        msg.flags = flags;
+
+        // Yul: log0(0, 0)
+        executing_host.accounts[callee].code = qrvmc::from_hex("60006000a000").value();
+        executing_host.clear_recordings();
+        EXPECT_EQ(executing_host.call(msg).status_code, QRVMC_SUCCESS);
+        ASSERT_EQ(executing_host.recorded_logs.size(), size_t{3});
+        EXPECT_EQ(executing_host.recorded_logs[0].creator, qrvmc::address{msg.recipient});
+        EXPECT_EQ(executing_host.recorded_logs[1].creator, callee);
+        EXPECT_EQ(executing_host.recorded_logs[2].creator, qrvmc::address{msg.recipient});
+        EXPECT_EQ(executing_host.recorded_logs[2].topics[0], qrvmc::bytes32{2});
+
+        // Yul: log0(0, 0) revert(0, 0)
+        executing_host.accounts[callee].code = qrvmc::from_hex("60006000a060006000fd").value();
+        executing_host.clear_recordings();
+        EXPECT_EQ(executing_host.call(msg).status_code, QRVMC_SUCCESS);
+        ASSERT_EQ(executing_host.recorded_logs.size(), size_t{2});
+        EXPECT_EQ(executing_host.recorded_logs[0].creator, qrvmc::address{msg.recipient});
+        EXPECT_EQ(executing_host.recorded_logs[1].creator, qrvmc::address{msg.recipient});
+    }
+}
@@ -0,0 +1,773 @@
+// EVMC: Ethereum Client-VM Connector API.
+// Copyright 2026 The EVMC Authors.
+// Licensed under the Apache License, Version 2.0.
+
+#include "../../examples/example_precompiles_vm/example_precompiles_vm.h"
+#include "../../examples/example_precompiles_vm/expmod.hpp"
+#include "../../examples/example_precompiles_vm/sha256.hpp"
+#include <qrvmc/hex.hpp>
+#include <qrvmc/qrvmc.hpp>
+#include <gtest/gtest.h>
+#include <atomic>
+#include <initializer_list>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+using namespace qrvmc::literals;
+using precompiles::Sha256Impl;
+
+namespace
+{
+constexpr Sha256Impl sha256_impls[] = {Sha256Impl::scalar, Sha256Impl::avx2, Sha256Impl::shani};
+
+std::string sha256_hex(const qrvmc::bytes_view data, Sha256Impl impl)
+{
+    uint8_t hash[32];
+    precompiles::sha256(hash, data.data(), data.size(), impl);
+    return qrvmc::hex({hash, sizeof(hash)});
+}
+
+qrvmc::bytes_view to_bytes(std::string_view s)
+{
+    return {reinterpret_cast<const uint8_t*>(s.data()), s.size()};
+}
+
+void store32be(uint8_t* output, uint32_t value)
+{
+    for (int i = 0; i < 4; ++i)
+        output[i] = static_cast<uint8_t>(value >> (24 - 8 * i));
+}
+
+qrvmc::Result execute_precompile(uint16_t id, const qrvmc::bytes_view input, int64_t gas)
+{
+    auto vm = qrvmc::VM{qrvmc_create_example_precompiles_vm()};
+    qrvmc_message msg{};
+    msg.code_address.bytes[18] = static_cast<uint8_t>(id >> 8);
+    msg.code_address.bytes[19] = static_cast<uint8_t>(id);
+    msg.input_data = input.data();
+    msg.input_size = input.size();
+    msg.gas = gas;
+    return vm.execute(QRVMC_MAX_REVISION, msg, nullptr, 0);
+}
+}  // namespace
+
+TEST(example_precompiles_vm, sha256_test_vectors)
+{
+    // The FIPS 180-4 examples and the hash of one million 'a'.
+    const std::string million_a(1000000, 'a');
+    const struct
+    {
+        std::string_view input;
+        const char* expected;
+    } test_cases[] = {
+        {"", "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855"},
+        {"abc", "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad"},
+        {"abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq",
+         "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1"},
+        {million_a, "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0"},
+    };
+
+    for (const auto impl : sha256_impls)
+    {
+        if (!precompiles::is_supported(impl))
+            continue;
+        for (const auto& t : test_cases)
+        {
+            SCOPED_TRACE(std::to_string(static_cast<int>(impl)) + " " +
+                         std::to_string(t.input.size()));
+            EXPECT_EQ(sha256_hex(to_bytes(t.input), impl), t.expected);
+        }
+    }
+}
+
+TEST(example_precompiles_vm, sha256_implementations_agree)
+{
+    // All lengths around the block boundaries and the multi-block batches of AVX2.
+    qrvmc::bytes data(64 * 20 + 1, 0);
+    for (size_t i = 0; i < data.size(); ++i)
+        data[i] = static_cast<uint8_t>(i * 0x9d + (i >> 8));
+
+    for (size_t size = 0; size <= data.size(); ++size)
+    {
+        SCOPED_TRACE(size);
+        const auto input = qrvmc::bytes_view{data.data(), size};
+        const auto expected = sha256_hex(input, Sha256Impl::scalar);
+        for (const auto impl : sha256_impls)
+        {
+            if (precompiles::is_supported(impl))
+            {
+                EXPECT_EQ(sha256_hex(input, impl), expected);
+            }
+        }
+    }
+}
+
+TEST(example_precompiles_vm, sha256_best_impl)
+{
+    const auto best = precompiles::best_sha256_impl();
+    EXPECT_TRUE(precompiles::is_supported(best));
+
+    uint8_t hash[32];
+    precompiles::sha256(hash, nullptr, 0);
+    EXPECT_EQ(qrvmc::hex({hash, sizeof(hash)}),
+              "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+}
+
+TEST(example_precompiles_vm, sha256)
+{
+    const auto input = to_bytes("abc");
+    const auto r = execute_precompile(0x0002, input, 100);
+    EXPECT_EQ(r.status_code, QRVMC_SUCCESS);
+    EXPECT_EQ(r.gas_left, 100 - (60 + 12));
+    EXPECT_EQ(qrvmc::hex({r.output_data, r.output_size}),
+              "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+
+    const auto r_empty = execute_precompile(0x0002, {}, 60);
+    EXPECT_EQ(r_empty.status_code, QRVMC_SUCCESS);
+    EXPECT_EQ(r_empty.gas_left, 0);
+    EXPECT_EQ(qrvmc::hex({r_empty.output_data, r_empty.output_size}),
+              "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+
+    // 33 bytes are 2 words.
+    const qrvmc::bytes data(33, 0);
+    EXPECT_EQ(execute_precompile(0x0002, data, 84).gas_left, 0);
+    EXPECT_EQ(execute_precompile(0x0002, data, 83).status_code, QRVMC_OUT_OF_GAS);
+}
+
+TEST(example_precompiles_vm, expmod)
+{
+    // The EIP-198 examples: 3^(p-1) mod p for the secp256k1 field prime p.
+    const auto p = "fffffffffffffffffffffffffffffffffffffffffffffffffffffffefffffc2f";
+    const auto p_minus_1 = "fffffffffffffffffffffffffffffffffffffffffffffffffffffffefffffc2e";
+    const auto header = std::string(62, '0') + "01" + std::string(62, '0') + "20" +
+                        std::string(62, '0') + "20";
+    const auto input = qrvmc::from_hex(header + "03" + p_minus_1 + p).value();
+    const auto r = execute_precompile(0x0005, input, 2000);
+    EXPECT_EQ(r.status_code, QRVMC_SUCCESS);
+    EXPECT_EQ(r.gas_left, 2000 - 1360);
+    EXPECT_EQ(qrvmc::hex({r.output_data, r.output_size}), std::string(63, '0') + "1");
+
+    // The empty base.
+    const auto header2 = std::string(64, '0') + std::string(62, '0') + "20" +
+                         std::string(62, '0') + "20";
+    const auto input2 = qrvmc::from_hex(header2 + p_minus_1 + p).value();
+    const auto r2 = execute_precompile(0x0005, input2, 1360);
+    EXPECT_EQ(r2.status_code, QRVMC_SUCCESS);
+    EXPECT_EQ(r2.gas_left, 0);
+    EXPECT_EQ(qrvmc::hex({r2.output_data, r2.output_size}), std::string(64, '0'));
+    EXPECT_EQ(execute_precompile(0x0005, input2, 1359).status_code, QRVMC_OUT_OF_GAS);
+}
+
+TEST(example_precompiles_vm, expmod_short_input)
+{
+    // The base_len = 1, exp_len = 1, mod_len = 2, the missing input bytes are zero.
+    const auto header = std::string(62, '0') + "01" + std::string(62, '0') + "01" +
+                        std::string(62, '0') + "02";
+
+    const auto r = execute_precompile(0x0005, qrvmc::from_hex(header + "020301").value(), 200);
+    EXPECT_EQ(r.status_code, QRVMC_SUCCESS);
+    EXPECT_EQ(r.gas_left, 0);
+    EXPECT_EQ(qrvmc::hex({r.output_data, r.output_size}), "0008");  // 2^3 mod 0x0100
+
+    const auto r_zero = execute_precompile(0x0005, qrvmc::from_hex(header + "0203").value(), 200);
+    EXPECT_EQ(r_zero.status_code, QRVMC_SUCCESS);
+    EXPECT_EQ(qrvmc::hex({r_zero.output_data, r_zero.output_size}), "0000");
+
+    const auto r_empty = execute_precompile(0x0005, {}, 200);
+    EXPECT_EQ(r_empty.status_code, QRVMC_SUCCESS);
+    EXPECT_EQ(r_empty.gas_left, 0);
+    EXPECT_EQ(r_empty.output_size, size_t{0});
+}
+
+TEST(example_precompiles_vm, expmod_gas)
+{
+    const uint8_t head[] = {0x01, 0x00};  // 9 bits.
+    EXPECT_EQ(precompiles::expmod_gas(0, 0, 0, nullptr, 0), uint64_t{200});
+    EXPECT_EQ(precompiles::expmod_gas(64, 2, 64, head, 2), uint64_t{200});
+    EXPECT_EQ(precompiles::expmod_gas(256, 2, 256, head, 2), uint64_t{32 * 32 * 8 / 3});
+    EXPECT_EQ(precompiles::expmod_gas(256, 2, 255, head, 2), uint64_t{32 * 32 * 8 / 3});
+    EXPECT_EQ(precompiles::expmod_gas(1, 2, 256, head, 2), uint64_t{32 * 32 * 8 / 3});
+    EXPECT_EQ(precompiles::expmod_gas(256, 0, 256, nullptr, 0), uint64_t{32 * 32 / 3});
+    EXPECT_EQ(precompiles::expmod_gas(256, 64, 256, head, 2), uint64_t{32 * 32 * (256 + 8) / 3});
+    EXPECT_EQ(precompiles::expmod_gas(256, 64, 256, nullptr, 0), uint64_t{32 * 32 * 256 / 3});
+
+    // The cost not fitting 64 bits is clamped, but the empty base and modulus cost the minimum.
+    constexpr auto max = std::numeric_limits<uint64_t>::max();
+    EXPECT_EQ(precompiles::expmod_gas(max, 1, 1, head, 1), max);
+    EXPECT_EQ(precompiles::expmod_gas(1, max, 1, head, 2), max);
+    EXPECT_EQ(precompiles::expmod_gas(0, max, 0, head, 2), uint64_t{200});
+
+    // The huge exponent of the empty modulus is not read.
+    const auto header = std::string(64, '0') + std::string(64, 'f') + std::string(64, '0');
+    const auto r = execute_precompile(0x0005, qrvmc::from_hex(header).value(), 200);
+    EXPECT_EQ(r.status_code, QRVMC_SUCCESS);
+    EXPECT_EQ(r.output_size, size_t{0});
+    const auto header2 = std::string(62, '0') + "01" + std::string(64, 'f') + std::string(62, '0') +
+                         "01";
+    const auto r2 = execute_precompile(0x0005, qrvmc::from_hex(header2).value(), 1'000'000'000);
+    EXPECT_EQ(r2.status_code, QRVMC_OUT_OF_GAS);
+}
+
+TEST(example_precompiles_vm, expmod_huge_exponent_length)
+{
+    // The exponent of 2^58 bytes past the input end is zero and is not materialized.
+    // The modulus after it is past the input end too, so the result is 1 mod 0 = 0.
+    const auto header = std::string(64, '0') + std::string(48, '0') + "0400000000000000" +
+                        std::string(62, '0') + "01";
+    const auto input = qrvmc::from_hex(header).value();
+    const auto r = execute_precompile(0x0005, input, std::numeric_limits<int64_t>::max());
+    EXPECT_EQ(r.status_code, QRVMC_SUCCESS);
+    EXPECT_EQ(qrvmc::hex({r.output_data, r.output_size}), "00");
+
+    // The modulus 0x01?? cut by the input end is 0x0100: 3^2 mod 256 = 9.
+    const auto r_cut = execute_precompile(
+        0x0005,
+        qrvmc::from_hex(std::string(62, '0') + "01" + std::string(62, '0') + "01" +
+                        std::string(62, '0') + "02" + "030201")
+            .value(),
+        200);
+    EXPECT_EQ(r_cut.status_code, QRVMC_SUCCESS);
+    EXPECT_EQ(qrvmc::hex({r_cut.output_data, r_cut.output_size}), "0009");
+}
+
+TEST(example_precompiles_vm, expmod_same_as_naive)
+{
+    // The moduli of all the fixed widths and around, odd, even and the powers of two.
+    uint64_t seed = 1;
+    const auto next_byte = [&seed] {
+        seed = seed * 6364136223846793005 + 1442695040888963407;
+        return static_cast<uint8_t>(seed >> 56);
+    };
+
+    for (const size_t mod_size :
+         std::initializer_list<size_t>{1, 8, 20, 32, 40, 64, 65, 128, 200, 256, 257, 512})
+    {
+        for (int kind = 0; kind < 4; ++kind)
+        {
+            qrvmc::bytes mod(mod_size, 0);
+            for (auto& b : mod)
+                b = next_byte();
+            mod[0] |= 0x80;
+            if (kind == 0)
+                mod.back() |= 1;
+            else if (kind == 1)
+                mod.back() &= 0xfe;
+            else if (kind == 2)
+                std::fill(mod.end() - static_cast<ptrdiff_t>((mod_size + 1) / 2), mod.end(), 0);
+            else
+                std::fill(mod.begin() + 1, mod.end(), 0);
+
+            qrvmc::bytes base(mod_size + 3, 0);
+            for (auto& b : base)
+                b = next_byte();
+            qrvmc::bytes exp(static_cast<size_t>(kind + 3), 0);
+            for (auto& b : exp)
+                b = next_byte();
+
+            SCOPED_TRACE(std::to_string(mod_size) + " " + std::to_string(kind));
+            qrvmc::bytes expected(mod_size, 0);
+            precompiles::expmod_naive(expected.data(), {base.data(), base.size(), base.size()},
+                                      {exp.data(), exp.size(), exp.size()},
+                                      {mod.data(), mod.size(), mod.size()});
+            qrvmc::bytes output(mod_size, 0);
+            precompiles::expmod(output.data(), {base.data(), base.size(), base.size()},
+                                {exp.data(), exp.size(), exp.size()},
+                                {mod.data(), mod.size(), mod.size()});
+            EXPECT_EQ(qrvmc::hex(output), qrvmc::hex(expected));
+        }
+    }
+}
+
+namespace
+{
+// The BN254 test points generated with py_ecc: G1 and G2 are the generators,
+// P = [0x1d2e3f] G1, Q = [0xabcdef] G2, N = -[0xabcdef] G1.
+const auto bn_g1 = std::string(63, '0') + "1" + std::string(63, '0') + "2";
+const auto bn_p = std::string(
+    "26767b7ea97bf686a4fadd5707fd8a8e5339916f43f1643f54d227adf65b2059"
+    "1e149db70fdee9ccc6ccfd9b69949a4657ab376c3371fcaeabf0ae61b87d5314");
+const auto bn_n = std::string(
+    "1514c6de453417383224c28310c6f3a5f4c6670cab9461422c40a7dd2cfc6005"
+    "03ea221a7a6ee65b855ee42782fdd477ecd6f4d430dce2129f535c7656b3b28d");
+const auto bn_g2 = std::string(
+    "198e9393920d483a7260bfb731fb5d25f1aa493335a9e71297e485b7aef312c2"
+    "1800deef121f1e76426a00665e5c4479674322d4f75edadd46debd5cd992f6ed"
+    "090689d0585ff075ec9e99ad690c3395bc4b313370b38ef355acdadcd122975b"
+    "12c85ea5db8c6deb4aab71808dcb408fe3d1e7690c43d37b4ce6cc0166fa7daa");
+const auto bn_q = std::string(
+    "15a5a5fbf580dcff3d820c136c4e715f3e5ddc7948183c01f1a0a27ae88389e0"
+    "0b769c62c073917fbc9aba22cf7d4ed20cec1bad91207fbd999971007c37751f"
+    "03711bed6b6659af39ab8a9b080095527b76004dfc3001715539da026de06eb5"
+    "0eacec7e2a38e0fdd59fe35de95fcadfac81ead6f41b604ce4c9526c8ec2015d");
+const auto bn_p_modulus =
+    std::string("30644e72e131a029b85045b68181585d97816a916871ca8d3c208c16d87cfd47");
+}  // namespace
+
+TEST(example_precompiles_vm, bnadd)
+{
+    const auto r = execute_precompile(0x0006, qrvmc::from_hex(bn_g1 + bn_p).value(), 200);
+    EXPECT_EQ(r.status_code, QRVMC_SUCCESS);
+    EXPECT_EQ(r.gas_left, 50);
+    EXPECT_EQ(qrvmc::hex({r.output_data, r.output_size}),
+              "2ecff2bb5e36a20d7218a14c127a5caa5c6e1e1e918b77d23f3c2d351a158ae6"
+              "0b67bac3f9d107de279f07ea503f34d3ad67d51c234b6345ca1e2fa68c43c69e");
+
+    // The doubling and the point at infinity, the missing input bytes are zero.
+    const auto r_dbl = execute_precompile(0x0006, qrvmc::from_hex(bn_p + bn_p).value(), 150);
+    EXPECT_EQ(qrvmc::hex({r_dbl.output_data, r_dbl.output_size}),
+              "16c6887603d3d15aacd5407d6fd13a112ae70698dde5ce162b7cede80418a86d"
+              "0a93e9f6cdc2155274101de715558a008a764277dbd23c0e8cb5ca31e6e22d0f");
+    const auto r_inf = execute_precompile(0x0006, qrvmc::from_hex(bn_p).value(), 150);
+    EXPECT_EQ(qrvmc::hex({r_inf.output_data, r_inf.output_size}), bn_p);
+    const auto r_empty = execute_precompile(0x0006, {}, 150);
+    EXPECT_EQ(r_empty.status_code, QRVMC_SUCCESS);
+    EXPECT_EQ(qrvmc::hex({r_empty.output_data, r_empty.output_size}), std::string(128, '0'));
+
+    EXPECT_EQ(execute_precompile(0x0006, {}, 149).status_code, QRVMC_OUT_OF_GAS);
+}
+
+TEST(example_precompiles_vm, bnadd_invalid_point)
+{
+    // The point (1, 3) is not on the curve.
+    const auto not_on_curve = std::string(63, '0') + "1" + std::string(63, '0') + "3";
+    const auto r = execute_precompile(0x0006, qrvmc::from_hex(bn_g1 + not_on_curve).value(), 200);
+    EXPECT_EQ(r.status_code, QRVMC_PRECOMPILE_FAILURE);
+    EXPECT_EQ(r.gas_left, 0);
+
+    // The coordinate is not less than p even if equal to the valid one mod p.
+    const auto not_in_field = std::string(63, '0') + "1" + bn_p_modulus;
+    EXPECT_EQ(execute_precompile(0x0006, qrvmc::from_hex(not_in_field).value(), 200).status_code,
+              QRVMC_PRECOMPILE_FAILURE);
+}
+
+TEST(example_precompiles_vm, bnmul)
+{
+    // The scalar close to the group order r.
+    const auto k = "30644e72e131a029b85045b68181585d2833e84879b9709143e1f581bba98771";
+    const auto r = execute_precompile(0x0007, qrvmc::from_hex(bn_p + k).value(), 6000);
+    EXPECT_EQ(r.status_code, QRVMC_SUCCESS);
+    EXPECT_EQ(r.gas_left, 0);
+    EXPECT_EQ(qrvmc::hex({r.output_data, r.output_size}),
+              "26f320cf9a49c24d2640857d42299cc1fbcfd5369fc4e861cc82685382961206"
+              "1efdd6f6a5c17327302ffb11e7b0b8bbdb2ceb7de40d2d3ce5e49ee2a12fdebf");
+
+    // The scalar r + 2 is reduced to 2.
+    const auto r_plus_2 = "30644e72e131a029b85045b68181585d2833e84879b9709143e1f593f0000003";
+    const auto r2 = execute_precompile(0x0007, qrvmc::from_hex(bn_p + r_plus_2).value(), 6000);
+    EXPECT_EQ(qrvmc::hex({r2.output_data, r2.output_size}),
+              "16c6887603d3d15aacd5407d6fd13a112ae70698dde5ce162b7cede80418a86d"
+              "0a93e9f6cdc2155274101de715558a008a764277dbd23c0e8cb5ca31e6e22d0f");
+
+    // The missing scalar is zero.
+    const auto r0 = execute_precompile(0x0007, qrvmc::from_hex(bn_p).value(), 6000);
+    EXPECT_EQ(r0.status_code, QRVMC_SUCCESS);
+    EXPECT_EQ(qrvmc::hex({r0.output_data, r0.output_size}), std::string(128, '0'));
+
+    const auto not_on_curve = std::string(63, '0') + "1" + std::string(63, '0') + "3";
+    const auto r_invalid =
+        execute_precompile(0x0007, qrvmc::from_hex(not_on_curve + k).value(), 6000);
+    EXPECT_EQ(r_invalid.status_code, QRVMC_PRECOMPILE_FAILURE);
+    EXPECT_EQ(r_invalid.gas_left, 0);
+
+    EXPECT_EQ(execute_precompile(0x0007, {}, 5999).status_code, QRVMC_OUT_OF_GAS);
+}
+
+TEST(example_precompiles_vm, bnpairing)
+{
+    const auto true_output = std::string(63, '0') + "1";
+    const auto false_output = std::string(64, '0');
+
+    // e(N, G2) e(G1, Q) = 1.
+    const auto input = qrvmc::from_hex(bn_n + bn_g2 + bn_g1 + bn_q).value();
+    const auto r = execute_precompile(0x0008, input, 113000);
+    EXPECT_EQ(r.status_code, QRVMC_SUCCESS);
+    EXPECT_EQ(r.gas_left, 0);
+    EXPECT_EQ(qrvmc::hex({r.output_data, r.output_size}), true_output);
+    EXPECT_EQ(execute_precompile(0x0008, input, 112999).status_code, QRVMC_OUT_OF_GAS);
+
+    // e(P, G2) != 1 alone, the pairs with the point at infinity are skipped.
+    const auto r1 = execute_precompile(0x0008, qrvmc::from_hex(bn_p + bn_g2).value(), 100000);
+    EXPECT_EQ(qrvmc::hex({r1.output_data, r1.output_size}), false_output);
+    const auto g1_infinity = std::string(128, '0');
+    const auto g2_infinity = std::string(256, '0');
+    const auto input_inf =
+        qrvmc::from_hex(bn_n + bn_g2 + g1_infinity + bn_q + bn_g1 + bn_q + bn_p + g2_infinity);
+    const auto r_inf = execute_precompile(0x0008, input_inf.value(), 200000);
+    EXPECT_EQ(qrvmc::hex({r_inf.output_data, r_inf.output_size}), true_output);
+
+    // The empty input.
+    const auto r_empty = execute_precompile(0x0008, {}, 45000);
+    EXPECT_EQ(r_empty.status_code, QRVMC_SUCCESS);
+    EXPECT_EQ(r_empty.gas_left, 0);
+    EXPECT_EQ(qrvmc::hex({r_empty.output_data, r_empty.output_size}), true_output);
+}
+
+TEST(example_precompiles_vm, bnpairing_invalid_input)
+{
+    const auto check = [](const std::string& hex_input) {
+        const auto r = execute_precompile(0x0008, qrvmc::from_hex(hex_input).value(), 1000000);
+        EXPECT_EQ(r.status_code, QRVMC_PRECOMPILE_FAILURE);
+        EXPECT_EQ(r.gas_left, 0);
+    };
+
+    // Not the multiple of 192 bytes.
+    check(bn_g1 + bn_g2 + "00");
+
+    // The G1 point not on the curve.
+    check(std::string(63, '0') + "1" + std::string(63, '0') + "3" + bn_g2);
+
+    // The G2 coordinate not less than p.
+    check(bn_g1 + bn_p_modulus + bn_g2.substr(64));
+
+    // The G2 point not on the twist.
+    auto not_on_twist = bn_g2;
+    not_on_twist.back() = 'b';
+    check(bn_g1 + not_on_twist);
+
+    // The point on the twist but not in the G2 subgroup.
+    check(bn_g1 +
+          "280bf6a8ad864c44e049548e8a0a8c9632ea6928f6236bf2504b74ba4a0fe75d"
+          "0aa7ae83df561d802a759159fb7ff337f5cae3bf3729c619c60a3cab359eeefb"
+          "0220570d0e2a6bc010d1c8a3681d067e774e78ec36c1f99b59c78dee462bf875"
+          "27612e8cf180450a0a8ccff8a25f9f6b6a54be4e7e0d4874aa1092230d7420b2");
+}
+
+TEST(example_precompiles_vm, register_precompile)
+{
+    // The precompile returning the input size with the gas cost of 100.
+    const auto gas = [](const uint8_t*, size_t) -> uint64_t { return 100; };
+    const auto execute = [](const uint8_t*, size_t input_size) {
+        qrvmc_result result{};
+        result.status_code = QRVMC_SUCCESS;
+        result.output_size = input_size;
+        return result;
+    };
+
+    auto vm = qrvmc::VM{qrvmc_create_example_precompiles_vm()};
+    qrvmc_example_precompiles_vm_register(vm.get_raw_pointer(), 0x0100, gas, execute);
+    qrvmc_example_precompiles_vm_register(vm.get_raw_pointer(), 0x0004, gas, execute);
+
+    const uint8_t input[5]{};
+    qrvmc_message msg{};
+    msg.input_data = input;
+    msg.input_size = sizeof(input);
+    msg.gas = 150;
+    for (const auto id : {0x0100, 0x0004})
+    {
+        msg.code_address.bytes[18] = static_cast<uint8_t>(id >> 8);
+        msg.code_address.bytes[19] = static_cast<uint8_t>(id);
+        const auto r = vm.execute(QRVMC_MAX_REVISION, msg, nullptr, 0);
+        EXPECT_EQ(r.status_code, QRVMC_SUCCESS);
+        EXPECT_EQ(r.gas_left, 50);
+        EXPECT_EQ(r.output_size, sizeof(input));
+    }
+
+    // The neighbouring ids on the same page stay empty.
+    msg.code_address.bytes[18] = 0x01;
+    msg.code_address.bytes[19] = 0x01;
+    const auto r_empty = vm.execute(QRVMC_MAX_REVISION, msg, nullptr, 0);
+    EXPECT_EQ(r_empty.status_code, QRVMC_SUCCESS);
+    EXPECT_EQ(r_empty.gas_left, 150);
+    EXPECT_EQ(r_empty.output_size, 0u);
+
+    // The registration is per VM instance.
+    const auto r_identity = execute_precompile(0x0004, {input, sizeof(input)}, 150);
+    EXPECT_EQ(r_identity.gas_left, 150 - 18);
+    EXPECT_EQ(r_identity.output_size, sizeof(input));
+
+    // The execution failure consumes all the gas.
+    const auto fail = [](const uint8_t*, size_t) {
+        qrvmc_result result{};
+        result.status_code = QRVMC_PRECOMPILE_FAILURE;
+        result.gas_left = 1;
+        return result;
+    };
+    qrvmc_example_precompiles_vm_register(vm.get_raw_pointer(), 0x0004, gas, fail);
+    msg.code_address.bytes[18] = 0x00;
+    msg.code_address.bytes[19] = 0x04;
+    const auto r_fail = vm.execute(QRVMC_MAX_REVISION, msg, nullptr, 0);
+    EXPECT_EQ(r_fail.status_code, QRVMC_PRECOMPILE_FAILURE);
+    EXPECT_EQ(r_fail.gas_left, 0);
+
+    // The gas cost is checked before the execution.
+    msg.gas = 99;
+    const auto r_oog = vm.execute(QRVMC_MAX_REVISION, msg, nullptr, 0);
+    EXPECT_EQ(r_oog.status_code, QRVMC_OUT_OF_GAS);
+    EXPECT_EQ(r_oog.gas_left, 0);
+}
+
+TEST(example_precompiles_vm, set_option_precompile)
+{
+    auto vm = qrvmc::VM{qrvmc_create_example_precompiles_vm()};
+    EXPECT_EQ(vm.set_option("precompile.0x0005", "expmod_naive"), QRVMC_SET_OPTION_SUCCESS);
+    EXPECT_EQ(vm.set_option("precompile.300", "sha256"), QRVMC_SET_OPTION_SUCCESS);
+    EXPECT_EQ(vm.set_option("precompile.2", "empty"), QRVMC_SET_OPTION_SUCCESS);
+
+    EXPECT_EQ(vm.set_option("precompile", "sha256"), QRVMC_SET_OPTION_INVALID_NAME);
+    EXPECT_EQ(vm.set_option("precompile.", "sha256"), QRVMC_SET_OPTION_INVALID_NAME);
+    EXPECT_EQ(vm.set_option("precompile.0x10000", "sha256"), QRVMC_SET_OPTION_INVALID_NAME);
+    EXPECT_EQ(vm.set_option("precompile.5x", "sha256"), QRVMC_SET_OPTION_INVALID_NAME);
+    EXPECT_EQ(vm.set_option("verbose", "1"), QRVMC_SET_OPTION_INVALID_NAME);
+    EXPECT_EQ(vm.set_option("precompile.5", "sha512"), QRVMC_SET_OPTION_INVALID_VALUE);
+    EXPECT_EQ(vm.set_option("precompile.5", nullptr), QRVMC_SET_OPTION_INVALID_VALUE);
+
+    const auto call = [&vm](uint16_t id, const qrvmc::bytes_view input) {
+        qrvmc_message msg{};
+        msg.code_address.bytes[18] = static_cast<uint8_t>(id >> 8);
+        msg.code_address.bytes[19] = static_cast<uint8_t>(id);
+        msg.input_data = input.data();
+        msg.input_size = input.size();
+        msg.gas = 1000000;
+        return vm.execute(QRVMC_MAX_REVISION, msg, nullptr, 0);
+    };
+
+    // 3^5 mod 7 = 5 with the naive implementation.
+    const auto input = qrvmc::from_hex(
+                           "0000000000000000000000000000000000000000000000000000000000000001"
+                           "0000000000000000000000000000000000000000000000000000000000000001"
+                           "0000000000000000000000000000000000000000000000000000000000000001"
+                           "030507")
+                           .value();
+    const auto r_expmod = call(0x0005, input);
+    EXPECT_EQ(r_expmod.status_code, QRVMC_SUCCESS);
+    EXPECT_EQ(qrvmc::hex({r_expmod.output_data, r_expmod.output_size}), "05");
+
+    // SHA256 at 300 (0x012c) and the empty one at its former id.
+    const auto r_sha256 = call(300, to_bytes("abc"));
+    EXPECT_EQ(qrvmc::hex({r_sha256.output_data, r_sha256.output_size}),
+              "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+    const auto r_empty = call(0x0002, to_bytes("abc"));
+    EXPECT_EQ(r_empty.status_code, QRVMC_SUCCESS);
+    EXPECT_EQ(r_empty.gas_left, 1000000);
+    EXPECT_EQ(r_empty.output_size, 0u);
+}
+
+TEST(example_precompiles_vm, result_cache)
+{
+    auto vm = qrvmc::VM{qrvmc_create_example_precompiles_vm()};
+    const auto stats = [&vm] {
+        return qrvmc_example_precompiles_vm_cache_stats(vm.get_raw_pointer());
+    };
+    const auto call = [&vm](uint16_t id, const qrvmc::bytes_view input, int64_t gas) {
+        qrvmc_message msg{};
+        msg.code_address.bytes[18] = static_cast<uint8_t>(id >> 8);
+        msg.code_address.bytes[19] = static_cast<uint8_t>(id);
+        msg.input_data = input.data();
+        msg.input_size = input.size();
+        msg.gas = gas;
+        return vm.execute(QRVMC_MAX_REVISION, msg, nullptr, 0);
+    };
+    const auto abc_hash = "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad";
+
+    // Disabled by default.
+    call(0x0002, to_bytes("abc"), 1000);
+    EXPECT_EQ(stats().misses, 0u);
+
+    ASSERT_EQ(vm.set_option("cache.size", "1048576"), QRVMC_SET_OPTION_SUCCESS);
+    const auto r1 = call(0x0002, to_bytes("abc"), 1000);
+    const auto r2 = call(0x0002, to_bytes("abc"), 2000);
+    const auto r3 = call(0x0002, to_bytes("abc"), 3000);
+    EXPECT_EQ(stats().misses, 1u);
+    EXPECT_EQ(stats().hits, 2u);
+    EXPECT_EQ(stats().insertions, 1u);
+    EXPECT_EQ(stats().entries, 1u);
+    EXPECT_EQ(r2.status_code, QRVMC_SUCCESS);
+    EXPECT_EQ(r1.gas_left, 1000 - 72);
+    EXPECT_EQ(r2.gas_left, 2000 - 72);
+    EXPECT_EQ(qrvmc::hex({r1.output_data, r1.output_size}), abc_hash);
+    EXPECT_EQ(qrvmc::hex({r2.output_data, r2.output_size}), abc_hash);
+    // The hits reference the cached output.
+    EXPECT_EQ(r2.output_data, r3.output_data);
+
+    // The gas is charged before the lookup.
+    EXPECT_EQ(call(0x0002, to_bytes("abc"), 71).status_code, QRVMC_OUT_OF_GAS);
+    EXPECT_EQ(stats().hits, 2u);
+
+    // Different inputs and ids.
+    call(0x0002, to_bytes("abd"), 1000);
+    call(0x0002, to_bytes(std::string_view{"abc\0", 4}), 1000);
+    EXPECT_EQ(stats().misses, 3u);
+    EXPECT_EQ(stats().entries, 3u);
+
+    // The failures are cached, the identity is not.
+    const auto invalid_point = qrvmc::bytes(128, 0xff);
+    for (int i = 0; i < 2; ++i)
+    {
+        const auto r = call(0x0006, invalid_point, 1000);
+        EXPECT_EQ(r.status_code, QRVMC_PRECOMPILE_FAILURE);
+        EXPECT_EQ(r.gas_left, 0);
+    }
+    call(0x0004, to_bytes("abc"), 1000);
+    EXPECT_EQ(stats().hits, 3u);
+    EXPECT_EQ(stats().misses, 4u);
+
+    // The served results outlive the cache.
+    ASSERT_EQ(vm.set_option("cache.size", "1048576"), QRVMC_SET_OPTION_SUCCESS);
+    EXPECT_EQ(stats().entries, 0u);
+    EXPECT_EQ(stats().hits, 0u);
+    EXPECT_EQ(qrvmc::hex({r3.output_data, r3.output_size}), abc_hash);
+
+    // The registration clears the cache.
+    call(0x0002, to_bytes("abc"), 1000);
+    EXPECT_EQ(stats().entries, 1u);
+    ASSERT_EQ(vm.set_option("precompile.0x0002", "identity"), QRVMC_SET_OPTION_SUCCESS);
+    EXPECT_EQ(stats().entries, 0u);
+    EXPECT_EQ(call(0x0002, to_bytes("abc"), 1000).output_size, 3u);
+
+    ASSERT_EQ(vm.set_option("cache.size", "0"), QRVMC_SET_OPTION_SUCCESS);
+    EXPECT_EQ(stats().insertions, 0u);
+
+    EXPECT_EQ(vm.set_option("cache.size", nullptr), QRVMC_SET_OPTION_INVALID_VALUE);
+    EXPECT_EQ(vm.set_option("cache.size", ""), QRVMC_SET_OPTION_INVALID_VALUE);
+    EXPECT_EQ(vm.set_option("cache.size", "-1"), QRVMC_SET_OPTION_INVALID_VALUE);
+    EXPECT_EQ(vm.set_option("cache.size", "1k"), QRVMC_SET_OPTION_INVALID_VALUE);
+    EXPECT_EQ(vm.set_option("cache.size", "99999999999999999999"), QRVMC_SET_OPTION_INVALID_VALUE);
+}
+
+TEST(example_precompiles_vm, result_cache_eviction)
+{
+    auto vm = qrvmc::VM{qrvmc_create_example_precompiles_vm()};
+    ASSERT_EQ(vm.set_option("cache.size", "16384"), QRVMC_SET_OPTION_SUCCESS);
+
+    qrvmc_message msg{};
+    msg.code_address.bytes[19] = 0x02;
+    msg.gas = 1000;
+    const auto hash_of = [&](uint32_t i) {
+        uint8_t input[4];
+        store32be(input, i);
+        msg.input_data = input;
+        msg.input_size = sizeof(input);
+        const auto r = vm.execute(QRVMC_MAX_REVISION, msg, nullptr, 0);
+        return qrvmc::hex({r.output_data, r.output_size});
+    };
+
+    // The repeatedly used input stays cached while the others are evicted.
+    const auto hot = hash_of(0);
+    for (uint32_t i = 1; i <= 1000; ++i)
+    {
+        EXPECT_EQ(hash_of(0), hot);
+        hash_of(i);
+    }
+    const auto stats = qrvmc_example_precompiles_vm_cache_stats(vm.get_raw_pointer());
+    EXPECT_EQ(stats.hits, 1000u);
+    EXPECT_EQ(stats.misses, 1001u);
+    EXPECT_EQ(stats.insertions, 1001u);
+    EXPECT_EQ(stats.evictions, stats.insertions - stats.entries);
+    EXPECT_GT(stats.evictions, 0u);
+    EXPECT_LE(stats.bytes, 16384u);
+}
+
+TEST(example_precompiles_vm, result_cache_concurrent)
+{
+    auto vm = qrvmc::VM{qrvmc_create_example_precompiles_vm()};
+    ASSERT_EQ(vm.set_option("cache.size", "1048576"), QRVMC_SET_OPTION_SUCCESS);
+
+    constexpr uint32_t num_inputs = 64;
+    std::string expected[num_inputs];
+    for (uint32_t i = 0; i < num_inputs; ++i)
+    {
+        uint8_t input[4];
+        store32be(input, i);
+        uint8_t hash[32];
+        precompiles::sha256(hash, input, sizeof(input));
+        expected[i] = qrvmc::hex({hash, sizeof(hash)});
+    }
+
+    constexpr int num_threads = 4;
+    constexpr uint32_t num_calls = 2000;
+    std::vector<std::thread> threads;
+    std::atomic<int> num_errors{0};
+    for (int t = 0; t < num_threads; ++t)
+    {
+        threads.emplace_back([&, t] {
+            for (uint32_t i = 0; i < num_calls; ++i)
+            {
+                const auto k = (i * 7 + static_cast<uint32_t>(t)) % num_inputs;
+                uint8_t input[4];
+                store32be(input, k);
+                qrvmc_message msg{};
+                msg.code_address.bytes[19] = 0x02;
+                msg.input_data = input;
+                msg.input_size = sizeof(input);
+                msg.gas = 1000;
+                const auto r = vm.execute(QRVMC_MAX_REVISION, msg, nullptr, 0);
+                if (qrvmc::hex({r.output_data, r.output_size}) != expected[k])
+                    ++num_errors;
+            }
+        });
+    }
+    for (auto& t : threads)
+        t.join();
+
+    EXPECT_EQ(num_errors, 0);
+    const auto stats = qrvmc_example_precompiles_vm_cache_stats(vm.get_raw_pointer());
+    EXPECT_EQ(stats.hits + stats.misses, num_threads * num_calls);
+    EXPECT_EQ(stats.entries, num_inputs);
+}
+
+TEST(example_precompiles_vm, identity_output_aliasing)
+{
+    auto vm = qrvmc::VM{qrvmc_create_example_precompiles_vm()};
+    const auto input = qrvmc::bytes(100, 0xab);
+    qrvmc_message msg{};
+    msg.code_address.bytes[19] = 0x04;
+    msg.input_data = input.data();
+    msg.input_size = input.size();
+    msg.gas = 100;
+
+    // The output is a copy by default.
+    const auto r_copy = vm.execute(QRVMC_MAX_REVISION, msg, nullptr, 0);
+    EXPECT_EQ(r_copy.status_code, QRVMC_SUCCESS);
+    EXPECT_EQ(r_copy.gas_left, 100 - 27);
+    EXPECT_NE(r_copy.output_data, input.data());
+    EXPECT_EQ(qrvmc::bytes_view(r_copy.output_data, r_copy.output_size), input);
+
+    // The output is the input if the caller allows aliasing.
+    msg.flags = QRVMC_ALLOW_OUTPUT_ALIASING;
+    const auto r_alias = vm.execute(QRVMC_MAX_REVISION, msg, nullptr, 0);
+    EXPECT_EQ(r_alias.status_code, QRVMC_SUCCESS);
+    EXPECT_EQ(r_alias.gas_left, 100 - 27);
+    EXPECT_EQ(r_alias.output_data, input.data());
+    EXPECT_EQ(r_alias.output_size, input.size());
+
+    // The empty input.
+    msg.input_data = nullptr;
+    msg.input_size = 0;
+    const auto r_empty = vm.execute(QRVMC_MAX_REVISION, msg, nullptr, 0);
+    EXPECT_EQ(r_empty.status_code, QRVMC_SUCCESS);
+    EXPECT_EQ(r_empty.output_size, 0u);
+}
+
+TEST(example_precompiles_vm, registered_output_aliasing)
+{
+    // The precompile returning the input without the first byte.
+    const auto gas = [](const uint8_t*, size_t) -> uint64_t { return 0; };
+    const auto execute = [](const uint8_t* input, size_t input_size) {
+        qrvmc_result result{};
+        result.status_code = QRVMC_SUCCESS;
+        result.output_data = input + 1;
+        result.output_size = input_size - 1;
+        return result;
+    };
+
+    auto vm = qrvmc::VM{qrvmc_create_example_precompiles_vm()};
+    qrvmc_example_precompiles_vm_register(vm.get_raw_pointer(), 0x0100, gas, execute);
+
+    const auto input = qrvmc::from_hex("000102030405").value();
+    qrvmc_message msg{};
+    msg.code_address.bytes[18] = 0x01;
+    msg.input_data = input.data();
+    msg.input_size = input.size();
+
+    const auto r_copy = vm.execute(QRVMC_MAX_REVISION, msg, nullptr, 0);
+    EXPECT_NE(r_copy.output_data, &input[1]);
+    EXPECT_EQ(qrvmc::hex({r_copy.output_data, r_copy.output_size}), "0102030405");
+
+    msg.flags = QRVMC_STATIC | QRVMC_ALLOW_OUTPUT_ALIASING;
+    const auto r_alias = vm.execute(QRVMC_MAX_REVISION, msg, nullptr, 0);
+    EXPECT_EQ(r_alias.output_data, &input[1]);
+    EXPECT_EQ(r_alias.output_size, 5u);
+}
@@ -8,6 +8,7 @@
 #include <qrvmc/qrvmc.hpp>
 #include <gtest/gtest.h>
 #include <cstring>
+#include <string>
 
 using namespace qrvmc::literals;
 
@@ -67,12 +68,28 @@ TEST_F(example_vm, empty_code)
     EXPECT_EQ(r.output_size, size_t{0});
 }
 
+TEST_F(example_vm, memory_cleared_between_executions)
+{
+    // Yul: mstore(0, 0xff) return(0, 32)
+    const auto r1 = execute_in_example_vm(10, "60ff60005260206000f3");
+    EXPECT_EQ(r1, Output("00000000000000000000000000000000000000000000000000000000000000ff"));
+
+    // Yul: return(0, 32)
+    const auto r2 = execute_in_example_vm(10, "60206000f3");
+    EXPECT_EQ(r2.status_code, QRVMC_SUCCESS);
+    EXPECT_EQ(r2, Output("0000000000000000000000000000000000000000000000000000000000000000"));
+
+    // Yul: return(0, msize())
+    const auto r3 = execute_in_example_vm(10, "596000f3");
+    EXPECT_EQ(r3.output_size, size_t{0});
+}
+
 TEST_F(example_vm, push)
 {
     // Yul:
     // mstore(0, 0xd0d1d2d3d4d5d6d7d8d9dadbdcdddedfe0e1e2e3e4e5e6e7e8e9eaebecedeeef) return(0, 32)
     const auto r = execute_in_example_vm(
-        10, "7fd0d1d2d3d4d5d6d7d8d9dadbdcdddedfe0e1e2e3e4e5e6e7e8e9eaebecedeeef60005260206000f3");
+        13, "7fd0d1d2d3d4d5d6d7d8d9dadbdcdddedfe0e1e2e3e4e5e6e7e8e9eaebecedeeef60005260206000f3");
     EXPECT_EQ(r.status_code, QRVMC_SUCCESS);
     EXPECT_EQ(r.gas_left, 4);
     EXPECT_EQ(r, Output("d0d1d2d3d4d5d6d7d8d9dadbdcdddedfe0e1e2e3e4e5e6e7e8e9eaebecedeeef"));
@@ -81,7 +98,7 @@ TEST_F(example_vm, push)
 TEST_F(example_vm, return_address)
 {
     // Yul: mstore(0, address()) return(12, 20)
-    const auto r = execute_in_example_vm(6, "306000526014600cf3");
+    const auto r = execute_in_example_vm(9, "306000526014600cf3");
     EXPECT_EQ(r.status_code, QRVMC_SUCCESS);
     EXPECT_EQ(r.gas_left, 0);
     EXPECT_EQ(r, Output("d00000000000000000000000000000000000000d"));
@@ -104,26 +121,36 @@ TEST_F(example_vm, return_block_number)
 {
     // Yul: mstore(0, number()) return(0, msize())
     host.tx_context.block_number = 0xb4;
-    const auto r = execute_in_example_vm(7, "43600052596000f3");
+    const auto r = execute_in_example_vm(10, "43600052596000f3");
     EXPECT_EQ(r.status_code, QRVMC_SUCCESS);
     EXPECT_EQ(r.gas_left, 1);
     EXPECT_EQ(r, Output("00000000000000000000000000000000000000000000000000000000000000b4"));
 }
 
+TEST_F(example_vm, return_block_number_tx_context_ptr)
+{
+    // Yul: mstore(0, number()) mstore(0, add(mload(0), number())) return(0, 32)
+    host.tx_context.block_number = 0xb4;
+    msg.flags = QRVMC_HOST_TX_CONTEXT_PTR;
+    const auto r = execute_in_example_vm(100, "43600052436000510160005260206000f3");
+    EXPECT_EQ(r.status_code, QRVMC_SUCCESS);
+    EXPECT_EQ(r, Output("0000000000000000000000000000000000000000000000000000000000000168"));
+}
+
 TEST_F(example_vm, return_out_of_memory)
 {
-    // Yul: return(1024, 1)
-    const auto r = execute_in_example_vm(10, "6001610400f3");
-    EXPECT_EQ(r.status_code, QRVMC_FAILURE);
+    // Yul: return(0x2000000, 1)
+    const auto r = execute_in_example_vm(10, "60016302000000f3");
+    EXPECT_EQ(r.status_code, QRVMC_OUT_OF_GAS);
     EXPECT_EQ(r.gas_left, 0);
     EXPECT_EQ(r, Output(""));
 }
 
 TEST_F(example_vm, revert_out_of_memory)
 {
-    // Yul: revert(512, 513)
-    const auto r = execute_in_example_vm(10, "610201610200fd");
-    EXPECT_EQ(r.status_code, QRVMC_FAILURE);
+    // Yul: revert(0x1ffffff, 2)
+    const auto r = execute_in_example_vm(10, "60026301fffffffd");
+    EXPECT_EQ(r.status_code, QRVMC_OUT_OF_GAS);
     EXPECT_EQ(r.gas_left, 0);
     EXPECT_EQ(r, Output(""));
 }
@@ -132,12 +159,23 @@ TEST_F(example_vm, revert_block_number)
 {
     // Yul: mstore(0, number()) revert(0, 32)
     host.tx_context.block_number = 0xb4;
-    const auto r = execute_in_example_vm(7, "4360005260206000fd");
+    const auto r = execute_in_example_vm(10, "4360005260206000fd");
     EXPECT_EQ(r.status_code, QRVMC_REVERT);
     EXPECT_EQ(r.gas_left, 1);
     EXPECT_EQ(r, Output("00000000000000000000000000000000000000000000000000000000000000b4"));
 }
 
+TEST_F(example_vm, return_block_hash)
+{
+    // Yul: mstore(0, blockhash(0x0101)) return(0, 32)
+    host.block_hashes.set(0x0101, 0xb10c_bytes32);
+    const auto r = execute_in_example_vm(13, "6101014060005260206000f3");
+    EXPECT_EQ(r.status_code, QRVMC_SUCCESS);
+    EXPECT_EQ(r.gas_left, 3);
+    EXPECT_EQ(r, Output("000000000000000000000000000000000000000000000000000000000000b10c"));
+    EXPECT_EQ(host.recorded_blockhashes, std::vector<int64_t>{0x0101});
+}
+
 TEST_F(example_vm, call)
 {
     // pseudo-Yul: call(3, 3, 3, 3, 3, 3, 3) return(0, msize())
@@ -146,8 +184,8 @@ TEST_F(example_vm, call)
     host.call_result.output_size = expected_output.size();
     const auto r = execute_in_example_vm(100, "6003808080808080f1596000f3");
     EXPECT_EQ(r.status_code, QRVMC_SUCCESS);
-    EXPECT_EQ(r.gas_left, 89);
-    EXPECT_EQ(r, Output("000000aabbcc"));
+    EXPECT_EQ(r.gas_left, 86);
+    EXPECT_EQ(r, Output("000000aabbcc0000000000000000000000000000000000000000000000000000"));
     ASSERT_EQ(host.recorded_calls.size(), size_t{1});
     EXPECT_EQ(host.recorded_calls[0].flags, uint32_t{0});
     EXPECT_EQ(host.recorded_calls[0].gas, 3);
@@ -156,13 +194,78 @@ TEST_F(example_vm, call)
     EXPECT_EQ(host.recorded_calls[0].recipient,
               "Q0000000000000000000000000000000000000003"_address);
     EXPECT_EQ(host.recorded_calls[0].input_size, size_t{3});
+    EXPECT_EQ(host.recorded_calls[0].sender, qrvmc::address{msg.recipient});
+    EXPECT_EQ(host.recorded_calls[0].code_address,
+              "Q0000000000000000000000000000000000000003"_address);
+    EXPECT_EQ(host.recorded_calls[0].depth, 1);
+}
+
+TEST_F(example_vm, log)
+{
+    // Yul: mstore(0, 0xaa) log2(31, 1, 1, 2) log0(0, 0)
+    const auto code = "60aa600052600260016001601fa260006000a000";
+    const auto expected_data = qrvmc::from_hex("aa").value();
+    const qrvmc::bytes32 expected_topics[] = {qrvmc::bytes32{1}, qrvmc::bytes32{2}};
+    for (const auto flags : {uint32_t{0}, uint32_t{QRVMC_HOST_EMIT_LOGS}})
+    {
+        for (const auto fusion : {"off", "on"})
+        {
+            SCOPED_TRACE(std::to_string(flags) + " " + fusion);
+            ASSERT_EQ(vm.set_option("fusion", fusion), QRVMC_SET_OPTION_SUCCESS);
+            host.clear_recordings();
+            msg.flags = flags;
+            const auto r = execute_in_example_vm(100, code);
+            EXPECT_EQ(r.status_code, QRVMC_SUCCESS);
+            ASSERT_EQ(host.recorded_logs.size(), size_t{2});
+            EXPECT_EQ(host.recorded_logs[0].creator, qrvmc::address{msg.recipient});
+            EXPECT_EQ(host.recorded_logs[0].data, qrvmc::bytes_view{expected_data});
+            EXPECT_EQ(host.recorded_logs[0].topics, qrvmc::bytes32_view(expected_topics, 2));
+            EXPECT_TRUE(host.recorded_logs[1].data.empty());
+            EXPECT_TRUE(host.recorded_logs[1].topics.empty());
+        }
+    }
+    vm.set_option("fusion", "off");
+}
+
+TEST_F(example_vm, log_reverted)
+{
+    // Yul: log0(0, 32) revert(0, 0)
+    msg.flags = QRVMC_HOST_EMIT_LOGS;
+    const auto r = execute_in_example_vm(100, "60206000a060006000fd");
+    EXPECT_EQ(r.status_code, QRVMC_REVERT);
+    EXPECT_TRUE(host.recorded_logs.empty());
+
+    // Out of gas after the LOG.
+    EXPECT_EQ(execute_in_example_vm(3, "60206000a0").status_code, QRVMC_OUT_OF_GAS);
+    EXPECT_TRUE(host.recorded_logs.empty());
+}
+
+TEST_F(example_vm, log_before_call)
+{
+    // The logs are passed to the host before the call, what keeps the order of the logs
+    // if the call is executed by another VM. Dropping them on the revert is up to the host.
+    // pseudo-Yul: log0(0, 0) call(0, 0, 0, 0, 0, 0, 0) revert(0, 0)
+    msg.flags = QRVMC_HOST_EMIT_LOGS;
+    const auto r = execute_in_example_vm(100, "60006000a06000808080808080f160006000fd");
+    EXPECT_EQ(r.status_code, QRVMC_REVERT);
+    EXPECT_EQ(host.recorded_calls.size(), size_t{1});
+    EXPECT_EQ(host.recorded_logs.size(), size_t{1});
+}
+
+TEST_F(example_vm, log_without_batches)
+{
+    // Without the host support for the batches, the logs are passed one by one right away.
+    // pseudo-Yul: log0(0, 0) revert(0, 0)
+    const auto r = execute_in_example_vm(100, "60006000a060006000fd");
+    EXPECT_EQ(r.status_code, QRVMC_REVERT);
+    EXPECT_EQ(host.recorded_logs.size(), size_t{1});
 }
 
 TEST_F(example_vm, calldataload_full)
 {
     // Yul: mstore(0, calldataload(2)) return(0, msize())
     const auto r = execute_in_example_vm(
-        7, "600235600052596000f3",
+        10, "600235600052596000f3",
         "4444000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f");
     EXPECT_EQ(r.status_code, QRVMC_SUCCESS);
     EXPECT_EQ(r.gas_left, 0);
@@ -172,7 +275,7 @@ TEST_F(example_vm, calldataload_full)
 TEST_F(example_vm, calldataload_partial)
 {
     // Yul: mstore(0, calldataload(0)) return(0, msize())
-    const auto r = execute_in_example_vm(7, "600035600052596000f3", "aabbccdd");
+    const auto r = execute_in_example_vm(10, "600035600052596000f3", "aabbccdd");
     EXPECT_EQ(r.status_code, QRVMC_SUCCESS);
     EXPECT_EQ(r.gas_left, 0);
     EXPECT_EQ(r, Output("aabbccdd00000000000000000000000000000000000000000000000000000000"));
@@ -181,7 +284,7 @@ TEST_F(example_vm, calldataload_partial)
 TEST_F(example_vm, calldataload_empty)
 {
     // Yul: mstore(0, calldataload(4)) return(0, msize())
-    const auto r = execute_in_example_vm(7, "600435600052596000f3", "aabbccdd");
+    const auto r = execute_in_example_vm(10, "600435600052596000f3", "aabbccdd");
     EXPECT_EQ(r.status_code, QRVMC_SUCCESS);
     EXPECT_EQ(r.gas_left, 0);
     EXPECT_EQ(r, Output("0000000000000000000000000000000000000000000000000000000000000000"));
@@ -189,9 +292,306 @@ TEST_F(example_vm, calldataload_empty)
 
 TEST_F(example_vm, mstore_out_of_memory)
 {
-    // Yul: mstore(1023, 0xffff)
-    const auto r = execute_in_example_vm(9, "61ffff6103ff52");
-    EXPECT_EQ(r.status_code, QRVMC_FAILURE);
+    // Yul: mstore(0x010000000000000000, 0xffff)
+    const auto r = execute_in_example_vm(1000, "61ffff6801000000000000000052");
+    EXPECT_EQ(r.status_code, QRVMC_OUT_OF_GAS);
     EXPECT_EQ(r.gas_left, 0);
     EXPECT_EQ(r, Output(""));
 }
+
+TEST_F(example_vm, memory_expansion_cost)
+{
+    // Yul: mstore(0x3fe0, 1) return(0, 0)
+    // The memory of 512 words costs 3 * 512 + 512 * 512 / 512 = 2048.
+    const auto code = "6001613fe05260006000f3";
+    const auto r1 = execute_in_example_vm(3000, code);
+    EXPECT_EQ(r1.status_code, QRVMC_SUCCESS);
+    EXPECT_EQ(r1.gas_left, 3000 - 6 - 2048);
+
+    const auto r2 = execute_in_example_vm(6 + 2048 - 1, code);
+    EXPECT_EQ(r2.status_code, QRVMC_OUT_OF_GAS);
+    EXPECT_EQ(r2.gas_left, 0);
+}
+
+TEST_F(example_vm, mload)
+{
+    // Yul: mstore(0, 0xaa) mstore(32, mload(0)) return(32, 32)
+    const auto r = execute_in_example_vm(100, "60aa60005260005160205260206020f3");
+    EXPECT_EQ(r.status_code, QRVMC_SUCCESS);
+    EXPECT_EQ(r.gas_left, 100 - 10 - 6);
+    EXPECT_EQ(r, Output("00000000000000000000000000000000000000000000000000000000000000aa"));
+}
+
+TEST_F(example_vm, calldatacopy)
+{
+    // Yul: calldatacopy(0, 1, 36) return(0, msize())
+    const auto r = execute_in_example_vm(100, "60246001600037596000f3", "aabbccddee");
+    EXPECT_EQ(r.status_code, QRVMC_SUCCESS);
+    EXPECT_EQ(r.gas_left, 100 - 7 - 6 - 6);  // Instructions, memory expansion and copy.
+    EXPECT_EQ(r, Output("bbccddee00000000000000000000000000000000000000000000000000000000"
+                        "0000000000000000000000000000000000000000000000000000000000000000"));
+}
+
+TEST_F(example_vm, big_memory_cleared_between_executions)
+{
+    // Yul: mstore(0x20000, 0xff)
+    const auto r1 = execute_in_example_vm(100000, "60ff620200005200");
+    EXPECT_EQ(r1.status_code, QRVMC_SUCCESS);
+
+    // Yul: return(0x20000, 32)
+    const auto r2 = execute_in_example_vm(100000, "602062020000f3");
+    EXPECT_EQ(r2.status_code, QRVMC_SUCCESS);
+    EXPECT_EQ(r2, Output("0000000000000000000000000000000000000000000000000000000000000000"));
+}
+
+TEST_F(example_vm, arithmetic)
+{
+    const struct
+    {
+        const char* code;
+        const char* expected;
+    } test_cases[] = {
+        // Yul: mstore(0, mul(0xffffffffffffffffffffffffffffffff, shl(128, 1))) return(0, 32)
+        {"6fffffffffffffffffffffffffffffffff600160801b0260005260206000f3",
+         "ffffffffffffffffffffffffffffffff00000000000000000000000000000000"},
+        // Yul: mstore(0, div(sub(0, 1), 3)) return(0, 32)
+        {"600360016000030460005260206000f3",
+         "5555555555555555555555555555555555555555555555555555555555555555"},
+        // Yul: mstore(0, mod(not(0), 10)) return(0, 32)
+        {"600a6000190660005260206000f3",
+         "0000000000000000000000000000000000000000000000000000000000000005"},
+        // Yul: mstore(0, shr(1, shl(255, 1))) return(0, 32)
+        {"600160ff1b60011c60005260206000f3",
+         "4000000000000000000000000000000000000000000000000000000000000000"},
+        // Yul: mstore(0, add(lt(1, 2), add(gt(1, 2), eq(3, 3)))) return(0, 32)
+        {"600360031460026001110160026001100160005260206000f3",
+         "0000000000000000000000000000000000000000000000000000000000000002"},
+        // Yul: mstore(0, xor(or(0xf0, 0x0f), and(0x3c, 0xff))) return(0, 32)
+        {"60ff603c16600f60f0171860005260206000f3",
+         "00000000000000000000000000000000000000000000000000000000000000c3"},
+    };
+
+    for (const auto& t : test_cases)
+    {
+        SCOPED_TRACE(t.code);
+        const auto r = execute_in_example_vm(100, t.code);
+        EXPECT_EQ(r.status_code, QRVMC_SUCCESS);
+        EXPECT_EQ(r, Output(t.expected));
+    }
+}
+
+TEST_F(example_vm, loop)
+{
+    // pseudo-Yul: for { let i := 16 } i { i := sub(i, 1) } {} return(0, 32)
+    // where the return outputs the memory with the final i.
+    const auto code = "60105b600190038060025760005260206000f3";
+    for (const auto charging : {"instruction", "block"})
+    {
+        ASSERT_EQ(vm.set_option("charging", charging), QRVMC_SET_OPTION_SUCCESS);
+        for (const auto dispatch : {"switch", "cgoto"})
+        {
+            SCOPED_TRACE(std::string{charging} + " " + dispatch);
+            const auto r = vm.set_option("dispatch", dispatch);
+            if (r == QRVMC_SET_OPTION_INVALID_VALUE)
+                continue;  // The computed goto is not supported by the compiler.
+            ASSERT_EQ(r, QRVMC_SET_OPTION_SUCCESS);
+
+            const auto r1 = execute_in_example_vm(1000, code);
+            EXPECT_EQ(r1.status_code, QRVMC_SUCCESS);
+            EXPECT_EQ(r1.gas_left, 1000 - (1 + 16 * 7 + 5 + 3));  // + the memory expansion.
+            EXPECT_EQ(r1,
+                      Output("0000000000000000000000000000000000000000000000000000000000000000"));
+
+            const auto r2 = execute_in_example_vm(50, code);
+            EXPECT_EQ(r2.status_code, QRVMC_OUT_OF_GAS);
+            EXPECT_EQ(r2.gas_left, 0);
+
+            // Jump to the PUSH1 instead of the JUMPDEST.
+            EXPECT_EQ(execute_in_example_vm(100, "600056").status_code,
+                      QRVMC_BAD_JUMP_DESTINATION);
+            // Jump outside of the code.
+            EXPECT_EQ(execute_in_example_vm(100, "6001600a57").status_code,
+                      QRVMC_BAD_JUMP_DESTINATION);
+            // Not taken conditional jump.
+            EXPECT_EQ(execute_in_example_vm(100, "6000600a57").status_code, QRVMC_SUCCESS);
+        }
+    }
+    vm.set_option("charging", "instruction");
+    vm.set_option("dispatch", "cgoto");  // Restore the default, if supported.
+}
+
+TEST_F(example_vm, block_charging)
+{
+    ASSERT_EQ(vm.set_option("charging", "block"), QRVMC_SET_OPTION_SUCCESS);
+
+    // The gas of the whole block is charged up front: nothing is stored.
+    const auto r1 = execute_in_example_vm(2, "6001600155");
+    EXPECT_EQ(r1.status_code, QRVMC_OUT_OF_GAS);
+    EXPECT_TRUE(host.accounts[msg.recipient].storage.empty());
+    EXPECT_EQ(execute_in_example_vm(3, "6001600155").gas_left, 0);
+
+    // The code starting with the JUMPDEST is charged once.
+    EXPECT_EQ(execute_in_example_vm(5, "5b00").gas_left, 3);
+
+    // The stack requirements are checked at the block entry.
+    EXPECT_EQ(execute_in_example_vm(100, "6001600101").status_code, QRVMC_SUCCESS);
+    EXPECT_EQ(execute_in_example_vm(100, "600101").status_code, QRVMC_STACK_UNDERFLOW);
+    // The block after the not taken JUMPI: ADD with the empty stack.
+    EXPECT_EQ(execute_in_example_vm(100, "6000600057" "01").status_code, QRVMC_STACK_UNDERFLOW);
+    std::string pushes;
+    for (int i = 0; i < 1025; ++i)
+        pushes += "6000";
+    EXPECT_EQ(execute_in_example_vm(2000, pushes.c_str() + 4).status_code, QRVMC_SUCCESS);
+    EXPECT_EQ(execute_in_example_vm(2000, pushes.c_str()).status_code, QRVMC_STACK_OVERFLOW);
+
+    // The JUMPDEST inside the push data is rejected.
+    EXPECT_EQ(execute_in_example_vm(100, "600456605b00").status_code, QRVMC_BAD_JUMP_DESTINATION);
+
+    vm.set_option("charging", "instruction");
+}
+
+TEST_F(example_vm, block_charging_all_revisions)
+{
+    // The block charging gives the same results as the per instruction one in each revision.
+    const struct
+    {
+        int64_t gas;
+        const char* code;
+    } test_cases[] = {
+        {100, "60ff60005260206000f3"},  // mstore(0, 0xff) return(0, 32)
+        {1000, "60105b600190038060025760005260206000f3"},  // The loop.
+        {50, "60105b600190038060025760005260206000f3"},    // Out of gas in the loop.
+        {100, "6001600101"},                               // ADD.
+        {2, "6001600155"},                                 // Out of gas in SSTORE.
+    };
+
+    for (int r = QRVMC_SHANGHAI; r <= QRVMC_MAX_REVISION; ++r)
+    {
+        rev = static_cast<qrvmc_revision>(r);
+        for (const auto& t : test_cases)
+        {
+            SCOPED_TRACE(std::string{qrvmc::to_string(rev)} + " " + t.code);
+            ASSERT_EQ(vm.set_option("charging", "instruction"), QRVMC_SET_OPTION_SUCCESS);
+            const auto expected = execute_in_example_vm(t.gas, t.code);
+            ASSERT_EQ(vm.set_option("charging", "block"), QRVMC_SET_OPTION_SUCCESS);
+            const auto r_block = execute_in_example_vm(t.gas, t.code);
+
+            if (expected.status_code == QRVMC_SUCCESS)
+            {
+                EXPECT_EQ(r_block.status_code, QRVMC_SUCCESS);
+                EXPECT_EQ(r_block.gas_left, expected.gas_left);
+                EXPECT_EQ(qrvmc::hex({r_block.output_data, r_block.output_size}),
+                          qrvmc::hex({expected.output_data, expected.output_size}));
+            }
+            else
+            {
+                EXPECT_NE(r_block.status_code, QRVMC_SUCCESS);
+            }
+        }
+    }
+    vm.set_option("charging", "instruction");
+}
+
+TEST_F(example_vm, set_option_dispatch)
+{
+    EXPECT_EQ(vm.set_option("dispatch", "threaded"), QRVMC_SET_OPTION_INVALID_VALUE);
+    EXPECT_EQ(vm.set_option("dispatch", nullptr), QRVMC_SET_OPTION_INVALID_VALUE);
+    EXPECT_EQ(vm.set_option("dispatch", "switch"), QRVMC_SET_OPTION_SUCCESS);
+    vm.set_option("dispatch", "cgoto");  // Restore the default, if supported.
+}
+
+TEST_F(example_vm, set_option_charging)
+{
+    EXPECT_EQ(vm.set_option("charging", "gas"), QRVMC_SET_OPTION_INVALID_VALUE);
+    EXPECT_EQ(vm.set_option("charging", nullptr), QRVMC_SET_OPTION_INVALID_VALUE);
+    EXPECT_EQ(vm.set_option("charging", "block"), QRVMC_SET_OPTION_SUCCESS);
+    EXPECT_EQ(vm.set_option("charging", "instruction"), QRVMC_SET_OPTION_SUCCESS);
+}
+
+TEST_F(example_vm, fusion)
+{
+    // The prepared code with the superinstructions gives the same results as the bytecode.
+    const struct
+    {
+        int64_t gas;
+        const char* code;
+    } test_cases[] = {
+        // The loop: PUSH SWAP1 SUB, DUP1 PUSH JUMPI, PUSH MSTORE.
+        {1000, "60105b600190038060025760005260206000f3"},
+        {50, "60105b600190038060025760005260206000f3"},  // Out of gas in the loop.
+        // PUSH ADD, PUSH SHL, PUSH SHR, PUSH AND, PUSH OR, PUSH XOR, PUSH MSTORE, PUSH MLOAD.
+        {100, "600360050160041b60011c60ff16600f17600a18600052600051602052604060" "00f3"},
+        // DUP1 SWAP1, SWAP1 POP.
+        {100, "60016002809090500160005260206000f3"},
+        // Yul: sstore(0, add(sload(0), 1)): PUSH SLOAD, PUSH ADD.
+        {100, "600054600101600055"},
+        {3, "600054600101600055"},  // Out of gas in the middle of the PUSH ADD.
+        // PUSH32 SLOAD.
+        {100, "7f000000000000000000000000000000000000000000000000000000000000000154" "00"},
+        {100, "600456fe5b00"},             // PUSH JUMP.
+        {100, "600056"},                   // PUSH JUMP to the PUSH1 instead of the JUMPDEST.
+        {100, "6001600a57"},               // PUSH JUMPI outside of the code.
+        {100, "6000600a57"},               // Not taken PUSH JUMPI.
+        {100, "60048056fe5b00"},           // DUP1 JUMP: the jump target known at run time.
+        {100, "600180600757fe5b00"},       // Taken DUP1 PUSH JUMPI.
+        {100, "60016000806008570100"},     // Not taken DUP1 PUSH JUMPI.
+        {100, "6001600a"},                 // PUSH1 at the code end.
+        {100, "0c"},                       // The undefined instruction.
+    };
+
+    for (const auto dispatch : {"switch", "cgoto"})
+    {
+        const auto r = vm.set_option("dispatch", dispatch);
+        if (r == QRVMC_SET_OPTION_INVALID_VALUE)
+            continue;  // The computed goto is not supported by the compiler.
+        ASSERT_EQ(r, QRVMC_SET_OPTION_SUCCESS);
+
+        for (const auto& t : test_cases)
+        {
+            SCOPED_TRACE(std::string{dispatch} + " " + t.code);
+            ASSERT_EQ(vm.set_option("fusion", "off"), QRVMC_SET_OPTION_SUCCESS);
+            const auto expected = execute_in_example_vm(t.gas, t.code);
+            const auto expected_storage_size = host.accounts[msg.recipient].storage.size();
+            host.accounts.clear();
+
+            ASSERT_EQ(vm.set_option("fusion", "on"), QRVMC_SET_OPTION_SUCCESS);
+            const auto result = execute_in_example_vm(t.gas, t.code);
+            EXPECT_EQ(result.status_code, expected.status_code);
+            EXPECT_EQ(result.gas_left, expected.gas_left);
+            EXPECT_EQ(qrvmc::hex({result.output_data, result.output_size}),
+                      qrvmc::hex({expected.output_data, expected.output_size}));
+            EXPECT_EQ(host.accounts[msg.recipient].storage.size(), expected_storage_size);
+            host.accounts.clear();
+        }
+    }
+    vm.set_option("fusion", "off");
+    vm.set_option("dispatch", "cgoto");  // Restore the default, if supported.
+}
+
+TEST_F(example_vm, fusion_prepared_code)
+{
+    ASSERT_EQ(vm.set_option("fusion", "on"), QRVMC_SET_OPTION_SUCCESS);
+
+    // The second execution of the same code runs the cached prepared code.
+    for (int i = 0; i < 2; ++i)
+    {
+        const auto r = execute_in_example_vm(1000, "60105b600190038060025760005260206000f3");
+        EXPECT_EQ(r.status_code, QRVMC_SUCCESS);
+        EXPECT_EQ(r.gas_left, 1000 - (1 + 16 * 7 + 5 + 3));
+    }
+
+    // The JUMPDEST inside the push data is rejected, by both static and dynamic jumps.
+    EXPECT_EQ(execute_in_example_vm(100, "600456605b00").status_code, QRVMC_BAD_JUMP_DESTINATION);
+    EXPECT_EQ(execute_in_example_vm(100, "60058056605b00").status_code,
+              QRVMC_BAD_JUMP_DESTINATION);
+
+    vm.set_option("fusion", "off");
+}
+
+TEST_F(example_vm, set_option_fusion)
+{
+    EXPECT_EQ(vm.set_option("fusion", "yes"), QRVMC_SET_OPTION_INVALID_VALUE);
+    EXPECT_EQ(vm.set_option("fusion", nullptr), QRVMC_SET_OPTION_INVALID_VALUE);
+    EXPECT_EQ(vm.set_option("fusion", "on"), QRVMC_SET_OPTION_SUCCESS);
+    EXPECT_EQ(vm.set_option("fusion", "off"), QRVMC_SET_OPTION_SUCCESS);
+}
@@ -0,0 +1,257 @@
+// EVMC: Ethereum Client-VM Connector API.
+// Copyright 2026 The EVMC Authors.
+// Licensed under the Apache License, Version 2.0.
+
+#include "../../examples/example_vm/example_vm.h"
+#include <qrvmc/executing_mocked_host.hpp>
+#include <qrvmc/hex.hpp>
+#include <gtest/gtest.h>
+
+using namespace qrvmc::literals;
+
+namespace
+{
+auto vm = qrvmc::VM{qrvmc_create_example_vm()};
+
+constexpr auto origin = "Q5000000000000000000000000000000000000005"_address;
+constexpr auto caller = "Qc000000000000000000000000000000000000000"_address;
+constexpr auto callee = "Q000000000000000000000000000000000000000a"_address;
+
+/// Yul: mstore(0, 42) return(0, 32)
+constexpr auto return_42 = "602a60005260206000f3";
+
+/// Yul: sstore(1, 1) revert(0, 0)
+constexpr auto store_and_revert = "600160015560006000fd";
+
+/// pseudo-Yul: call(0xffff, 0x0a, 1, 0, 0, 0, 32) return(0, 32)
+constexpr auto call_callee = "60206000600060006001600a61fffff160206000f3";
+
+class executing_mocked_host : public testing::Test
+{
+protected:
+    qrvmc::ExecutingMockedHost host{vm, QRVMC_SHANGHAI};
+
+    qrvmc::Result call(const qrvmc::address& recipient, uint64_t value = 0, int32_t depth = 0)
+    {
+        qrvmc_message msg{};
+        msg.depth = depth;
+        msg.gas = 1000;
+        msg.sender = origin;
+        msg.recipient = recipient;
+        msg.code_address = recipient;
+        msg.value = qrvmc::uint256be{value};
+        return host.call(msg);
+    }
+
+    qrvmc::Result create(const char* init_code_hex)
+    {
+        const auto init_code = qrvmc::from_hex(init_code_hex).value();
+        qrvmc_message msg{};
+        msg.kind = QRVMC_CREATE;
+        msg.gas = 1000;
+        msg.sender = origin;
+        msg.input_data = init_code.data();
+        msg.input_size = init_code.size();
+        return host.call(msg);
+    }
+
+    void set_code(const qrvmc::address& addr, const char* code_hex)
+    {
+        host.accounts[addr].code = qrvmc::from_hex(code_hex).value();
+    }
+};
+}  // namespace
+
+TEST_F(executing_mocked_host, call_executes_code)
+{
+    set_code(callee, return_42);
+    const auto r = call(callee);
+    EXPECT_EQ(r.status_code, QRVMC_SUCCESS);
+    EXPECT_EQ(r.gas_left, 991);
+    ASSERT_EQ(r.output_size, size_t{32});
+    EXPECT_EQ(r.output_data[31], 42);
+    EXPECT_EQ(host.depth(), size_t{0});
+}
+
+TEST_F(executing_mocked_host, call_without_code)
+{
+    const auto r = call(callee);
+    EXPECT_EQ(r.status_code, QRVMC_SUCCESS);
+    EXPECT_EQ(r.gas_left, 1000);
+    EXPECT_EQ(r.output_size, size_t{0});
+}
+
+TEST_F(executing_mocked_host, nested_call)
+{
+    set_code(caller, call_callee);
+    set_code(callee, return_42);
+    host.accounts[origin].set_balance(10);
+
+    const auto r = call(caller, 3);
+    EXPECT_EQ(r.status_code, QRVMC_SUCCESS);
+    ASSERT_EQ(r.output_size, size_t{32});
+    EXPECT_EQ(r.output_data[31], 42);
+
+    EXPECT_EQ(host.accounts[origin].balance, qrvmc::uint256be{7});
+    EXPECT_EQ(host.accounts[caller].balance, qrvmc::uint256be{2});
+    EXPECT_EQ(host.accounts[callee].balance, qrvmc::uint256be{1});
+
+    ASSERT_EQ(host.recorded_calls.size(), size_t{2});
+    EXPECT_EQ(host.recorded_calls[1].depth, 1);
+    EXPECT_EQ(host.recorded_calls[1].sender, caller);
+    EXPECT_EQ(host.recorded_calls[1].recipient, callee);
+    // The VM keeps the host capabilities in the nested call.
+    EXPECT_EQ(host.recorded_calls[1].flags, qrvmc::MockedHost::host_flags);
+}
+
+TEST_F(executing_mocked_host, revert)
+{
+    set_code(callee, store_and_revert);
+    host.accounts[origin].set_balance(10);
+
+    const auto r = call(callee, 3);
+    EXPECT_EQ(r.status_code, QRVMC_REVERT);
+    EXPECT_EQ(host.accounts[origin].balance, qrvmc::uint256be{10});
+    EXPECT_TRUE(qrvmc::is_zero(host.accounts[callee].balance));
+    EXPECT_TRUE(host.accounts[callee].storage.empty());
+}
+
+TEST_F(executing_mocked_host, nested_revert)
+{
+    set_code(caller, call_callee);
+    set_code(callee, store_and_revert);
+    host.accounts[caller].set_balance(1);
+
+    const auto r = call(caller);
+    EXPECT_EQ(r.status_code, QRVMC_SUCCESS);
+    EXPECT_EQ(host.accounts[caller].balance, qrvmc::uint256be{1});
+    EXPECT_TRUE(qrvmc::is_zero(host.accounts[callee].balance));
+    EXPECT_TRUE(host.accounts[callee].storage.empty());
+}
+
+TEST_F(executing_mocked_host, nested_logs)
+{
+    // pseudo-Yul: log1(0, 0, 1) pop(call(0xffff, 0x0a, 0, 0, 0, 0, 0)) log1(0, 0, 2)
+    set_code(caller, "600160006000a160006000600060006000600a61fffff150600260006000a100");
+
+    // Yul: log0(0, 0)
+    set_code(callee, "60006000a000");
+    EXPECT_EQ(call(caller).status_code, QRVMC_SUCCESS);
+    ASSERT_EQ(host.recorded_logs.size(), size_t{3});
+    EXPECT_EQ(host.recorded_logs[0].creator, caller);
+    EXPECT_EQ(host.recorded_logs[1].creator, callee);
+    EXPECT_EQ(host.recorded_logs[2].creator, caller);
+    EXPECT_EQ(host.recorded_logs[2].topics[0], qrvmc::bytes32{2});
+
+    // Yul: log0(0, 0) revert(0, 0)
+    set_code(callee, "60006000a060006000fd");
+    host.clear_recordings();
+    EXPECT_EQ(call(caller).status_code, QRVMC_SUCCESS);
+    ASSERT_EQ(host.recorded_logs.size(), size_t{2});
+    EXPECT_EQ(host.recorded_logs[0].creator, caller);
+    EXPECT_EQ(host.recorded_logs[1].creator, caller);
+}
+
+namespace
+{
+/// The address of the account executed by another VM.
+constexpr auto other_vm_account = "Q000000000000000000000000000000000000000b"_address;
+
+/// The host executing the calls to the other_vm_account as another VM would:
+/// passing the log to the host directly. The other calls are executed by the example VM.
+class MixedVMsHost : public qrvmc::ExecutingMockedHost
+{
+public:
+    using ExecutingMockedHost::ExecutingMockedHost;
+
+    qrvmc::Result call(const qrvmc_message& msg) noexcept override
+    {
+        if (msg.recipient != other_vm_account)
+            return ExecutingMockedHost::call(msg);
+        emit_log(msg.recipient, nullptr, 0, nullptr, 0);
+        return qrvmc::Result{QRVMC_SUCCESS, msg.gas};
+    }
+};
+}  // namespace
+
+TEST_F(executing_mocked_host, nested_logs_mixed_vms)
+{
+    MixedVMsHost mixed_host{vm, QRVMC_SHANGHAI};
+
+    // pseudo-Yul: log1(0, 0, 1) pop(call(0xffff, 0x0b, 0, 0, 0, 0, 0))
+    //             log1(0, 0, 2) pop(call(0xffff, 0x0a, 0, 0, 0, 0, 0)) log1(0, 0, 3)
+    mixed_host.accounts[caller].code =
+        qrvmc::from_hex(
+            "600160006000a160006000600060006000600b61fffff150"
+            "600260006000a160006000600060006000600a61fffff150600360006000a100")
+            .value();
+
+    // Yul: log0(0, 0)
+    mixed_host.accounts[callee].code = qrvmc::from_hex("60006000a000").value();
+
+    qrvmc_message msg{};
+    msg.gas = 1000;
+    msg.sender = origin;
+    msg.recipient = caller;
+    msg.code_address = caller;
+    EXPECT_EQ(mixed_host.call(msg).status_code, QRVMC_SUCCESS);
+
+    // The logs are in the order of the LOG instructions, whoever executes them.
+    const auto& logs = mixed_host.recorded_logs;
+    ASSERT_EQ(logs.size(), size_t{5});
+    EXPECT_EQ(logs[0].creator, caller);
+    EXPECT_EQ(logs[0].topics[0], qrvmc::bytes32{1});
+    EXPECT_EQ(logs[1].creator, other_vm_account);
+    EXPECT_EQ(logs[2].creator, caller);
+    EXPECT_EQ(logs[2].topics[0], qrvmc::bytes32{2});
+    EXPECT_EQ(logs[3].creator, callee);
+    EXPECT_EQ(logs[4].creator, caller);
+    EXPECT_EQ(logs[4].topics[0], qrvmc::bytes32{3});
+}
+
+TEST_F(executing_mocked_host, insufficient_balance)
+{
+    set_code(callee, return_42);
+    host.accounts[origin].set_balance(1);
+
+    const auto r = call(callee, 2);
+    EXPECT_EQ(r.status_code, QRVMC_INSUFFICIENT_BALANCE);
+    EXPECT_EQ(host.accounts[origin].balance, qrvmc::uint256be{1});
+}
+
+TEST_F(executing_mocked_host, call_depth_exceeded)
+{
+    set_code(callee, return_42);
+    EXPECT_EQ(call(callee, 0, qrvmc::ExecutingMockedHost::max_depth).status_code, QRVMC_SUCCESS);
+    EXPECT_EQ(call(callee, 0, qrvmc::ExecutingMockedHost::max_depth + 1).status_code,
+              QRVMC_CALL_DEPTH_EXCEEDED);
+}
+
+TEST_F(executing_mocked_host, create)
+{
+    // Yul: mstore(0, <return_42>) return(22, 10)
+    const auto init_code = "69602a60005260206000f3600052600a6016f3";
+    const auto r1 = create(init_code);
+    ASSERT_EQ(r1.status_code, QRVMC_SUCCESS);
+    const auto created = qrvmc::address{r1.create_address};
+    EXPECT_EQ(host.accounts[created].code, qrvmc::from_hex(return_42).value());
+    EXPECT_EQ(host.accounts[created].nonce, 1);
+    EXPECT_EQ(host.accounts[origin].nonce, 1);
+
+    const auto r2 = call(created);
+    ASSERT_EQ(r2.output_size, size_t{32});
+    EXPECT_EQ(r2.output_data[31], 42);
+
+    const auto r3 = create(init_code);
+    ASSERT_EQ(r3.status_code, QRVMC_SUCCESS);
+    EXPECT_NE(qrvmc::address{r3.create_address}, created);
+    EXPECT_EQ(host.accounts[origin].nonce, 2);
+}
+
+TEST_F(executing_mocked_host, create_failure)
+{
+    const auto r = create("60006000fd");
+    EXPECT_EQ(r.status_code, QRVMC_REVERT);
+    EXPECT_EQ(host.accounts.count(r.create_address), size_t{0});
+    EXPECT_EQ(host.accounts[origin].nonce, 1);
+}
@@ -4,6 +4,7 @@
 
 #include <qrvmc/mocked_host.hpp>
 #include <gtest/gtest.h>
+#include <sstream>
 
 using namespace qrvmc::literals;
 
@@ -107,3 +108,102 @@ TEST(mocked_host, storage_update_scenarios)
     EXPECT_EQ(execute_scenario(O, Y, O), QRVMC_STORAGE_ADDED_DELETED);
     EXPECT_EQ(execute_scenario(X, Y, X), QRVMC_STORAGE_MODIFIED_RESTORED);
 }
+
+TEST(mocked_host, block_hashes)
+{
+    qrvmc::MockedHost host;
+    host.block_hash = 0xff_bytes32;
+    host.block_hashes.set(1000, 0x03e8_bytes32);
+    host.block_hashes.set(1255, 0x04e7_bytes32);
+
+    EXPECT_EQ(host.get_block_hash(1000), 0x03e8_bytes32);
+    EXPECT_EQ(host.get_block_hash(1255), 0x04e7_bytes32);
+    EXPECT_EQ(host.get_block_hash(999), 0xff_bytes32);
+    EXPECT_EQ(host.get_block_hash(-1), 0xff_bytes32);
+
+    // The block 256 numbers newer takes the slot.
+    host.block_hashes.set(1256, 0x04e8_bytes32);
+    EXPECT_EQ(host.get_block_hash(1000), 0xff_bytes32);
+    EXPECT_EQ(host.get_block_hash(1256), 0x04e8_bytes32);
+    EXPECT_EQ(host.recorded_blockhashes, (std::vector<int64_t>{1000, 1255, 999, -1, 1000, 1256}));
+
+    host.record_blockhashes = false;
+    EXPECT_EQ(host.get_block_hash(1255), 0x04e7_bytes32);
+    EXPECT_EQ(host.recorded_blockhashes.size(), size_t{6});
+
+    host.block_hashes.clear();
+    EXPECT_EQ(host.get_block_hash(1255), 0xff_bytes32);
+}
+
+TEST(mocked_host, block_hashes_load)
+{
+    qrvmc::BlockHashes block_hashes;
+    std::istringstream history{
+        "1 0x01\n"
+        "2 0000000000000000000000000000000000000000000000000000000000000002\n"
+        "257 0x0102\n"};
+    EXPECT_TRUE(block_hashes.load(history));
+    EXPECT_EQ(block_hashes.find(1), nullptr);
+    EXPECT_EQ(*block_hashes.find(2), 0x02_bytes32);
+    EXPECT_EQ(*block_hashes.find(257), 0x0102_bytes32);
+
+    std::istringstream invalid_hash{"3 0x03\n4 0xzz\n"};
+    EXPECT_FALSE(block_hashes.load(invalid_hash));
+    EXPECT_EQ(*block_hashes.find(3), 0x03_bytes32);
+    EXPECT_EQ(block_hashes.find(4), nullptr);
+
+    std::istringstream invalid_number{"x 0x05\n"};
+    EXPECT_FALSE(block_hashes.load(invalid_number));
+
+    std::istringstream truncated{"6 0x06\n7"};
+    EXPECT_FALSE(block_hashes.load(truncated));
+    EXPECT_EQ(*block_hashes.find(6), 0x06_bytes32);
+    EXPECT_EQ(block_hashes.find(7), nullptr);
+
+    std::istringstream invalid_token_at_end{"8 0x08\n-"};
+    EXPECT_FALSE(block_hashes.load(invalid_token_at_end));
+
+    std::istringstream trailing_whitespace{"9 0x09\n\n  "};
+    EXPECT_TRUE(block_hashes.load(trailing_whitespace));
+    EXPECT_EQ(*block_hashes.find(9), 0x09_bytes32);
+}
+
+TEST(mocked_host, recordings)
+{
+    const auto addr = "Qa000000000000000000000000000000000000000"_address;
+    const uint8_t input[] = {1, 2, 3};
+    const qrvmc::bytes32 topics[] = {0x01_bytes32, 0x02_bytes32};
+    const qrvmc::bytes large_data(100000, 0xdd);
+
+    qrvmc::MockedHost host;
+    qrvmc_message msg{};
+    msg.input_data = input;
+    msg.input_size = sizeof(input);
+    host.call(msg);
+    host.emit_log(addr, input, sizeof(input), topics, 2);
+    host.emit_log(addr, large_data.data(), large_data.size(), topics, 0);
+
+    ASSERT_EQ(host.recorded_calls.size(), size_t{1});
+    EXPECT_NE(host.recorded_calls[0].input_data, input);
+    EXPECT_EQ(qrvmc::bytes_view(host.recorded_calls[0].input_data, 3), qrvmc::bytes(input, 3));
+    ASSERT_EQ(host.recorded_logs.size(), size_t{2});
+    EXPECT_EQ(host.recorded_logs[0].creator, addr);
+    EXPECT_EQ(host.recorded_logs[0].data, qrvmc::bytes(input, 3));
+    EXPECT_EQ(host.recorded_logs[0].topics.size(), size_t{2});
+    EXPECT_EQ(host.recorded_logs[0].topics[1], 0x02_bytes32);
+    EXPECT_EQ(host.recorded_logs[0].topics, (std::vector<qrvmc::bytes32>{topics, topics + 2}));
+    EXPECT_EQ(host.recorded_logs[1].data, large_data);
+    EXPECT_TRUE(host.recorded_logs[1].topics.empty());
+
+    // The copy keeps the records valid after the original one is cleared and reused.
+    const auto copy = host;
+    host.clear_recordings();
+    EXPECT_TRUE(host.recorded_calls.empty());
+    EXPECT_TRUE(host.recorded_logs.empty());
+    host.emit_log({}, large_data.data(), 3, topics, 1);
+    ASSERT_EQ(copy.recorded_logs.size(), size_t{2});
+    EXPECT_EQ(copy.recorded_logs[0].data, qrvmc::bytes(input, 3));
+    EXPECT_EQ(copy.recorded_logs[1].data, large_data);
+    EXPECT_EQ(host.recorded_logs[0].data, qrvmc::bytes(3, 0xdd));
+    EXPECT_EQ(host.recorded_logs[0].topics[0], 0x01_bytes32);
+}
@@ -0,0 +1,246 @@
+// EVMC: Ethereum Client-VM Connector API.
+// Copyright 2026 The EVMC Authors.
+// Licensed under the Apache License, Version 2.0.
+
+#include "../../examples/example_vm/example_vm.h"
+#include <qrvmc/executing_mocked_host.hpp>
+#include <qrvmc/hex.hpp>
+#include <qrvmc/parallel.hpp>
+#include <gtest/gtest.h>
+#include <atomic>
+
+using namespace qrvmc::literals;
+using qrvmc::parallel::State;
+
+namespace
+{
+constexpr auto token = "Q7070000000000000000000000000000000000070"_address;
+
+/// The token code moving 1 from the storage slot of the first input word to the slot of
+/// the second one: sstore(a, sub(sload(a), 1)) sstore(b, add(sload(b), 1)).
+const auto token_code = qrvmc::from_hex("600035805460019003905560203580546001019055").value();
+
+/// The input of the token transfer.
+qrvmc::bytes transfer_input(uint64_t from, uint64_t to)
+{
+    qrvmc::bytes input{qrvmc::bytes32{from}.bytes, 32};
+    input.append(qrvmc::bytes32{to}.bytes, 32);
+    return input;
+}
+
+qrvmc_message make_call(const qrvmc::address& recipient, qrvmc::bytes_view input = {})
+{
+    qrvmc_message msg{};
+    msg.kind = QRVMC_CALL;
+    msg.gas = 100000;
+    msg.recipient = recipient;
+    msg.code_address = recipient;
+    msg.input_data = input.data();
+    msg.input_size = input.size();
+    return msg;
+}
+
+/// Executes the transactions one by one with qrvmc::ExecutingMockedHost.
+std::vector<qrvmc::Result> execute_serially(qrvmc::VM& vm,
+                                            State& state,
+                                            const std::vector<qrvmc_message>& transactions)
+{
+    qrvmc::ExecutingMockedHost host{vm, QRVMC_SHANGHAI};
+    host.accounts = state;
+    std::vector<qrvmc::Result> results;
+    for (const auto& msg : transactions)
+    {
+        // Each transaction starts with the original storage values and the cold storage.
+        for (auto& [addr, acc] : host.accounts)
+        {
+            for (auto& [key, value] : acc.storage)
+                value = qrvmc::StorageValue{value.current};
+        }
+        host.clear_recordings();
+        results.emplace_back(host.call(msg));
+    }
+    state = host.accounts;
+    return results;
+}
+
+/// Returns the current storage value of the account, zero if not set.
+qrvmc::bytes32 get_storage(const qrvmc::MockedAccount& acc, const qrvmc::bytes32& key)
+{
+    const auto it = acc.storage.find(key);
+    return it != acc.storage.end() ? it->second.current : qrvmc::bytes32{};
+}
+
+/// Expects the same accounts and the same non-zero storage values in the states.
+void expect_same_state(const State& a, const State& b)
+{
+    ASSERT_EQ(a.size(), b.size());
+    for (const auto& [addr, acc] : a)
+    {
+        SCOPED_TRACE(qrvmc::hex(addr));
+        const auto it = b.find(addr);
+        ASSERT_NE(it, b.end());
+        EXPECT_EQ(acc.nonce, it->second.nonce);
+        EXPECT_EQ(acc.balance, it->second.balance);
+        EXPECT_EQ(acc.code, it->second.code);
+        for (const auto& [key, value] : acc.storage)
+            EXPECT_EQ(value.current, get_storage(it->second, key)) << qrvmc::hex(key);
+        for (const auto& [key, value] : it->second.storage)
+            EXPECT_EQ(value.current, get_storage(acc, key)) << qrvmc::hex(key);
+    }
+}
+
+/// Executes the transactions in parallel and serially and expects the same results.
+qrvmc::parallel::BlockResult execute_and_compare(const State& base,
+                                                 const std::vector<qrvmc_message>& transactions,
+                                                 size_t num_threads)
+{
+    auto vm = qrvmc::VM{qrvmc_create_example_vm()};
+    qrvmc::parallel::Executor executor{vm, QRVMC_SHANGHAI, num_threads};
+    auto state = base;
+    auto block = executor.execute(state, transactions);
+
+    auto expected_state = base;
+    const auto expected = execute_serially(vm, expected_state, transactions);
+    EXPECT_EQ(block.transactions.size(), transactions.size());
+    for (size_t i = 0; i < transactions.size(); ++i)
+    {
+        SCOPED_TRACE(i);
+        EXPECT_EQ(block.transactions[i].result.status_code, expected[i].status_code);
+        EXPECT_EQ(block.transactions[i].result.gas_left, expected[i].gas_left);
+    }
+    expect_same_state(state, expected_state);
+    return block;
+}
+}  // namespace
+
+TEST(parallel, thread_pool)
+{
+    for (const size_t num_threads : {size_t{1}, size_t{4}})
+    {
+        qrvmc::parallel::ThreadPool pool{num_threads};
+        EXPECT_EQ(pool.size(), num_threads);
+
+        for (const size_t num_tasks : {size_t{0}, size_t{1}, size_t{3}, size_t{1000}})
+        {
+            std::vector<std::atomic<int>> counts(num_tasks);
+            pool.run(num_tasks, [&](size_t worker, size_t task) {
+                EXPECT_LT(worker, num_threads);
+                ++counts[task];
+            });
+            for (const auto& count : counts)
+                EXPECT_EQ(count, 1);
+        }
+    }
+    EXPECT_EQ(qrvmc::parallel::ThreadPool{0}.size(), size_t{1});
+}
+
+TEST(parallel, independent_transfers)
+{
+    State base;
+    base[token].code = token_code;
+    std::vector<qrvmc::bytes> inputs;
+    for (uint64_t i = 0; i < 100; ++i)
+    {
+        base[token].storage[qrvmc::bytes32{2 * i + 1}] = qrvmc::bytes32{10};
+        inputs.push_back(transfer_input(2 * i + 1, 2 * i + 2));
+    }
+    std::vector<qrvmc_message> transactions;
+    for (const auto& input : inputs)
+        transactions.push_back(make_call(token, input));
+
+    for (const size_t num_threads : {size_t{1}, size_t{4}})
+    {
+        const auto block = execute_and_compare(base, transactions, num_threads);
+        EXPECT_EQ(block.num_reexecuted, size_t{0});
+    }
+}
+
+TEST(parallel, hot_counter)
+{
+    State base;
+    base[token].code = token_code;
+    const auto input = transfer_input(1, 0);
+    const std::vector<qrvmc_message> transactions(100, make_call(token, input));
+
+    for (const size_t num_threads : {size_t{1}, size_t{4}})
+    {
+        const auto block = execute_and_compare(base, transactions, num_threads);
+        // The transactions executed speculatively one after another read the fresh values.
+        if (num_threads == 1)
+        {
+            EXPECT_EQ(block.num_reexecuted, size_t{0});
+        }
+        EXPECT_LT(block.num_reexecuted, transactions.size());
+    }
+}
+
+TEST(parallel, dependent_value_transfers)
+{
+    constexpr auto a = "Q000000000000000000000000000000000000000a"_address;
+    constexpr auto b = "Q000000000000000000000000000000000000000b"_address;
+    constexpr auto c = "Q000000000000000000000000000000000000000c"_address;
+    State base;
+    base[a].set_balance(10);
+
+    // The transfers of 5 a -> b -> c -> a, then c -> a again: each account can pay only after
+    // receiving the value from the preceding transaction, the last transfer fails.
+    const std::pair<qrvmc::address, qrvmc::address> transfers[]{{a, b}, {b, c}, {c, a}, {c, a}};
+    std::vector<qrvmc_message> transactions;
+    for (const auto& [from, to] : transfers)
+    {
+        auto msg = make_call(to);
+        msg.sender = from;
+        msg.value.bytes[31] = 5;
+        transactions.push_back(msg);
+    }
+
+    for (const size_t num_threads : {size_t{1}, size_t{3}})
+    {
+        const auto block = execute_and_compare(base, transactions, num_threads);
+        EXPECT_EQ(block.transactions[0].result.status_code, QRVMC_SUCCESS);
+        EXPECT_EQ(block.transactions[1].result.status_code, QRVMC_SUCCESS);
+        EXPECT_EQ(block.transactions[2].result.status_code, QRVMC_SUCCESS);
+        EXPECT_EQ(block.transactions[3].result.status_code, QRVMC_INSUFFICIENT_BALANCE);
+    }
+}
+
+TEST(parallel, logs)
+{
+    constexpr auto logger = "Q1000000000000000000000000000000000000001"_address;
+    constexpr auto reverter = "Q2000000000000000000000000000000000000002"_address;
+    constexpr auto nested_logger = "Q000000000000000000000000000000000000000c"_address;
+    constexpr auto nested_reverter = "Q000000000000000000000000000000000000000b"_address;
+    constexpr auto outer_caller = "Q000000000000000000000000000000000000000a"_address;
+    State base;
+    // Yul: mstore(0, 0xaa) log1(31, 1, 0xbb)
+    base[logger].code = qrvmc::from_hex("60aa60005260bb6001601fa100").value();
+    // Yul: mstore(0, 0xaa) log1(31, 1, 0xbb) revert(0, 0)
+    base[reverter].code = qrvmc::from_hex("60aa60005260bb6001601fa160006000fd").value();
+    base[nested_logger].code = base[logger].code;
+    // pseudo-Yul: call(0xffff, 0x0c, 0, 0, 0, 0, 0) revert(0, 0)
+    base[nested_reverter].code =
+        qrvmc::from_hex("60006000600060006000600c61fffff160006000fd").value();
+    // pseudo-Yul: call(0xffff, 0x0b, 0, 0, 0, 0, 0)
+    base[outer_caller].code = qrvmc::from_hex("60006000600060006000600b61fffff100").value();
+
+    auto vm = qrvmc::VM{qrvmc_create_example_vm()};
+    qrvmc::parallel::Executor executor{vm, QRVMC_SHANGHAI, 2};
+    EXPECT_EQ(executor.num_threads(), size_t{2});
+    auto state = base;
+    const auto block = executor.execute(
+        state, {make_call(logger), make_call(reverter), make_call(outer_caller)});
+
+    ASSERT_EQ(block.transactions.size(), size_t{3});
+    EXPECT_EQ(block.transactions[0].result.status_code, QRVMC_SUCCESS);
+    ASSERT_EQ(block.transactions[0].logs.size(), size_t{1});
+    const auto& log = block.transactions[0].logs[0];
+    EXPECT_EQ(log.creator, logger);
+    EXPECT_EQ(log.data, qrvmc::bytes{0xaa});
+    EXPECT_EQ(log.topics, std::vector<qrvmc::bytes32>{0xbb_bytes32});
+    EXPECT_EQ(block.transactions[1].result.status_code, QRVMC_REVERT);
+    EXPECT_TRUE(block.transactions[1].logs.empty());
+
+    // The log of the nested call reverted by its caller is dropped.
+    EXPECT_EQ(block.transactions[2].result.status_code, QRVMC_SUCCESS);
+    EXPECT_TRUE(block.transactions[2].logs.empty());
+}
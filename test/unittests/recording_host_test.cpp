@@ -0,0 +1,176 @@
+// EVMC: Ethereum Client-VM Connector API.
+// Copyright 2026 The EVMC Authors.
+// Licensed under the Apache License, Version 2.0.
+
+#include "../../examples/example_vm/example_vm.h"
+#include <qrvmc/hex.hpp>
+#include <qrvmc/mocked_host.hpp>
+#include <qrvmc/recording_host.hpp>
+#include <gtest/gtest.h>
+
+using namespace qrvmc::literals;
+
+namespace
+{
+constexpr auto a = "Q000000000000000000000000000000000000000a"_address;
+constexpr auto b = "Q000000000000000000000000000000000000000b"_address;
+constexpr auto c = "Q000000000000000000000000000000000000000c"_address;
+
+qrvmc::ReadWriteSet make_set(std::vector<qrvmc::StorageSlot> reads,
+                             std::vector<qrvmc::StorageSlot> writes)
+{
+    qrvmc::ReadWriteSet set;
+    set.reads.slots = std::move(reads);
+    set.writes.slots = std::move(writes);
+    set.normalize();
+    return set;
+}
+}  // namespace
+
+TEST(recording_host, storage)
+{
+    qrvmc::MockedHost mocked_host;
+    qrvmc::RecordingHost host{mocked_host};
+    EXPECT_EQ(&host.host(), &mocked_host);
+
+    host.set_storage(a, 0x01_bytes32, 0x02_bytes32);
+    EXPECT_EQ(host.get_storage(a, 0x01_bytes32), 0x02_bytes32);
+    host.get_storage(b, 0x01_bytes32);
+    host.get_storage(a, 0x00_bytes32);
+    host.access_storage(c, 0x01_bytes32);
+
+    const auto& set = host.read_write_set();
+    const std::vector<qrvmc::StorageSlot> expected_reads{
+        {a, 0x00_bytes32}, {a, 0x01_bytes32}, {b, 0x01_bytes32}};
+    const std::vector<qrvmc::StorageSlot> expected_writes{{a, 0x01_bytes32}};
+    EXPECT_EQ(set.reads.slots, expected_reads);
+    EXPECT_EQ(set.writes.slots, expected_writes);
+    EXPECT_TRUE(set.reads.accounts.empty());
+    EXPECT_TRUE(set.writes.accounts.empty());
+
+    host.clear();
+    EXPECT_TRUE(host.read_write_set().reads.empty());
+    EXPECT_TRUE(host.read_write_set().writes.empty());
+}
+
+TEST(recording_host, accounts)
+{
+    qrvmc::MockedHost mocked_host;
+    qrvmc::RecordingHost host{mocked_host};
+
+    host.account_exists(c);
+    host.get_balance(b);
+    host.get_code_size(a);
+    host.get_code_hash(a);
+    host.copy_code(a, 0, nullptr, 0);
+    host.access_account(c);
+    host.get_block_hash(1);
+    host.get_tx_context();
+    host.emit_log(a, nullptr, 0, nullptr, 0);
+    EXPECT_EQ(mocked_host.recorded_logs.size(), size_t{1});
+
+    const auto& set = host.read_write_set();
+    EXPECT_EQ(set.reads.accounts, (std::vector<qrvmc::address>{a, b, c}));
+    EXPECT_TRUE(set.writes.empty());
+}
+
+TEST(recording_host, call)
+{
+    qrvmc::MockedHost mocked_host;
+    qrvmc::RecordingHost host{mocked_host};
+
+    qrvmc_message msg{};
+    msg.sender = a;
+    msg.recipient = b;
+    msg.code_address = c;
+    host.call(msg);
+    EXPECT_EQ(mocked_host.recorded_calls.size(), size_t{1});
+    EXPECT_EQ(host.read_write_set().reads.accounts, std::vector<qrvmc::address>{c});
+    EXPECT_TRUE(host.read_write_set().writes.empty());
+
+    // The value transfer modifies the sender and the recipient.
+    host.clear();
+    msg.value = qrvmc::uint256be{1};
+    host.call(msg);
+    EXPECT_EQ(host.read_write_set().reads.accounts, (std::vector<qrvmc::address>{a, b, c}));
+    EXPECT_EQ(host.read_write_set().writes.accounts, (std::vector<qrvmc::address>{a, b}));
+
+    // The creation modifies the creator and the created account.
+    host.clear();
+    msg.kind = QRVMC_CREATE;
+    mocked_host.call_result.create_address = c;
+    host.call(msg);
+    EXPECT_EQ(host.read_write_set().writes.accounts, (std::vector<qrvmc::address>{a, c}));
+}
+
+TEST(recording_host, execute)
+{
+    // Yul: sstore(1, add(sload(1), sload(2)))
+    auto vm = qrvmc::VM{qrvmc_create_example_vm()};
+    const auto code = qrvmc::from_hex("6002546001540160015500").value();
+    qrvmc::MockedHost mocked_host;
+    qrvmc::RecordingHost host{mocked_host};
+    qrvmc_message msg{};
+    msg.recipient = a;
+    msg.gas = 100;
+    EXPECT_EQ(vm.execute(host, QRVMC_SHANGHAI, msg, code.data(), code.size()).status_code,
+              QRVMC_SUCCESS);
+
+    const auto& set = host.read_write_set();
+    const std::vector<qrvmc::StorageSlot> expected_reads{{a, 0x01_bytes32}, {a, 0x02_bytes32}};
+    const std::vector<qrvmc::StorageSlot> expected_writes{{a, 0x01_bytes32}};
+    EXPECT_EQ(set.reads.slots, expected_reads);
+    EXPECT_EQ(set.writes.slots, expected_writes);
+}
+
+TEST(recording_host, conflicts)
+{
+    const auto t1 = make_set({{a, 0x01_bytes32}}, {{a, 0x01_bytes32}});
+    const auto t2 = make_set({{a, 0x01_bytes32}, {b, 0x01_bytes32}}, {{b, 0x01_bytes32}});
+    const auto t3 = make_set({{c, 0x01_bytes32}}, {{a, 0x01_bytes32}, {a, 0x02_bytes32}});
+
+    // The read after the write.
+    EXPECT_TRUE(qrvmc::conflicts(t1, t2));
+    EXPECT_TRUE(qrvmc::conflicts(t3, t1));
+    // The write after the read.
+    EXPECT_FALSE(qrvmc::conflicts(t2, t1));
+    EXPECT_FALSE(qrvmc::conflicts(t2, t3));
+    // The writes of the same slot.
+    EXPECT_FALSE(qrvmc::conflicts(t1, t3));
+    EXPECT_FALSE(qrvmc::conflicts(t1, qrvmc::ReadWriteSet{}));
+
+    // The accounts are checked as well.
+    qrvmc::ReadWriteSet transfer;
+    transfer.writes.accounts = {a, b};
+    qrvmc::ReadWriteSet balance;
+    balance.reads.accounts = {b};
+    EXPECT_TRUE(qrvmc::conflicts(transfer, balance));
+    EXPECT_FALSE(qrvmc::conflicts(balance, transfer));
+}
+
+TEST(recording_host, intersects)
+{
+    // The sets of similar and of very different sizes.
+    for (const auto big_size : {size_t{8}, size_t{1000}})
+    {
+        SCOPED_TRACE(big_size);
+        qrvmc::AccessSet big;
+        for (size_t i = 0; i < big_size; ++i)
+            big.slots.push_back({a, qrvmc::bytes32{2 * i}});
+        big.normalize();
+
+        qrvmc::AccessSet odd;
+        odd.slots = {{a, qrvmc::bytes32{1}}, {a, qrvmc::bytes32{2 * big_size - 1}}};
+        EXPECT_FALSE(big.intersects(odd));
+        EXPECT_FALSE(odd.intersects(big));
+
+        qrvmc::AccessSet last;
+        last.slots = {{a, qrvmc::bytes32{1}}, {a, qrvmc::bytes32{2 * big_size - 2}}};
+        EXPECT_TRUE(big.intersects(last));
+        EXPECT_TRUE(last.intersects(big));
+
+        qrvmc::AccessSet other_account;
+        other_account.slots = {{b, qrvmc::bytes32{0}}};
+        EXPECT_FALSE(big.intersects(other_account));
+    }
+}
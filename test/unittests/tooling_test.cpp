@@ -10,6 +10,7 @@
 
 using namespace qrvmc::tooling;
 using qrvmc::from_hex;
+using namespace qrvmc::literals;
 
 namespace
 {
@@ -60,7 +61,7 @@ TEST(tool_commands, run_return_my_address)
         run(vm, QRVMC_SHANGHAI, 200, *from_hex("30600052596000f3"), {}, false, false, out);
     EXPECT_EQ(exit_code, 0);
     EXPECT_EQ(out.str(),
-              out_pattern("Shanghai", 200, "success", 6,
+              out_pattern("Shanghai", 200, "success", 9,
                           "0000000000000000000000000000000000000000000000000000000000000000"));
 }
 
@@ -76,7 +77,7 @@ TEST(tool_commands, run_copy_input_to_output)
             false, out);
     EXPECT_EQ(exit_code, 0);
     EXPECT_EQ(out.str(),
-              out_pattern("Shanghai", 200, "success", 7,
+              out_pattern("Shanghai", 200, "success", 10,
                           "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f"));
 }
 
@@ -91,7 +92,7 @@ TEST(tool_commands, create_return_1)
         run(vm, QRVMC_SHANGHAI, 200, *from_hex("6960016000526001601ff3600052600a6016f3"), {}, true,
             false, out);
     EXPECT_EQ(exit_code, 0);
-    EXPECT_EQ(out.str(), out_pattern("Shanghai", 200, "success", 6, "01", true));
+    EXPECT_EQ(out.str(), out_pattern("Shanghai", 200, "success", 9, "01", true));
 }
 
 TEST(tool_commands, create_copy_input_to_output)
@@ -107,7 +108,7 @@ TEST(tool_commands, create_copy_input_to_output)
     EXPECT_EQ(exit_code, 0);
     EXPECT_EQ(
         out.str(),
-        out_pattern("Shanghai", 200, "success", 7,
+        out_pattern("Shanghai", 200, "success", 10,
                     "0c49c40000000000000000000000000000000000000000000000000000000000", true));
 }
 
@@ -136,7 +137,41 @@ TEST(tool_commands, create_preserve_storage)
         run(vm, QRVMC_SHANGHAI, 200,
             *from_hex("60bb6000556a6000546000526001601ff3600052600b6015f3"), {}, true, false, out);
     EXPECT_EQ(exit_code, 0);
-    EXPECT_EQ(out.str(), out_pattern("Shanghai", 200, "success", 7, "bb", true));
+    EXPECT_EQ(out.str(), out_pattern("Shanghai", 200, "success", 10, "bb", true));
+}
+
+TEST(tool_commands, run_nested_call)
+{
+    // pseudo-Yul: call(0xffff, 0x0a, 0, 0, 0, 0, 32) return(0, 32)
+    // The account 0x0a: mstore(0, 42) return(0, 32)
+    auto vm = qrvmc::VM{qrvmc_create_example_vm()};
+    std::ostringstream out;
+
+    const auto code = *from_hex("60206000600060006000600a61fffff160206000f3");
+    State state;
+    state.accounts["Q000000000000000000000000000000000000000a"_address] =
+        *from_hex("602a60005260206000f3");
+    const auto exit_code = run(vm, QRVMC_SHANGHAI, 200, code, {}, false, false, out, state);
+    EXPECT_EQ(exit_code, 0);
+    EXPECT_EQ(out.str(),
+              out_pattern("Shanghai", 200, "success", 14,
+                          "000000000000000000000000000000000000000000000000000000000000002a"));
+}
+
+TEST(tool_commands, run_block_hash)
+{
+    // Yul: mstore(0, blockhash(7)) return(0, 32)
+    auto vm = qrvmc::VM{qrvmc_create_example_vm()};
+    std::ostringstream out;
+
+    State state;
+    state.block_hashes.set(7, 0x07_bytes32);
+    const auto exit_code = run(vm, QRVMC_SHANGHAI, 200, *from_hex("60074060005260206000f3"), {},
+                               false, false, out, state);
+    EXPECT_EQ(exit_code, 0);
+    EXPECT_EQ(out.str(),
+              out_pattern("Shanghai", 200, "success", 10,
+                          "0000000000000000000000000000000000000000000000000000000000000007"));
 }
 
 TEST(tool_commands, bench_add)
@@ -172,5 +207,5 @@ TEST(tool_commands, bench_inconsistent_output)
         std::string::npos);
     EXPECT_NE(o.find("Time:     "), std::string::npos);
     EXPECT_NE(o.find("Result:   success"), std::string::npos);
-    EXPECT_NE(o.find("Gas used: 10"), std::string::npos);
+    EXPECT_NE(o.find("Gas used: 13"), std::string::npos);
 }
@@ -42,6 +42,22 @@ struct HexOrFileValidator : public CLI::Validator
         };
     }
 };
+
+/// Validates the account argument in the form of ADDRESS:HEX or ADDRESS:@FILE.
+struct AccountValidator : public CLI::Validator
+{
+    AccountValidator() : CLI::Validator{"ADDRESS:HEX|@FILE"}
+    {
+        func_ = [](const std::string& str) -> std::string {
+            const auto sep = str.find(':');
+            if (sep == std::string::npos)
+                return "missing ':' separator";
+            if (!qrvmc::from_prefixed_hex<qrvmc::address>(str.substr(0, sep), "Q"))
+                return "invalid address";
+            return HexOrFileValidator{}(str.substr(sep + 1));
+        };
+    }
+};
 }  // namespace
 
 int main(int argc, const char** argv) noexcept
@@ -51,6 +67,7 @@ int main(int argc, const char** argv) noexcept
     try
     {
         const HexOrFileValidator HexOrFile;
+        const AccountValidator Account;
 
         std::string vm_config;
         std::string code_arg;
@@ -59,6 +76,8 @@ int main(int argc, const char** argv) noexcept
         std::string input_arg;
         auto create = false;
         auto bench = false;
+        std::vector<std::string> account_args;
+        std::string block_hashes_file;
 
         CLI::App app{"QRVMC tool"};
         const auto& version_flag = *app.add_flag("--version", "Print version information and exit");
@@ -78,6 +97,14 @@ int main(int argc, const char** argv) noexcept
         run_cmd.add_flag(
             "--bench", bench,
             "Benchmark execution time (state modification may result in unexpected behaviour)");
+        run_cmd
+            .add_option("--account", account_args,
+                        "Account with the given code called by the executed code")
+            ->check(Account);
+        run_cmd
+            .add_option("--block-hashes", block_hashes_file,
+                        "File with the hashes of the recent blocks: \"<number> <hash>\" per line")
+            ->check(CLI::ExistingFile);
 
         try
         {
@@ -123,7 +150,23 @@ int main(int argc, const char** argv) noexcept
                 // If code_arg or input_arg contains invalid hex string an exception is thrown.
                 const auto code = load_from_hex(code_arg);
                 const auto input = load_from_hex(input_arg);
-                return tooling::run(vm, rev, gas, code, input, create, bench, std::cout);
+
+                tooling::State state;
+                for (const auto& account_arg : account_args)
+                {
+                    const auto sep = account_arg.find(':');
+                    const auto addr =
+                        from_prefixed_hex<address>(account_arg.substr(0, sep), "Q").value();
+                    state.accounts[addr] = load_from_hex(account_arg.substr(sep + 1));
+                }
+                if (!block_hashes_file.empty())
+                {
+                    std::ifstream file{block_hashes_file};
+                    if (!state.block_hashes.load(file))
+                        throw std::invalid_argument{"invalid block hashes in " +
+                                                    block_hashes_file};
+                }
+                return tooling::run(vm, rev, gas, code, input, create, bench, std::cout, state);
             }
 
             return 0;